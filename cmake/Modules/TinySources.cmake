@@ -20,6 +20,7 @@ function(tinyorm_sources out_headers out_sources)
     list(APPEND headers
         basegrammar.hpp
         concerns/countsqueries.hpp
+        concerns/detectsnplusonequeries.hpp
         concerns/detectslostconnections.hpp
         concerns/hasconnectionresolver.hpp
         concerns/logsqueries.hpp
@@ -51,6 +52,7 @@ function(tinyorm_sources out_headers out_sources)
         exceptions/logicerror.hpp
         exceptions/lostconnectionerror.hpp
         exceptions/multiplerecordsfounderror.hpp
+        exceptions/nplusonequeryerror.hpp
         exceptions/ormerror.hpp
         exceptions/queryerror.hpp
         exceptions/recordsnotfounderror.hpp
@@ -73,6 +75,9 @@ function(tinyorm_sources out_headers out_sources)
         ormconcepts.hpp
         ormtypes.hpp
         postgresconnection.hpp
+        query/cache/cachedsqlresult.hpp
+        query/cache/lruquerycache.hpp
+        query/cache/querycache.hpp
         query/concerns/buildsqueries.hpp
         query/expression.hpp
         query/grammars/grammar.hpp
@@ -85,6 +90,7 @@ function(tinyorm_sources out_headers out_sources)
         query/processors/processor.hpp
         query/processors/sqliteprocessor.hpp
         query/querybuilder.hpp
+        query/rowdecoder.hpp
         schema.hpp
         schema/blueprint.hpp
         schema/columndefinition.hpp
@@ -105,9 +111,15 @@ function(tinyorm_sources out_headers out_sources)
         sqliteconnection.hpp
         support/databaseconfiguration.hpp
         support/databaseconnectionsmap.hpp
+        types/arrowstreamwriter.hpp
+        types/columnarresult.hpp
+        types/jsonwriter.hpp
+        types/lazyrange.hpp
         types/log.hpp
+        types/nplusoneviolation.hpp
         types/sqlquery.hpp
         types/statementscounter.hpp
+        utils/cbor.hpp
         utils/configuration.hpp
         utils/container.hpp
         utils/fs.hpp
@@ -117,12 +129,14 @@ function(tinyorm_sources out_headers out_sources)
         utils/query.hpp
         utils/string.hpp
         utils/thread.hpp
+        utils/threadpool.hpp
         utils/type.hpp
         version.hpp
     )
 
     if(ORM)
         list(APPEND headers
+            tiny/cache/entitycache.hpp
             tiny/casts/attribute.hpp
             tiny/concerns/buildsqueries.hpp
             tiny/concerns/buildssoftdeletes.hpp
@@ -161,6 +175,7 @@ function(tinyorm_sources out_headers out_sources)
             tiny/support/stores/baserelationstore.hpp
             tiny/support/stores/belongstomanyrelatedtablestore.hpp
             tiny/support/stores/eagerrelationstore.hpp
+            tiny/support/stores/fromcborrelationstore.hpp
             tiny/support/stores/lazyrelationstore.hpp
             tiny/support/stores/pushrelationstore.hpp
             tiny/support/stores/queriesrelationshipsstore.hpp
@@ -170,9 +185,12 @@ function(tinyorm_sources out_headers out_sources)
             tiny/tinybuilderproxies.hpp
             tiny/tinyconcepts.hpp
             tiny/tinytypes.hpp
+            tiny/types/attributeshash.hpp
             tiny/types/connectionoverride.hpp
+            tiny/types/identitymap.hpp
             tiny/types/modelattributes.hpp
             tiny/types/modelscollection.hpp
+            tiny/types/modelskeyindex.hpp
             tiny/types/syncchanges.hpp
             tiny/utils/attribute.hpp
         )
@@ -191,6 +209,7 @@ function(tinyorm_sources out_headers out_sources)
     list(APPEND sources
         basegrammar.cpp
         concerns/countsqueries.cpp
+        concerns/detectsnplusonequeries.cpp
         concerns/detectslostconnections.cpp
         concerns/hasconnectionresolver.cpp
         concerns/logsqueries.cpp
@@ -217,12 +236,15 @@ function(tinyorm_sources out_headers out_sources)
         libraryinfo.cpp
         mysqlconnection.cpp
         postgresconnection.cpp
+        query/cache/cachedsqlresult.cpp
+        query/cache/lruquerycache.cpp
         query/concerns/buildsqueries.cpp
         query/grammars/grammar.cpp
         query/grammars/mysqlgrammar.cpp
         query/grammars/postgresgrammar.cpp
         query/grammars/sqlitegrammar.cpp
         query/joinclause.cpp
+        query/processors/mysqlprocessor.cpp
         query/processors/processor.cpp
         query/processors/sqliteprocessor.cpp
         query/querybuilder.cpp
@@ -240,7 +262,11 @@ function(tinyorm_sources out_headers out_sources)
         schema/schemabuilder.cpp
         schema/sqliteschemabuilder.cpp
         sqliteconnection.cpp
+        types/arrowstreamwriter.cpp
+        types/columnarresult.cpp
+        types/jsonwriter.cpp
         types/sqlquery.cpp
+        utils/cbor.cpp
         utils/configuration.cpp
         utils/fs.cpp
         utils/helpers.cpp
@@ -248,11 +274,13 @@ function(tinyorm_sources out_headers out_sources)
         utils/query.cpp
         utils/string.cpp
         utils/thread.cpp
+        utils/threadpool.cpp
         utils/type.cpp
     )
 
     if(ORM)
         list(APPEND sources
+            tiny/cache/entitycache.cpp
             tiny/concerns/guardedmodel.cpp
             tiny/exceptions/modelnotfounderror.cpp
             tiny/exceptions/relationmappingnotfounderror.cpp
@@ -430,6 +458,7 @@ function(tiny_model_sources out_headers out_sources)
         datetime.hpp
         datetime_serializeoverride.hpp
         filepropertyproperty.hpp
+        filepropertyproperty_entitycache.hpp
         massassignmentmodels.hpp
         phone.hpp
         role.hpp
@@ -441,6 +470,7 @@ function(tiny_model_sources out_headers out_sources)
         tagged.hpp
         tagproperty.hpp
         torrent.hpp
+        torrent_batchedlazyloading.hpp
         torrent_returnrelation.hpp
         torrenteager.hpp
         torrenteager_failed.hpp
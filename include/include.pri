@@ -12,6 +12,7 @@ else: \
 headersList += \
     $$PWD/orm/basegrammar.hpp \
     $$PWD/orm/concerns/countsqueries.hpp \
+    $$PWD/orm/concerns/detectsnplusonequeries.hpp \
     $$PWD/orm/concerns/detectslostconnections.hpp \
     $$PWD/orm/concerns/hasconnectionresolver.hpp \
     $$PWD/orm/concerns/logsqueries.hpp \
@@ -43,6 +44,7 @@ headersList += \
     $$PWD/orm/exceptions/logicerror.hpp \
     $$PWD/orm/exceptions/lostconnectionerror.hpp \
     $$PWD/orm/exceptions/multiplerecordsfounderror.hpp \
+    $$PWD/orm/exceptions/nplusonequeryerror.hpp \
     $$PWD/orm/exceptions/ormerror.hpp \
     $$PWD/orm/exceptions/queryerror.hpp \
     $$PWD/orm/exceptions/recordsnotfounderror.hpp \
@@ -65,6 +67,9 @@ headersList += \
     $$PWD/orm/ormconcepts.hpp \
     $$PWD/orm/ormtypes.hpp \
     $$PWD/orm/postgresconnection.hpp \
+    $$PWD/orm/query/cache/cachedsqlresult.hpp \
+    $$PWD/orm/query/cache/lruquerycache.hpp \
+    $$PWD/orm/query/cache/querycache.hpp \
     $$PWD/orm/query/concerns/buildsqueries.hpp \
     $$PWD/orm/query/expression.hpp \
     $$PWD/orm/query/grammars/grammar.hpp \
@@ -77,6 +82,7 @@ headersList += \
     $$PWD/orm/query/processors/processor.hpp \
     $$PWD/orm/query/processors/sqliteprocessor.hpp \
     $$PWD/orm/query/querybuilder.hpp \
+    $$PWD/orm/query/rowdecoder.hpp \
     $$PWD/orm/schema.hpp \
     $$PWD/orm/schema/blueprint.hpp \
     $$PWD/orm/schema/columndefinition.hpp \
@@ -97,9 +103,15 @@ headersList += \
     $$PWD/orm/sqliteconnection.hpp \
     $$PWD/orm/support/databaseconfiguration.hpp \
     $$PWD/orm/support/databaseconnectionsmap.hpp \
+    $$PWD/orm/types/arrowstreamwriter.hpp \
+    $$PWD/orm/types/columnarresult.hpp \
+    $$PWD/orm/types/jsonwriter.hpp \
+    $$PWD/orm/types/lazyrange.hpp \
     $$PWD/orm/types/log.hpp \
+    $$PWD/orm/types/nplusoneviolation.hpp \
     $$PWD/orm/types/sqlquery.hpp \
     $$PWD/orm/types/statementscounter.hpp \
+    $$PWD/orm/utils/cbor.hpp \
     $$PWD/orm/utils/configuration.hpp \
     $$PWD/orm/utils/container.hpp \
     $$PWD/orm/utils/fs.hpp \
@@ -109,11 +121,13 @@ headersList += \
     $$PWD/orm/utils/query.hpp \
     $$PWD/orm/utils/string.hpp \
     $$PWD/orm/utils/thread.hpp \
+    $$PWD/orm/utils/threadpool.hpp \
     $$PWD/orm/utils/type.hpp \
     $$PWD/orm/version.hpp \
 
 !disable_orm: \
     headersList += \
+        $$PWD/orm/tiny/cache/entitycache.hpp \
         $$PWD/orm/tiny/casts/attribute.hpp \
         $$PWD/orm/tiny/concerns/buildsqueries.hpp \
         $$PWD/orm/tiny/concerns/buildssoftdeletes.hpp \
@@ -152,6 +166,7 @@ headersList += \
         $$PWD/orm/tiny/support/stores/baserelationstore.hpp \
         $$PWD/orm/tiny/support/stores/belongstomanyrelatedtablestore.hpp \
         $$PWD/orm/tiny/support/stores/eagerrelationstore.hpp \
+        $$PWD/orm/tiny/support/stores/fromcborrelationstore.hpp \
         $$PWD/orm/tiny/support/stores/lazyrelationstore.hpp \
         $$PWD/orm/tiny/support/stores/pushrelationstore.hpp \
         $$PWD/orm/tiny/support/stores/queriesrelationshipsstore.hpp \
@@ -161,9 +176,12 @@ headersList += \
         $$PWD/orm/tiny/tinybuilderproxies.hpp \
         $$PWD/orm/tiny/tinyconcepts.hpp \
         $$PWD/orm/tiny/tinytypes.hpp \
+        $$PWD/orm/tiny/types/attributeshash.hpp \
         $$PWD/orm/tiny/types/connectionoverride.hpp \
+        $$PWD/orm/tiny/types/identitymap.hpp \
         $$PWD/orm/tiny/types/modelattributes.hpp \
         $$PWD/orm/tiny/types/modelscollection.hpp \
+        $$PWD/orm/tiny/types/modelskeyindex.hpp \
         $$PWD/orm/tiny/types/syncchanges.hpp \
         $$PWD/orm/tiny/utils/attribute.hpp \
 
@@ -128,7 +128,19 @@ namespace Query
     template<ColumnContainer T>
     QString BaseGrammar::columnize(T &&columns) const
     {
-        return columnizeWithoutWrap(wrapArray(std::forward<T>(columns)));
+        // Wrap and join in one pass, without the intermediate vector of wrapped columns
+        QString columnized;
+        columnized.reserve(static_cast<QString::size_type>(columns.size()) * 16);
+
+        for (auto it = std::cbegin(columns); it != std::cend(columns); ++it) {
+            // Don't prepend a comma before the first column
+            if (it != std::cbegin(columns))
+                columnized += Constants::COMMA;
+
+            columnized += wrap(*it);
+        }
+
+        return columnized;
     }
 
     /* I leave this method here because it has meaningful name, not make it inline to avoid
@@ -199,14 +211,19 @@ namespace Query
     template<Parametrize Container>
     QString BaseGrammar::parametrize(const Container &values) const
     {
-        QStringList compiledParameters;
-        compiledParameters.reserve(
-                    static_cast<QStringList::size_type>(values.size()));
+        // Append in one pass, without the intermediate QStringList of place-holders
+        QString parameters;
+        parameters.reserve(static_cast<QString::size_type>(values.size()) * 3);
 
-        for (const auto &value : values)
-            compiledParameters << parameter(value);
+        for (auto it = values.constBegin(); it != values.constEnd(); ++it) {
+            // Don't prepend a comma before the first place-holder
+            if (it != values.constBegin())
+                parameters += Constants::COMMA;
+
+            parameters += parameter(*it);
+        }
 
-        return columnizeWithoutWrap(compiledParameters);
+        return parameters;
     }
 
 } // namespace Orm
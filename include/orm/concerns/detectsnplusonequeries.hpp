@@ -0,0 +1,107 @@
+#pragma once
+#ifndef ORM_CONCERNS_DETECTSNPLUSONEQUERIES_HPP
+#define ORM_CONCERNS_DETECTSNPLUSONEQUERIES_HPP
+
+#include "orm/macros/systemheader.hpp"
+TINY_SYSTEM_HEADER
+
+#include <QHash>
+#include <QVector>
+
+#include <typeinfo>
+
+#include "orm/macros/export.hpp"
+#include "orm/types/nplusoneviolation.hpp"
+
+TINYORM_BEGIN_COMMON_NAMESPACE
+
+namespace Orm
+{
+
+class DatabaseConnection;
+
+namespace Concerns
+{
+
+    /*! Detects the same query repeatedly executed by the lazy relation loading (N+1),
+        the detector scope starts with the enableNPlusOneDetector() and ends with
+        the resetNPlusOneDetector() or disableNPlusOneDetector(). */
+    class SHAREDLIB_EXPORT DetectsNPlusOneQueries
+    {
+        Q_DISABLE_COPY(DetectsNPlusOneQueries)
+
+    public:
+        /*! Default constructor. */
+        inline DetectsNPlusOneQueries() = default;
+        /*! Pure virtual destructor, to pass -Weffc++. */
+        inline virtual ~DetectsNPlusOneQueries() = 0;
+
+        /*! Determine whether the N+1 queries are being detected. */
+        bool detectingNPlusOne() const;
+        /*! Enable the N+1 queries detector on the current connection (the query
+            is reported when executed the threshold times by the same relation). */
+        DatabaseConnection &
+        enableNPlusOneDetector(qint64 threshold = 2,
+                               NPlusOneAction action = NPlusOneAction::Log);
+        /*! Disable the N+1 queries detector on the current connection. */
+        DatabaseConnection &disableNPlusOneDetector();
+        /*! Start a new detector scope (forget the counted queries and violations). */
+        DatabaseConnection &resetNPlusOneDetector();
+        /*! Get the N+1 queries detected in the current scope. */
+        const QVector<NPlusOneViolation> &getNPlusOneViolations() const;
+
+    protected:
+        /*! Count the query if executed by the lazy relation loading. */
+        void detectNPlusOne(const QString &queryString);
+
+        /*! Indicates whether the N+1 queries are being detected. */
+        bool m_detectingNPlusOne = false;
+        /*! Number of executions that is reported as the N+1 query. */
+        qint64 m_nPlusOneThreshold = 2;
+        /*! What to do when the N+1 query is detected. */
+        NPlusOneAction m_nPlusOneAction = NPlusOneAction::Log;
+        /*! Number of executions by the relation and query string. */
+        QHash<QString, qint64> m_lazyQueries;
+        /*! N+1 queries detected in the current scope. */
+        QVector<NPlusOneViolation> m_nPlusOneViolations;
+
+    private:
+        /*! Dynamic cast *this to the DatabaseConnection & derived type. */
+        DatabaseConnection &databaseConnection();
+    };
+
+    /*! Marks queries executed on the current thread as the lazy loading
+        of the given relation (RAII, used by the Model::getRelationValue()). */
+    class SHAREDLIB_EXPORT LazyRelationLoading
+    {
+        Q_DISABLE_COPY_MOVE(LazyRelationLoading)
+
+    public:
+        /*! Constructor. */
+        LazyRelationLoading(const std::type_info &model, const QString &relation);
+        /*! Destructor. */
+        ~LazyRelationLoading();
+
+        /*! Get the relation being lazy loaded on the current thread (Model::relation)
+            or an empty string. */
+        static QString current();
+
+    private:
+        /*! The model type. */
+        const std::type_info &m_model;
+        /*! The relation name. */
+        const QString &m_relation;
+        /*! The lazy loading that was active before this one. */
+        LazyRelationLoading *m_previous;
+    };
+
+    /* public */
+
+    DetectsNPlusOneQueries::~DetectsNPlusOneQueries() = default;
+
+} // namespace Concerns
+} // namespace Orm
+
+TINYORM_END_COMMON_NAMESPACE
+
+#endif // ORM_CONCERNS_DETECTSNPLUSONEQUERIES_HPP
@@ -6,11 +6,13 @@
 TINY_SYSTEM_HEADER
 
 #include "orm/concerns/countsqueries.hpp"
+#include "orm/concerns/detectsnplusonequeries.hpp"
 #include "orm/concerns/detectslostconnections.hpp"
 #include "orm/concerns/logsqueries.hpp"
 #include "orm/concerns/managestransactions.hpp"
 #include "orm/connectors/connectorinterface.hpp"
 #include "orm/exceptions/queryerror.hpp"
+#include "orm/query/cache/querycache.hpp"
 #include "orm/query/grammars/grammar.hpp"
 #include "orm/query/processors/processor.hpp"
 #include "orm/schema/grammars/schemagrammar.hpp"
@@ -48,6 +50,7 @@ namespace Orm
             public Concerns::ManagesTransactions,
             public Concerns::LogsQueries,
             public Concerns::CountsQueries,
+            public Concerns::DetectsNPlusOneQueries,
             // Needed to suppress the -Wnon-virtual-dtor diagnostic
             public std::enable_shared_from_this<DatabaseConnection>
     {
@@ -110,6 +113,17 @@ namespace Orm
         selectFromWriteConnection(const QString &queryString,
                                   QVector<QVariant> bindings = {});
 
+        /*! Run a select statement against the database using the forward-only
+            query, the result can be iterated only once. */
+        SqlQuery
+        cursor(const QString &queryString, QVector<QVariant> bindings = {});
+
+        /*! Run a select statement against the database, the result is cached
+            for the given time and invalidated when the given tables are modified. */
+        SqlQuery
+        selectRemembered(const QString &queryString, QVector<QVariant> bindings,
+                         std::chrono::milliseconds ttl, const QStringList &tables = {});
+
         /*! Run a select statement and return a single result. */
         SqlQuery
         selectOne(const QString &queryString, QVector<QVariant> bindings = {});
@@ -242,6 +256,17 @@ namespace Orm
         /*! Reset the record modification state. */
         inline void forgetRecordModificationState();
 
+        /* Query cache */
+        /*! Get the query cache used by the remember() queries (shared by all
+            connections, nullptr by default). */
+        inline static const std::shared_ptr<Query::Cache::QueryCache> &
+        getQueryCache() noexcept;
+        /*! Set the query cache used by the remember() queries to enable caching,
+            nullptr disables it (should be set before connections are used in other
+            threads). */
+        inline static void
+        setQueryCache(std::shared_ptr<Query::Cache::QueryCache> queryCache) noexcept;
+
     protected:
         /*! Set the query grammar to the default implementation. */
         void useDefaultQueryGrammar();
@@ -310,8 +335,17 @@ namespace Orm
         bool m_pretending = false;
 
     private:
+        /*! Run a select statement against the database. */
+        SqlQuery selectInternal(const QString &queryString, QVector<QVariant> &&bindings,
+                                bool forwardOnly, const char *functionName);
         /*! Prepare an SQL statement and return the query object. */
-        QSqlQuery prepareQuery(const QString &queryString);
+        QSqlQuery prepareQuery(const QString &queryString, bool forwardOnly = false);
+
+        /*! Remove cached results invalidated by the given write query. */
+        void invalidateQueryCache(const QString &queryString) const;
+        /*! Create the SqlQuery that serves rows of the given cached entry. */
+        SqlQuery
+        cachedQuery(std::shared_ptr<const Query::Cache::QueryCacheEntry> &&entry);
         /*! Get a new invalid QSqlQuery instance for the pretend. */
         inline static QSqlQuery getQtQueryForPretend();
 
@@ -348,10 +382,15 @@ namespace Orm
         QString m_connectionName;
         /*! Host name, obtained from the connection configuration. */
         QString m_hostName;
+        /*! Query cache scope, shared by all connections to the same database. */
+        QString m_queryCacheScope;
 
         /*! Connection's driver name in printable format eg. QMYSQL -> MySQL. */
         std::optional<std::reference_wrapper<const QString>>
         m_driverNamePrintable = std::nullopt;
+
+        /*! Query cache used by the remember() queries. */
+        static std::shared_ptr<Query::Cache::QueryCache> m_queryCache;
     };
 #if defined(__GNUG__) && !defined(__clang__)
 #  pragma GCC diagnostic pop
@@ -508,6 +547,20 @@ namespace Orm
         m_recordsModified = false;
     }
 
+    /* Query cache */
+
+    const std::shared_ptr<Query::Cache::QueryCache> &
+    DatabaseConnection::getQueryCache() noexcept
+    {
+        return m_queryCache;
+    }
+
+    void DatabaseConnection::setQueryCache(
+            std::shared_ptr<Query::Cache::QueryCache> queryCache) noexcept
+    {
+        m_queryCache = std::move(queryCache);
+    }
+
     /* protected */
 
     template<typename Return>
@@ -560,6 +613,10 @@ namespace Orm
         else
             logQuery(result, elapsed, type);
 
+        // Detect the same query repeatedly executed by the lazy relation loading
+        if (m_detectingNPlusOne && !m_pretending)
+            detectNPlusOne(queryString);
+
         return result;
     }
 
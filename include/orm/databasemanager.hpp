@@ -5,6 +5,8 @@
 #include "orm/macros/systemheader.hpp"
 TINY_SYSTEM_HEADER
 
+#include <mutex>
+
 #include "orm/connectionresolverinterface.hpp"
 #include "orm/query/querybuilder.hpp" // IWYU pragma: export
 #include "orm/support/databaseconfiguration.hpp"
@@ -166,6 +168,16 @@ namespace Query
         /*! Determine whether a given connection is already registered. */
         bool containsConnection(const QString &name = "");
 
+        /*! Register a copy of the given connection for a worker thread and return its
+            name, every thread needs its own database connection. */
+        QString addWorkerConnection(const QString &connection = "");
+        /*! Get the given worker connection instance, must be called from the worker
+            thread that will be using this connection. */
+        DatabaseConnection &workerConnection(const QString &name);
+        /*! Remove the given worker connection, must be called from the worker thread
+            that was using this connection. */
+        bool removeWorkerConnection(const QString &name);
+
         /*! Reconnect to the given database. */
         DatabaseConnection &reconnect(const QString &name = "");
         /*! Disconnect from the given database. */
@@ -379,6 +391,10 @@ namespace Query
         /*! Make the database connection instance. */
         std::shared_ptr<DatabaseConnection>
         makeConnection(const QString &connection);
+        /*! Make the worker database connection instance (nullptr if the given
+            connection is not a worker connection). */
+        std::shared_ptr<DatabaseConnection>
+        makeWorkerConnection(const QString &connection);
 
         /*! Get the configuration for a connection. */
         QVariantHash &configuration(const QString &connection);
@@ -410,6 +426,11 @@ namespace Query
 
         /*! Shared pointer to the DatabaseManager instance. */
         static std::shared_ptr<DatabaseManager> m_instance;
+        /*! Worker connection configurations, they are kept apart from the main
+            configuration that is read without the lock. */
+        std::unordered_map<QString, QVariantHash> m_workerConfigurations {};
+        /*! Guards the worker connection configurations. */
+        static std::mutex m_workerConnectionsMutex;
     };
 
     /* public */
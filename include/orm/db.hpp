@@ -355,6 +355,24 @@ namespace Orm
         /*! Reset the number of executed queries on given connections. */
         static void resetStatementCounters(const QStringList &connections);
 
+        /* N+1 queries detector */
+        /*! Determine whether the N+1 queries are being detected. */
+        static bool detectingNPlusOne(const QString &connection = "");
+        /*! Enable the N+1 queries detector on the given connection. */
+        static DatabaseConnection &
+        enableNPlusOneDetector(qint64 threshold = 2,
+                               NPlusOneAction action = NPlusOneAction::Log,
+                               const QString &connection = "");
+        /*! Disable the N+1 queries detector on the given connection. */
+        static DatabaseConnection &
+        disableNPlusOneDetector(const QString &connection = "");
+        /*! Start a new N+1 queries detector scope on the given connection. */
+        static DatabaseConnection &
+        resetNPlusOneDetector(const QString &connection = "");
+        /*! Get the N+1 queries detected in the current scope. */
+        static const QVector<NPlusOneViolation> &
+        getNPlusOneViolations(const QString &connection = "");
+
     private:
         /*! Get a reference to the DatabaseManager. */
         static DatabaseManager &manager();
@@ -0,0 +1,51 @@
+#pragma once
+#ifndef ORM_EXCEPTIONS_NPLUSONEQUERYERROR_HPP
+#define ORM_EXCEPTIONS_NPLUSONEQUERYERROR_HPP
+
+#include "orm/macros/systemheader.hpp"
+TINY_SYSTEM_HEADER
+
+#include "orm/exceptions/runtimeerror.hpp"
+#include "orm/types/nplusoneviolation.hpp"
+
+TINYORM_BEGIN_COMMON_NAMESPACE
+
+namespace Orm::Exceptions
+{
+
+    /*! The N+1 query detected by the DatabaseConnection N+1 detector. */
+    class NPlusOneQueryError : public RuntimeError // clazy:exclude=copyable-polymorphic
+    {
+    public:
+        /*! Constructor. */
+        inline explicit NPlusOneQueryError(NPlusOneViolation violation);
+
+        /*! Get the detected N+1 query. */
+        inline const NPlusOneViolation &violation() const noexcept;
+
+    protected:
+        /*! The detected N+1 query. */
+        NPlusOneViolation m_violation;
+    };
+
+    /* public */
+
+    NPlusOneQueryError::NPlusOneQueryError(NPlusOneViolation violation)
+        : RuntimeError(QStringLiteral("N+1 query detected, the '%1' relation was lazy "
+                                      "loaded %2 times using the query: %3")
+                       .arg(violation.relation).arg(violation.count)
+                       .arg(violation.queryString)
+                       .toUtf8().constData())
+        , m_violation(std::move(violation))
+    {}
+
+    const NPlusOneViolation &NPlusOneQueryError::violation() const noexcept
+    {
+        return m_violation;
+    }
+
+} // namespace Orm::Exceptions
+
+TINYORM_END_COMMON_NAMESPACE
+
+#endif // ORM_EXCEPTIONS_NPLUSONEQUERYERROR_HPP
@@ -43,6 +43,10 @@ namespace Orm
         bool isMaria();
         /*! Determine whether to use the upsert alias (by MySQL version >=8.0.19). */
         bool useUpsertAlias();
+        /*! Get the auto_increment_increment session variable value. */
+        quint64 autoIncrementIncrement();
+        /*! Get the innodb_autoinc_lock_mode global variable value. */
+        quint64 autoIncrementLockMode();
 #ifdef TINYORM_TESTS_CODE
         /*! Override the version database configuration value. */
         void setConfigVersion(const QString &value);
@@ -70,6 +74,10 @@ namespace Orm
         std::optional<bool> m_isMaria = std::nullopt;
         /*! Determine whether to use the upsert alias (by MySQL version >=8.0.19). */
         std::optional<bool> m_useUpsertAlias = std::nullopt;
+        /*! The auto_increment_increment session variable value. */
+        std::optional<quint64> m_autoIncrementIncrement = std::nullopt;
+        /*! The innodb_autoinc_lock_mode global variable value. */
+        std::optional<quint64> m_autoIncrementLockMode = std::nullopt;
     };
 
     /* public */
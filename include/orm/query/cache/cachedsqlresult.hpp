@@ -0,0 +1,73 @@
+#pragma once
+#ifndef ORM_QUERY_CACHE_CACHEDSQLRESULT_HPP
+#define ORM_QUERY_CACHE_CACHEDSQLRESULT_HPP
+
+#include "orm/macros/systemheader.hpp"
+TINY_SYSTEM_HEADER
+
+#include <QtSql/QSqlResult>
+
+#include "orm/macros/export.hpp"
+#include "orm/query/cache/querycache.hpp"
+
+TINYORM_BEGIN_COMMON_NAMESPACE
+
+namespace Orm::Query::Cache
+{
+
+    /*! The QSqlResult that serves rows of the cached entry, it allows to return
+        the cached result as the QSqlQuery. */
+    class SHAREDLIB_EXPORT CachedSqlResult final : public QSqlResult
+    {
+        Q_DISABLE_COPY(CachedSqlResult)
+
+    public:
+        /*! Constructor. */
+        CachedSqlResult(const QSqlDriver *driver,
+                        std::shared_ptr<const QueryCacheEntry> entry);
+        /*! Virtual destructor. */
+        inline ~CachedSqlResult() final = default;
+
+    protected:
+        /*! Get the value of the field at the given index in the current row. */
+        QVariant data(int index) final;
+        /*! Determine whether the field at the given index in the current row is
+            NULL. */
+        bool isNull(int index) final;
+        /*! Nothing to do, the cached result can't execute queries. */
+        bool reset(const QString &query) final;
+
+        /*! Position the result to the given row. */
+        bool fetch(int index) final;
+        /*! Position the result to the first row. */
+        bool fetchFirst() final;
+        /*! Position the result to the last row. */
+        bool fetchLast() final;
+
+        /*! Get the number of rows in the result. */
+        int size() final;
+        /*! Get the number of rows affected (-1 for the select query). */
+        int numRowsAffected() final;
+        /*! Get the columns of the result. */
+        QSqlRecord record() const final;
+
+    private:
+        /*! Get the number of rows in the result. */
+        inline int rowsCount() const;
+
+        /*! The cached entry. */
+        std::shared_ptr<const QueryCacheEntry> m_entry;
+    };
+
+    /* private */
+
+    int CachedSqlResult::rowsCount() const
+    {
+        return static_cast<int>(m_entry->rows.size());
+    }
+
+} // namespace Orm::Query::Cache
+
+TINYORM_END_COMMON_NAMESPACE
+
+#endif // ORM_QUERY_CACHE_CACHEDSQLRESULT_HPP
@@ -0,0 +1,119 @@
+#pragma once
+#ifndef ORM_QUERY_CACHE_LRUQUERYCACHE_HPP
+#define ORM_QUERY_CACHE_LRUQUERYCACHE_HPP
+
+#include "orm/macros/systemheader.hpp"
+TINY_SYSTEM_HEADER
+
+#include <QHash>
+#include <QSet>
+
+#include <atomic>
+#include <list>
+#include <mutex>
+
+#include "orm/macros/export.hpp"
+#include "orm/query/cache/querycache.hpp"
+
+TINYORM_BEGIN_COMMON_NAMESPACE
+
+namespace Orm::Query::Cache
+{
+
+    /*! In-process thread-safe query cache, the least recently used entries are
+        evicted when the number of entries or the memory limit is exceeded. */
+    class SHAREDLIB_EXPORT LruQueryCache final : public QueryCache
+    {
+        Q_DISABLE_COPY(LruQueryCache)
+
+    public:
+        /*! Constructor. */
+        explicit LruQueryCache(quint64 maxEntries = 1000,
+                               quint64 maxBytes = 64ULL * 1024 * 1024);
+        /*! Virtual destructor. */
+        inline ~LruQueryCache() final = default;
+
+        /*! Get the not expired entry for the given key or nullptr if not found. */
+        std::shared_ptr<const QueryCacheEntry> get(const QByteArray &key) final;
+        /*! Store the entry for the given key. */
+        void put(const QByteArray &key,
+                 std::shared_ptr<const QueryCacheEntry> entry) final;
+
+        /*! Remove all entries in the given scope that read the given table
+            (also entries with unknown tables). */
+        void invalidate(const QString &scope, const QString &table) final;
+        /*! Remove all entries in the given scope. */
+        void flush(const QString &scope) final;
+        /*! Remove all entries. */
+        void flush() final;
+
+        /*! Determine whether the cache is empty. */
+        bool isEmpty() const final;
+        /*! Get the cache metrics. */
+        QueryCacheStats stats() const final;
+
+        /*! Get the maximum number of entries. */
+        inline quint64 maxEntries() const noexcept;
+        /*! Get the memory limit in bytes. */
+        inline quint64 maxBytes() const noexcept;
+
+    private:
+        /*! Cached entry with the LRU bookkeeping. */
+        struct Node
+        {
+            /*! The cached entry. */
+            std::shared_ptr<const QueryCacheEntry> entry;
+            /*! Position in the LRU list. */
+            std::list<QByteArray>::iterator position;
+            /*! Estimated memory used by the entry in bytes. */
+            quint64 bytes;
+        };
+
+        /*! Remove the entry for the given key, the mutex must be locked. */
+        void removeEntry(const QByteArray &key);
+        /*! Evict the least recently used entries until limits are met, the mutex
+            must be locked. */
+        void evict();
+
+        /*! Get the tag for the given scope and table. */
+        static QString tag(const QString &scope, const QString &table);
+        /*! Estimate the memory used by the given entry in bytes. */
+        static quint64 estimateSize(const QByteArray &key,
+                                    const QueryCacheEntry &entry);
+
+        /*! Maximum number of entries. */
+        quint64 m_maxEntries;
+        /*! Memory limit in bytes. */
+        quint64 m_maxBytes;
+
+        /*! Guards all data members below. */
+        mutable std::mutex m_mutex;
+        /*! Cached entries by the key. */
+        QHash<QByteArray, Node> m_entries;
+        /*! Keys ordered from the most recently used. */
+        std::list<QByteArray> m_lru;
+        /*! Keys of entries by the scope and table tag. */
+        QHash<QString, QSet<QByteArray>> m_tags;
+        /*! Cache metrics. */
+        QueryCacheStats m_stats;
+        /*! Number of entries, allows to check isEmpty() without locking. */
+        std::atomic<quint64> m_size = 0;
+    };
+
+    /* public */
+
+    quint64 LruQueryCache::maxEntries() const noexcept
+    {
+        return m_maxEntries;
+    }
+
+    quint64 LruQueryCache::maxBytes() const noexcept
+    {
+        return m_maxBytes;
+    }
+
+} // namespace Orm::Query::Cache
+
+TINYORM_END_COMMON_NAMESPACE
+
+#endif // ORM_QUERY_CACHE_LRUQUERYCACHE_HPP
@@ -0,0 +1,110 @@
+#pragma once
+#ifndef ORM_QUERY_CACHE_QUERYCACHE_HPP
+#define ORM_QUERY_CACHE_QUERYCACHE_HPP
+
+#include "orm/macros/systemheader.hpp"
+TINY_SYSTEM_HEADER
+
+#include <QtSql/QSqlRecord>
+
+#include <chrono>
+#include <memory>
+
+#include "orm/macros/commonnamespace.hpp"
+
+TINYORM_BEGIN_COMMON_NAMESPACE
+
+namespace Orm::Query::Cache
+{
+
+    /*! Cached result of the select query. */
+    struct QueryCacheEntry
+    {
+        /*! Cache scope of the database on which the query was executed. */
+        QString scope;
+        /*! Tables the query reads from, an empty list means any table. */
+        QStringList tables;
+        /*! Columns of the result. */
+        QSqlRecord record;
+        /*! Rows of the result (values as returned by the QSqlQuery). */
+        QVector<QVector<QVariant>> rows;
+        /*! Point in time when the entry expires. */
+        std::chrono::steady_clock::time_point expiresAt;
+    };
+
+    /*! Query cache metrics. */
+    struct QueryCacheStats
+    {
+        /*! Number of found and not expired entries. */
+        quint64 hits = 0;
+        /*! Number of not found or expired entries. */
+        quint64 misses = 0;
+        /*! Number of stored entries. */
+        quint64 puts = 0;
+        /*! Number of entries removed because of the memory or size limit. */
+        quint64 evictions = 0;
+        /*! Number of entries removed because a tagged table was modified. */
+        quint64 invalidations = 0;
+        /*! Number of entries currently in the cache. */
+        quint64 entries = 0;
+        /*! Estimated memory used by the cached entries in bytes. */
+        quint64 bytes = 0;
+
+        /*! Get the ratio of hits to all lookups. */
+        inline double hitRatio() const noexcept;
+    };
+
+    /*! Query cache interface, stores results of remember()-ed select queries. */
+    class QueryCache
+    {
+        Q_DISABLE_COPY(QueryCache)
+
+    public:
+        /*! Default constructor. */
+        inline QueryCache() = default;
+        /*! Pure virtual destructor. */
+        inline virtual ~QueryCache() = 0;
+
+        /*! Get the not expired entry for the given key or nullptr if not found. */
+        virtual std::shared_ptr<const QueryCacheEntry> get(const QByteArray &key) = 0;
+        /*! Store the entry for the given key. */
+        virtual void put(const QByteArray &key,
+                         std::shared_ptr<const QueryCacheEntry> entry) = 0;
+
+        /*! Remove all entries in the given scope that read the given table
+            (also entries with unknown tables). */
+        virtual void invalidate(const QString &scope, const QString &table) = 0;
+        /*! Remove all entries in the given scope. */
+        virtual void flush(const QString &scope) = 0;
+        /*! Remove all entries. */
+        virtual void flush() = 0;
+
+        /*! Determine whether the cache is empty. */
+        virtual bool isEmpty() const = 0;
+        /*! Get the cache metrics. */
+        virtual QueryCacheStats stats() const = 0;
+    };
+
+    /* public */
+
+    /* QueryCacheStats */
+
+    double QueryCacheStats::hitRatio() const noexcept
+    {
+        const auto lookups = hits + misses;
+
+        if (lookups == 0)
+            return 0.0;
+
+        return static_cast<double>(hits) / static_cast<double>(lookups);
+    }
+
+    /* QueryCache */
+
+    QueryCache::~QueryCache() = default;
+
+} // namespace Orm::Query::Cache
+
+TINYORM_END_COMMON_NAMESPACE
+
+#endif // ORM_QUERY_CACHE_QUERYCACHE_HPP
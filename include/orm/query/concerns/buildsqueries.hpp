@@ -5,6 +5,11 @@
 #include "orm/macros/systemheader.hpp"
 TINY_SYSTEM_HEADER
 
+#include <QtSql/QSqlRecord>
+
+#include <atomic>
+
+#include "orm/types/lazyrange.hpp"
 #include "orm/types/sqlquery.hpp"
 
 TINYORM_BEGIN_COMMON_NAMESPACE
@@ -54,6 +59,27 @@ namespace Orm::Query::Concerns
                       qint64 count = 1000, const QString &column = "",
                       const QString &alias = "");
 
+        /*! Query lazily by chunking the results of a query by comparing IDs, the next
+            chunk can be prefetched using the worker connection in the background. */
+        LazyRange<QSqlRecord>
+        lazyById(qint64 count = 1000, const QString &column = "",
+                 const QString &alias = "", bool prefetch = false);
+
+        /*! Chunk the results of a query by comparing IDs, disjoint ID ranges are
+            processed in parallel by the given number of workers (the callback is
+            invoked from the worker threads, the page is counted per ID range). */
+        bool chunkByIdParallel(qint64 count, int workers,
+                               const std::function<
+                                   bool(SqlQuery &results, qint64 page)> &callback,
+                               const QString &column = "", const QString &alias = "");
+        /*! Split the ID range into disjoint ranges and invoke the callback for every
+            range in the worker thread, the query passed to the callback is constrained
+            to the range and uses the worker connection. */
+        bool eachIdRangeParallel(
+                int workers,
+                const std::function<
+                    bool(Builder &query, const std::atomic_bool &stopped)> &callback,
+                const QString &column = "");
 
         /*! Execute the query and get the first result if it's the sole matching
             record. */
@@ -62,6 +88,9 @@ namespace Orm::Query::Concerns
         /*! Pass the query to a given callback. */
         Builder &tap(const std::function<void(Builder &query)> &callback);
 
+        /*! Determine whether the query can be executed using the worker connection. */
+        bool canUseWorkerConnections() const;
+
     private:
         /*! Static cast *this to the QueryBuilder & derived type. */
         Builder &builder() noexcept;
@@ -5,6 +5,9 @@
 #include "orm/macros/systemheader.hpp"
 TINY_SYSTEM_HEADER
 
+#include <atomic>
+#include <bit>
+#include <mutex>
 #include <optional>
 #include <unordered_set>
 
@@ -27,7 +30,8 @@ namespace Orm::Query::Grammars
         /*! Pure virtual destructor. */
         inline ~Grammar() override = 0;
 
-        /*! Compile a select query into SQL. */
+        /*! Compile a select query into SQL (returns the cached SQL for the query
+            of the same shape if the select cache is enabled). */
         QString compileSelect(QueryBuilder &query) const;
 
         /*! Compile an exists statement into SQL. */
@@ -46,6 +50,11 @@ namespace Orm::Query::Grammars
         compileInsertGetId(const QueryBuilder &query,
                            const QVector<QVariantMap> &values,
                            const QString &sequence) const;
+        /*! Compile a multi-rows insert and get IDs statement into SQL. */
+        inline virtual QString
+        compileInsertGetIds(const QueryBuilder &query,
+                            const QVector<QVariantMap> &values,
+                            const QString &sequence) const;
 
         /*! Compile an update statement into SQL. */
         virtual QString
@@ -77,6 +86,33 @@ namespace Orm::Query::Grammars
         /*! Get the grammar specific operators. */
         virtual const std::unordered_set<QString> &getOperators() const;
 
+        /* Compiled select queries cache */
+        /*! Compiled select queries cache statistics. */
+        struct SelectCacheStats
+        {
+            /*! Number of compileSelect() calls that returned the cached SQL. */
+            quint64 hits = 0;
+            /*! Number of compileSelect() calls that compiled and cached the SQL. */
+            quint64 misses = 0;
+            /*! Number of cached SQL queries. */
+            std::size_t size = 0;
+
+            /*! Get the hit ratio (0 if no query was looked up in the cache). */
+            inline double hitRatio() const noexcept;
+        };
+
+        /*! Enable the compiled select queries cache keyed by the query shape (the cache
+            is flushed when the maxSize is reached). */
+        void enableSelectCache(std::size_t maxSize = 512);
+        /*! Disable the compiled select queries cache and flush it. */
+        void disableSelectCache();
+        /*! Determine whether the compiled select queries cache is enabled. */
+        inline bool isSelectCacheEnabled() const noexcept;
+        /*! Flush the compiled select queries cache and reset its statistics. */
+        void flushSelectCache();
+        /*! Get the compiled select queries cache statistics. */
+        SelectCacheStats getSelectCacheStats() const;
+
     protected:
         /*! The select component compile method and whether the component was set. */
         struct SelectComponentValue
@@ -104,7 +140,7 @@ namespace Orm::Query::Grammars
                                       Query::Expression> &from);
 
         /*! Compile the components necessary for a select clause. */
-        QStringList compileComponents(const QueryBuilder &query) const;
+        QString compileComponents(const QueryBuilder &query) const;
 
         /*! Compile an aggregated select clause. */
         QString compileAggregate(const QueryBuilder &query) const;
@@ -116,11 +152,6 @@ namespace Orm::Query::Grammars
 
         /*! Compile the "where" portions of the query. */
         QString compileWheres(const QueryBuilder &query) const;
-        /*! Get the vector of all the where clauses for the query. */
-        QStringList compileWheresToVector(const QueryBuilder &query) const;
-        /*! Format the where clause statements into one string. */
-        static QString concatenateWhereClauses(const QueryBuilder &query,
-                                               const QStringList &sql);
 
         /*! Compile the "join" portions of the query. */
         QString compileJoins(const QueryBuilder &query) const;
@@ -137,8 +168,6 @@ namespace Orm::Query::Grammars
 
         /*! Compile the "order by" portions of the query. */
         QString compileOrders(const QueryBuilder &query) const;
-        /*! Compile the query orders to the vector. */
-        QStringList compileOrdersToVector(const QueryBuilder &query) const;
         /*! Compile the "limit" portions of the query. */
         QString compileLimit(const QueryBuilder &query) const;
         /*! Compile the "offset" portions of the query. */
@@ -212,10 +241,11 @@ namespace Orm::Query::Grammars
         compileDeleteWithJoins(const QueryBuilder &query, const QString &table,
                                const QString &wheres) const;
 
-        /*! Concatenate an array of segments, removing empties. */
-        static QString concatenate(QStringList &&segments);
         /*! Remove the leading boolean from a statement. */
         static QString removeLeadingBoolean(QString &&statement);
+        /*! Remove the leading boolean from a statement in place (starting at
+            the given position). */
+        static void removeLeadingBoolean(QString &statement, QString::size_type from);
 
         /*! Flat bindings map and exclude given binding types. */
         static QVector<std::reference_wrapper<const QVariant>>
@@ -226,6 +256,75 @@ namespace Orm::Query::Grammars
         static QVector<QVariant>::size_type
         computeReserveForBindingsMap(const BindingsMap &bindings,
                                      const QVector<BindingType> &exclude = {});
+
+    private:
+        /*! Structural hash of the select query shape (the compiled select cache key),
+            two independent 64-bit hashes are computed to make collisions negligible. */
+        struct SelectShape
+        {
+            /*! The FNV-1a hash of the shape. */
+            quint64 hash1 = 0xCBF29CE484222325;
+            /*! The second hash of the shape (the rotate-multiply mix). */
+            quint64 hash2 = 0x9E3779B97F4A7C15;
+
+            /*! Mix the given value into the hash. */
+            inline void add(quint64 value) noexcept;
+            /*! Mix the given string into the hash (the size is mixed first). */
+            inline void add(QStringView value) noexcept;
+
+            /*! Equality comparison operator for the SelectShape. */
+            bool operator==(const SelectShape &) const = default;
+
+            /*! Hash functor for the compiled select queries cache. */
+            struct Hash
+            {
+                /*! Get the hash of the given shape. */
+                inline std::size_t operator()(const SelectShape &shape) const noexcept;
+            };
+        };
+
+        /*! Compile a select query into SQL (without the select cache). */
+        QString compileSelectWithoutCache(QueryBuilder &query) const;
+
+        /*! Append the shape of the select query to the key, the shape contains
+            everything that affects the compiled SQL except binding values, returns
+            false if the query can't be cached (contains raw expressions). */
+        bool appendSelectShape(SelectShape &key, const QueryBuilder &query) const;
+        /*! Append the shape of the where clauses to the key. */
+        bool appendWheresShape(SelectShape &key, const QueryBuilder &query) const;
+        /*! Append the shape of the where clause to the key. */
+        bool appendWhereShape(SelectShape &key, const WhereConditionItem &where) const;
+        /*! Append the shape of the having clauses to the key. */
+        static bool appendHavingsShape(SelectShape &key, const QueryBuilder &query);
+        /*! Append the shape of the order by clauses to the key. */
+        static bool appendOrdersShape(SelectShape &key, const QueryBuilder &query);
+        /*! Append the shape of the lock to the key. */
+        static void appendLockShape(SelectShape &key, const QueryBuilder &query);
+
+        /*! Append the column name to the key (false for the raw expression). */
+        static bool appendShape(SelectShape &key, const Column &column);
+        /*! Append the column names to the key (false for the raw expression). */
+        static bool appendShape(SelectShape &key, const QVector<Column> &columns);
+        /*! Append the table name to the key (false for the raw expression). */
+        static bool appendShape(SelectShape &key, const FromClause &table);
+        /*! Append the string to the key. */
+        inline static void appendShape(SelectShape &key, const QString &value);
+        /*! Append the number to the key. */
+        inline static void appendShape(SelectShape &key, quint64 value);
+        /*! Append the binding placeholder to the key (false for the raw expression). */
+        static bool appendBindingShape(SelectShape &key, const QVariant &value);
+
+        /*! Compiled select queries keyed by the query shape. */
+        mutable std::unordered_map<SelectShape, QString, SelectShape::Hash>
+        m_selectCache;
+        /*! Synchronize access to the compiled select queries cache. */
+        mutable std::mutex m_selectCacheMutex;
+        /*! Maximum number of cached select queries (0 if the cache is disabled). */
+        std::atomic<std::size_t> m_selectCacheMaxSize = 0;
+        /*! Number of compileSelect() calls that returned the cached SQL. */
+        mutable quint64 m_selectCacheHits = 0;
+        /*! Number of compileSelect() calls that compiled and cached the SQL. */
+        mutable quint64 m_selectCacheMisses = 0;
     };
 
     /* public */
@@ -239,6 +338,58 @@ namespace Orm::Query::Grammars
         return compileInsert(query, values);
     }
 
+    QString Grammar::compileInsertGetIds(
+            const QueryBuilder &query, const QVector<QVariantMap> &values,
+            const QString &sequence) const
+    {
+        return compileInsertGetId(query, values, sequence);
+    }
+
+    double Grammar::SelectCacheStats::hitRatio() const noexcept
+    {
+        const auto total = hits + misses;
+
+        return total == 0 ? 0.0 : static_cast<double>(hits) / static_cast<double>(total);
+    }
+
+    bool Grammar::isSelectCacheEnabled() const noexcept
+    {
+        return m_selectCacheMaxSize > 0;
+    }
+
+    /* private */
+
+    void Grammar::SelectShape::add(const quint64 value) noexcept
+    {
+        hash1 = (hash1 ^ value) * 0x100000001B3;
+        hash2 = std::rotl(hash2 ^ value, 29) * 0xBF58476D1CE4E5B9;
+    }
+
+    void Grammar::SelectShape::add(const QStringView value) noexcept
+    {
+        // The size makes the encoding prefix-free, so concatenated shapes don't collide
+        add(static_cast<quint64>(value.size()));
+
+        for (const auto ch : value)
+            add(static_cast<quint64>(ch.unicode()));
+    }
+
+    std::size_t
+    Grammar::SelectShape::Hash::operator()(const SelectShape &shape) const noexcept
+    {
+        return static_cast<std::size_t>(shape.hash1);
+    }
+
+    void Grammar::appendShape(SelectShape &key, const QString &value)
+    {
+        key.add(value);
+    }
+
+    void Grammar::appendShape(SelectShape &key, const quint64 value)
+    {
+        key.add(value);
+    }
+
 } // namespace Orm::Query::Grammars
 
 TINYORM_END_COMMON_NAMESPACE
@@ -26,6 +26,10 @@ namespace Orm::Query::Grammars
         /*! Compile an insert ignore statement into SQL. */
         QString compileInsertOrIgnore(const QueryBuilder &query,
                                       const QVector<QVariantMap> &values) const override;
+        /*! Compile a multi-rows insert and get IDs statement into SQL. */
+        QString compileInsertGetIds(const QueryBuilder &query,
+                                    const QVector<QVariantMap> &values,
+                                    const QString &sequence) const override;
 
         /*! Compile an update statement into SQL. */
         QString compileUpdate(QueryBuilder &query,
@@ -13,15 +13,26 @@ namespace Orm::Query::Processors
 {
 
     /*! MySQL processor, process SQL results. */
-    class MySqlProcessor final : public Processor
+    class SHAREDLIB_EXPORT MySqlProcessor final : public Processor
     {
         Q_DISABLE_COPY(MySqlProcessor)
 
+        /*! Alias for the SqlQuery. */
+        using SqlQuery = Orm::Types::SqlQuery;
+
     public:
         /*! Default constructor. */
         inline MySqlProcessor() = default;
         /*! Virtual destructor. */
         inline ~MySqlProcessor() final = default;
+
+        /*! Determine whether IDs of all records inserted by the multi-rows insert
+            statement can be obtained (insertGetIds()). */
+        bool supportsInsertGetIds(QueryBuilder &query) const final;
+        /*! Process the results of the multi-rows "insert get IDs" query. */
+        QVector<quint64>
+        processInsertGetIds(SqlQuery &query,
+                            QVector<QVariant>::size_type count) const final;
     };
 
 } // namespace Orm::Query::Processors
@@ -22,8 +22,20 @@ namespace Orm::Query::Processors
         inline PostgresProcessor() = default;
         /*! Virtual destructor. */
         inline ~PostgresProcessor() final = default;
+
+        /*! Determine whether IDs of all records inserted by the multi-rows insert
+            statement can be obtained (insertGetIds()). */
+        inline bool supportsInsertGetIds(QueryBuilder &query) const final;
     };
 
+    /* public */
+
+    bool PostgresProcessor::supportsInsertGetIds(QueryBuilder &/*unused*/) const
+    {
+        // IDs are obtained using the RETURNING clause
+        return true;
+    }
+
 } // namespace Orm::Query::Processors
 
 TINYORM_END_COMMON_NAMESPACE
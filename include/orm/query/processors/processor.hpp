@@ -6,6 +6,7 @@
 TINY_SYSTEM_HEADER
 
 #include <QStringList>
+#include <QVariant>
 
 #include "orm/macros/commonnamespace.hpp"
 #include "orm/macros/export.hpp"
@@ -14,6 +15,10 @@ TINYORM_BEGIN_COMMON_NAMESPACE
 
 namespace Orm
 {
+namespace Query
+{
+    class Builder;
+}
 namespace Types
 {
     class SqlQuery;
@@ -30,6 +35,10 @@ namespace Query::Processors
         /*! Alias for the SqlQuery. */
         using SqlQuery = Orm::Types::SqlQuery;
 
+    protected:
+        /*! Alias for the QueryBuilder. */
+        using QueryBuilder = Orm::Query::Builder;
+
     public:
         /*! Default constructor. */
         inline Processor() = default;
@@ -38,12 +47,24 @@ namespace Query::Processors
 
         /*! Process the results of a column listing query. */
         virtual QStringList processColumnListing(SqlQuery &query) const;
+
+        /*! Determine whether IDs of all records inserted by the multi-rows insert
+            statement can be obtained (insertGetIds()). */
+        inline virtual bool supportsInsertGetIds(QueryBuilder &query) const;
+        /*! Process the results of the multi-rows "insert get IDs" query. */
+        virtual QVector<quint64>
+        processInsertGetIds(SqlQuery &query, QVector<QVariant>::size_type count) const;
     };
 
     /* public */
 
     Processor::~Processor() = default;
 
+    bool Processor::supportsInsertGetIds(QueryBuilder &/*unused*/) const
+    {
+        return false;
+    }
+
 } // namespace Query::Processors
 } // namespace Orm
 
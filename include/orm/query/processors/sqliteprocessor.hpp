@@ -28,6 +28,10 @@ namespace Orm::Query::Processors
 
         /*! Process the results of a column listing query. */
         QStringList processColumnListing(SqlQuery &query) const final;
+
+        /*! Determine whether IDs of all records inserted by the multi-rows insert
+            statement can be obtained (insertGetIds()). */
+        bool supportsInsertGetIds(QueryBuilder &query) const final;
     };
 
 } // namespace Orm::Query::Processors
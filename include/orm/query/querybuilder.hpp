@@ -5,8 +5,14 @@
 #include "orm/macros/systemheader.hpp"
 TINY_SYSTEM_HEADER
 
+#include <QIODevice>
+
+#include <chrono>
+
 #include "orm/query/concerns/buildsqueries.hpp"
 #include "orm/query/grammars/grammar.hpp"
+#include "orm/query/rowdecoder.hpp"
+#include "orm/types/columnarresult.hpp"
 #include "orm/utils/query.hpp"
 
 TINYORM_BEGIN_COMMON_NAMESPACE
@@ -52,7 +58,7 @@ namespace Orm::Query
         Builder(std::shared_ptr<DatabaseConnection> connection,
                 std::shared_ptr<QueryGrammar> grammar);
         /* Need to be the polymorphic type because of dynamic_cast<>
-           in the Grammar::concatenateWhereClauses(). */
+           in the Grammar::compileWheres(). */
         /*! Virtual destructor. */
         inline ~Builder() override = default;
 
@@ -69,6 +75,25 @@ namespace Orm::Query
         /* Retrieving results */
         /*! Execute the query as a "select" statement. */
         SqlQuery get(const QVector<Column> &columns = {ASTERISK});
+        /*! Get a lazy range for the given query using the forward-only query (yields
+            one record at a time, the same record instance is reused for every row). */
+        LazyRange<QSqlRecord> cursor(const QVector<Column> &columns = {ASTERISK});
+        /*! Execute the query as a "select" statement and decode rows straight into
+            the aggregate struct or std::tuple (columns are mapped by position or by
+            the T::RowColumns names, which are also selected instead of the *). */
+        template<typename T>
+        QVector<T> getAs(const QVector<Column> &columns = {ASTERISK});
+        /*! Get a lazy range for the given query that decodes rows straight into
+            the aggregate struct or std::tuple using the forward-only query. */
+        template<typename T>
+        LazyRange<T> cursorAs(const QVector<Column> &columns = {ASTERISK});
+        /*! Execute the query as a "select" statement and read the result into
+            the typed column buffers (struct-of-arrays) for client-side analytics. */
+        ColumnarResult getColumnar(const QVector<Column> &columns = {ASTERISK});
+        /*! Write the query result to the given device as the Apache Arrow IPC stream
+            (record batches of the given rows count), returns rows count. */
+        qint64 toArrowStream(QIODevice &device, qint64 batchSize = 1000,
+                             const QVector<Column> &columns = {ASTERISK});
         /*! Execute a query for a single record by ID. */
         SqlQuery find(const QVariant &id, const QVector<Column> &columns = {ASTERISK});
 
@@ -123,6 +148,9 @@ namespace Orm::Query
 
         /*! Insert a new record and get the value of the primary key. */
         quint64 insertGetId(const QVariantMap &values, const QString &sequence = "");
+        /*! Insert new records (multi-rows insert) and get values of primary keys. */
+        QVector<quint64>
+        insertGetIds(const QVector<QVariantMap> &values, const QString &sequence = "");
 
         /*! Insert new records into the database while ignoring errors. */
         std::tuple<int, std::optional<QSqlQuery>>
@@ -715,6 +743,15 @@ namespace Orm::Query
         /*! Lock the selected rows in the table. */
         Builder &lock(QString &&value);
 
+        /* Query cache */
+        /*! Cache results of the select query for the given time, the cache is
+            invalidated when the tables in the from and joins clauses are modified
+            (needs DatabaseConnection::setQueryCache(), queries with subqueries
+            or inside transactions are not cached). */
+        Builder &remember(std::chrono::milliseconds ttl);
+        /*! Don't cache results of the select query. */
+        Builder &dontRemember();
+
         /* Debugging */
         /*! Dump the current SQL and bindings. */
         void dump(bool replaceBindings = true, bool simpleBindings = false);
@@ -790,6 +827,9 @@ namespace Orm::Query
         /*! Get the row locking. */
         inline const std::variant<std::monostate, bool, QString> &
         getLock() const noexcept;
+        /*! Get the time for which results of the select query are cached. */
+        inline const std::optional<std::chrono::milliseconds> &
+        getCacheTtl() const noexcept;
 
         /* Other methods */
         /*! Get a new instance of the query builder. */
@@ -832,6 +872,9 @@ namespace Orm::Query
         /*! Clone the query without the given bindings. */
         Builder cloneWithoutBindings(
                 const std::unordered_set<BindingType> &except) const;
+        /*! Clone the query and execute it using the given connection (worker threads
+            need their own connection). */
+        Builder cloneOnConnection(std::shared_ptr<DatabaseConnection> connection) const;
 
     protected:
         /*! Throw if the given operator is not valid for the current DB connection. */
@@ -909,6 +952,18 @@ namespace Orm::Query
     private:
         /*! Run the query as a "select" statement against the connection. */
         SqlQuery runSelect();
+        /*! Get the tables the query reads from for the query cache, the std::nullopt
+            means that the query reads unknown tables and can't be cached. */
+        std::optional<QStringList> cacheTables() const;
+        /*! Determine whether the query contains a subquery (eg. where in/exists,
+            select, or order by subqueries), also checks nested wheres and joins. */
+        bool hasSubquery() const;
+        /*! Determine whether the given raw SQL contains a subquery. */
+        static bool isSubquerySql(const QString &sql);
+        /*! Get the columns to select for the typed row decoding (the T::RowColumns
+            are selected instead of the * if the T has the names list). */
+        template<typename T>
+        static QVector<Column> rowColumns(const QVector<Column> &columns);
 
         /*! Set the table which the query is targeting. */
         inline Builder &setFrom(const FromClause &from);
@@ -989,12 +1044,74 @@ namespace Orm::Query
         qint64 m_offset = -1;
         /*! Indicates whether row locking is being used. */
         std::variant<std::monostate, bool, QString> m_lock {};
+        /*! The time for which results of the select query are cached. */
+        std::optional<std::chrono::milliseconds> m_cacheTtl = std::nullopt;
     };
 
     /* public */
 
     /* Retrieving results */
 
+    template<typename T>
+    QVector<T> Builder::getAs(const QVector<Column> &columns)
+    {
+        auto query = get(rowColumns<T>(columns));
+
+        QVector<T> rows;
+
+        // Nothing to decode
+        if (!query.isActive())
+            return rows;
+
+        const auto indexes = RowDecoder<T>::columnIndexes(query);
+
+        rows.reserve(static_cast<typename QVector<T>::size_type>(
+                         QueryUtils::queryResultSize(query)));
+
+        while (query.next())
+            rows << RowDecoder<T>::decode(query, indexes);
+
+        return rows;
+    }
+
+    template<typename T>
+    LazyRange<T> Builder::cursorAs(const QVector<Column> &columns)
+    {
+        /*! State of the lazy range, the std::function callback must be copyable. */
+        struct CursorState
+        {
+            /*! The forward-only query. */
+            SqlQuery query;
+            /*! The column indexes for the row fields. */
+            QVector<int> indexes {};
+            /*! The current row, reused for every row. */
+            std::optional<T> row = std::nullopt;
+        };
+
+        auto query = onceWithColumns(rowColumns<T>(columns), [this]
+        {
+            return m_connection->cursor(toSql(), getBindings());
+        });
+
+        QVector<int> indexes;
+        if (query.isActive())
+            indexes = RowDecoder<T>::columnIndexes(query);
+
+        auto state = std::make_shared<CursorState>(
+                         CursorState {std::move(query), std::move(indexes)});
+
+        return LazyRange<T>([state = std::move(state)]() -> T *
+        {
+            // No more rows
+            if (!state->query.next())
+                return nullptr;
+
+            state->row = RowDecoder<T>::decode(state->query, state->indexes);
+
+            return &*state->row;
+        });
+    }
+
     SqlQuery Builder::findOr(const QVariant &id,
                              const std::function<void()> &callback)
     {
@@ -1770,6 +1887,12 @@ namespace Orm::Query
         return m_lock;
     }
 
+    const std::optional<std::chrono::milliseconds> &
+    Builder::getCacheTtl() const noexcept
+    {
+        return m_cacheTtl;
+    }
+
     Builder Builder::clone() const
     {
         return *this;
@@ -1785,6 +1908,20 @@ namespace Orm::Query
 
     /* private */
 
+    template<typename T>
+    QVector<Column> Builder::rowColumns(const QVector<Column> &columns)
+    {
+        if constexpr (RowColumnsList<T>) {
+            if (columns.size() == 1 &&
+                std::holds_alternative<QString>(columns.constFirst()) &&
+                std::get<QString>(columns.constFirst()) == ASTERISK
+            )
+                return RowDecoder<T>::columns();
+        }
+
+        return columns;
+    }
+
     Builder &
     Builder::setFrom(const FromClause &from)
     {
@@ -0,0 +1,349 @@
+#pragma once
+#ifndef ORM_QUERY_ROWDECODER_HPP
+#define ORM_QUERY_ROWDECODER_HPP
+
+#include "orm/macros/systemheader.hpp"
+TINY_SYSTEM_HEADER
+
+#include <QDateTime>
+
+#include <optional>
+#include <tuple>
+
+#include "orm/exceptions/invalidargumenterror.hpp"
+#include "orm/ormtypes.hpp"
+#include "orm/types/sqlquery.hpp"
+#include "orm/utils/type.hpp"
+
+TINYORM_BEGIN_COMMON_NAMESPACE
+
+namespace Orm::Query
+{
+
+    /*! Concept for the std::tuple-like row type. */
+    template<typename T>
+    concept RowTuple = requires { std::tuple_size<T>::value; };
+
+    /*! Concept for the std::optional row field type. */
+    template<typename T>
+    concept RowOptional = requires(const T &field)
+    {
+        typename T::value_type;
+        { field.has_value() } -> std::same_as<bool>;
+    };
+
+    /*! Concept for the aggregate row type with the compile-time column names list
+        (static constexpr std::array RowColumns {"id", "name"}). */
+    template<typename T>
+    concept RowColumnsList = requires
+    {
+        std::tuple_size<std::remove_cvref_t<decltype(T::RowColumns)>>::value;
+        { T::RowColumns[0] } -> std::convertible_to<const char *>;
+    };
+
+    /*! Decodes the current row of the SqlQuery straight into the plain aggregate
+        struct or std::tuple, columns are mapped to fields by position or by
+        the T::RowColumns names list (without the Model, AttributeItem-s,
+        attributes hashing, or casting). */
+    template<typename T>
+    class RowDecoder
+    {
+        static_assert(RowTuple<T> ||
+                      (std::is_aggregate_v<T> && std::is_default_constructible_v<T>),
+                      "The RowDecoder<T> template argument must be the std::tuple or "
+                      "the default constructible aggregate.");
+
+    public:
+        /*! Get the number of the row fields. */
+        constexpr static std::size_t fieldsCount() noexcept;
+
+        /*! Get the columns to select from the T::RowColumns names list. */
+        static QVector<Column> columns();
+
+        /*! Get the column indexes for the row fields (by the T::RowColumns names or
+            by position), throws if a column is missing or the count doesn't match. */
+        static QVector<int> columnIndexes(const SqlQuery &query);
+
+        /*! Decode the current row of the given query. */
+        static T decode(const SqlQuery &query, const QVector<int> &indexes);
+
+        /*! Decode the given value to the row field type (checked at compile time),
+            throws if the value is NULL and the field isn't the std::optional. */
+        template<typename F>
+        static F decodeValue(const QVariant &value, int index);
+
+    private:
+        /*! Converts to any field type, used to count the aggregate fields (excludes
+            the std::optional so its converting constructor isn't ambiguous). */
+        struct AnyField
+        {
+            /*! Converting operator to any field type (unevaluated only). */
+            template<typename F> requires (!RowOptional<F>)
+            operator F() const; // NOLINT(google-explicit-constructor)
+        };
+
+        /*! Determine whether the aggregate can be initialized from N fields. */
+        template<std::size_t ...I>
+        constexpr static bool isInitializableFrom(std::index_sequence<I...> /*unused*/);
+        /*! Count the aggregate fields (the maximum initializable fields count). */
+        template<std::size_t N = 16>
+        constexpr static std::size_t countAggregateFields();
+
+        /*! Decode the fields from the query columns at the given indexes. */
+        template<typename ...Fields>
+        static void decodeFields(const SqlQuery &query, const QVector<int> &indexes,
+                                 Fields &...fields);
+    };
+
+    /* public */
+
+    template<typename T>
+    constexpr std::size_t RowDecoder<T>::fieldsCount() noexcept
+    {
+        if constexpr (RowTuple<T>)
+            return std::tuple_size_v<T>;
+        else
+            return countAggregateFields();
+    }
+
+    template<typename T>
+    QVector<Column> RowDecoder<T>::columns()
+    {
+        static_assert(RowColumnsList<T>,
+                      "The RowDecoder<T>::columns() requires the T::RowColumns.");
+
+        QVector<Column> columns;
+        columns.reserve(static_cast<QVector<Column>::size_type>(fieldsCount()));
+
+        for (const char *const column : T::RowColumns)
+            columns << QString::fromUtf8(column);
+
+        return columns;
+    }
+
+    template<typename T>
+    QVector<int> RowDecoder<T>::columnIndexes(const SqlQuery &query)
+    {
+        const auto record = query.record();
+
+        QVector<int> indexes;
+        indexes.reserve(static_cast<QVector<int>::size_type>(fieldsCount()));
+
+        // Map the fields by the compile-time column names
+        if constexpr (RowColumnsList<T>) {
+            static_assert(std::tuple_size_v<
+                              std::remove_cvref_t<decltype(T::RowColumns)>> ==
+                          fieldsCount(),
+                          "The T::RowColumns size must match the number of "
+                          "the RowDecoder<T> row fields.");
+
+            for (const char *const column : T::RowColumns) {
+                const auto index = record.indexOf(QString::fromUtf8(column));
+
+                if (index == -1)
+                    throw Exceptions::InvalidArgumentError(
+                                QStringLiteral("The '%1' column from the RowColumns "
+                                               "is not in the result in %2().")
+                                .arg(QString::fromUtf8(column), __tiny_func__));
+
+                indexes << index;
+            }
+
+            return indexes;
+        }
+
+        // Map the fields by position
+        else {
+            const auto columnsCount = record.count();
+
+            if (static_cast<std::size_t>(columnsCount) != fieldsCount())
+                throw Exceptions::InvalidArgumentError(
+                            QStringLiteral("The number of the selected columns '%1' "
+                                           "doesn't match the number of the row "
+                                           "fields '%2' in %3().")
+                            .arg(columnsCount).arg(fieldsCount())
+                            .arg(__tiny_func__));
+
+            for (int index = 0; index < columnsCount; ++index)
+                indexes << index;
+
+            return indexes;
+        }
+    }
+
+    template<typename T>
+    T RowDecoder<T>::decode(const SqlQuery &query, const QVector<int> &indexes)
+    {
+        T row {};
+
+        if constexpr (RowTuple<T>)
+            std::apply([&query, &indexes](auto &...fields)
+            {
+                decodeFields(query, indexes, fields...);
+            },
+                row);
+
+        else {
+            constexpr auto FieldsCount = fieldsCount();
+
+            static_assert(FieldsCount > 0 && FieldsCount <= 16,
+                          "The aggregate for the RowDecoder<T> can have 1 to 16 fields, "
+                          "use the std::tuple for more fields.");
+
+            // Structured bindings can't be variadic
+            if constexpr (FieldsCount == 1) {
+                auto &[f0] = row;
+                decodeFields(query, indexes, f0);
+            }
+            else if constexpr (FieldsCount == 2) {
+                auto &[f0, f1] = row;
+                decodeFields(query, indexes, f0, f1);
+            }
+            else if constexpr (FieldsCount == 3) {
+                auto &[f0, f1, f2] = row;
+                decodeFields(query, indexes, f0, f1, f2);
+            }
+            else if constexpr (FieldsCount == 4) {
+                auto &[f0, f1, f2, f3] = row;
+                decodeFields(query, indexes, f0, f1, f2, f3);
+            }
+            else if constexpr (FieldsCount == 5) {
+                auto &[f0, f1, f2, f3, f4] = row;
+                decodeFields(query, indexes, f0, f1, f2, f3, f4);
+            }
+            else if constexpr (FieldsCount == 6) {
+                auto &[f0, f1, f2, f3, f4, f5] = row;
+                decodeFields(query, indexes, f0, f1, f2, f3, f4, f5);
+            }
+            else if constexpr (FieldsCount == 7) {
+                auto &[f0, f1, f2, f3, f4, f5, f6] = row;
+                decodeFields(query, indexes, f0, f1, f2, f3, f4, f5, f6);
+            }
+            else if constexpr (FieldsCount == 8) {
+                auto &[f0, f1, f2, f3, f4, f5, f6, f7] = row;
+                decodeFields(query, indexes, f0, f1, f2, f3, f4, f5, f6, f7);
+            }
+            else if constexpr (FieldsCount == 9) {
+                auto &[f0, f1, f2, f3, f4, f5, f6, f7, f8] = row;
+                decodeFields(query, indexes, f0, f1, f2, f3, f4, f5, f6, f7, f8);
+            }
+            else if constexpr (FieldsCount == 10) {
+                auto &[f0, f1, f2, f3, f4, f5, f6, f7, f8, f9] = row;
+                decodeFields(query, indexes, f0, f1, f2, f3, f4, f5, f6, f7, f8, f9);
+            }
+            else if constexpr (FieldsCount == 11) {
+                auto &[f0, f1, f2, f3, f4, f5, f6, f7, f8, f9, f10] = row;
+                decodeFields(query, indexes, f0, f1, f2, f3, f4, f5, f6, f7, f8, f9, f10);
+            }
+            else if constexpr (FieldsCount == 12) {
+                auto &[f0, f1, f2, f3, f4, f5, f6, f7, f8, f9, f10, f11] = row;
+                decodeFields(query, indexes, f0, f1, f2, f3, f4, f5, f6, f7,
+                             f8, f9, f10, f11);
+            }
+            else if constexpr (FieldsCount == 13) {
+                auto &[f0, f1, f2, f3, f4, f5, f6, f7, f8, f9, f10, f11, f12] = row;
+                decodeFields(query, indexes, f0, f1, f2, f3, f4, f5, f6, f7,
+                             f8, f9, f10, f11, f12);
+            }
+            else if constexpr (FieldsCount == 14) {
+                auto &[f0, f1, f2, f3, f4, f5, f6, f7, f8, f9, f10, f11, f12, f13] = row;
+                decodeFields(query, indexes, f0, f1, f2, f3, f4, f5, f6, f7,
+                             f8, f9, f10, f11, f12, f13);
+            }
+            else if constexpr (FieldsCount == 15) {
+                auto &[f0, f1, f2, f3, f4, f5, f6, f7,
+                       f8, f9, f10, f11, f12, f13, f14] = row;
+                decodeFields(query, indexes, f0, f1, f2, f3, f4, f5, f6, f7,
+                             f8, f9, f10, f11, f12, f13, f14);
+            }
+            else if constexpr (FieldsCount == 16) {
+                auto &[f0, f1, f2, f3, f4, f5, f6, f7,
+                       f8, f9, f10, f11, f12, f13, f14, f15] = row;
+                decodeFields(query, indexes, f0, f1, f2, f3, f4, f5, f6, f7,
+                             f8, f9, f10, f11, f12, f13, f14, f15);
+            }
+        }
+
+        return row;
+    }
+
+    template<typename T>
+    template<typename F>
+    F RowDecoder<T>::decodeValue(const QVariant &value, const int index)
+    {
+        // Null values are decoded only into the std::optional
+        if constexpr (RowOptional<F>) {
+            if (value.isNull())
+                return std::nullopt;
+
+            return decodeValue<typename F::value_type>(value, index);
+        }
+        else if constexpr (std::is_same_v<F, QVariant>)
+            return value;
+
+        else {
+            static_assert(std::is_arithmetic_v<F> || std::is_same_v<F, QString> ||
+                          std::is_same_v<F, QByteArray> ||
+                          std::is_same_v<F, QDateTime> || std::is_same_v<F, QDate> ||
+                          std::is_same_v<F, QTime>,
+                          "Unsupported row field type in the RowDecoder<T>, supported "
+                          "are arithmetic types, QString, QByteArray, QDateTime, QDate, "
+                          "QTime, QVariant, and the std::optional of them.");
+
+            if (value.isNull())
+                throw Exceptions::InvalidArgumentError(
+                            QStringLiteral("The NULL value in the column at the index "
+                                           "'%1' can't be decoded into the non-optional "
+                                           "row field, use the std::optional in %2().")
+                            .arg(index).arg(__tiny_func__));
+
+            if (!value.template canConvert<F>())
+                throw Exceptions::InvalidArgumentError(
+                            QStringLiteral("The '%1' value in the column at the index "
+                                           "'%2' can't be converted to the row field "
+                                           "type in %3().")
+                            .arg(value.typeName()).arg(index).arg(__tiny_func__));
+
+            return value.template value<F>();
+        }
+    }
+
+    /* private */
+
+    template<typename T>
+    template<std::size_t ...I>
+    constexpr bool
+    RowDecoder<T>::isInitializableFrom(std::index_sequence<I...> /*unused*/)
+    {
+        return requires { T {(static_cast<void>(I), AnyField {})...}; };
+    }
+
+    template<typename T>
+    template<std::size_t N>
+    constexpr std::size_t RowDecoder<T>::countAggregateFields()
+    {
+        if constexpr (N == 0)
+            return 0;
+        else if constexpr (isInitializableFrom(std::make_index_sequence<N>()))
+            return N;
+        else
+            return countAggregateFields<N - 1>();
+    }
+
+    template<typename T>
+    template<typename ...Fields>
+    void RowDecoder<T>::decodeFields(const SqlQuery &query,
+                                     const QVector<int> &indexes, Fields &...fields)
+    {
+        auto index = indexes.constBegin();
+
+        // SqlQuery::value() also correctly handles the QDateTime's time zone
+        ((fields = decodeValue<std::remove_cvref_t<Fields>>(query.value(*index), *index),
+          ++index), ...);
+    }
+
+} // namespace Orm::Query
+
+TINYORM_END_COMMON_NAMESPACE
+
+#endif // ORM_QUERY_ROWDECODER_HPP
@@ -43,6 +43,12 @@ namespace Orm
         /*! Set return the QDateTime or QString (override the return_qdatetime). */
         SQLiteConnection &setReturnQDateTime(bool value);
 
+        /* Getters / Setters */
+        /*! Get the SQLite library version. */
+        std::optional<QString> version();
+        /*! Determine whether the RETURNING clause is supported (by SQLite >=3.35). */
+        bool supportsReturning();
+
     protected:
         /*! Get the default query grammar instance. */
         std::unique_ptr<QueryGrammar> getDefaultQueryGrammar() const final;
@@ -52,6 +58,11 @@ namespace Orm
         std::unique_ptr<SchemaBuilder> getDefaultSchemaBuilder() final;
         /*! Get the default post processor instance. */
         std::unique_ptr<QueryProcessor> getDefaultPostProcessor() const final;
+
+        /*! SQLite library version. */
+        std::optional<QString> m_version = std::nullopt;
+        /*! Determine whether the RETURNING clause is supported (by SQLite >=3.35). */
+        std::optional<bool> m_supportsReturning = std::nullopt;
     };
 
     /* public */
@@ -0,0 +1,142 @@
+#pragma once
+#ifndef ORM_TINY_CACHE_ENTITYCACHE_HPP
+#define ORM_TINY_CACHE_ENTITYCACHE_HPP
+
+#include "orm/macros/systemheader.hpp"
+TINY_SYSTEM_HEADER
+
+#include <QHash>
+#include <QSet>
+
+#include <atomic>
+#include <list>
+#include <mutex>
+#include <optional>
+
+#include "orm/tiny/tinytypes.hpp"
+
+TINYORM_BEGIN_COMMON_NAMESPACE
+
+namespace Orm::Tiny::Cache
+{
+
+    /*! Entity cache metrics. */
+    struct EntityCacheStats
+    {
+        /*! Number of found entities. */
+        quint64 hits = 0;
+        /*! Number of not found entities. */
+        quint64 misses = 0;
+        /*! Number of stored entities. */
+        quint64 puts = 0;
+        /*! Number of entities removed because of the size limit. */
+        quint64 evictions = 0;
+        /*! Number of entities removed because they were modified. */
+        quint64 invalidations = 0;
+        /*! Number of entities currently in the cache. */
+        quint64 entries = 0;
+
+        /*! Get the ratio of hits to all lookups. */
+        inline double hitRatio() const noexcept;
+    };
+
+    /*! Second-level cache of the model attributes keyed by the connection, table,
+        and primary key, shared by all models that enable the u_entityCache
+        (thread-safe, the least recently used entities are evicted). */
+    class SHAREDLIB_EXPORT EntityCache final
+    {
+        Q_DISABLE_COPY(EntityCache)
+
+    public:
+        /*! Constructor. */
+        explicit EntityCache(quint64 maxEntries = 10000);
+        /*! Default destructor. */
+        inline ~EntityCache() = default;
+
+        /*! Get the process-wide entity cache instance. */
+        static EntityCache &instance();
+
+        /*! Get the attributes of the cached entity or std::nullopt if not found. */
+        std::optional<QVector<AttributeItem>>
+        get(const QString &connection, const QString &table, const QVariant &key);
+        /*! Store the attributes of the entity. */
+        void put(const QString &connection, const QString &table, const QVariant &key,
+                 QVector<AttributeItem> attributes);
+
+        /*! Remove the entity from the cache. */
+        void forget(const QString &connection, const QString &table,
+                    const QVariant &key);
+        /*! Remove all entities of the given table from the cache. */
+        void forgetTable(const QString &connection, const QString &table);
+        /*! Remove all entities. */
+        void flush();
+
+        /*! Determine whether the cache is empty. */
+        bool isEmpty() const;
+        /*! Get the cache metrics. */
+        EntityCacheStats stats() const;
+
+        /*! Get the maximum number of entities. */
+        quint64 maxEntries() const;
+        /*! Set the maximum number of entities (evicts if needed). */
+        void setMaxEntries(quint64 maxEntries);
+
+    private:
+        /*! Cached entity with the LRU bookkeeping. */
+        struct Node
+        {
+            /*! Attributes of the cached entity. */
+            QVector<AttributeItem> attributes;
+            /*! The connection and table tag. */
+            QString tag;
+            /*! Position in the LRU list. */
+            std::list<QString>::iterator position;
+        };
+
+        /*! Remove the entity for the given cache key, the mutex must be locked. */
+        void removeEntry(const QString &cacheKey);
+        /*! Evict the least recently used entities until the limit is met, the mutex
+            must be locked. */
+        void evict();
+
+        /*! Get the tag for the given connection and table. */
+        static QString tag(const QString &connection, const QString &table);
+        /*! Get the cache key for the given tag and primary key. */
+        static QString cacheKey(const QString &tag, const QVariant &key);
+
+        /*! Maximum number of entities. */
+        quint64 m_maxEntries;
+
+        /*! Guards all data members below. */
+        mutable std::mutex m_mutex;
+        /*! Cached entities by the cache key. */
+        QHash<QString, Node> m_entries;
+        /*! Cache keys ordered from the most recently used. */
+        std::list<QString> m_lru;
+        /*! Cache keys by the connection and table tag. */
+        QHash<QString, QSet<QString>> m_tags;
+        /*! Cache metrics. */
+        EntityCacheStats m_stats;
+        /*! Number of entities, allows to check isEmpty() without locking. */
+        std::atomic<quint64> m_size = 0;
+    };
+
+    /* public */
+
+    /* EntityCacheStats */
+
+    double EntityCacheStats::hitRatio() const noexcept
+    {
+        const auto lookups = hits + misses;
+
+        if (lookups == 0)
+            return 0.0;
+
+        return static_cast<double>(hits) / static_cast<double>(lookups);
+    }
+
+} // namespace Orm::Tiny::Cache
+
+TINYORM_END_COMMON_NAMESPACE
+
+#endif // ORM_TINY_CACHE_ENTITYCACHE_HPP
@@ -5,9 +5,12 @@
 #include "orm/macros/systemheader.hpp"
 TINY_SYSTEM_HEADER
 
+#include "orm/databaseconnection.hpp"
 #include "orm/exceptions/multiplerecordsfounderror.hpp"
 #include "orm/exceptions/recordsnotfounderror.hpp"
+#include "orm/query/querybuilder.hpp"
 #include "orm/tiny/types/modelscollection.hpp"
+#include "orm/types/lazyrange.hpp"
 #include "orm/utils/query.hpp"
 
 TINYORM_BEGIN_COMMON_NAMESPACE
@@ -70,6 +73,24 @@ namespace Concerns
                       qint64 count = 1000, const QString &column = "",
                       const QString &alias = "") const;
 
+        /*! Query lazily by chunking the results of a query by comparing IDs, the next
+            chunk can be prefetched using the worker connection in the background
+            (eager loading is not supported). */
+        LazyRange<Model>
+        lazyById(qint64 count = 1000, const QString &column = "",
+                 const QString &alias = "", bool prefetch = false);
+
+        /*! Chunk the results of a query by comparing IDs, disjoint ID ranges are
+            processed in parallel by the given number of workers (the callback is
+            invoked from the worker threads, models use the original connection so
+            they can't query the database in the callback, eager loading is not
+            supported). */
+        bool chunkByIdParallel(
+                qint64 count, int workers,
+                const std::function<
+                    bool(ModelsCollection<Model> &&models, qint64 page)> &callback,
+                const QString &column = "", const QString &alias = "");
+
         /*! Execute the query and get the first result if it's the sole matching
             record. */
         Model sole(const QVector<Column> &columns = {ASTERISK});
@@ -280,6 +301,97 @@ namespace Concerns
             column, alias);
     }
 
+    template<ModelConcept Model>
+    LazyRange<Model>
+    BuildsQueries<Model>::lazyById(const qint64 count, const QString &column,
+                                   const QString &alias, const bool prefetch)
+    {
+        const auto columnName = column.isEmpty() ? builder().defaultKeyName() : column;
+
+        /*! State of the lazy range, the std::function callback must be copyable. */
+        struct LazyByIdState
+        {
+            /*! Lazily fetched records. */
+            LazyRange<QSqlRecord> records;
+            /*! Model instance used to create new models. */
+            Model instance;
+            /*! The current model. */
+            Model model {};
+        };
+
+        auto state = std::make_shared<LazyByIdState>(LazyByIdState {
+                         builder().toBase().lazyById(count, columnName, alias,
+                                                     prefetch),
+                         builder().newModelInstance()});
+
+        return LazyRange<Model>([state = std::move(state)]() -> Model *
+        {
+            auto *const record = state->records.next();
+
+            // No more records
+            if (record == nullptr)
+                return nullptr;
+
+            const auto fieldsCount = record->count();
+
+            QVector<AttributeItem> attributes;
+            attributes.reserve(fieldsCount);
+
+            // Populate model attributes with data from the database (one table row)
+            for (int i = 0; i < fieldsCount; ++i)
+                attributes.append({record->fieldName(i), record->value(i)});
+
+            // Create a new model instance from the table row
+            state->model = state->instance.newFromBuilder(std::move(attributes));
+
+            return &state->model;
+        });
+    }
+
+    template<ModelConcept Model>
+    bool BuildsQueries<Model>::chunkByIdParallel(
+            const qint64 count, const int workers,
+            const std::function<bool(ModelsCollection<Model> &&, qint64)> &callback,
+            const QString &column, const QString &alias)
+    {
+        const auto columnName = column.isEmpty() ? builder().defaultKeyName() : column;
+
+        /* Every worker hydrates models using its own TinyBuilder and model instance,
+           the TinyBuilder of the current thread can't be shared between threads. */
+        const auto &model = builder().getModel();
+        const auto &connection = builder().getConnection().getName();
+
+        return builder().toBase().eachIdRangeParallel(
+                    workers,
+                    [count, &callback, &columnName, &alias, &model, &connection]
+                    (QueryBuilder &query, const std::atomic_bool &stopped)
+        {
+            Builder<Model> workerBuilder(std::make_shared<QueryBuilder>(query.clone()),
+                                         model.newInstance());
+
+            return query.chunkById(count, [&callback, &stopped, &connection,
+                                           &workerBuilder]
+                                          (SqlQuery &results, const qint64 page)
+            {
+                // Some other worker failed or its callback returned false
+                if (stopped)
+                    return false;
+
+                auto models = workerBuilder.hydrate(std::move(results));
+
+                /* The worker connection is removed when the worker finishes, so models
+                   must use the original connection (they can be kept after
+                   the callback), they can't query the database in the worker thread. */
+                for (auto &hydrated : models)
+                    hydrated.setConnection(connection);
+
+                return std::invoke(callback, std::move(models), page);
+            },
+                columnName, alias);
+        },
+            columnName);
+    }
+
     template<ModelConcept Model>
     Model BuildsQueries<Model>::sole(const QVector<Column> &columns)
     {
@@ -21,7 +21,10 @@ TINY_SYSTEM_HEADER
 #include "orm/tiny/casts/attribute.hpp"
 #include "orm/tiny/exceptions/mutatormappingnotfounderror.hpp"
 #include "orm/tiny/macros/crtpmodelwithbase.hpp"
+#include "orm/tiny/types/attributeshash.hpp"
 #include "orm/tiny/utils/attribute.hpp"
+#include "orm/types/jsonwriter.hpp"
+#include "orm/utils/cbor.hpp"
 #include "orm/utils/configuration.hpp"
 #include "orm/utils/helpers.hpp"
 #include "orm/utils/nullvariant.hpp"
@@ -39,6 +42,8 @@ namespace Orm::Tiny::Concerns
     {
         /*! Alias for the attribute utils. */
         using AttributeUtils = Orm::Tiny::Utils::Attribute;
+        /*! Alias for the CBOR utils. */
+        using CborUtils = Orm::Utils::Cbor;
         /*! Alias for the configuration utils. */
         using ConfigUtils = Orm::Utils::Configuration;
         /*! Alias for the helper utils. */
@@ -67,6 +72,11 @@ namespace Orm::Tiny::Concerns
         /*! Set a vector of model attributes. No checking is done. */
         Derived &setRawAttributes(QVector<AttributeItem> &&attributes,
                                   bool sync = false);
+        /*! Set a vector of model attributes without duplicit keys, the attributes hash
+            contains their positions (used by the hydration, no rehashing is done). */
+        Derived &setRawAttributes(
+                QVector<AttributeItem> &&attributes, const AttributesHash &attributesHash,
+                bool sync = false);
         /*! Sync the original attributes with the current. */
         Derived &syncOriginal();
 
@@ -241,6 +251,14 @@ namespace Orm::Tiny::Concerns
         QVariantMap attributesToMap() const;
         /*! Convert the model's attributes to the vector. */
         QVector<AttributeItem> attributesToVector() const;
+        /*! Write the model's attributes straight to the JSON writer (streaming). */
+        void writeAttributesJson(JsonWriter &writer) const;
+        /*! Write the model's raw attributes to the CBOR writer (native types,
+            without the casts, dates, visible/hidden, and appends). */
+        void writeAttributesCbor(QCborStreamWriter &writer) const;
+        /*! Set the model's raw attributes from the CBOR (written by
+            the writeAttributesCbor()) and sync the original attributes. */
+        void readAttributesCbor(QCborStreamReader &reader);
 
         /* Serialization - Appends */
         /*! Append accessor attribute to the u_appends set. */
@@ -298,8 +316,7 @@ namespace Orm::Tiny::Concerns
         /*! Rehash attribute positions from the given index. */
         static void rehashAttributePositions(
                 const QVector<AttributeItem> &attributes,
-                std::unordered_map<QString, AttributesSizeType> &attributesHash,
-                int from = 0);
+                AttributesHash &attributesHash, int from = 0);
         /*! Rehash attribute positions from the given index. */
         static std::unordered_map<QString, AttributesSizeType>
         rehashAttributePositions(const QVector<AttributeItem> &attributes,
@@ -308,6 +325,9 @@ namespace Orm::Tiny::Concerns
         /* Datetime-related */
         /*! Determine if the given attribute is a date. */
         bool isDateAttribute(const QString &key) const;
+        /*! Determine if the given attribute is in the getDates() (without building
+            the dates list). */
+        bool isInDates(const QString &key) const;
 
         /*! Return a timestamp as QDateTime object. */
         QDateTime asDateTime(const QVariant &value) const;
@@ -340,6 +360,9 @@ namespace Orm::Tiny::Concerns
         inline CastItem getCastItem(const QString &key) const;
         /*! Get the type of cast for a model attribute. */
         inline CastType getCastType(const QString &key) const;
+        /*! Get the cast item for a model attribute or nullptr if it has no cast
+            (without copying the u_casts like the getCasts() does). */
+        const CastItem *findCastItem(const QString &key) const;
 
         /*! Determine whether a value is Date / DateTime castable. */
         inline bool isDateCastable(const QString &key) const;
@@ -421,12 +444,15 @@ namespace Orm::Tiny::Concerns
 
         /* Don't want to use std::reference_wrapper to attributes, because if a copy
            of the model is made, all references would be invalidated. */
+        /* The attribute positions are implicitly shared, the hydrated models share
+           them with the other models from the same result and the original state
+           shares them with the attributes until one of them is modified. */
         /*! The model's attributes hash (for fast lookup). */
-        std::unordered_map<QString, AttributesSizeType> m_attributesHash;
+        AttributesHash m_attributesHash;
         /*! The model attribute's original state (for fast lookup). */
-        std::unordered_map<QString, AttributesSizeType> m_originalHash;
+        AttributesHash m_originalHash;
         /*! The changed model attributes (for fast lookup). */
-        std::unordered_map<QString, AttributesSizeType> m_changesHash;
+        AttributesHash m_changesHash;
 
         /*! The storage format of the model's date columns. */
         T_THREAD_LOCAL
@@ -643,12 +669,33 @@ namespace Orm::Tiny::Concerns
         return model();
     }
 
+    template<typename Derived, AllRelationsConcept ...AllRelations>
+    Derived &
+    HasAttributes<Derived, AllRelations...>::setRawAttributes(
+            QVector<AttributeItem> &&attributes, const AttributesHash &attributesHash,
+            const bool sync)
+    {
+        m_attributes = std::move(attributes);
+        m_attributesHash = attributesHash;
+
+        // The original attributes share the same data and positions
+        if (sync) {
+            m_original = m_attributes;
+            m_originalHash = attributesHash;
+        }
+
+        m_attributeMutatorsCache.clear();
+        m_modelAttributesCacheForMutators.reset();
+
+        return model();
+    }
+
     template<typename Derived, AllRelationsConcept ...AllRelations>
     Derived &HasAttributes<Derived, AllRelations...>::syncOriginal()
     {
         m_original = getAttributes();
-
-        rehashAttributePositions(m_original, m_originalHash);
+        // The same positions, shared until one of them is modified
+        m_originalHash = m_attributesHash;
 
         return model();
     }
@@ -715,11 +762,13 @@ namespace Orm::Tiny::Concerns
     HasAttributes<Derived, AllRelations...>::getAttributeFromArray(
             const QString &key) const
     {
+        const auto itPosition = m_attributesHash.find(key);
+
         // Not found
-        if (!m_attributesHash.contains(key))
+        if (itPosition == m_attributesHash.end())
             return {};
 
-        return m_attributes.at(m_attributesHash.at(key)).value;
+        return m_attributes.at(itPosition->second).value;
     }
 
     // NOTE api different, doesn't support key = {} silverqx
@@ -1191,14 +1240,16 @@ namespace Orm::Tiny::Concerns
     template<typename Derived, AllRelationsConcept ...AllRelations>
     bool HasAttributes<Derived, AllRelations...>::hasCast(const QString &key) const
     {
-        return getCasts().contains(key);
+        return findCastItem(key) != nullptr;
     }
 
     template<typename Derived, AllRelationsConcept ...AllRelations>
     bool HasAttributes<Derived, AllRelations...>::hasCast(
             const QString &key, const std::unordered_set<CastType> &types) const
     {
-        return hasCast(key) && types.contains(getCastType(key));
+        const auto *const castItem = findCastItem(key);
+
+        return castItem != nullptr && types.contains(castItem->type());
     }
 
     template<typename Derived, AllRelationsConcept ...AllRelations>
@@ -1350,6 +1401,104 @@ namespace Orm::Tiny::Concerns
         return attributes;
     }
 
+    template<typename Derived, AllRelationsConcept ...AllRelations>
+    void
+    HasAttributes<Derived, AllRelations...>::writeAttributesJson(
+            JsonWriter &writer) const
+    {
+        const auto &basemodel = this->basemodel();
+        const auto &visible   = basemodel.getUserVisible();
+        const auto &hidden    = basemodel.getUserHidden();
+        const auto &appends   = basemodel.getUserAppends();
+
+        /* The same logic as the attributesToVector() but every attribute is written
+           to the writer right away, without copying the attributes vector. */
+        for (const auto &[key, value] : getAttributes()) {
+            /* Skip hidden attributes and the keys that are in the u_appends,
+               they will be written later. */
+            if ((!visible.empty() && !visible.contains(key)) || hidden.contains(key) ||
+                appends.contains(key)
+            )
+                continue;
+
+            writer.writeKey(key);
+
+            const auto *const castItem = findCastItem(key);
+            const auto serializeDate = isInDates(key) && !isDateCastable(key) &&
+                                       !isCustomDateCastable(key);
+
+            // Nothing to convert, write the value as it is (the most common case)
+            if (castItem == nullptr && !serializeDate) {
+                writer.writeValue(value);
+                continue;
+            }
+
+            auto serializedValue = value;
+
+            // The same as the addDateAttributesToVector()
+            if (serializeDate)
+                serializedValue = serializedValue.isNull()
+                                  ? NullVariant::QDateTime()
+                                  : Model<Derived, AllRelations...>::
+                                    getUserSerializeDateTime(asDateTime(serializedValue));
+
+            // The same as the addCastAttributesToVector()
+            if (castItem != nullptr)
+                castAttributeForSerialization(serializedValue, key, *castItem);
+
+            writer.writeValue(serializedValue);
+        }
+
+        // Appended, calculated attributes
+        for (const auto &key : getSerializableAppends()) {
+            writer.writeKey(key);
+            writer.writeValue(mutateAccessorAttribute(key));
+        }
+    }
+
+    template<typename Derived, AllRelationsConcept ...AllRelations>
+    void
+    HasAttributes<Derived, AllRelations...>::writeAttributesCbor(
+            QCborStreamWriter &writer) const
+    {
+        const auto &attributes = getAttributes();
+
+        // The map preserves the attributes vector order
+        writer.startMap(static_cast<quint64>(attributes.size()));
+
+        for (const auto &[key, value] : attributes) {
+            writer.append(key);
+            CborUtils::writeValue(writer, value);
+        }
+
+        writer.endMap();
+    }
+
+    template<typename Derived, AllRelationsConcept ...AllRelations>
+    void
+    HasAttributes<Derived, AllRelations...>::readAttributesCbor(
+            QCborStreamReader &reader)
+    {
+        CborUtils::enterContainer(reader, QCborStreamReader::Map);
+
+        QVector<AttributeItem> attributes;
+        if (reader.isLengthKnown())
+            attributes.reserve(static_cast<AttributesSizeType>(reader.length()));
+
+        while (reader.hasNext()) {
+            auto key = CborUtils::readString(reader);
+#if QT_VERSION >= QT_VERSION_CHECK(6, 0, 0)
+            attributes.emplaceBack(std::move(key), CborUtils::readValue(reader));
+#else
+            attributes.append({std::move(key), CborUtils::readValue(reader)});
+#endif
+        }
+
+        CborUtils::leaveContainer(reader);
+
+        setRawAttributes(std::move(attributes), true);
+    }
+
     /* Serialization - Appends */
 
     template<typename Derived, AllRelationsConcept ...AllRelations>
@@ -1463,7 +1612,7 @@ namespace Orm::Tiny::Concerns
            we need to return the null QVariant(QString) for the SQLite database, so
            the logic here is, whatever the QtSql driver returns if the QVariant is null
            we will return too. */
-        if (!value.isNull() && getDates().contains(key))
+        if (!value.isNull() && isInDates(key))
             return asDateOrDateTime(value);
 
         return value;
@@ -1606,8 +1755,7 @@ namespace Orm::Tiny::Concerns
     template<typename Derived, AllRelationsConcept ...AllRelations>
     void HasAttributes<Derived, AllRelations...>::rehashAttributePositions(
             const QVector<AttributeItem> &attributes,
-            std::unordered_map<QString, AttributesSizeType> &attributesHash,
-            const int from)
+            AttributesHash &attributesHash, const int from)
     {
         /* This member function is universal and can be used for m_attributes,
            m_changes and m_original and it associated unordered_maps m_attributesHash,
@@ -1628,7 +1776,9 @@ namespace Orm::Tiny::Concerns
                 static_cast<std::unordered_map<QString, AttributesSizeType>::size_type>(
                         attributes.size()));
 
-        rehashAttributePositions(attributes, attributesHash, from);
+        for (auto i = from; i < attributes.size(); ++i)
+            // 'i' is the position index
+            attributesHash[attributes.at(i).key] = i;
 
         return attributesHash;
     }
@@ -1639,7 +1789,16 @@ namespace Orm::Tiny::Concerns
     bool
     HasAttributes<Derived, AllRelations...>::isDateAttribute(const QString &key) const
     {
-        return getDates().contains(key) || isDateCastable(key);
+        return isInDates(key) || isDateCastable(key);
+    }
+
+    template<typename Derived, AllRelationsConcept ...AllRelations>
+    bool HasAttributes<Derived, AllRelations...>::isInDates(const QString &key) const
+    {
+        // The same as the getDates().contains(key)
+        return Model<Derived, AllRelations...>::getUserDates().contains(key) ||
+               (basemodel().usesTimestamps() &&
+                Model<Derived, AllRelations...>::timestampColumnNames().contains(key));
     }
 
     template<typename Derived, AllRelationsConcept ...AllRelations>
@@ -1952,6 +2111,10 @@ namespace Orm::Tiny::Concerns
     CastItem
     HasAttributes<Derived, AllRelations...>::getCastItem(const QString &key) const
     {
+        if (const auto *const castItem = findCastItem(key); castItem != nullptr)
+            return *castItem;
+
+        // Throws the std::out_of_range exception
         return getCasts().at(key);
     }
 
@@ -1959,14 +2122,37 @@ namespace Orm::Tiny::Concerns
     CastType
     HasAttributes<Derived, AllRelations...>::getCastType(const QString &key) const
     {
-        return getCasts().at(key).type();
+        return getCastItem(key).type();
+    }
+
+    template<typename Derived, AllRelationsConcept ...AllRelations>
+    const CastItem *
+    HasAttributes<Derived, AllRelations...>::findCastItem(const QString &key) const
+    {
+        const auto &basemodel = this->basemodel();
+        const auto &userCasts = basemodel.getUserCasts();
+
+        if (const auto itCast = userCasts.find(key); itCast != userCasts.cend())
+            return &itCast->second;
+
+        // The same as the getCasts(), the primary key cast is added on the fly
+        if (basemodel.getIncrementing() && key == basemodel.getKeyName()) {
+            // FEATURE dilemma primarykey, Model::KeyType vs QVariant silverqx
+            static const CastItem keyCast(CastType::ULongLong);
+
+            return &keyCast;
+        }
+
+        return nullptr;
     }
 
     template<typename Derived, AllRelationsConcept ...AllRelations>
     bool
     HasAttributes<Derived, AllRelations...>::isDateCastable(const QString &key) const
     {
-        return hasCast(key, {CastType::QDate, CastType::QDateTime});
+        const auto *const castItem = findCastItem(key);
+
+        return castItem != nullptr && isDateCastType(castItem->type());
     }
 
     template<typename Derived, AllRelationsConcept ...AllRelations>
@@ -1974,7 +2160,12 @@ namespace Orm::Tiny::Concerns
     HasAttributes<Derived, AllRelations...>::isCustomDateCastable(
             const QString &key) const
     {
-        return hasCast(key, {CastType::CustomQDate, CastType::CustomQDateTime});
+        const auto *const castItem = findCastItem(key);
+
+        // The same as the hasCast(key, {CastType::CustomQDate, CastType::CustomQDateTime})
+        return castItem != nullptr &&
+               (castItem->type() == CastType::CustomQDate ||
+                castItem->type() == CastType::CustomQDateTime);
     }
 
     template<typename Derived, AllRelationsConcept ...AllRelations>
@@ -7,6 +7,7 @@ TINY_SYSTEM_HEADER
 
 #include <range/v3/algorithm/contains.hpp>
 
+#include "orm/concerns/detectsnplusonequeries.hpp"
 #include "orm/exceptions/invalidtemplateargumenterror.hpp"
 #include "orm/tiny/concerns/hasrelationstore.hpp"
 #include "orm/tiny/exceptions/relationmappingnotfounderror.hpp"
@@ -16,6 +17,8 @@ TINY_SYSTEM_HEADER
 #include "orm/tiny/relations/belongstomany.hpp"
 #include "orm/tiny/relations/hasmany.hpp"
 #include "orm/tiny/relations/hasone.hpp"
+#include "orm/types/jsonwriter.hpp"
+#include "orm/utils/cbor.hpp"
 #include "orm/utils/string.hpp"
 
 TINYORM_BEGIN_COMMON_NAMESPACE
@@ -49,11 +52,15 @@ namespace Concerns
         template<SerializedAttributes C, typename Derived_,
                  AllRelationsConcept ...AllRelations_>
         friend class Support::Stores::SerializeRelationStore;
+        // To access private readRelationCborVisited()
+        friend Support::Stores::FromCborRelationStore<Derived, AllRelations...>;
         // To access eagerLoadRelationWithVisitor()
         friend TinyBuilder<Derived>;
 
         /*! Alias for the attribute utils. */
         using AttributeUtils = Orm::Tiny::Utils::Attribute;
+        /*! Alias for the CBOR utils. */
+        using CborUtils = Orm::Utils::Cbor;
         /*! Alias for the string utils. */
         using StringUtils = Orm::Utils::String;
         /*! Alias for the type utils. */
@@ -178,6 +185,17 @@ namespace Concerns
         /*! Convert the model's relationships to the map or vector. */
         template<SerializedAttributes C, typename PivotType = void>
         C serializeRelations() const;
+        /*! Write the model's relationships straight to the JSON writer (streaming). */
+        template<typename PivotType = void>
+        void writeRelationsJson(JsonWriter &writer) const;
+        /*! Write all the model's loaded relationships to the CBOR writer (raw, without
+            the visible/hidden and snake case keys). */
+        template<typename PivotType = void>
+        void writeRelationsCbor(QCborStreamWriter &writer) const;
+        /*! Hydrate the model's relationships from the CBOR (written by
+            the writeRelationsCbor()). */
+        template<typename PivotType = void>
+        void readRelationsCbor(QCborStreamReader &reader);
 
         /* Others */
         /*! Equality comparison operator for the HasRelationships concern. */
@@ -257,6 +275,17 @@ namespace Concerns
                     const QHash<QString, RelationVisitor> &left,
                     const QHash<QString, RelationVisitor> &right);
 
+        /*! Models hydrated together (shared by the sibling models), the lazy loading
+            of a relation on any of them eager loads this relation for all of them. */
+        struct LazyLoadingSiblings
+        {
+            /*! Hydrated attributes of the sibling models by the primary key (implicitly
+                shared with the models until they are modified). */
+            QHash<QString, QVector<AttributeItem>> attributes;
+            /*! Eager loaded relations by the relation name and primary key. */
+            QHash<QString, QHash<QString, RelationsType<AllRelations...>>> relations;
+        };
+
         /* Data members */
         /*! Map of relation names to methods. */
         QHash<QString, RelationVisitor> u_relations;
@@ -270,6 +299,8 @@ namespace Concerns
         // CUR1 use sets instead of QStringList where appropriate silverqx
         /*! Currently loaded Pivot relation names. */
         std::unordered_set<QString> m_pivots;
+        /*! Models hydrated together with this model (u_batchLazyLoading only). */
+        std::shared_ptr<LazyLoadingSiblings> m_lazyLoadingSiblings = nullptr;
 
     private:
         /*! Alias for the enum struct RelationMappingNotFoundError::From. */
@@ -294,6 +325,10 @@ namespace Concerns
         /*! Create lazy store and obtain a relationship from defined method. */
         template<typename Related, typename Result>
         Result getRelationshipFromMethodWithVisitor(const QString &relation) const;
+        /*! Eager load the relation for all the sibling models and obtain the result
+            for this model (std::nullopt if it isn't possible). */
+        std::optional<RelationsType<AllRelations...>>
+        getRelationFromSiblings(const QString &relation);
 
         /*! Throw exception if correct getRelation/Value() method was not used, to avoid
             std::bad_variant_access. */
@@ -352,6 +387,12 @@ namespace Concerns
                         Concerns::QueriesRelationshipsCallback<Related> &)> &callback,
                 std::optional<std::reference_wrapper<
                         QStringList>> relations = std::nullopt) const;
+        /*! Create 'QueriesRelationships relation store' to obtain relation instance
+            for the withAggregate(). */
+        void queriesRelationshipsWithVisitor(
+                const Concerns::RelationAggregate &aggregate,
+                Concerns::QueriesRelationships<Derived> &origin,
+                const std::function<void(QueryBuilder &)> &callback) const;
 
         /* Operations on a Model instance */
         /*! Obtain all loaded relation names except pivot relations. */
@@ -384,6 +425,25 @@ namespace Concerns
         inline static void serializeRelation(QVariant &relationSerialized, // don't remove inline
                                              const std::optional<Related> &model);
 
+        /*! Write the relation to the JSON writer (the JsonWriter counterpart
+            of the serializeRelationVisited()). */
+        template<typename Related, typename PivotType>
+        void writeRelationJsonVisited(
+                QString relation, const RelationsType<AllRelations...> &models,
+                JsonWriter &writer) const;
+
+        /*! Write the relation to the CBOR writer. */
+        template<typename Related, typename PivotType>
+        void writeRelationCborVisited(const RelationsType<AllRelations...> &models,
+                                      QCborStreamWriter &writer) const;
+        /*! Create and visit the from CBOR relation store. */
+        void readRelationCborWithVisitor(const QString &relation,
+                                         QCborStreamReader &reader);
+        /*! Hydrate the relation from the CBOR reader. */
+        template<typename Related, typename PivotType>
+        void readRelationCborVisited(const QString &relation,
+                                     QCborStreamReader &reader);
+
         /*! Insert the serialized relation attributes to the final attributes map. */
         inline static void
         insertSerializedRelation(QVariantMap &attributes, const QString &relation,
@@ -844,6 +904,101 @@ namespace Concerns
         return attributes;
     }
 
+    template<typename Derived, AllRelationsConcept ...AllRelations>
+    template<typename PivotType>
+    void
+    HasRelationships<Derived, AllRelations...>::writeRelationsJson(
+            JsonWriter &writer) const
+    {
+        const auto &basemodel = this->basemodel();
+        const auto &visible   = basemodel.getUserVisible();
+        const auto &hidden    = basemodel.getUserHidden();
+
+        /* The same logic as the getSerializableRelations() but without copying
+           the relations container. */
+        for (const auto &[relation, models] : getRelations()) {
+            Q_ASSERT(!models.valueless_by_exception());
+
+            if ((!visible.empty() && !visible.contains(relation)) ||
+                hidden.contains(relation)
+            )
+                continue;
+
+            // Serialize belongs-to-many relation or the pivot model
+            if constexpr (hasPivotRelation() && !std::is_void_v<PivotType>) {
+                // Pivot model, skipping the relation store, call the visited directly
+                if (m_pivots.contains(relation))
+                    writeRelationJsonVisited<PivotType, void>(relation, models, writer);
+                // belongs-to-many relation
+                else
+                    serializeRelationWithVisitor(relation, models, writer);
+            }
+            // Serialize has-one, has-many, and belongs-to relations
+            else
+                serializeRelationWithVisitor(relation, models, writer);
+        }
+    }
+
+    template<typename Derived, AllRelationsConcept ...AllRelations>
+    template<typename PivotType>
+    void
+    HasRelationships<Derived, AllRelations...>::writeRelationsCbor(
+            QCborStreamWriter &writer) const
+    {
+        const auto &relations = getRelations();
+
+        writer.startMap(static_cast<quint64>(relations.size()));
+
+        for (const auto &[relation, models] : relations) {
+            Q_ASSERT(!models.valueless_by_exception());
+
+            writer.append(relation);
+
+            // The same logic as the serializeRelations()
+            if constexpr (hasPivotRelation() && !std::is_void_v<PivotType>) {
+                // Pivot model, skipping the relation store, call the visited directly
+                if (m_pivots.contains(relation))
+                    writeRelationCborVisited<PivotType, void>(models, writer);
+                // belongs-to-many relation
+                else
+                    serializeRelationWithVisitor(relation, models, writer);
+            }
+            // Serialize has-one, has-many, and belongs-to relations
+            else
+                serializeRelationWithVisitor(relation, models, writer);
+        }
+
+        writer.endMap();
+    }
+
+    template<typename Derived, AllRelationsConcept ...AllRelations>
+    template<typename PivotType>
+    void
+    HasRelationships<Derived, AllRelations...>::readRelationsCbor(
+            QCborStreamReader &reader)
+    {
+        CborUtils::enterContainer(reader, QCborStreamReader::Map);
+
+        while (reader.hasNext()) {
+            const auto relation = CborUtils::readString(reader);
+
+            /* Pivot model, it isn't defined in the u_relations, it's the only relation
+               that can be missing there. */
+            if constexpr (hasPivotRelation() && !std::is_void_v<PivotType>)
+                if (!basemodel().getUserRelations().contains(relation)) {
+                    readRelationCborVisited<PivotType, void>(relation, reader);
+                    continue;
+                }
+
+            // Throw if the relation is not defined
+            validateUserRelation(relation);
+
+            readRelationCborWithVisitor(relation, reader);
+        }
+
+        CborUtils::leaveContainer(reader);
+    }
+
     /* Others */
 
     template<typename Derived, AllRelationsConcept ...AllRelations>
@@ -878,6 +1033,19 @@ namespace Concerns
     HasRelationships<Derived, AllRelations...>::getRelationshipFromMethod(
             const QString &relation)
     {
+        // Eager loaded for all the models hydrated together
+        if (m_lazyLoadingSiblings)
+            if (auto relatedModels = getRelationFromSiblings(relation);
+                relatedModels
+            ) {
+                checkRelationType<ModelsCollection<Related>, Related>(
+                            *relatedModels, relation, QStringLiteral("getRelationValue"));
+
+                m_relations[relation] = std::move(*relatedModels);
+
+                return getRelationFromHash<Related, Container>(relation);
+            }
+
         // Obtain related models
         auto relatedModels =
                 getRelationshipFromMethodWithVisitor<Related,
@@ -894,6 +1062,19 @@ namespace Concerns
     HasRelationships<Derived, AllRelations...>::getRelationshipFromMethod(
             const QString &relation)
     {
+        // Eager loaded for all the models hydrated together
+        if (m_lazyLoadingSiblings)
+            if (auto relatedModel = getRelationFromSiblings(relation);
+                relatedModel
+            ) {
+                checkRelationType<std::optional<Related>, Related>(
+                            *relatedModel, relation, QStringLiteral("getRelationValue"));
+
+                m_relations[relation] = std::move(*relatedModel);
+
+                return getRelationFromHash<Related, Tag>(relation);
+            }
+
         // Obtain related model
         auto relatedModel =
                 getRelationshipFromMethodWithVisitor<Related,
@@ -1147,6 +1328,10 @@ namespace Concerns
         // Throw exception if a relation is not defined
         validateUserRelation(relation);
 
+        // Queries executed below are reported by the N+1 queries detector
+        const Orm::Concerns::LazyRelationLoading lazyRelationLoading(typeid (Derived),
+                                                                     relation);
+
         // Save model/s to the store to avoid passing variables to the visitor
         this->template createLazyStore<Related>().visit(relation);
 
@@ -1163,6 +1348,73 @@ namespace Concerns
         return std::get<Result>(lazyResult);
     }
 
+    template<typename Derived, AllRelationsConcept ...AllRelations>
+    std::optional<RelationsType<AllRelations...>>
+    HasRelationships<Derived, AllRelations...>::getRelationFromSiblings(
+            const QString &relation)
+    {
+        const auto key = model().getKey();
+
+        // Nothing to do, siblings are matched by the primary key
+        if (!key.isValid() || key.isNull())
+            return std::nullopt;
+
+        auto &siblings = *m_lazyLoadingSiblings;
+
+        /* The model wasn't hydrated together with the siblings (eg. the key changed)
+           or it was modified since (eg. the foreign key changed), the relation must be
+           loaded using its current attributes. */
+        if (const auto itAttributes = siblings.attributes.constFind(key.toString());
+            itAttributes == siblings.attributes.cend() ||
+            *itAttributes != model().getRawAttributes()
+        )
+            return std::nullopt;
+
+        auto itRelation = siblings.relations.find(relation);
+
+        /* The first lazy loading of the relation eager loads it for all the sibling
+           models using one query, results are moved to the siblings one by one. */
+        if (itRelation == siblings.relations.end()) {
+            // Throw exception if a relation is not defined
+            validateUserRelation(relation);
+
+            // Models are created from the hydrated attributes only for this eager load
+            ModelsCollection<Derived> models;
+            models.reserve(siblings.attributes.size());
+
+            const auto &connection = model().getConnectionName();
+
+            for (const auto &attributes : std::as_const(siblings.attributes))
+                models << model().newFromBuilder(attributes, connection);
+
+            models.load(relation);
+
+            QHash<QString, RelationsType<AllRelations...>> results;
+            results.reserve(models.size());
+
+            for (auto &sibling : models)
+                if (auto itResult = sibling.m_relations.find(relation);
+                    itResult != sibling.m_relations.end()
+                )
+                    results.insert(sibling.getKey().toString(),
+                                   std::move(itResult->second));
+
+            itRelation = siblings.relations.insert(relation, std::move(results));
+        }
+
+        const auto itResult = itRelation->find(key.toString());
+
+        // Already moved to this model before (eg. the relation was unset since)
+        if (itResult == itRelation->end())
+            return std::nullopt;
+
+        auto result = std::move(*itResult);
+
+        itRelation->erase(itResult);
+
+        return result;
+    }
+
     template<typename Derived, AllRelationsConcept ...AllRelations>
     template<typename Result, typename Related, typename T>
     void HasRelationships<Derived, AllRelations...>::checkRelationType(
@@ -1396,6 +1648,23 @@ namespace Concerns
         this->resetRelationStore();
     }
 
+    template<typename Derived, AllRelationsConcept ...AllRelations>
+    void HasRelationships<Derived, AllRelations...>::queriesRelationshipsWithVisitor(
+            const Concerns::RelationAggregate &aggregate,
+            Concerns::QueriesRelationships<Derived> &origin,
+            const std::function<void(QueryBuilder &)> &callback) const
+    {
+        // Throw exception if a relation is not defined
+        validateUserRelation(aggregate.relation);
+
+        // Save the aggregate to the store to avoid passing variables to the visitor
+        this->createQueriesRelationshipsStore(origin, aggregate, callback)
+                .visit(aggregate.relation);
+
+        // Releases the ownership and destroy the top relation store on the stack
+        this->resetRelationStore();
+    }
+
     /* Operations on a Model instance */
 
     template<typename Derived, AllRelationsConcept ...AllRelations>
@@ -1542,6 +1811,94 @@ namespace Concerns
             relationSerialized.setValue(nullptr);
     }
 
+    template<typename Derived, AllRelationsConcept ...AllRelations>
+    template<typename Related, typename PivotType>
+    void HasRelationships<Derived, AllRelations...>::writeRelationJsonVisited(
+            QString relation, const RelationsType<AllRelations...> &models,
+            JsonWriter &writer) const
+    {
+        // The same snake-casing as the serializeRelationVisited()
+        if (basemodel().getUserSnakeAttributes())
+            relation = StringUtils::snake(std::move(relation));
+
+        writer.writeKey(relation);
+
+        // Many type relationship
+        if (std::holds_alternative<ModelsCollection<Related>>(models))
+            std::get<ModelsCollection<Related>>(models)
+                    .template writeJson<PivotType>(writer);
+
+        // One type relationship
+        else if (std::holds_alternative<std::optional<Related>>(models)) {
+            // No need to pass the PivotType down for the one type relation
+            if (const auto &model = std::get<std::optional<Related>>(models); model)
+                model->writeJson(writer);
+            // A NULL foreign key
+            else
+                writer.writeNull();
+        }
+
+        else
+            Q_UNREACHABLE();
+    }
+
+    template<typename Derived, AllRelationsConcept ...AllRelations>
+    template<typename Related, typename PivotType>
+    void HasRelationships<Derived, AllRelations...>::writeRelationCborVisited(
+            const RelationsType<AllRelations...> &models,
+            QCborStreamWriter &writer) const
+    {
+        // Many type relationship
+        if (std::holds_alternative<ModelsCollection<Related>>(models))
+            std::get<ModelsCollection<Related>>(models)
+                    .template writeCbor<PivotType>(writer);
+
+        // One type relationship
+        else if (std::holds_alternative<std::optional<Related>>(models)) {
+            // No need to pass the PivotType down for the one type relation
+            if (const auto &model = std::get<std::optional<Related>>(models); model)
+                model->writeCbor(writer);
+            // A NULL foreign key
+            else
+                writer.append(nullptr);
+        }
+
+        else
+            Q_UNREACHABLE();
+    }
+
+    template<typename Derived, AllRelationsConcept ...AllRelations>
+    void HasRelationships<Derived, AllRelations...>::readRelationCborWithVisitor(
+            const QString &relation, QCborStreamReader &reader)
+    {
+        // Save the reader to the store to avoid passing variables to the visitor
+        this->createFromCborRelationStore(relation, reader).visit(relation);
+
+        // Releases the ownership and destroy the top relation store on the stack
+        this->resetRelationStore();
+    }
+
+    template<typename Derived, AllRelationsConcept ...AllRelations>
+    template<typename Related, typename PivotType>
+    void HasRelationships<Derived, AllRelations...>::readRelationCborVisited(
+            const QString &relation, QCborStreamReader &reader)
+    {
+        // Many type relationship
+        if (reader.isArray())
+            setRelation(relation, ModelsCollection<Related>::template fromCbor<PivotType>(
+                                      reader));
+
+        // One type relationship with a NULL foreign key
+        else if (reader.isNull()) {
+            reader.next();
+            setRelation(relation, std::optional<Related>());
+        }
+
+        // One type relationship
+        else
+            setRelation(relation, std::optional<Related>(Related::fromCbor(reader)));
+    }
+
     template<typename Derived, AllRelationsConcept ...AllRelations>
     void HasRelationships<Derived, AllRelations...>::insertSerializedRelation(
             QVariantMap &attributes, const QString &relation,
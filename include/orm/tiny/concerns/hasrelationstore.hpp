@@ -10,6 +10,7 @@ TINY_SYSTEM_HEADER
 #include "orm/tiny/macros/crtpmodelwithbase.hpp"
 #include "orm/tiny/support/stores/belongstomanyrelatedtablestore.hpp"
 #include "orm/tiny/support/stores/eagerrelationstore.hpp"
+#include "orm/tiny/support/stores/fromcborrelationstore.hpp"
 #include "orm/tiny/support/stores/lazyrelationstore.hpp"
 #include "orm/tiny/support/stores/pushrelationstore.hpp"
 #include "orm/tiny/support/stores/queriesrelationshipsstore.hpp"
@@ -87,12 +88,24 @@ namespace Orm::Tiny::Concerns
                         void(QueriesRelationshipsCallback<Related> &)> &callback,
                 std::optional<std::reference_wrapper<
                         QStringList>> relations = std::nullopt) const;
+        /*! Factory method to create the QueriesRelationships store for
+            the withAggregate(). */
+        BaseRelationStore &
+        createQueriesRelationshipsStore(
+                QueriesRelationships<Derived> &origin,
+                const RelationAggregate &aggregate,
+                const std::function<void(QueryBuilder &)> &callback) const;
         /*! Factory method to create the store for serializing relationship. */
         template<SerializedAttributes C>
         BaseRelationStore &
         createSerializeRelationStore(
                 const QString &relation, const RelationsType<AllRelations...> &models,
                 C &attributes) const;
+        /*! Factory method to create the store for hydrating relationship from
+            the CBOR. */
+        BaseRelationStore &
+        createFromCborRelationStore(const QString &relation,
+                                    QCborStreamReader &reader) const;
 
         /*! Release the ownership and destroy the top relation store on the stack. */
         void resetRelationStore() const;
@@ -299,6 +312,19 @@ namespace Orm::Tiny::Concerns
         return *m_relationStore.top();
     }
 
+    template<typename Derived, AllRelationsConcept ...AllRelations>
+    typename HasRelationStore<Derived, AllRelations...>::BaseRelationStore &
+    HasRelationStore<Derived, AllRelations...>::createQueriesRelationshipsStore(
+            QueriesRelationships<Derived> &origin, const RelationAggregate &aggregate,
+            const std::function<void(QueryBuilder &)> &callback) const
+    {
+        m_relationStore.push(std::make_shared<QueriesRelationshipsStore<void>>(
+                                 const_cast<HasRelationStore *>(this), origin,
+                                 aggregate, callback));
+
+        return *m_relationStore.top();
+    }
+
     template<typename Derived, AllRelationsConcept ...AllRelations>
     template<SerializedAttributes C>
     typename HasRelationStore<Derived, AllRelations...>::BaseRelationStore &
@@ -313,6 +339,18 @@ namespace Orm::Tiny::Concerns
         return *m_relationStore.top();
     }
 
+    template<typename Derived, AllRelationsConcept ...AllRelations>
+    typename HasRelationStore<Derived, AllRelations...>::BaseRelationStore &
+    HasRelationStore<Derived, AllRelations...>::createFromCborRelationStore(
+            const QString &relation, QCborStreamReader &reader) const
+    {
+        m_relationStore.push(std::make_shared<FromCborRelationStore>(
+                                 const_cast<HasRelationStore *>(this), relation,
+                                 reader));
+
+        return *m_relationStore.top();
+    }
+
     template<typename Derived, AllRelationsConcept ...AllRelations>
     void HasRelationStore<Derived, AllRelations...>::resetRelationStore() const
     {
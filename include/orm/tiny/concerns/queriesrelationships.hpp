@@ -10,6 +10,7 @@ TINY_SYSTEM_HEADER
 #include "orm/exceptions/invalidtemplateargumenterror.hpp"
 #include "orm/query/querybuilder.hpp"
 #include "orm/tiny/relations/relation.hpp"
+#include "orm/utils/string.hpp"
 
 TINYORM_BEGIN_COMMON_NAMESPACE
 
@@ -216,6 +217,51 @@ namespace Private
                  const std::function<void(TinyBuilder<Related> &)> &callback = nullptr,
                  const QString &comparison = GE, qint64 count = 1);
 
+        /* Relationship aggregates */
+        /*! Add a subselect query to include an aggregate value for a relationship
+            (the relation can be aliased using the "relation as alias" syntax). */
+        TinyBuilder<Model> &
+        withAggregate(const QString &relation, const QString &column,
+                      const QString &function,
+                      const std::function<void(QueryBuilder &)> &callback = nullptr);
+        /*! Add subselect queries to include an aggregate value for relationships. */
+        TinyBuilder<Model> &
+        withAggregate(const QVector<QString> &relations, const QString &column,
+                      const QString &function);
+
+        /*! Add a subselect query to count the related models. */
+        inline TinyBuilder<Model> &
+        withCount(const QString &relation,
+                  const std::function<void(QueryBuilder &)> &callback = nullptr);
+        /*! Add subselect queries to count the related models. */
+        inline TinyBuilder<Model> &
+        withCount(const QVector<QString> &relations);
+
+        /*! Add a subselect query to include the max of the relation's column. */
+        inline TinyBuilder<Model> &
+        withMax(const QString &relation, const QString &column,
+                const std::function<void(QueryBuilder &)> &callback = nullptr);
+        /*! Add a subselect query to include the min of the relation's column. */
+        inline TinyBuilder<Model> &
+        withMin(const QString &relation, const QString &column,
+                const std::function<void(QueryBuilder &)> &callback = nullptr);
+        /*! Add a subselect query to include the sum of the relation's column. */
+        inline TinyBuilder<Model> &
+        withSum(const QString &relation, const QString &column,
+                const std::function<void(QueryBuilder &)> &callback = nullptr);
+        /*! Add a subselect query to include the average of the relation's column. */
+        inline TinyBuilder<Model> &
+        withAvg(const QString &relation, const QString &column,
+                const std::function<void(QueryBuilder &)> &callback = nullptr);
+
+        /*! Add a subselect query to include the existence of related models. */
+        inline TinyBuilder<Model> &
+        withExists(const QString &relation,
+                   const std::function<void(QueryBuilder &)> &callback = nullptr);
+        /*! Add subselect queries to include the existence of related models. */
+        inline TinyBuilder<Model> &
+        withExists(const QVector<QString> &relations);
+
     protected:
         /*! Sets up recursive call to whereHas until we finish the nested relation. */
         template<typename Related>
@@ -290,6 +336,19 @@ namespace Private
         /*! Check if Related template argument passed to the has() method is correct. */
         template<typename Related>
         void checkNestedRelationType() const;
+
+        /* Relationship aggregates */
+        /*! Called from model store after a relation was visited and Related type was
+            obtained and adds the aggregate subselect to the query. */
+        template<typename Related>
+        void withAggregateVisited(
+                std::unique_ptr<Relation<Related>> &&relation,
+                const RelationAggregate &aggregate,
+                const std::function<void(QueryBuilder &)> &callback);
+        /*! Parse the relation name, alias, and create the relationship aggregate. */
+        static RelationAggregate
+        createRelationAggregate(const QString &relation, const QString &column,
+                                const QString &function);
     };
 
     /*
@@ -724,6 +783,185 @@ namespace Private
                      TypeUtils::classPureBasename<Related>()));
     }
 
+    /* Relationship aggregates */
+
+    template<typename Model>
+    TinyBuilder<Model> &
+    QueriesRelationships<Model>::withAggregate(
+            const QString &relation, const QString &column, const QString &function,
+            const std::function<void(QueryBuilder &)> &callback)
+    {
+        const auto aggregate = createRelationAggregate(relation, column, function);
+
+        query().getModel().queriesRelationshipsWithVisitor(aggregate, *this, callback);
+
+        return query();
+    }
+
+    template<typename Model>
+    TinyBuilder<Model> &
+    QueriesRelationships<Model>::withAggregate(
+            const QVector<QString> &relations, const QString &column,
+            const QString &function)
+    {
+        for (const auto &relation : relations)
+            withAggregate(relation, column, function);
+
+        return query();
+    }
+
+    template<typename Model>
+    TinyBuilder<Model> &
+    QueriesRelationships<Model>::withCount(
+            const QString &relation, const std::function<void(QueryBuilder &)> &callback)
+    {
+        return withAggregate(relation, ASTERISK, QStringLiteral("count"), callback);
+    }
+
+    template<typename Model>
+    TinyBuilder<Model> &
+    QueriesRelationships<Model>::withCount(const QVector<QString> &relations)
+    {
+        return withAggregate(relations, ASTERISK, QStringLiteral("count"));
+    }
+
+    template<typename Model>
+    TinyBuilder<Model> &
+    QueriesRelationships<Model>::withMax(
+            const QString &relation, const QString &column,
+            const std::function<void(QueryBuilder &)> &callback)
+    {
+        return withAggregate(relation, column, QStringLiteral("max"), callback);
+    }
+
+    template<typename Model>
+    TinyBuilder<Model> &
+    QueriesRelationships<Model>::withMin(
+            const QString &relation, const QString &column,
+            const std::function<void(QueryBuilder &)> &callback)
+    {
+        return withAggregate(relation, column, QStringLiteral("min"), callback);
+    }
+
+    template<typename Model>
+    TinyBuilder<Model> &
+    QueriesRelationships<Model>::withSum(
+            const QString &relation, const QString &column,
+            const std::function<void(QueryBuilder &)> &callback)
+    {
+        return withAggregate(relation, column, QStringLiteral("sum"), callback);
+    }
+
+    template<typename Model>
+    TinyBuilder<Model> &
+    QueriesRelationships<Model>::withAvg(
+            const QString &relation, const QString &column,
+            const std::function<void(QueryBuilder &)> &callback)
+    {
+        return withAggregate(relation, column, QStringLiteral("avg"), callback);
+    }
+
+    template<typename Model>
+    TinyBuilder<Model> &
+    QueriesRelationships<Model>::withExists(
+            const QString &relation, const std::function<void(QueryBuilder &)> &callback)
+    {
+        return withAggregate(relation, ASTERISK, QStringLiteral("exists"), callback);
+    }
+
+    template<typename Model>
+    TinyBuilder<Model> &
+    QueriesRelationships<Model>::withExists(const QVector<QString> &relations)
+    {
+        return withAggregate(relations, ASTERISK, QStringLiteral("exists"));
+    }
+
+    template<typename Model>
+    template<typename Related>
+    void QueriesRelationships<Model>::withAggregateVisited(
+            std::unique_ptr<Relation<Related>> &&relation,
+            const RelationAggregate &aggregate,
+            const std::function<void(QueryBuilder &)> &callback)
+    {
+        auto &baseQuery = query().getQuery();
+        const auto &grammar = baseQuery.getGrammar();
+
+        /* The aggregate is added as a next column, so all the model's columns have to be
+           selected explicitly if no columns were selected yet. */
+        if (baseQuery.getColumns().isEmpty())
+            baseQuery.select(query().getModel().qualifyColumn(ASTERISK));
+
+        const auto isExists = aggregate.function == QStringLiteral("exists");
+
+        const auto wrappedColumn =
+                aggregate.column == ASTERISK
+                ? ASTERISK
+                : grammar.wrap(relation->getRelated().qualifyColumn(aggregate.column));
+
+        const auto expression = isExists
+                                ? wrappedColumn
+                                : QStringLiteral("%1(%2)").arg(aggregate.function,
+                                                               wrappedColumn);
+
+        // Ownership of a unique_ptr()
+        auto aggregateQuery = std::invoke(
+                                  &Relation<Related>::getRelationExistenceQuery,
+                                  *relation,
+                                  relation->getRelated().newQueryWithoutRelationships(),
+                                  query(), QVector<Column> {Expression(expression)});
+
+        aggregateQuery->getQuery().setBindings({}, BindingType::SELECT);
+
+        // Add relation constraints defined in the user callback
+        if (callback)
+            std::invoke(callback, aggregateQuery->getQuery());
+
+        aggregateQuery->mergeConstraintsFrom(relation->getQuery());
+
+        // The same as toBase()
+        aggregateQuery->applySoftDeletes();
+
+        auto &subQuery = aggregateQuery->getQuery();
+
+        // Ordering has no effect on the aggregate
+        subQuery.reorder();
+
+        if (isExists) {
+            baseQuery.selectRaw(QStringLiteral("exists(%1) as %2")
+                                .arg(subQuery.toSql(), grammar.wrap(aggregate.alias)),
+                                subQuery.getBindings());
+
+            // The exists() returns an integer on some databases
+            query().withCast({aggregate.alias, CastType::Bool});
+        }
+        else
+            baseQuery.selectSub(subQuery, aggregate.alias);
+    }
+
+    template<typename Model>
+    RelationAggregate
+    QueriesRelationships<Model>::createRelationAggregate(
+            const QString &relation, const QString &column, const QString &function)
+    {
+        static const auto as = QStringLiteral(" as ");
+
+        const auto segments = relation.split(as, Qt::KeepEmptyParts, Qt::CaseInsensitive);
+        auto name = segments.constFirst().trimmed();
+
+        // Alias passed using the "relation as alias" syntax
+        if (segments.size() == 2)
+            return {std::move(name), column, function, segments.constLast().trimmed()};
+
+        // Eg. torrent_files_count or torrent_files_sum_size
+        auto alias = column == ASTERISK
+                     ? QStringLiteral("%1_%2").arg(name, function)
+                     : QStringLiteral("%1_%2_%3").arg(name, function, column);
+
+        alias = Orm::Utils::String::snake(std::move(alias)).replace(DOT, UNDERSCORE);
+
+        return {std::move(name), column, function, std::move(alias)};
+    }
+
 } // namespace Concerns
 } // namespace Orm::Tiny
 
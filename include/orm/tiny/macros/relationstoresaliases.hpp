@@ -36,6 +36,10 @@ TINY_SYSTEM_HEADER
           Support::Stores::                                                             \
                    EagerRelationStore<Derived, CollectionModel, AllRelations...>;       \
                                                                                         \
+    /*! Alias for the FromCborRelationStore (for shorter name). */                      \
+    using FromCborRelationStore =                                                       \
+          Support::Stores::FromCborRelationStore<Derived, AllRelations...>;             \
+                                                                                        \
     /*! Alias for the LazyRelationStore (for shorter name). */                          \
     template<typename Related>                                                          \
     using LazyRelationStore =                                                           \
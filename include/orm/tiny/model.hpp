@@ -194,6 +194,10 @@ namespace Orm::Tiny
         /*! Destroy the model by the given ID. */
         inline static std::size_t destroy(const QVariant &id);
 
+        /*! Save the given models to the database, new models are inserted using
+            multi-rows inserts. */
+        static bool saveMany(ModelsCollection<Derived> &models, SaveOptions options = {});
+
         /* Operations on a Model instance */
         /*! Save the model to the database. */
         bool save(SaveOptions options = {});
@@ -287,6 +291,12 @@ namespace Orm::Tiny
         Derived
         newFromBuilder(QVector<AttributeItem> &&attributes = {},
                        const std::optional<QString> &connection = std::nullopt) const;
+        /*! Create a new model instance that is existing (attributes without duplicit
+            keys and with the shared positions hash). */
+        Derived
+        newFromBuilder(QVector<AttributeItem> &&attributes,
+                       const AttributesHash &attributesHash,
+                       const QString &connection) const;
         /*! Create a new instance of the given model. */
         inline Derived newInstance() const;
         /*! Create a new instance of the given model. */
@@ -326,6 +336,28 @@ namespace Orm::Tiny
         inline QByteArray
         toJson(QJsonDocument::JsonFormat format = QJsonDocument::Compact) const;
 
+        /*! Write the model instance as compact JSON to the writer (streaming). */
+        template<typename PivotType = void> // PivotType is primarily internal
+        void writeJson(JsonWriter &writer) const;
+        /*! Write the model instance as compact JSON to the device (streaming). */
+        inline void writeJson(QIODevice &device) const;
+        /*! Append the model instance as compact JSON to the buffer (streaming). */
+        inline void writeJson(QByteArray &buffer) const;
+
+        /*! Write the model instance to the CBOR writer (raw attributes with native
+            types and all loaded relations, for caching and IPC). */
+        template<typename PivotType = void> // PivotType is primarily internal
+        void writeCbor(QCborStreamWriter &writer) const;
+        /*! Convert the model instance to CBOR (raw attributes and loaded relations). */
+        inline QByteArray toCbor() const;
+
+        /*! Hydrate a new model instance from the CBOR reader (written by
+            the writeCbor()). */
+        template<typename PivotType = void> // PivotType is primarily internal
+        static Derived fromCbor(QCborStreamReader &reader);
+        /*! Hydrate a new model instance from the CBOR (created by the toCbor()). */
+        inline static Derived fromCbor(const QByteArray &cbor);
+
         /* Getters / Setters */
         /*! Get the current connection name for the model. */
         const QString &getConnectionName() const;
@@ -359,6 +391,10 @@ namespace Orm::Tiny
         QString qualifyColumn(const QString &column) const;
         /*! Determina whether the Derived Model extends the SoftDeletes. */
         constexpr static bool extendsSoftDeletes();
+        /*! Determine whether the Derived Model uses the entity cache. */
+        inline static bool usesEntityCache() noexcept;
+        /*! Determine whether the Derived Model uses the batched lazy loading. */
+        inline static bool usesBatchedLazyLoading() noexcept;
 
         /* Data members */
         /*! Indicates if the model exists. */
@@ -411,6 +447,14 @@ namespace Orm::Tiny
         bool u_incrementing = true;
         /*! The primary key associated with the table. */
         QString u_primaryKey = ID;
+        /*! Indicates whether the model attributes are stored in the entity cache
+            (second-level cache used by the find() and BelongsTo eager loads). */
+        T_THREAD_LOCAL
+        inline static bool u_entityCache = false;
+        /*! Indicates whether the lazy loading of a relation on one of the models
+            hydrated together eager loads this relation for all of them. */
+        T_THREAD_LOCAL
+        inline static bool u_batchLazyLoading = false;
 
         // TODO detect (best at compile time) circular eager relation problem, the exception which happens during this problem is stackoverflow in QRegularExpression silverqx
         /*! The relations to eager load on every query. */
@@ -419,6 +463,14 @@ namespace Orm::Tiny
 //        QVector<WithItem> u_withCount;
 
     private:
+        /* Static operations on the Model class */
+        /*! Maximum number of bindings in one multi-rows insert statement (saveMany()),
+            it's the SQLite's SQLITE_MAX_VARIABLE_NUMBER default value before 3.32. */
+        constexpr static QVector<QVariant>::size_type MaxInsertBindings = 999;
+
+        /*! Insert the given batch of new models using multi-rows insert statements. */
+        static void insertMany(const QVector<Derived *> &models, SaveOptions options);
+
         /* Operations on a Model instance */
         /*! Method to call in the incrementOrDecrement(). */
         enum struct IncrementOrDecrement
@@ -794,6 +846,70 @@ namespace Orm::Tiny
         return destroy(QVector<QVariant> {id});
     }
 
+    template<typename Derived, AllRelationsConcept ...AllRelations>
+    bool Model<Derived, AllRelations...>::saveMany(ModelsCollection<Derived> &models,
+                                                   const SaveOptions options)
+    {
+        auto saved = true;
+
+        /* New models are grouped by the connection, by the inserted columns and by
+           whether the primary key is incrementing, so every group can be inserted using
+           the one multi-rows insert statement. The order of groups is preserved. */
+        QVector<QVector<Derived *>> batches;
+        std::unordered_map<QString, typename QVector<Derived *>::size_type> batchesIndex;
+
+        for (auto &model : models) {
+            const auto &attributes = model.getAttributes();
+
+            /* Existing models are updated one by one, and also new models with empty
+               attributes or with the manually set auto-incrementing primary key are
+               inserted in the same way as the save() method does. */
+            if (model.exists || attributes.isEmpty() ||
+                (model.getIncrementing() && !model.getKey().isNull())
+            ) {
+                saved = model.save(options) && saved;
+                continue;
+            }
+
+//            if (!model.fireModelEvent("saving") || !model.fireModelEvent("creating"))
+//                continue;
+
+            /* Touch the creation and update timestamps on every model the same way
+               as the performInsert() does. */
+            if (model.usesTimestamps())
+                model.updateTimestamps();
+
+            QStringList columns;
+            columns.reserve(attributes.size());
+
+            for (const auto &attribute : attributes)
+                columns << attribute.key;
+
+            // The same order as in QVariantMap that is used by the QueryBuilder::insert()
+            columns.sort();
+
+            auto batchKey = QStringLiteral("%1|%2|%3")
+                            .arg(model.getConnectionName(),
+                                 model.getIncrementing() ? QStringLiteral("1")
+                                                         : QStringLiteral("0"),
+                                 columns.join(QLatin1Char(',')));
+
+            if (const auto it = batchesIndex.find(batchKey);
+                it != batchesIndex.end()
+            )
+                batches[it->second] << &model;
+            else {
+                batchesIndex.emplace(std::move(batchKey), batches.size());
+                batches.append({&model});
+            }
+        }
+
+        for (const auto &batch : std::as_const(batches))
+            insertMany(batch, options);
+
+        return saved;
+    }
+
     /* Operations on a Model instance */
 
     template<typename Derived, AllRelationsConcept ...AllRelations>
@@ -1294,6 +1410,21 @@ namespace Orm::Tiny
         return model;
     }
 
+    template<typename Derived, AllRelationsConcept ...AllRelations>
+    Derived
+    Model<Derived, AllRelations...>::newFromBuilder(
+            QVector<AttributeItem> &&attributes, const AttributesHash &attributesHash,
+            const QString &connection) const
+    {
+        auto model = newInstance({}, true);
+
+        model.setRawAttributes(std::move(attributes), attributesHash, true);
+
+        model.setConnection(connection);
+
+        return model;
+    }
+
     template<typename Derived, AllRelationsConcept ...AllRelations>
     Derived
     Model<Derived, AllRelations...>::newInstance() const
@@ -1441,6 +1572,110 @@ namespace Orm::Tiny
         return toJsonDocument().toJson(format);
     }
 
+    template<typename Derived, AllRelationsConcept ...AllRelations>
+    template<typename PivotType>
+    void Model<Derived, AllRelations...>::writeJson(JsonWriter &writer) const
+    {
+        writer.beginObject();
+
+        this->writeAttributesJson(writer);
+        this->template writeRelationsJson<PivotType>(writer);
+
+        writer.endObject();
+    }
+
+    template<typename Derived, AllRelationsConcept ...AllRelations>
+    void Model<Derived, AllRelations...>::writeJson(QIODevice &device) const
+    {
+        JsonWriter writer(device);
+
+        writeJson(writer);
+
+        writer.flush();
+    }
+
+    template<typename Derived, AllRelationsConcept ...AllRelations>
+    void Model<Derived, AllRelations...>::writeJson(QByteArray &buffer) const
+    {
+        JsonWriter writer(buffer);
+
+        writeJson(writer);
+    }
+
+    template<typename Derived, AllRelationsConcept ...AllRelations>
+    template<typename PivotType>
+    void Model<Derived, AllRelations...>::writeCbor(QCborStreamWriter &writer) const
+    {
+        writer.startMap(4);
+
+        writer.append(QStringLiteral("connection"));
+        writer.append(model().u_connection);
+
+        writer.append(QStringLiteral("exists"));
+        writer.append(exists);
+
+        writer.append(QStringLiteral("attributes"));
+        this->writeAttributesCbor(writer);
+
+        writer.append(QStringLiteral("relations"));
+        this->template writeRelationsCbor<PivotType>(writer);
+
+        writer.endMap();
+    }
+
+    template<typename Derived, AllRelationsConcept ...AllRelations>
+    QByteArray Model<Derived, AllRelations...>::toCbor() const
+    {
+        QByteArray cbor;
+        QCborStreamWriter writer(&cbor);
+
+        writeCbor(writer);
+
+        return cbor;
+    }
+
+    template<typename Derived, AllRelationsConcept ...AllRelations>
+    template<typename PivotType>
+    Derived Model<Derived, AllRelations...>::fromCbor(QCborStreamReader &reader)
+    {
+        Derived model;
+
+        Orm::Utils::Cbor::enterContainer(reader, QCborStreamReader::Map);
+
+        while (reader.hasNext()) {
+            const auto key = Orm::Utils::Cbor::readString(reader);
+
+            if (key == QStringLiteral("attributes"))
+                model.readAttributesCbor(reader);
+
+            else if (key == QStringLiteral("relations"))
+                model.template readRelationsCbor<PivotType>(reader);
+
+            else if (key == QStringLiteral("exists")) {
+                model.exists = reader.isBool() && reader.toBool();
+                reader.next();
+            }
+            else if (key == QStringLiteral("connection") && reader.isString())
+                model.u_connection = Orm::Utils::Cbor::readString(reader);
+
+            // Skip unknown keys
+            else
+                reader.next();
+        }
+
+        Orm::Utils::Cbor::leaveContainer(reader);
+
+        return model;
+    }
+
+    template<typename Derived, AllRelationsConcept ...AllRelations>
+    Derived Model<Derived, AllRelations...>::fromCbor(const QByteArray &cbor)
+    {
+        QCborStreamReader reader(cbor);
+
+        return fromCbor(reader);
+    }
+
     /* Getters / Setters */
 
     template<typename Derived, AllRelationsConcept ...AllRelations>
@@ -1587,6 +1822,18 @@ namespace Orm::Tiny
         return std::is_base_of_v<SoftDeletes<Derived>, Derived>;
     }
 
+    template<typename Derived, AllRelationsConcept ...AllRelations>
+    bool Model<Derived, AllRelations...>::usesEntityCache() noexcept
+    {
+        return Derived::u_entityCache;
+    }
+
+    template<typename Derived, AllRelationsConcept ...AllRelations>
+    bool Model<Derived, AllRelations...>::usesBatchedLazyLoading() noexcept
+    {
+        return Derived::u_batchLazyLoading;
+    }
+
     /* protected */
 
     /* HasTimestamps */
@@ -1768,6 +2015,65 @@ namespace Orm::Tiny
 
     /* private */
 
+    /* Static operations on the Model class */
+
+    template<typename Derived, AllRelationsConcept ...AllRelations>
+    void Model<Derived, AllRelations...>::insertMany(const QVector<Derived *> &models,
+                                                     const SaveOptions options)
+    {
+        // All models in the batch have the same connection, columns, and incrementing
+        const auto &firstModel = *models.constFirst();
+
+        // Ownership of a unique_ptr()
+        const auto query = firstModel.newModelQuery();
+        const auto &connectionName = query->getConnection().getName();
+
+        const auto incrementing = firstModel.getIncrementing();
+        const auto &keyName = firstModel.getKeyName();
+
+        // Don't exceed the maximum number of bindings for the one insert statement
+        const auto chunkSize = std::max<QVector<QVariant>::size_type>(
+                                   1, MaxInsertBindings /
+                                      firstModel.getAttributes().size());
+
+        for (typename QVector<Derived *>::size_type offset = 0; offset < models.size();
+             offset += chunkSize
+        ) {
+            const auto chunk = models.mid(offset, chunkSize);
+
+            QVector<QVector<AttributeItem>> values;
+            values.reserve(chunk.size());
+
+            for (const auto *const model : chunk)
+                values << model->getAttributes();
+
+            /* If the model has an incrementing key, we can use the "insertGetIds" method
+               on the query builder, which will give us back the final inserted IDs for
+               this table from the database in the same order as the values. */
+            if (incrementing) {
+                const auto ids = query->insertGetIds(values, keyName);
+
+                for (typename QVector<Derived *>::size_type i = 0; i < chunk.size(); ++i)
+                    // Insert was successful (0 while pretending)
+                    if (const auto id = ids.at(i); id != 0)
+                        chunk.at(i)->setAttribute(keyName, id);
+            }
+            else
+                query->insert(values);
+
+            for (auto *const model : chunk) {
+                model->exists = true;
+
+//                model->fireModelEvent("created", false);
+
+                if (model->getConnectionName().isEmpty())
+                    model->setConnection(connectionName);
+
+                model->finishSave(options);
+            }
+        }
+    }
+
     /* Operations on a Model instance */
 
     template<typename Derived, AllRelationsConcept ...AllRelations>
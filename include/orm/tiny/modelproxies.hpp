@@ -7,6 +7,7 @@ TINY_SYSTEM_HEADER
 
 #include "orm/ormconcepts.hpp"
 #include "orm/tiny/types/modelscollection.hpp"
+#include "orm/types/lazyrange.hpp"
 #include "orm/types/sqlquery.hpp"
 
 TINYORM_BEGIN_COMMON_NAMESPACE
@@ -36,6 +37,10 @@ namespace Tiny
 
     public:
         /* Retrieving results */
+        /*! Get a lazy range for the given query, hydrates one model at a time using
+            the forward-only query (eager loading is not supported). */
+        static LazyRange<Derived> cursor(const QVector<Column> &columns = {ASTERISK});
+
         /*! Get a single column's value from the first result of a query. */
         static QVariant value(const Column &column);
         /*! Get a single column's value from the first result of a query if it's
@@ -178,6 +183,19 @@ namespace Tiny
         static std::unique_ptr<TinyBuilder<Derived>>
         withOnly(QVector<QString> &&relations);
 
+        /*! Begin querying a model with the count of the related models. */
+        static std::unique_ptr<TinyBuilder<Derived>>
+        withCount(const QString &relation);
+        /*! Begin querying a model with the count of the related models. */
+        static std::unique_ptr<TinyBuilder<Derived>>
+        withCount(const QVector<QString> &relations);
+        /*! Begin querying a model with the existence of the related models. */
+        static std::unique_ptr<TinyBuilder<Derived>>
+        withExists(const QString &relation);
+        /*! Begin querying a model with the existence of the related models. */
+        static std::unique_ptr<TinyBuilder<Derived>>
+        withExists(const QVector<QString> &relations);
+
         /* Insert, Update, Delete */
         /*! Save a new model and return the instance. */
         static Derived create(const QVector<AttributeItem> &attributes = {});
@@ -865,6 +883,12 @@ namespace Tiny
         static std::unique_ptr<TinyBuilder<Derived>>
         lock(QString &&value);
 
+        /* Query cache */
+        /*! Cache results of the select query for the given time, the cache is
+            invalidated when the tables in the from and joins clauses are modified. */
+        static std::unique_ptr<TinyBuilder<Derived>>
+        remember(std::chrono::milliseconds ttl);
+
         /* Builds Queries */
         /*! Chunk the results of the query. */
         static bool
@@ -897,6 +921,21 @@ namespace Tiny
                  qint64 count = 1000, const QString &column = "",
                  const QString &alias = "");
 
+        /*! Query lazily by chunking the results of a query by comparing IDs, the next
+            chunk can be prefetched using the worker connection in the background. */
+        static LazyRange<Derived>
+        lazyById(qint64 count = 1000, const QString &column = "",
+                 const QString &alias = "", bool prefetch = false);
+
+        /*! Chunk the results of a query by comparing IDs, disjoint ID ranges are
+            processed in parallel by the given number of workers. */
+        static bool
+        chunkByIdParallel(
+                qint64 count, int workers,
+                const std::function<
+                    bool(ModelsCollection<Derived> &&models, qint64 page)> &callback,
+                const QString &column = "", const QString &alias = "");
+
         /*! Execute the query and get the first result if it's the sole matching
             record. */
         static Derived sole(const QVector<Column> &columns = {ASTERISK});
@@ -1042,6 +1081,13 @@ namespace Tiny
 
     /* Retrieving results */
 
+    template<typename Derived, AllRelationsConcept ...AllRelations>
+    LazyRange<Derived>
+    ModelProxies<Derived, AllRelations...>::cursor(const QVector<Column> &columns)
+    {
+        return query()->cursor(columns);
+    }
+
     template<typename Derived, AllRelationsConcept ...AllRelations>
     QVariant ModelProxies<Derived, AllRelations...>::value(const Column &column)
     {
@@ -1372,6 +1418,51 @@ namespace Tiny
         return builder;
     }
 
+    template<typename Derived, AllRelationsConcept ...AllRelations>
+    std::unique_ptr<TinyBuilder<Derived>>
+    ModelProxies<Derived, AllRelations...>::withCount(const QString &relation)
+    {
+        auto builder = query();
+
+        builder->withCount(relation);
+
+        return builder;
+    }
+
+    template<typename Derived, AllRelationsConcept ...AllRelations>
+    std::unique_ptr<TinyBuilder<Derived>>
+    ModelProxies<Derived, AllRelations...>::withCount(const QVector<QString> &relations)
+    {
+        auto builder = query();
+
+        builder->withCount(relations);
+
+        return builder;
+    }
+
+    template<typename Derived, AllRelationsConcept ...AllRelations>
+    std::unique_ptr<TinyBuilder<Derived>>
+    ModelProxies<Derived, AllRelations...>::withExists(const QString &relation)
+    {
+        auto builder = query();
+
+        builder->withExists(relation);
+
+        return builder;
+    }
+
+    template<typename Derived, AllRelationsConcept ...AllRelations>
+    std::unique_ptr<TinyBuilder<Derived>>
+    ModelProxies<Derived, AllRelations...>::withExists(
+            const QVector<QString> &relations)
+    {
+        auto builder = query();
+
+        builder->withExists(relations);
+
+        return builder;
+    }
+
     /* Insert, Update, Delete */
 
     template<typename Derived, AllRelationsConcept ...AllRelations>
@@ -3359,6 +3450,20 @@ namespace Tiny
         return builder;
     }
 
+    /* Query cache */
+
+    template<typename Derived, AllRelationsConcept ...AllRelations>
+    std::unique_ptr<TinyBuilder<Derived>>
+    ModelProxies<Derived, AllRelations...>::remember(
+            const std::chrono::milliseconds ttl)
+    {
+        auto builder = query();
+
+        builder->remember(ttl);
+
+        return builder;
+    }
+
     /* Builds Queries */
 
     template<typename Derived, AllRelationsConcept ...AllRelations>
@@ -3410,6 +3515,24 @@ namespace Tiny
         return query()->eachById(callback, count, column, alias);
     }
 
+    template<typename Derived, AllRelationsConcept ...AllRelations>
+    LazyRange<Derived>
+    ModelProxies<Derived, AllRelations...>::lazyById(
+            const qint64 count, const QString &column, const QString &alias,
+            const bool prefetch)
+    {
+        return query()->lazyById(count, column, alias, prefetch);
+    }
+
+    template<typename Derived, AllRelationsConcept ...AllRelations>
+    bool ModelProxies<Derived, AllRelations...>::chunkByIdParallel(
+            const qint64 count, const int workers,
+            const std::function<bool(ModelsCollection<Derived> &&, qint64)> &callback,
+            const QString &column, const QString &alias)
+    {
+        return query()->chunkByIdParallel(count, workers, callback, column, alias);
+    }
+
     template<typename Derived, AllRelationsConcept ...AllRelations>
     Derived ModelProxies<Derived, AllRelations...>::sole(const QVector<Column> &columns)
     {
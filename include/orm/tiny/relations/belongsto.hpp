@@ -81,6 +81,8 @@ namespace Orm::Tiny::Relations
         /*! Get the results of the relationship. */
         std::variant<ModelsCollection<Related>, std::optional<Related>>
         getResults() const override;
+        /*! Get the relationship for eager loading (including cached models). */
+        ModelsCollection<Related> getEager() const override;
 
         /* Updating relationship */
         /*! Associate the model instance to the given parent. */
@@ -147,6 +149,11 @@ namespace Orm::Tiny::Relations
         QString m_ownerKey;
         /*! The name of the relationship. */
         QString m_relationName;
+        /*! Related models obtained from the entity cache during the eager load. */
+        mutable ModelsCollection<Related> m_eagerCached;
+        /*! Determine whether all related models were obtained from the entity cache
+            (the eager load query is not needed). */
+        mutable bool m_eagerAllCached = false;
         /*! The count of self joins. */
         T_THREAD_LOCAL
         inline static int selfJoinCount = 0;
@@ -306,6 +313,32 @@ namespace Orm::Tiny::Relations
         return first ? std::move(first) : this->getDefaultFor(*m_child);
     }
 
+    template<class Model, class Related>
+    ModelsCollection<Related> BelongsTo<Model, Related>::getEager() const
+    {
+        // All related models were found in the entity cache, no query is needed
+        auto models = m_eagerAllCached ? ModelsCollection<Related>()
+                                       : Relation<Model, Related>::getEager();
+
+        m_eagerAllCached = false;
+
+        // Nothing to do, no related models from the entity cache
+        if (m_eagerCached.isEmpty())
+            return models;
+
+        // Load nested relations, queried models have them already loaded
+        this->m_query->eagerLoadRelations(m_eagerCached);
+
+        models.reserve(models.size() + m_eagerCached.size());
+
+        for (auto &&related : m_eagerCached)
+            models << std::move(related);
+
+        m_eagerCached.clear();
+
+        return models;
+    }
+
     /* Updating relationship */
 
     template<class Model, class Related>
@@ -482,11 +515,31 @@ namespace Orm::Tiny::Relations
     void BelongsTo<Model, Related>::addEagerConstraintsInternal(
             const ModelsCollection<CollectionModel> &models)
     {
+        auto keys = getEagerModelKeys(models);
+
+        /* Related models found in the entity cache don't have to be queried, this is
+           only possible if the owner key is the primary key and the relation query
+           doesn't have any other constraints. */
+        if (this->m_eagerEntityCache && m_ownerKey == this->m_related->getKeyName() &&
+            this->m_query->canReadEntityCache({ASTERISK})
+        ) {
+            QVector<QVariant> missingKeys;
+
+            for (auto &&key : keys)
+                if (auto related = this->m_query->cachedEntity(key); related)
+                    m_eagerCached << std::move(*related);
+                else
+                    missingKeys << std::move(key);
+
+            keys = std::move(missingKeys);
+
+            m_eagerAllCached = keys.isEmpty() && !m_eagerCached.isEmpty();
+        }
+
         /* We'll grab the primary key name of the related models since it could be set to
            a non-standard name and not "id". We will then construct the constraint for
            our eagerly loading query so it returns the proper models from execution. */
-        this->whereInEager(DOT_IN.arg(this->m_related->getTable(), m_ownerKey),
-                           getEagerModelKeys(models));
+        this->whereInEager(DOT_IN.arg(this->m_related->getTable(), m_ownerKey), keys);
     }
 
     template<class Model, class Related>
@@ -516,10 +569,26 @@ namespace Orm::Tiny::Relations
         /* First we will get to build a dictionary of the child models by their primary
            key of the relationship, then we can easily match the children back onto
            the parents using that dictionary and the primary key of the children. */
-        const auto dictionary = buildDictionary(std::move(results));
+        auto dictionary = buildDictionary(std::move(results));
 
         /*! Model type used in the for-ranged loops. */
         using ModelLoopType = typename ModelsCollection<CollectionModel>::ModelLoopType;
+        /*! Key type of the relationship. */
+        using KeyType = typename Model::KeyType;
+
+        /* Many children can belong to the same parent, all of them get copies of one
+           parent instance that share its implicitly shared attributes, and the last
+           child takes the parent instance itself, so it isn't copied at all. */
+        QHash<KeyType, qsizetype> childrenCount;
+        childrenCount.reserve(dictionary.size());
+
+        for (ModelLoopType model : models)
+            if (const auto foreignKey = Relation<Model,Related>::toPointer(model)
+                                        ->getAttribute(m_foreignKey)
+                                        .template value<KeyType>();
+                dictionary.contains(foreignKey)
+            )
+                ++childrenCount[foreignKey];
 
         /* Once we have the dictionary constructed, we can loop through all the parents
            and match back onto their children using these keys of the dictionary and
@@ -527,16 +596,20 @@ namespace Orm::Tiny::Relations
         for (ModelLoopType model : models) {
             auto *const modelPointer = Relation<Model,Related>::toPointer(model);
 
-            if (const auto foreignKey = modelPointer->getAttribute(m_foreignKey)
-                                        .template value<typename Model::KeyType>();
-                dictionary.contains(foreignKey)
-            )
-                modelPointer->setRelation(
-                            relation,
-                            std::make_optional<Related>(
-                                /* Don't move here! as one Related model can be set
-                                   on more parent models. */
-                                dictionary.find(foreignKey).value()));
+            const auto foreignKey = modelPointer->getAttribute(m_foreignKey)
+                                    .template value<KeyType>();
+
+            const auto itRelated = dictionary.find(foreignKey);
+
+            if (itRelated == dictionary.end())
+                continue;
+
+            modelPointer->setRelation(
+                        relation,
+                        std::make_optional<Related>(
+                            --childrenCount[foreignKey] == 0
+                            ? std::move(itRelated.value())
+                            : itRelated.value()));
         }
     }
 
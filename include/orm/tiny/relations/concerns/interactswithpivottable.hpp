@@ -7,10 +7,13 @@ TINY_SYSTEM_HEADER
 
 #include <QtSql/QSqlRecord>
 
+#include <unordered_map>
+
 #include <range/v3/view/set_algorithm.hpp>
 
 #include "orm/exceptions/domainerror.hpp"
 #include "orm/ormconcepts.hpp"
+#include "orm/tiny/types/modelscollection.hpp"
 #include "orm/tiny/types/syncchanges.hpp"
 #include "orm/tiny/utils/attribute.hpp"
 #include "orm/utils/query.hpp"
@@ -197,6 +200,9 @@ namespace Concerns
 
         /*! Get the pivot models that are currently attached. */
         QVector<PivotType> getCurrentlyAttachedPivots() const;
+        /*! Key the given pivot models by the related model ID. */
+        std::unordered_map<RelatedKeyType, PivotType>
+        keyPivotsByRelatedId(QVector<PivotType> &&pivots) const;
         /*! Get the attached pivot model by related model ID. */
         std::optional<PivotType> getAttachedPivot(const QVariant &id) const;
         /*! Convert a QSqlRecord to the QVector<AttributeItem>. */
@@ -215,7 +221,25 @@ namespace Concerns
         SyncChanges
         attachNew(const std::map<RelatedKeyType,
                                  QVector<AttributeItem>> &records,
-                  const QVector<QVariant> &current, bool touch = true) const;
+                  std::unordered_map<RelatedKeyType, PivotType> &current,
+                  bool touch = true) const;
+        /*! The existing pivot record to update (used by the sync()). */
+        struct PivotUpdate
+        {
+            /*! The related model ID. */
+            QVariant id;
+            /*! Values to update. */
+            QVector<AttributeItem> values;
+            /*! Determine whether the given attributes change the loaded pivot. */
+            bool changed;
+        };
+
+        /*! Get the pivot values to update for the currently attached pivot model. */
+        std::optional<PivotUpdate>
+        getPivotValuesToUpdate(const QVariant &id, PivotType &pivot,
+                               const QVector<AttributeItem> &attributes) const;
+        /*! Update the existing pivot records, the same values are updated at once. */
+        QVector<QVariant> updateExistingPivots(QVector<PivotUpdate> &&updates) const;
 
         /*! Convert IDs vector to the map with attributes keyed by IDs. */
         std::map<RelatedKeyType, QVector<AttributeItem>>
@@ -453,17 +477,19 @@ namespace Concerns
 
         /* First we need to attach any of the associated models that are not currently
            in this joining table. We'll spin through the given IDs, checking to see
-           if they exist in the vector of current ones, and if not we will insert. */
-        auto current = getRelatedIds(getCurrentlyAttachedPivots());
+           if they exist in the hash of current ones, and if not we will insert. */
+        auto current = keyPivotsByRelatedId(getCurrentlyAttachedPivots());
 
         // Compute different keys, these keys will be detached
-        auto ids = idsFromRecords(idsWithAttributes);
+        QVector<QVariant> detach;
+        detach.reserve(static_cast<decltype (detach)::size_type>(current.size()));
+
+        for (const auto &[id, pivot] : current)
+            if (!idsWithAttributes.contains(id))
+                detach << pivot.getAttribute(getRelatedPivotKeyName_());
 
-        std::ranges::sort(ids, {}, castKey);
-        std::ranges::sort(current, {}, castKey);
-        auto detach =
-                ranges::views::set_difference(current, ids, {}, castKey, castKey) |
-                ranges::to<QVector<QVariant>>();
+        // Detached IDs are sorted the same way as the attached IDs
+        std::ranges::sort(detach, {}, castKey);
 
         /* Next, we will take the differences of the currents and given IDs and detach
            all of the entities that exist in the "current" vector but are not in the
@@ -676,8 +702,14 @@ namespace Concerns
             const QVector<QVariant> &ids,
             const QVector<AttributeItem> &attributes) const
     {
+        ModelsCollection<PivotType> pivots;
+        pivots.reserve(ids.size());
+
         for (const auto &record : formatAttachRecords(ids, attributes))
-            newPivot(record).save();
+            pivots << newPivot(record);
+
+        // Inserted using multi-rows inserts
+        PivotType::saveMany(pivots);
     }
 
     template<class Model, class Related, class PivotType>
@@ -739,8 +771,15 @@ namespace Concerns
             const std::map<RelatedKeyType,
                            QVector<AttributeItem>> &idsWithAttributes) const
     {
+        ModelsCollection<PivotType> pivots;
+        pivots.reserve(static_cast<decltype (pivots)::size_type>(
+                           idsWithAttributes.size()));
+
         for (const auto &record : formatAttachRecords(idsWithAttributes))
-            newPivot(record).save();
+            pivots << newPivot(record);
+
+        // Inserted using multi-rows inserts
+        PivotType::saveMany(pivots);
     }
 
     template<class Model, class Related, class PivotType>
@@ -841,6 +880,27 @@ namespace Concerns
         return pivots;
     }
 
+    template<class Model, class Related, class PivotType>
+    std::unordered_map<
+            typename InteractsWithPivotTable<Model, Related, PivotType>::RelatedKeyType,
+            PivotType>
+    InteractsWithPivotTable<Model, Related, PivotType>::keyPivotsByRelatedId(
+            QVector<PivotType> &&pivots) const
+    {
+        std::unordered_map<RelatedKeyType, PivotType> pivotsById;
+        pivotsById.reserve(static_cast<std::size_t>(pivots.size()));
+
+        const auto &relatedPivotKeyName = getRelatedPivotKeyName_();
+
+        for (auto &&pivot : pivots) {
+            auto id = castKey<RelatedKeyType>(pivot.getAttribute(relatedPivotKeyName));
+
+            pivotsById.emplace(std::move(id), std::move(pivot));
+        }
+
+        return pivotsById;
+    }
+
     template<class Model, class Related, class PivotType>
     std::optional<PivotType>
     InteractsWithPivotTable<Model, Related, PivotType>::getAttachedPivot(
@@ -908,17 +968,24 @@ namespace Concerns
     SyncChanges
     InteractsWithPivotTable<Model, Related, PivotType>::attachNew(
             const std::map<RelatedKeyType, QVector<AttributeItem>> &records,
-            const QVector<QVariant> &current, const bool touch) const
+            std::unordered_map<RelatedKeyType, PivotType> &current,
+            const bool touch) const
     {
         SyncChanges changes;
 
+        std::map<RelatedKeyType, QVector<AttributeItem>> attachRecords;
+        QVector<PivotUpdate> updates;
+        bool updatesExisting = false;
+
         for (const auto &[id, attributes] : records) {
-            /* If the ID is not in the list of existing pivot IDs, we will insert
+            /* If the ID is not in the hash of existing pivots, we will insert
                a new pivot record, otherwise, we will just update this existing record
                on this joining table, so that the developers will easily update these
                records pain free. */
-            if (!current.contains(id)) {
-                attach(id, attributes, touch);
+            const auto pivot = current.find(id);
+
+            if (pivot == current.end()) {
+                attachRecords.emplace(id, attributes);
 
                 changes.at(Attached) << id;
             }
@@ -927,15 +994,181 @@ namespace Concerns
                that were given to the method. If the model is actually updated, we will
                add it to the list of updated pivot records, so we return them back
                out to the consumer. */
-            else if (!attributes.isEmpty() &&
-                     updateExistingPivot(id, attributes, touch)
-            )
-                changes.at(Updated_) << id;
+            else if (!attributes.isEmpty()) {
+                updatesExisting = true;
+
+                if (auto update = getPivotValuesToUpdate(id, pivot->second, attributes);
+                    update
+                )
+                    updates << std::move(*update);
+            }
         }
 
+        // All new records are inserted using the one multi-rows insert statement
+        if (!attachRecords.empty())
+            attach(attachRecords, touch);
+
+        if (!updates.isEmpty())
+            changes.at(Updated_) = updateExistingPivots(std::move(updates));
+
+        /* The same as the updateExistingPivot(), it touches even if the custom pivot
+           wasn't changed, but only once for all existing records. */
+        if (updatesExisting && touch)
+            touchIfTouching_();
+
         return changes;
     }
 
+    template<class Model, class Related, class PivotType>
+    std::optional<
+            typename InteractsWithPivotTable<Model, Related, PivotType>::PivotUpdate>
+    InteractsWithPivotTable<Model, Related, PivotType>::getPivotValuesToUpdate(
+            const QVariant &id, PivotType &pivot,
+            const QVector<AttributeItem> &attributes) const
+    {
+        /* The currently attached pivot is already loaded, so the changed pivot records
+           can be determined in memory without querying the database. */
+        if constexpr (std::is_same_v<PivotType, Pivot>) {
+            // The same values as the updateExistingPivot() updates
+            auto values = attributes;
+
+            if (hasPivotColumn(updatedAt_()))
+                addTimestampsToAttachment(values, true);
+
+            /* The basic pivot record is always updated, the changed flag is needed
+               only when the database reports changed rows instead of matched rows. */
+            const auto changed = pivot.forceFill(attributes).isDirty();
+
+            return PivotUpdate {id, std::move(values), changed};
+        }
+        else {
+            // The same values as the updateExistingPivotUsingCustomClass() saves
+            if (!pivot.fill(attributes).isDirty())
+                return std::nullopt;
+
+            if (pivot.usesTimestamps())
+                pivot.updateTimestamps();
+
+            return PivotUpdate {id, pivot.getDirty(), true};
+        }
+    }
+
+    template<class Model, class Related, class PivotType>
+    QVector<QVariant>
+    InteractsWithPivotTable<Model, Related, PivotType>::updateExistingPivots(
+            QVector<PivotUpdate> &&updates) const
+    {
+        /* Group the pivot records that have to be updated with the same values,
+           every group is updated using the one update statement. Groups contain
+           indexes to the updates vector. The updated_at timestamps can differ by
+           a second, the whole group is updated with the first record's timestamp. */
+        QVector<QVector<typename QVector<PivotUpdate>::size_type>> groups;
+        /* Groups keyed by the serialized pivot values, the serialized values can
+           collide (eg. types without the string conversion), so every bucket contains
+           the groups with the same serialized values that are compared exactly. */
+        std::unordered_map<QString, QVector<typename decltype (groups)::size_type>>
+        buckets;
+        buckets.reserve(static_cast<std::size_t>(updates.size()));
+
+        const auto &updatedAt = updatedAt_();
+
+        const auto isSameUpdate = [&updatedAt](const QVector<AttributeItem> &left,
+                                               const QVector<AttributeItem> &right)
+        {
+            return std::ranges::equal(left, right, [&updatedAt]
+                                      (const AttributeItem &l, const AttributeItem &r)
+            {
+                return l.key == r.key && (l.key == updatedAt || l.value == r.value);
+            });
+        };
+
+        // The updated_at value is not a part of the key, the same as the isSameUpdate
+        const auto serializeValues = [&updatedAt](const QVector<AttributeItem> &values)
+        {
+            QString key;
+            key.reserve(values.size() * 16);
+
+            for (const auto &[column, value] : values) {
+                key += column;
+                key += QChar(0x1F);
+
+                if (column != updatedAt) {
+                    key += QString::number(value.userType());
+                    key += QChar(0x1F);
+                    key += value.toString();
+                }
+
+                key += QChar(0x1E);
+            }
+
+            return key;
+        };
+
+        for (typename QVector<PivotUpdate>::size_type index = 0;
+             index < updates.size(); ++index
+        ) {
+            const auto &values = updates.at(index).values;
+
+            auto &bucket = buckets[serializeValues(values)];
+
+            const auto group = std::ranges::find_if(bucket,
+                                                    [&groups, &updates, &values,
+                                                     &isSameUpdate]
+                                                    (const auto groupIndex)
+            {
+                return isSameUpdate(
+                            updates.at(groups.at(groupIndex).constFirst()).values,
+                            values);
+            });
+
+            if (group != bucket.end()) {
+                groups[*group] << index;
+                continue;
+            }
+
+            bucket << groups.size();
+            groups.append({index});
+        }
+
+        std::vector<bool> updated(static_cast<std::size_t>(updates.size()), false);
+
+        for (const auto &group : groups) {
+            QVector<QVariant> ids;
+            ids.reserve(group.size());
+
+            for (const auto index : group)
+                ids << updates.at(index).id;
+
+            int affected = -1;
+            std::tie(affected, std::ignore) =
+                    newPivotStatementForId(ids)->update(
+                        AttributeUtils::convertVectorToUpdateItem(
+                            std::move(updates[group.constFirst()].values)));
+
+            /* The updateExistingPivot() reports the record as updated if its update
+               statement affected the row. All rows were affected if the affected
+               rows count is the same as the group size, otherwise, the database
+               reports changed rows only (MySQL), so report the changed records. */
+            const auto allAffected = affected == group.size();
+
+            for (const auto index : group)
+                updated[static_cast<std::size_t>(index)] =
+                        allAffected || updates.at(index).changed;
+        }
+
+        // Updated IDs in the same order as the records were given
+        QVector<QVariant> updatedIds;
+        updatedIds.reserve(updates.size());
+
+        for (typename QVector<PivotUpdate>::size_type index = 0;
+             index < updates.size(); ++index
+        )
+            if (updated[static_cast<std::size_t>(index)])
+                updatedIds << std::move(updates[index].id);
+
+        return updatedIds;
+    }
+
     template<class Model, class Related, class PivotType>
     std::map<typename InteractsWithPivotTable<Model, Related, PivotType>::RelatedKeyType,
              QVector<AttributeItem>>
@@ -1060,15 +1293,11 @@ namespace Concerns
     int InteractsWithPivotTable<Model, Related, PivotType>::detachUsingCustomClass(
             const QVector<QVariant> &ids) const
     {
+        /* Pivot model events are not supported, so there is no need to instantiate and
+           remove the custom pivot models one by one, all of them are deleted using
+           the one delete statement, the same as the BasePivot::remove() does. */
         int affected = 0;
-
-        for (const auto &id : ids)
-            affected += newPivot({
-                {getForeignPivotKeyName_(),
-                 getParent_().getAttribute(getParentKeyName_())},
-
-                {getRelatedPivotKeyName_(), id},
-            }, true).remove();
+        std::tie(affected, std::ignore) = newPivotStatementForId(ids)->remove();
 
         return affected;
     }
@@ -295,7 +295,10 @@ namespace Orm::Tiny::Relations
     HasOneOrMany<Model, Related>::saveMany(ModelsCollection<Related> &models) const
     {
         for (auto &model : models)
-            save(model);
+            setForeignAttributesForCreate(model);
+
+        // New models are inserted using multi-rows inserts
+        Related::saveMany(models);
 
         return models;
     }
@@ -305,7 +308,10 @@ namespace Orm::Tiny::Relations
     HasOneOrMany<Model, Related>::saveMany(ModelsCollection<Related> &&models) const
     {
         for (auto &model : models)
-            save(model);
+            setForeignAttributesForCreate(model);
+
+        // New models are inserted using multi-rows inserts
+        Related::saveMany(models);
 
         return std::move(models);
     }
@@ -344,8 +350,16 @@ namespace Orm::Tiny::Relations
         ModelsCollection<Related> instances;
         instances.reserve(records.size());
 
-        for (const auto &record : records)
-            instances << create(record);
+        for (const auto &record : records) {
+            auto instance = this->m_related->newInstance(record);
+
+            setForeignAttributesForCreate(instance);
+
+            instances << std::move(instance);
+        }
+
+        // All instances are inserted using multi-rows inserts
+        Related::saveMany(instances);
 
         return instances;
     }
@@ -358,8 +372,16 @@ namespace Orm::Tiny::Relations
         ModelsCollection<Related> instances;
         instances.reserve(records.size());
 
-        for (auto &&record : records)
-            instances << create(std::move(record));
+        for (auto &&record : records) {
+            auto instance = this->m_related->newInstance(std::move(record));
+
+            setForeignAttributesForCreate(instance);
+
+            instances << std::move(instance);
+        }
+
+        // All instances are inserted using multi-rows inserts
+        Related::saveMany(instances);
 
         return instances;
     }
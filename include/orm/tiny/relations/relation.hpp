@@ -104,7 +104,7 @@ namespace Relations
         getResults() const = 0;
 
         /*! Get the relationship for eager loading. */
-        inline ModelsCollection<Related> getEager() const;
+        inline virtual ModelsCollection<Related> getEager() const;
         /*! Execute the query as a "select" statement. */
         inline virtual ModelsCollection<Related>
         get(const QVector<Column> &columns = {ASTERISK}) const;
@@ -142,6 +142,9 @@ namespace Relations
         /*! Run a raw update against the base query. */
         inline std::tuple<int, QSqlQuery>
         rawUpdate(const QVector<UpdateItem> &values = {}) const;
+        /*! Don't use the entity cache for the eager load (user constraints are
+            applied on the relation query). */
+        inline void withoutEntityCache() noexcept;
 
         /*! The textual representation of the Relation type. */
         virtual const QString &relationTypeName() const = 0;
@@ -199,6 +202,8 @@ namespace Relations
         /*! Indicates if the relation is adding constraints. */
         T_THREAD_LOCAL
         inline static bool constraints = true;
+        /*! Indicates whether the eager load can use the entity cache. */
+        bool m_eagerEntityCache = true;
 
     private:
         /*! Indicates whether the eagerly loaded relation should implicitly return
@@ -352,6 +357,12 @@ namespace Relations
         return m_query->update(values);
     }
 
+    template<class Model, class Related>
+    void Relation<Model, Related>::withoutEntityCache() noexcept
+    {
+        m_eagerEntityCache = false;
+    }
+
     /* protected */
 
     /* Relation related operations */
@@ -62,6 +62,9 @@ namespace Support::Stores
     template<SerializedAttributes C, typename Derived,
              AllRelationsConcept ...AllRelations>
     class SerializeRelationStore;
+    /*! The store for hydrating relationship from the CBOR. */
+    template<typename Derived, AllRelationsConcept ...AllRelations>
+    class FromCborRelationStore;
 
     /*! Type of data saved in the relation store. */
     enum struct RelationStoreType
@@ -75,8 +78,12 @@ namespace Support::Stores
         QUERIES_RELATIONSHIPS_QUERY,
         QUERIES_RELATIONSHIPS_TINY,
         QUERIES_RELATIONSHIPS_TINY_NESTED,
+        QUERIES_RELATIONSHIPS_AGGREGATE,
         RELATION_TO_MAP,
         RELATION_TO_VECTOR,
+        RELATION_TO_JSON,
+        RELATION_TO_CBOR,
+        RELATION_FROM_CBOR,
     };
 
     /*! Base class for relation stores. */
@@ -186,8 +193,12 @@ namespace Support::Stores
         case RelationStoreType::QUERIES_RELATIONSHIPS_QUERY:
         case RelationStoreType::QUERIES_RELATIONSHIPS_TINY:
         case RelationStoreType::QUERIES_RELATIONSHIPS_TINY_NESTED:
+        case RelationStoreType::QUERIES_RELATIONSHIPS_AGGREGATE:
         case RelationStoreType::RELATION_TO_MAP:
         case RelationStoreType::RELATION_TO_VECTOR:
+        case RelationStoreType::RELATION_TO_JSON:
+        case RelationStoreType::RELATION_TO_CBOR:
+        case RelationStoreType::RELATION_FROM_CBOR:
         {
             using Related = typename std::invoke_result_t<Method, Derived>
                                         ::element_type::RelatedType;
@@ -199,6 +210,7 @@ namespace Support::Stores
 
             case RelationStoreType::QUERIES_RELATIONSHIPS_QUERY:
             case RelationStoreType::QUERIES_RELATIONSHIPS_TINY_NESTED:
+            case RelationStoreType::QUERIES_RELATIONSHIPS_AGGREGATE:
                 static_cast<QueriesRelationshipsStore<void> *>(this)
                         ->template visited<Related>(method);
                 break;
@@ -217,6 +229,20 @@ namespace Support::Stores
                         ->visited(method);
                 break;
 
+            case RelationStoreType::RELATION_TO_JSON:
+                static_cast<SerializeRelationStore<Orm::Types::JsonWriter> *>(this)
+                        ->visited(method);
+                break;
+
+            case RelationStoreType::RELATION_TO_CBOR:
+                static_cast<SerializeRelationStore<QCborStreamWriter> *>(this)
+                        ->visited(method);
+                break;
+
+            case RelationStoreType::RELATION_FROM_CBOR:
+                static_cast<FromCborRelationStore *>(this)->visited(method);
+                break;
+
             default:
                 Q_UNREACHABLE();
             }
@@ -0,0 +1,105 @@
+#pragma once
+#ifndef ORM_TINY_RELATIONS_STORES_FROMCBORRELATIONSTORE_HPP
+#define ORM_TINY_RELATIONS_STORES_FROMCBORRELATIONSTORE_HPP
+
+#include "orm/macros/systemheader.hpp"
+TINY_SYSTEM_HEADER
+
+#include "orm/tiny/support/stores/baserelationstore.hpp"
+#include "orm/utils/cbor.hpp"
+
+TINYORM_BEGIN_COMMON_NAMESPACE
+
+namespace Orm::Tiny
+{
+namespace Relations
+{
+    class IsPivotRelation;
+}
+
+namespace Support::Stores
+{
+
+    /*! The store for hydrating relationship from the CBOR. */
+    template<typename Derived, AllRelationsConcept ...AllRelations>
+    class FromCborRelationStore final :
+            public BaseRelationStore<Derived, AllRelations...>
+    {
+        Q_DISABLE_COPY(FromCborRelationStore)
+
+        /*! Alias for the NotNull. */
+        template<typename T>
+        using NotNull = Orm::Utils::NotNull<T>;
+
+        /*! Alias for the BaseRelationStore (for shorter name). */
+        using BaseRelationStore_ = BaseRelationStore<Derived, AllRelations...>;
+        /*! Alias for the HasRelationStore (for shorter name). */
+        using HasRelationStore = Concerns::HasRelationStore<Derived, AllRelations...>;
+
+        // To access visited()
+        friend BaseRelationStore_;
+
+    public:
+        /*! Constructor. */
+        FromCborRelationStore(
+                NotNull<HasRelationStore *> hasRelationStore, const QString &relation,
+                QCborStreamReader &reader);
+        /*! Default destructor. */
+        inline ~FromCborRelationStore() = default;
+
+    private:
+        /*! Method called after visitation. */
+        template<RelationshipMethod<Derived> Method>
+        void visited(Method /*unused*/);
+
+        /*! The name of the relationship to hydrate. */
+        NotNull<const QString *> m_relation;
+        /*! The reader positioned at the relation's models. */
+        NotNull<QCborStreamReader *> m_reader;
+    };
+
+    /* public */
+
+    template<typename Derived, AllRelationsConcept ...AllRelations>
+    FromCborRelationStore<Derived, AllRelations...>::FromCborRelationStore(
+            NotNull<HasRelationStore *> hasRelationStore, const QString &relation,
+            QCborStreamReader &reader
+    )
+        : BaseRelationStore_(hasRelationStore, RelationStoreType::RELATION_FROM_CBOR)
+        , m_relation(&relation)
+        , m_reader(&reader)
+    {}
+
+    /* private */
+
+    template<typename Derived, AllRelationsConcept ...AllRelations>
+    template<RelationshipMethod<Derived> Method>
+    void FromCborRelationStore<Derived, AllRelations...>::visited(
+            const Method /*unused*/)
+    {
+        using Relation = typename std::invoke_result_t<Method, Derived>::element_type;
+        using Related  = typename Relation::RelatedType;
+
+        /* The same as the SerializeRelationStore, the PivotType of the belongs-to-many
+           relation is needed to hydrate the pivot models of related models. */
+
+        // belongs-to-many
+        if constexpr (std::is_base_of_v<Relations::IsPivotRelation, Relation>)
+            this->basemodel()
+                    .template readRelationCborVisited<
+                        Related, typename Relation::PivotTypeType>(
+                            *m_relation, *m_reader);
+
+        // has-one, has-many, and belongs-to
+        else
+            this->basemodel()
+                    .template readRelationCborVisited<Related, void>(
+                        *m_relation, *m_reader);
+    }
+
+} // namespace Support::Stores
+} // namespace Orm::Tiny
+
+TINYORM_END_COMMON_NAMESPACE
+
+#endif // ORM_TINY_RELATIONS_STORES_FROMCBORRELATIONSTORE_HPP
@@ -58,6 +58,13 @@ namespace Support::Stores
                         void(QueriesRelationshipsCallback<Related> &)> &callback,
                 std::optional<std::reference_wrapper<
                         QStringList>> relations = std::nullopt);
+        /*! QueriesRelationshipsStore constructor for the withAggregate() method. */
+        QueriesRelationshipsStore(
+                NotNull<HasRelationStore *> hasRelationStore,
+                QueriesRelationships<Derived> &origin,
+                const Concerns::RelationAggregate &aggregate,
+                const std::function<
+                        void(QueriesRelationshipsCallback<Related> &)> &callback);
         /*! Default destructor. */
         inline ~QueriesRelationshipsStore() = default;
 
@@ -86,6 +93,8 @@ namespace Support::Stores
                 QueriesRelationshipsCallback<Related> &)> *> m_callback;
         /*! Nested relations for hasNested() method. */
         QStringList *m_relations;
+        /*! Relationship aggregate for withAggregate() method. */
+        const Concerns::RelationAggregate *m_aggregate = nullptr;
     };
 
     /* QueriesRelationshipsStore<Related> is templated by Related, because it needs to
@@ -106,7 +115,9 @@ namespace Support::Stores
        QueriesRelationshipsStore (instantiated means template instance generated by
        the compiler, not a class instance), because the QueriesRelationshipsStore class
        can handle 3 store types, the nested store type is used on the base of ctor's
-       'relations' argument. */
+       'relations' argument.
+       The QUERIES_RELATIONSHIPS_AGGREGATE store type for the withAggregate() method
+       is created by the second ctor, it's always instantiated with the void Related. */
 
     /* public */
 
@@ -131,6 +142,25 @@ namespace Support::Stores
         , m_relations(relations ? &relations->get() : nullptr)
     {}
 
+    template<typename Derived, typename Related, AllRelationsConcept ...AllRelations>
+    QueriesRelationshipsStore<Derived, Related, AllRelations...>::
+    QueriesRelationshipsStore(
+            NotNull<HasRelationStore *> hasRelationStore,
+            QueriesRelationships<Derived> &origin,
+            const Concerns::RelationAggregate &aggregate,
+            const std::function<void(QueriesRelationshipsCallback<Related> &)> &callback
+    )
+        : BaseRelationStore_(hasRelationStore,
+                             RelationStoreType::QUERIES_RELATIONSHIPS_AGGREGATE)
+        , m_origin(&origin)
+        , m_comparison(&GE)
+        , m_count(1)
+        , m_condition(&AND)
+        , m_callback(&callback)
+        , m_relations(nullptr)
+        , m_aggregate(&aggregate)
+    {}
+
     /* private */
 
     template<typename Derived, typename Related, AllRelationsConcept ...AllRelations>
@@ -157,6 +187,15 @@ namespace Support::Stores
             m_origin->template hasInternalVisited<RelatedFromMethod>(
                         std::move(relationInstance), *m_comparison, m_count,
                         *m_condition, *m_relations);
+
+        // Aggregate store type, used by withAggregate()
+        else if (this->getStoreType() ==
+                 RelationStoreType::QUERIES_RELATIONSHIPS_AGGREGATE
+        ) {
+            if constexpr (std::is_void_v<Related>)
+                m_origin->template withAggregateVisited<RelatedFromMethod>(
+                            std::move(relationInstance), *m_aggregate, *m_callback);
+        }
         else
             m_origin->template has<RelatedFromMethod>(
                         std::move(relationInstance), *m_comparison, m_count,
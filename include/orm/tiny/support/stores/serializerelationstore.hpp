@@ -6,6 +6,8 @@
 TINY_SYSTEM_HEADER
 
 #include "orm/tiny/support/stores/baserelationstore.hpp"
+#include "orm/types/jsonwriter.hpp"
+#include "orm/utils/cbor.hpp"
 
 TINYORM_BEGIN_COMMON_NAMESPACE
 
@@ -52,6 +54,10 @@ namespace Support::Stores
         template<RelationshipMethod<Derived> Method>
         void visited(Method /*unused*/) const;
 
+        /*! Serialize the relation using the obtained Related and PivotType types. */
+        template<typename Related, typename PivotType>
+        void serializeVisited() const;
+
         /*! Store type initializer. */
         constexpr static RelationStoreType initStoreType();
 
@@ -98,15 +104,34 @@ namespace Support::Stores
 
         // belongs-to-many
         if constexpr (std::is_base_of_v<Relations::IsPivotRelation, Relation>)
+            serializeVisited<Related, typename Relation::PivotTypeType>();
+
+        // has-one, has-many, and belongs-to
+        else
+            serializeVisited<Related, void>();
+    }
+
+    template<SerializedAttributes C, typename Derived,
+             AllRelationsConcept ...AllRelations>
+    template<typename Related, typename PivotType>
+    void SerializeRelationStore<C, Derived, AllRelations...>::serializeVisited() const
+    {
+        // Streaming JSON serialization, the relation is written straight to the writer
+        if constexpr (std::is_same_v<C, JsonWriter>)
             this->basemodel()
-                    .template serializeRelationVisited<Related, C,
-                                                       typename Relation::PivotTypeType>(
+                    .template writeRelationJsonVisited<Related, PivotType>(
                         *m_relation, *m_models, *m_attributes);
 
-        // has-one, has-many, and belongs-to
+        // CBOR serialization, the relation is written straight to the writer
+        else if constexpr (std::is_same_v<C, QCborStreamWriter>)
+            this->basemodel()
+                    .template writeRelationCborVisited<Related, PivotType>(
+                        *m_models, *m_attributes);
+
+        // toMap() or toVector()
         else
             this->basemodel()
-                    .template serializeRelationVisited<Related, C, void>(
+                    .template serializeRelationVisited<Related, C, PivotType>(
                         *m_relation, *m_models, *m_attributes);
     }
 
@@ -121,6 +146,12 @@ namespace Support::Stores
         else if constexpr (std::is_same_v<C, QVector<AttributeItem>>)
             return RelationStoreType::RELATION_TO_VECTOR;
 
+        else if constexpr (std::is_same_v<C, JsonWriter>)
+            return RelationStoreType::RELATION_TO_JSON;
+
+        else if constexpr (std::is_same_v<C, QCborStreamWriter>)
+            return RelationStoreType::RELATION_TO_CBOR;
+
         else
             Q_UNREACHABLE();
     }
@@ -5,16 +5,23 @@
 #include "orm/macros/systemheader.hpp"
 TINY_SYSTEM_HEADER
 
+#include <QScopeGuard>
 #include <QtSql/QSqlRecord>
 
 #include <range/v3/action/transform.hpp>
 
+#include <thread>
+#include <unordered_set>
+
 #include "orm/databaseconnection.hpp"
+#include "orm/databasemanager.hpp"
+#include "orm/tiny/cache/entitycache.hpp"
 #include "orm/tiny/concerns/buildsqueries.hpp"
 #include "orm/tiny/concerns/buildssoftdeletes.hpp"
 #include "orm/tiny/concerns/queriesrelationships.hpp"
 #include "orm/tiny/exceptions/modelnotfounderror.hpp"
 #include "orm/tiny/tinybuilderproxies.hpp"
+#include "orm/tiny/types/identitymap.hpp"
 
 TINYORM_BEGIN_COMMON_NAMESPACE
 
@@ -33,6 +40,9 @@ namespace Orm::Tiny
         // To access enforceOrderBy(), and defaultKeyName()
         template<ModelConcept T>
         friend class Concerns::BuildsQueries;
+        // To swap the m_query of the relation query during concurrent eager loading
+        template<typename T>
+        friend class Builder;
 
         /*! Alias for the attribute utils. */
         using AttributeUtils = Orm::Tiny::Utils::Attribute;
@@ -67,6 +77,9 @@ namespace Orm::Tiny
         /* Retrieving results */
         /*! Execute the query as a "select" statement. */
         ModelsCollection<Model> get(const QVector<Column> &columns = {ASTERISK});
+        /*! Get a lazy range for the given query, hydrates one model at a time using
+            the forward-only query (eager loading is not supported). */
+        LazyRange<Model> cursor(const QVector<Column> &columns = {ASTERISK});
 
         /*! Get a single column's value from the first result of a query. */
         QVariant value(const Column &column);
@@ -189,6 +202,11 @@ namespace Orm::Tiny
             any previously added eager loading specifications. */
         inline Builder &withOnly(QVector<QString> &&relations);
 
+        /*! Eager load independent top-level relations concurrently, every relation
+            query runs on its own worker connection and the results are matched
+            on the calling thread. */
+        inline Builder &eagerLoadConcurrently(bool value = true) noexcept;
+
         /* Insert, Update, Delete */
         /*! Save a new model and return the instance. */
         Model create(const QVector<AttributeItem> &attributes = {});
@@ -258,6 +276,26 @@ namespace Orm::Tiny
         /*! Create a vector of models from the SqlQuery. */
         ModelsCollection<Model> hydrate(SqlQuery &&result) const;
 
+        /*! The result set layout, the same for all rows of the result set. */
+        struct ResultLayout
+        {
+            /*! Record field indexes of the hydrated columns. */
+            QVector<int> fieldIndexes;
+            /*! Hydrated column names (implicitly shared by models). */
+            QVector<QString> columns;
+            /*! Attribute positions (shared by models). */
+            AttributesHash attributesHash;
+        };
+        /*! Get the result set layout for the given record (duplicit columns are
+            skipped, only the last one is hydrated). */
+        static ResultLayout resultLayout(const QSqlRecord &record);
+
+        /* Entity cache */
+        /*! Determine whether the find() can be served from the entity cache. */
+        bool canReadEntityCache(const QVector<Column> &columns) const;
+        /*! Get the model from the entity cache (without eager loading). */
+        std::optional<Model> cachedEntity(const QVariant &id) const;
+
         /*! Get the model instance being queried. */
         inline Model &getModel() noexcept;
         /*! Get the underlying query builder instance. */
@@ -304,6 +342,22 @@ namespace Orm::Tiny
         static QVector<WithItem>::size_type
         guessParseWithRelationsSize(const QVector<WithItem> &relations);
 
+        /*! Determine whether the relations can be eager loaded concurrently. */
+        bool canEagerLoadConcurrently() const;
+        /*! Eager load the top-level relations starting at the given index
+            concurrently (every visited relation visits the next one). */
+        template<SameDerivedCollectionModel<Model> CollectionModel>
+        void eagerLoadRelationsConcurrently(
+                ModelsCollection<CollectionModel> &models,
+                QVector<WithItem>::size_type index) const;
+        /*! Eagerly load the relationship using the worker connection while
+            the following relations are visited. */
+        template<typename Relation, SameDerivedCollectionModel<Model> CollectionModel>
+        void eagerLoadRelationConcurrently(
+                Relation &relation, ModelsCollection<CollectionModel> &models,
+                const WithItem &relationItem, QVector<WithItem> &&nested,
+                std::function<void()> &&next) const;
+
         /*! Get the deeply nested relations for a given top-level relation. */
         QVector<WithItem>
         relationsNestedUnder(const QString &topRelationName) const;
@@ -327,6 +381,26 @@ namespace Orm::Tiny
         /*! Add a generic "order by" clause if the query doesn't already have one. */
         void enforceOrderBy();
 
+        /* Entity cache */
+        /*! Determine whether the query result can be stored in the entity cache. */
+        bool canFillEntityCache(const QVector<Column> &columns) const;
+        /*! Store the models in the entity cache. */
+        void putCachedEntities(const ModelsCollection<Model> &models) const;
+        /*! Remove entities modified by the update or delete query from the entity
+            cache and the identity map (only one entity if constrained by
+            the primary key). */
+        void forgetCachedEntities() const;
+        /*! Get the primary key value if the query is constrained to one model. */
+        std::optional<QVariant> getConstrainedKey() const;
+
+        /* Identity map */
+        /*! Get the identity prefix (connection, table, and columns) for the result. */
+        QString identityPrefixFor(const QSqlRecord &record) const;
+
+        /* Batched lazy loading */
+        /*! Let the models know about each other, for the batched lazy loading. */
+        static void setLazyLoadingSiblings(ModelsCollection<Model> &models);
+
         /*! Apply the given scope on the current builder instance. */
 //        template<typename ...Args>
 //        Builder &callScope(const std::function<void(Builder &, Args ...)> &scope,
@@ -341,6 +415,10 @@ namespace Orm::Tiny
         Model m_model;
         /*! The relationships that should be eager loaded. */
         QVector<WithItem> m_eagerLoad;
+        /*! Indicates whether the top-level relations are eager loaded concurrently. */
+        bool m_eagerLoadConcurrently = false;
+        /*! Visits the next relation during the concurrent eager loading. */
+        mutable std::function<void()> m_eagerLoadNext = nullptr;
 
         /*! A replacement for the typical delete function. */
         std::function<std::tuple<int, QSqlQuery>(Builder<Model> &)> m_onDelete = nullptr;
@@ -395,11 +473,73 @@ namespace Orm::Tiny
                at the end of the call tree, no need to return models. */
             eagerLoadRelations(models);
 
+        // Lazy loading of a relation on any model eager loads it for all the models
+        if (Model::usesBatchedLazyLoading() && models.size() > 1)
+            setLazyLoadingSiblings(models);
+
         return models;
         // FUTURE if I will implement custom container for the Models, this is right place to do it silverqx
 //        return getModel().newCollection(models);
     }
 
+    template<typename Model>
+    LazyRange<Model> Builder<Model>::cursor(const QVector<Column> &columns)
+    {
+        /*! State of the lazy range, the std::function callback must be copyable. */
+        struct CursorState
+        {
+            /*! Lazily fetched records. */
+            LazyRange<QSqlRecord> records;
+            /*! Model instance used to create new models. */
+            Model instance;
+            /*! Connection name of hydrated models. */
+            QString connection {};
+            /*! The result set layout, built from the first record. */
+            std::optional<ResultLayout> layout = std::nullopt;
+            /*! The current model. */
+            Model model {};
+        };
+
+        auto instance = newModelInstance();
+        auto connection = instance.getConnectionName();
+
+        auto state = std::make_shared<CursorState>(CursorState {
+                         toBase().cursor(columns), std::move(instance),
+                         std::move(connection)});
+
+        return LazyRange<Model>([state = std::move(state)]() -> Model *
+        {
+            auto *const record = state->records.next();
+
+            // No more records
+            if (record == nullptr)
+                return nullptr;
+
+            /* The record layout is the same for all rows, the column names and
+               the attribute positions are computed once, the same as the hydrate()
+               does. */
+            if (!state->layout)
+                state->layout = resultLayout(*record);
+
+            const auto &[fieldIndexes, columnNames, attributesHash] = *state->layout;
+
+            /* Populate model attributes with data from the database (one table row),
+               the vector is moved to the model that owns it, so it's allocated for
+               every row but with the exact capacity. */
+            QVector<AttributeItem> attributes;
+            attributes.reserve(columnNames.size());
+
+            for (AttributesHash::mapped_type i = 0; i < columnNames.size(); ++i)
+                attributes.append({columnNames.at(i), record->value(fieldIndexes.at(i))});
+
+            // Create a new model instance from the table row
+            state->model = state->instance.newFromBuilder(
+                               std::move(attributes), attributesHash, state->connection);
+
+            return &state->model;
+        });
+    }
+
     template<typename Model>
     QVariant Builder<Model>::value(const Column &column)
     {
@@ -514,6 +654,14 @@ namespace Orm::Tiny
     std::optional<Model>
     Builder<Model>::find(const QVariant &id, const QVector<Column> &columns)
     {
+        // Serve the model from the entity cache if possible
+        if (canReadEntityCache(columns))
+            if (auto model = cachedEntity(id); model) {
+                eagerLoadRelations(*model);
+
+                return model;
+            }
+
         return whereKey(id).first(columns);
     }
 
@@ -550,7 +698,72 @@ namespace Orm::Tiny
         if (ids.isEmpty())
             return {};
 
-        return whereKey(ids).get(columns);
+        // Cached models can't be ordered by the order by clauses
+        if (!canReadEntityCache(columns) || !m_query->getOrders().isEmpty())
+            return whereKey(ids).get(columns);
+
+        /* Serve models from the entity cache and query only the missing ones, models
+           are returned in the order of the given IDs (every model only once). */
+        QHash<QString, std::optional<Model>> modelsById;
+        modelsById.reserve(ids.size());
+
+        QSet<QString> cachedIds;
+        QVector<QVariant> missingIds;
+
+        for (const auto &id : ids) {
+            auto key = id.value<QString>();
+
+            // Duplicate ID
+            if (modelsById.contains(key))
+                continue;
+
+            auto model = cachedEntity(id);
+
+            if (model)
+                cachedIds.insert(key);
+            else
+                missingIds << id;
+
+            modelsById.insert(std::move(key), std::move(model));
+        }
+
+        if (!missingIds.isEmpty())
+            for (auto &&model : whereKey(missingIds).get(columns))
+                modelsById[model.getKey().template value<QString>()] = std::move(model);
+
+        ModelsCollection<Model> models;
+        models.reserve(ids.size());
+
+        QVector<qsizetype> cachedIndexes;
+        cachedIndexes.reserve(cachedIds.size());
+
+        for (const auto &id : ids) {
+            const auto key = id.value<QString>();
+            const auto itModel = modelsById.find(key);
+
+            // Not found or a duplicate ID
+            if (itModel == modelsById.end() || !itModel.value())
+                continue;
+
+            if (cachedIds.contains(key))
+                cachedIndexes << models.size();
+
+            models << std::move(*itModel.value());
+            itModel.value().reset();
+        }
+
+        // Load relations of cached models, queried models have them already loaded
+        if (!cachedIndexes.isEmpty()) {
+            ModelsCollection<Model *> cached;
+            cached.reserve(cachedIndexes.size());
+
+            for (const auto index : std::as_const(cachedIndexes))
+                cached << &models[index];
+
+            eagerLoadRelations(cached);
+        }
+
+        return models;
     }
 
     template<typename Model>
@@ -857,6 +1070,14 @@ namespace Orm::Tiny
         return withOnly(WithItem::fromStringVector(std::move(relations)));
     }
 
+    template<typename Model>
+    Builder<Model> &Builder<Model>::eagerLoadConcurrently(const bool value) noexcept
+    {
+        m_eagerLoadConcurrently = value;
+
+        return *this;
+    }
+
     /* Insert, Update, Delete */
 
     template<typename Model>
@@ -896,15 +1117,19 @@ namespace Orm::Tiny
     {
         auto time = m_model.freshTimestamp();
 
-        if (!column.isEmpty())
-            return toBase().update({{column, std::move(time)}});
-
         const auto &updatedAtColumn = m_model.getUpdatedAtColumn();
 
-        if (!m_model.usesTimestamps() || updatedAtColumn.isEmpty())
+        if (column.isEmpty() &&
+            (!m_model.usesTimestamps() || updatedAtColumn.isEmpty())
+        )
             return {0, std::nullopt};
 
-        return toBase().update({{updatedAtColumn, std::move(time)}});
+        auto result = toBase().update({{column.isEmpty() ? updatedAtColumn : column,
+                                        std::move(time)}});
+
+        forgetCachedEntities();
+
+        return result;
     }
 
     /* QueryBuilder proxy methods that need modifications */
@@ -913,7 +1138,11 @@ namespace Orm::Tiny
     std::tuple<int, QSqlQuery>
     Builder<Model>::update(const QVector<UpdateItem> &values)
     {
-        return toBase().update(addUpdatedAtColumn(values));
+        auto result = toBase().update(addUpdatedAtColumn(values));
+
+        forgetCachedEntities();
+
+        return result;
     }
 
     template<typename Model>
@@ -923,7 +1152,11 @@ namespace Orm::Tiny
         if (m_onDelete)
             return std::invoke(m_onDelete, *this);
 
-        return toBase().deleteRow();
+        auto result = toBase().deleteRow();
+
+        forgetCachedEntities();
+
+        return result;
     }
 
     template<typename Model>
@@ -949,8 +1182,12 @@ namespace Orm::Tiny
                     "The upsert method doesn't support an empty update argument, please "
                     "use the insert method instead.");
 
-        return toBase().upsert(addTimestampsToUpsertValues(values), uniqueBy,
-                               addUpdatedAtToUpsertColumns(update));
+        auto result = toBase().upsert(addTimestampsToUpsertValues(values), uniqueBy,
+                                      addUpdatedAtToUpsertColumns(update));
+
+        forgetCachedEntities();
+
+        return result;
     }
 
     template<typename Model>
@@ -1029,7 +1266,15 @@ namespace Orm::Tiny
     ModelsCollection<Model>
     Builder<Model>::getModels(const QVector<Column> &columns)
     {
-        return hydrate(m_query->get(columns));
+        // Must be checked before the query is executed
+        const auto fillEntityCache = canFillEntityCache(columns);
+
+        auto models = hydrate(m_query->get(columns));
+
+        if (fillEntityCache)
+            putCachedEntities(models);
+
+        return models;
     }
 
     // TODO docs add similar note for lazy load silverqx
@@ -1077,6 +1322,11 @@ namespace Orm::Tiny
         if (m_eagerLoad.isEmpty())
             return;
 
+        if (m_eagerLoadConcurrently && canEagerLoadConcurrently()) {
+            eagerLoadRelationsConcurrently(models, 0);
+            return;
+        }
+
         for (const auto &relation : std::as_const(m_eagerLoad))
             /* For nested eager loads we'll skip loading them here and they will be
                loaded later using the nested query which retrieves this nested relations,
@@ -1122,12 +1372,24 @@ namespace Orm::Tiny
            ordering (where, orderBy, and maybe more). */
         auto nested = relationsNestedUnder(relationItem.name);
 
+        // Visited from the eagerLoadRelationsConcurrently()
+        if (m_eagerLoadNext) {
+            eagerLoadRelationConcurrently(relation, models, relationItem,
+                                          std::move(nested),
+                                          std::exchange(m_eagerLoadNext, nullptr));
+            return;
+        }
+
         /* If there are nested relationships set on this query, we will put those onto
            the relation's query instance so they can be handled after this relationship
            is loaded. In this way they will all trickle down as they are loaded. */
         if (nested.size() > 0)
             relation->getQuery().with(std::move(nested));
 
+        // Cached models can't be filtered by the user defined constraints
+        if (relationItem.constraints)
+            relation->withoutEntityCache();
+
         relation->addEagerConstraints(models);
 
         // Add relation constraints defined in the user callback
@@ -1152,24 +1414,143 @@ namespace Orm::Tiny
         models.reserve(static_cast<decltype (models)::size_type>(
                            QueryUtils::queryResultSize(result)));
 
-        const auto fieldsCount = result.record().count();
+        /* The record layout is the same for all rows, the column names and
+           the attribute positions (the result shape) are shared by all the hydrated
+           models (implicitly shared). */
+        const auto record = result.record();
 
-        while (result.next()) {
+        const auto layout = resultLayout(record);
+        const auto &fieldIndexes = layout.fieldIndexes;
+        const auto &columns = layout.columns;
+        const auto &attributesHash = layout.attributesHash;
+
+        const auto connection = instance.getConnectionName();
+
+        const auto makeModel = [&instance, &result, &fieldIndexes, &columns,
+                                &attributesHash, &connection]
+        {
             QVector<AttributeItem> row;
-            row.reserve(fieldsCount);
+            row.reserve(columns.size());
 
             // Populate model attributes with data from the database (one table row)
-            const auto record = result.record();
-            for (int i = 0; i < record.count(); ++i)
-                row.append({record.fieldName(i), result.value(i)});
+            for (AttributesHash::mapped_type i = 0; i < columns.size(); ++i)
+                row.append({columns.at(i), result.value(fieldIndexes.at(i))});
 
             // Create a new model instance from the table row
-            models << instance.newFromBuilder(std::move(row));
+            return instance.newFromBuilder(std::move(row), attributesHash, connection);
+        };
+
+        /* Models with the same identity are hydrated only once in the identity map
+           scope, the key column is ambiguous if the query contains joins. */
+        auto *const identityMap = IdentityMap::current();
+        const auto keyIndex = identityMap != nullptr && m_query->getJoins().isEmpty()
+                              ? record.indexOf(m_model.getKeyName())
+                              : -1;
+
+        if (keyIndex == -1) {
+            while (result.next())
+                models << makeModel();
+
+            return models;
+        }
+
+        const auto identityPrefix = identityPrefixFor(record);
+
+        while (result.next()) {
+            const auto key = result.value(keyIndex);
+
+            if (key.isNull()) {
+                models << makeModel();
+                continue;
+            }
+
+            auto identity = identityPrefix + key.toString();
+
+            if (const auto *const model = identityMap->get<Model>(identity);
+                model != nullptr
+            )
+                models << *model;
+            else
+                models << identityMap->put<Model>(identity, makeModel());
         }
 
         return models;
     }
 
+    template<typename Model>
+    typename Builder<Model>::ResultLayout
+    Builder<Model>::resultLayout(const QSqlRecord &record)
+    {
+        /* Only the last duplicit column is hydrated (the same as the removeDuplicitKeys()
+           does), so the record is looped in the reverse order. */
+        QVector<int> fieldIndexes;
+        fieldIndexes.reserve(record.count());
+        std::unordered_set<QString> added(static_cast<std::size_t>(record.count()));
+
+        for (auto i = record.count() - 1; i >= 0; --i)
+            if (added.insert(record.fieldName(i)).second)
+                fieldIndexes.prepend(i);
+
+        QVector<QString> columns;
+        columns.reserve(fieldIndexes.size());
+        AttributesHash attributesHash;
+        attributesHash.reserve(static_cast<AttributesHash::size_type>(
+                                   fieldIndexes.size()));
+
+        for (const auto fieldIndex : std::as_const(fieldIndexes)) {
+            attributesHash.emplace(record.fieldName(fieldIndex), columns.size());
+            columns << record.fieldName(fieldIndex);
+        }
+
+        return {std::move(fieldIndexes), std::move(columns), std::move(attributesHash)};
+    }
+
+    /* Entity cache */
+
+    template<typename Model>
+    bool Builder<Model>::canReadEntityCache(const QVector<Column> &columns) const
+    {
+        if (!canFillEntityCache(columns))
+            return false;
+
+        // Cached models can't satisfy any additional constraints
+        if (!m_query->getWheres().isEmpty() || !m_query->getGroups().isEmpty() ||
+            !m_query->getHavings().isEmpty() || m_query->getOffset() > 0 ||
+            !std::holds_alternative<std::monostate>(m_query->getLock())
+        )
+            return false;
+
+        if constexpr (m_extendsSoftDeletes)
+            return this->currentSoftDeletes() != this->OnlyTrashed;
+        else
+            return true;
+    }
+
+    template<typename Model>
+    std::optional<Model> Builder<Model>::cachedEntity(const QVariant &id) const
+    {
+        auto attributes = Cache::EntityCache::instance().get(
+                              m_query->getConnection().getName(), m_model.getTable(),
+                              id);
+
+        if (!attributes)
+            return std::nullopt;
+
+        // Trashed models are excluded by the default soft deletes constraint
+        if constexpr (m_extendsSoftDeletes)
+            if (this->m_withSoftDeletes &&
+                this->currentSoftDeletes() == this->WithoutTrashed
+            ) {
+                const auto &deletedAtColumn = Model::getDeletedAtColumn();
+
+                for (const auto &attribute : std::as_const(*attributes))
+                    if (attribute.key == deletedAtColumn && !attribute.value.isNull())
+                        return std::nullopt;
+            }
+
+        return newModelInstance().newFromBuilder(std::move(*attributes));
+    }
+
     template<typename Model>
     Model &Builder<Model>::getModel() noexcept
     {
@@ -1409,6 +1790,138 @@ namespace Orm::Tiny
         return size;
     }
 
+    template<typename Model>
+    bool Builder<Model>::canEagerLoadConcurrently() const
+    {
+        // Nothing to run concurrently
+        if (std::ranges::count_if(m_eagerLoad, [](const WithItem &relation)
+        {
+            return !relation.name.contains(DOT);
+        }) < 2)
+            return false;
+
+        return m_query->canUseWorkerConnections();
+    }
+
+    template<typename Model>
+    template<SameDerivedCollectionModel<Model> CollectionModel>
+    void Builder<Model>::eagerLoadRelationsConcurrently(
+            ModelsCollection<CollectionModel> &models,
+            QVector<WithItem>::size_type index) const
+    {
+        // Nested relations are loaded by the relation query of their parent
+        while (index < m_eagerLoad.size() && m_eagerLoad.at(index).name.contains(DOT))
+            ++index;
+
+        // Nothing to load
+        if (index >= m_eagerLoad.size())
+            return;
+
+        /* Visiting the following relations from inside of the visited relation keeps
+           the relation instance and its dummy parent model alive until the relation
+           query in the worker thread finishes. */
+        m_eagerLoadNext = [this, &models, index]
+        {
+            eagerLoadRelationsConcurrently(models, index + 1);
+        };
+
+        m_model.eagerLoadRelationWithVisitor(m_eagerLoad.at(index), *this, models);
+    }
+
+    template<typename Model>
+    template<typename Relation, SameDerivedCollectionModel<Model> CollectionModel>
+    void Builder<Model>::eagerLoadRelationConcurrently(
+            Relation &relation, ModelsCollection<CollectionModel> &models,
+            const WithItem &relationItem, QVector<WithItem> &&nested,
+            std::function<void()> &&next) const
+    {
+        // Cached models can't be filtered by the user defined constraints
+        if (relationItem.constraints)
+            relation->withoutEntityCache();
+
+        relation->addEagerConstraints(models);
+
+        // Add relation constraints defined in the user callback
+        if (relationItem.constraints)
+            std::invoke(relationItem.constraints, relation->getBaseQuery());
+
+        auto &query = relation->getQuery();
+        const auto originalQuery = query.m_query;
+        const auto connectionName = originalQuery->getConnection().getName();
+
+        auto &manager = DatabaseManager::reference();
+
+        /* Relations of the related model (eg. the u_with) would be loaded in the worker
+           thread using the worker connection, they are loaded below together with
+           the nested relations, so they are loaded only once. */
+        auto relatedEagerLoad = std::exchange(query.m_eagerLoad, {});
+
+        const auto restoreQuery = [&query, &originalQuery, &relatedEagerLoad]
+        {
+            query.m_query = originalQuery;
+            query.m_eagerLoad = std::move(relatedEagerLoad);
+        };
+        // Restore the relation query also if the next() or the worker throws
+        auto queryGuard = qScopeGuard(restoreQuery);
+
+        std::remove_cvref_t<decltype (relation->getEager())> results;
+        std::exception_ptr exception;
+
+        std::thread worker([&, workerConnection = manager.addWorkerConnection(
+                                                      connectionName)]
+        {
+            try {
+                // The worker connection must be created in the thread that uses it
+                query.m_query = std::make_shared<QueryBuilder>(
+                                    originalQuery->cloneOnConnection(
+                                        manager.workerConnection(workerConnection)
+                                        .shared_from_this()));
+
+                results = relation->getEager();
+
+                // Hydrated models would reference the removed worker connection
+                for (auto &model : results)
+                    model.setConnection(connectionName);
+
+            } catch (...) {
+                exception = std::current_exception();
+            }
+
+            // The worker query must be destroyed before its connection
+            query.m_query = originalQuery;
+
+            manager.removeWorkerConnection(workerConnection);
+        });
+
+        // Visit the following relations while this relation is being queried
+        try {
+            std::invoke(next);
+        } catch (...) {
+            worker.join();
+            throw;
+        }
+
+        worker.join();
+
+        // Nested relations below are added to the restored relation query
+        queryGuard.dismiss();
+        restoreQuery();
+
+        // Re-throw the exception thrown in the worker thread
+        if (exception)
+            std::rethrow_exception(exception);
+
+        /* Nested relations are loaded after their parent on the calling thread, they
+           are loaded using the current connection. */
+        if (!nested.isEmpty())
+            query.with(std::move(nested));
+
+        query.eagerLoadRelations(results);
+
+        relation->match(relation->initRelation(models, relationItem.name),
+                        std::move(results), relationItem.name);
+    }
+
     template<typename Model>
     QVector<WithItem>
     Builder<Model>::relationsNestedUnder(const QString &topRelationName) const
@@ -1571,6 +2084,137 @@ namespace Orm::Tiny
         this->orderBy(m_model.getQualifiedKeyName(), ASC);
     }
 
+    /* Entity cache */
+
+    template<typename Model>
+    bool Builder<Model>::canFillEntityCache(const QVector<Column> &columns) const
+    {
+        /* Rows read inside a transaction can contain uncommitted changes that would
+           stay cached after the rollBack(), and cached rows can be stale. */
+        if (!Model::usesEntityCache() || m_query->getConnection().inTransaction())
+            return false;
+
+        // Only whole rows of the model's table can be cached
+        static const auto isAsterisk = [](const QVector<Column> &columns_)
+        {
+            return columns_.size() == 1 &&
+                   std::holds_alternative<QString>(columns_.constFirst()) &&
+                   std::get<QString>(columns_.constFirst()) == ASTERISK;
+        };
+
+        const auto &queryColumns = m_query->getColumns();
+        const auto &from = m_query->getFrom();
+
+        return (queryColumns.isEmpty() ? isAsterisk(columns)
+                                       : isAsterisk(queryColumns)) &&
+                m_query->getJoins().isEmpty() && !m_query->getAggregate() &&
+                std::holds_alternative<QString>(from) &&
+                std::get<QString>(from) == m_model.getTable();
+    }
+
+    template<typename Model>
+    void
+    Builder<Model>::putCachedEntities(const ModelsCollection<Model> &models) const
+    {
+        auto &cache = Cache::EntityCache::instance();
+
+        const auto &connection = m_query->getConnection().getName();
+        const auto &table = m_model.getTable();
+
+        for (const auto &model : models)
+            if (auto key = model.getKey(); key.isValid() && !key.isNull())
+                cache.put(connection, table, key, model.getRawAttributes());
+    }
+
+    template<typename Model>
+    void Builder<Model>::forgetCachedEntities() const
+    {
+        auto *const identityMap = IdentityMap::current();
+        auto &cache = Cache::EntityCache::instance();
+
+        // Nothing to do
+        if (identityMap == nullptr && cache.isEmpty())
+            return;
+
+        const auto key = getConstrainedKey();
+
+        // The following queries in the identity map scope must hydrate fresh models
+        if (identityMap != nullptr)
+            identityMap->template forget<Model>(key);
+
+        if (cache.isEmpty())
+            return;
+
+        const auto &connection = m_query->getConnection().getName();
+        const auto &table = m_model.getTable();
+
+        if (key)
+            cache.forget(connection, table, *key);
+        else
+            cache.forgetTable(connection, table);
+    }
+
+    template<typename Model>
+    std::optional<QVariant> Builder<Model>::getConstrainedKey() const
+    {
+        const auto &keyName = m_model.getKeyName();
+        const auto qualifiedKeyName = m_model.getQualifiedKeyName();
+
+        std::optional<QVariant> key;
+
+        for (const auto &where : m_query->getWheres()) {
+            // Any OR condition can affect other rows
+            if (where.condition.compare(AND, Qt::CaseInsensitive) != 0)
+                return std::nullopt;
+
+            if (where.type != WhereType::BASIC || where.comparison != EQ ||
+                !std::holds_alternative<QString>(where.column)
+            )
+                continue;
+
+            if (const auto &column = std::get<QString>(where.column);
+                column == keyName || column == qualifiedKeyName
+            )
+                key = where.value;
+        }
+
+        return key;
+    }
+
+    /* Identity map */
+
+    template<typename Model>
+    QString Builder<Model>::identityPrefixFor(const QSqlRecord &record) const
+    {
+        // Models with different columns can't be interchanged
+        QStringList columns;
+        columns.reserve(record.count());
+
+        for (int i = 0; i < record.count(); ++i)
+            columns << record.fieldName(i);
+
+        return QStringLiteral("%1\n%2\n%3\n").arg(m_query->getConnection().getName(),
+                                                 m_model.getTable(),
+                                                 columns.join(COMMA_C));
+    }
+
+    /* Batched lazy loading */
+
+    template<typename Model>
+    void Builder<Model>::setLazyLoadingSiblings(ModelsCollection<Model> &models)
+    {
+        auto siblings = std::make_shared<typename Model::LazyLoadingSiblings>();
+        siblings->attributes.reserve(models.size());
+
+        // Only attributes are kept, they are implicitly shared with the models
+        for (const auto &model : std::as_const(models))
+            if (const auto key = model.getKey(); key.isValid() && !key.isNull())
+                siblings->attributes.insert(key.toString(), model.getRawAttributes());
+
+        for (auto &model : models)
+            model.m_lazyLoadingSiblings = siblings;
+    }
+
     // FEATURE scopes, anyway std::apply() do the same, will have to investigate it silverqx
 //    template<typename Model>
 //    template<typename ...Args>
@@ -127,6 +127,9 @@ namespace Tiny
         /*! Insert a new record and get the value of the primary key. */
         quint64 insertGetId(const QVector<AttributeItem> &values,
                             const QString &sequence = "") const;
+        /*! Insert new records (multi-rows insert) and get values of primary keys. */
+        QVector<quint64> insertGetIds(const QVector<QVector<AttributeItem>> &values,
+                                      const QString &sequence = "") const;
 
         /*! Insert a new record into the database while ignoring errors. */
         std::tuple<int, std::optional<QSqlQuery>>
@@ -671,6 +674,13 @@ namespace Tiny
         /*! Lock the selected rows in the table. */
         TinyBuilder<Model> &lock(QString &&value);
 
+        /* Query cache */
+        /*! Cache results of the select query for the given time, the cache is
+            invalidated when the tables in the from and joins clauses are modified. */
+        TinyBuilder<Model> &remember(std::chrono::milliseconds ttl);
+        /*! Don't cache results of the select query. */
+        TinyBuilder<Model> &dontRemember();
+
         /* Others proxy methods, not added to the Model and Relation */
         /*! Add an "exists" clause to the query. */
         TinyBuilder<Model> &
@@ -833,7 +843,12 @@ namespace Tiny
     BuilderProxies<Model>::increment(
             const QString &column, const T amount, const QVector<UpdateItem> &extra)
     {
-        return toBase().increment(column, amount, builder().addUpdatedAtColumn(extra));
+        auto result = toBase().increment(column, amount,
+                                         builder().addUpdatedAtColumn(extra));
+
+        builder().forgetCachedEntities();
+
+        return result;
     }
 
     template<typename Model>
@@ -842,7 +857,12 @@ namespace Tiny
     BuilderProxies<Model>::decrement(
             const QString &column, const T amount, const QVector<UpdateItem> &extra)
     {
-        return toBase().decrement(column, amount, builder().addUpdatedAtColumn(extra));
+        auto result = toBase().decrement(column, amount,
+                                         builder().addUpdatedAtColumn(extra));
+
+        builder().forgetCachedEntities();
+
+        return result;
     }
 
     /* Insert, Update, Delete */
@@ -881,6 +901,15 @@ namespace Tiny
                                       sequence);
     }
 
+    template<typename Model>
+    QVector<quint64>
+    BuilderProxies<Model>::insertGetIds(const QVector<QVector<AttributeItem>> &values,
+                                        const QString &sequence) const
+    {
+        return getQuery().insertGetIds(AttributeUtils::convertVectorsToMaps(values),
+                                       sequence);
+    }
+
     template<typename Model>
     std::tuple<int, std::optional<QSqlQuery>>
     BuilderProxies<Model>::insertOrIgnore(const QVector<AttributeItem> &values) const
@@ -908,20 +937,30 @@ namespace Tiny
     std::tuple<int, QSqlQuery> BuilderProxies<Model>::forceDelete() const
     {
         // Skip applying SoftDeletes (getQuery()) to actually delete
-        return getQuery().remove();
+        auto result = getQuery().remove();
+
+        builder().forgetCachedEntities();
+
+        return result;
     }
 
     template<typename Model>
     std::tuple<int, QSqlQuery> BuilderProxies<Model>::forceRemove() const
     {
         // Skip applying SoftDeletes (getQuery()) to actually delete
-        return getQuery().remove();
+        auto result = getQuery().remove();
+
+        builder().forgetCachedEntities();
+
+        return result;
     }
 
     template<typename Model>
     void BuilderProxies<Model>::truncate() const
     {
         getQuery().truncate();
+
+        builder().forgetCachedEntities();
     }
 
     /* Select */
@@ -2244,6 +2283,23 @@ namespace Tiny
         return builder();
     }
 
+    /* Query cache */
+
+    template<typename Model>
+    TinyBuilder<Model> &
+    BuilderProxies<Model>::remember(const std::chrono::milliseconds ttl)
+    {
+        getQuery().remember(ttl);
+        return builder();
+    }
+
+    template<typename Model>
+    TinyBuilder<Model> &BuilderProxies<Model>::dontRemember()
+    {
+        getQuery().dontRemember();
+        return builder();
+    }
+
     /* Others proxy methods, not added to the Model and Relation */
 
     template<typename Model>
@@ -12,8 +12,15 @@ TINY_SYSTEM_HEADER
 
 #include "orm/macros/commonnamespace.hpp"
 
+class QCborStreamWriter;
+
 TINYORM_BEGIN_COMMON_NAMESPACE
 
+namespace Orm::Types
+{
+    class JsonWriter;
+}
+
 namespace Orm::Tiny
 {
 
@@ -53,10 +60,13 @@ namespace Orm::Tiny
 
     struct AttributeItem;
 
-    /*! Concept to check the container for serialized model attributes. */
+    /*! Concept to check the container for serialized model attributes (or the JSON
+        and CBOR writers for the streaming serialization). */
     template<typename C>
     concept SerializedAttributes = std::same_as<C, QVariantMap> ||
-                                   std::same_as<C, QVector<AttributeItem>>;
+                                   std::same_as<C, QVector<AttributeItem>> ||
+                                   std::same_as<C, Types::JsonWriter> ||
+                                   std::same_as<C, QCborStreamWriter>;
 
     /* Others */
     template<typename C>
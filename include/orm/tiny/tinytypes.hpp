@@ -208,6 +208,19 @@ namespace Concerns
     using QueriesRelationshipsCallback =
             std::conditional_t<std::is_void_v<Related>, QueryBuilder,
                                TinyBuilder<Related>>;
+
+    /*! Relationship aggregate selected by the withAggregate() related methods. */
+    struct RelationAggregate
+    {
+        /*! Relation name. */
+        QString relation;
+        /*! Column to aggregate. */
+        QString column;
+        /*! Aggregate function (count, sum, min, max, avg, or exists). */
+        QString function;
+        /*! Alias of the selected aggregate. */
+        QString alias;
+    };
 } // namespace Concerns
 } // namespace Tiny
 
@@ -0,0 +1,234 @@
+#pragma once
+#ifndef ORM_TINY_TYPES_ATTRIBUTESHASH_HPP
+#define ORM_TINY_TYPES_ATTRIBUTESHASH_HPP
+
+#include "orm/macros/systemheader.hpp"
+TINY_SYSTEM_HEADER
+
+#include <QSharedData>
+
+#include <unordered_map>
+
+#include "orm/tiny/tinytypes.hpp"
+
+TINYORM_BEGIN_COMMON_NAMESPACE
+
+namespace Orm::Tiny
+{
+namespace Types
+{
+
+    /*! Implicitly shared attribute positions hash (the attribute key to its position
+        in the attributes vector), models hydrated from the same result share
+        one instance (the result shape) until one of them is modified. */
+    class AttributesHash
+    {
+    public:
+        /* Container related */
+        using key_type       = QString;
+        using mapped_type    = typename QVector<AttributeItem>::size_type;
+        using ContainerType  = std::unordered_map<key_type, mapped_type>;
+        /* Iterators related */
+        using const_iterator = typename ContainerType::const_iterator;
+        using size_type      = typename ContainerType::size_type;
+
+        /*! Default constructor. */
+        inline AttributesHash() = default;
+        /*! Converting constructor from the std::unordered_map. */
+        inline AttributesHash(ContainerType hash); // NOLINT(google-explicit-constructor)
+        /*! Default destructor. */
+        inline ~AttributesHash() = default;
+
+        /*! Copy constructor. */
+        inline AttributesHash(const AttributesHash &) = default;
+        /*! Copy assignment operator. */
+        inline AttributesHash &operator=(const AttributesHash &) = default;
+        /*! Move constructor. */
+        inline AttributesHash(AttributesHash &&) noexcept = default;
+        /*! Move assignment operator. */
+        inline AttributesHash &operator=(AttributesHash &&) noexcept = default;
+
+        /*! Converting operator to the std::unordered_map (no copy is made). */
+        inline operator const ContainerType &() const noexcept; // NOLINT(google-explicit-constructor)
+        /*! Get the underlying std::unordered_map (no copy is made). */
+        inline const ContainerType &hash() const noexcept;
+
+        /*! Determine whether the hash is shared with another model. */
+        inline bool isShared() const noexcept;
+
+        /* std::unordered_map proxy methods */
+        /*! Returns an iterator to the beginning. */
+        inline const_iterator begin() const noexcept;
+        /*! Returns an iterator to the end. */
+        inline const_iterator end() const noexcept;
+
+        /*! Returns the number of elements. */
+        inline size_type size() const noexcept;
+        /*! Checks whether the container is empty. */
+        inline bool empty() const noexcept;
+
+        /*! Access specified element with bounds checking. */
+        inline mapped_type at(const key_type &key) const;
+        /*! Finds element with specific key. */
+        inline const_iterator find(const key_type &key) const;
+        /*! Checks if the container contains element with specific key. */
+        inline bool contains(const key_type &key) const;
+
+        /* Modifiers (detach if shared) */
+        /*! Access or insert specified element. */
+        inline mapped_type &operator[](const key_type &key);
+        /*! Inserts a new element into the container. */
+        inline bool emplace(const key_type &key, mapped_type position);
+        /*! Erases the element with the given key. */
+        inline size_type erase(const key_type &key);
+        /*! Clears the contents (releases the shared data). */
+        inline void clear() noexcept;
+        /*! Reserves space for at least the specified number of elements. */
+        inline void reserve(size_type count);
+
+        /* Comparison */
+        /*! Equality comparison operator for the AttributesHash. */
+        inline bool operator==(const AttributesHash &right) const;
+
+    private:
+        /*! Implicitly shared data. */
+        struct Data : public QSharedData
+        {
+            /*! The attribute positions. */
+            ContainerType hash;
+        };
+
+        /*! Get the detached data for modification. */
+        inline ContainerType &detached();
+        /*! Get an empty hash (for the null data). */
+        inline static const ContainerType &emptyHash() noexcept;
+
+        /*! Implicitly shared data (nullptr if empty). */
+        QSharedDataPointer<Data> d;
+    };
+
+    /* public */
+
+    AttributesHash::AttributesHash(ContainerType hash)
+    {
+        if (!hash.empty())
+            detached() = std::move(hash);
+    }
+
+    AttributesHash::operator const ContainerType &() const noexcept
+    {
+        return hash();
+    }
+
+    const AttributesHash::ContainerType &AttributesHash::hash() const noexcept
+    {
+        return d ? d->hash : emptyHash();
+    }
+
+    bool AttributesHash::isShared() const noexcept
+    {
+        return d && d->ref.loadRelaxed() > 1;
+    }
+
+    /* std::unordered_map proxy methods */
+
+    AttributesHash::const_iterator AttributesHash::begin() const noexcept
+    {
+        return hash().cbegin();
+    }
+
+    AttributesHash::const_iterator AttributesHash::end() const noexcept
+    {
+        return hash().cend();
+    }
+
+    AttributesHash::size_type AttributesHash::size() const noexcept
+    {
+        return hash().size();
+    }
+
+    bool AttributesHash::empty() const noexcept
+    {
+        return hash().empty();
+    }
+
+    AttributesHash::mapped_type AttributesHash::at(const key_type &key) const
+    {
+        return hash().at(key);
+    }
+
+    AttributesHash::const_iterator AttributesHash::find(const key_type &key) const
+    {
+        return hash().find(key);
+    }
+
+    bool AttributesHash::contains(const key_type &key) const
+    {
+        return hash().contains(key);
+    }
+
+    /* Modifiers (detach if shared) */
+
+    AttributesHash::mapped_type &AttributesHash::operator[](const key_type &key)
+    {
+        return detached()[key];
+    }
+
+    bool AttributesHash::emplace(const key_type &key, const mapped_type position)
+    {
+        return detached().emplace(key, position).second;
+    }
+
+    AttributesHash::size_type AttributesHash::erase(const key_type &key)
+    {
+        // Don't detach if there is nothing to erase
+        if (!contains(key))
+            return 0;
+
+        return detached().erase(key);
+    }
+
+    void AttributesHash::clear() noexcept
+    {
+        d = QSharedDataPointer<Data>();
+    }
+
+    void AttributesHash::reserve(const size_type count)
+    {
+        detached().reserve(count);
+    }
+
+    /* Comparison */
+
+    bool AttributesHash::operator==(const AttributesHash &right) const
+    {
+        return d == right.d || hash() == right.hash();
+    }
+
+    /* private */
+
+    AttributesHash::ContainerType &AttributesHash::detached()
+    {
+        if (!d)
+            d = new Data;
+
+        // The non-const operator->() detaches if shared
+        return d->hash;
+    }
+
+    const AttributesHash::ContainerType &AttributesHash::emptyHash() noexcept
+    {
+        static const ContainerType cached;
+
+        return cached;
+    }
+
+} // namespace Types
+
+    using AttributesHash = Tiny::Types::AttributesHash;
+
+} // namespace Orm::Tiny
+
+TINYORM_END_COMMON_NAMESPACE
+
+#endif // ORM_TINY_TYPES_ATTRIBUTESHASH_HPP
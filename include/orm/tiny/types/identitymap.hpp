@@ -0,0 +1,170 @@
+#pragma once
+#ifndef ORM_TINY_TYPES_IDENTITYMAP_HPP
+#define ORM_TINY_TYPES_IDENTITYMAP_HPP
+
+#include "orm/macros/systemheader.hpp"
+TINY_SYSTEM_HEADER
+
+#include <QHash>
+#include <QVariant>
+
+#include <memory>
+#include <optional>
+#include <typeindex>
+#include <unordered_map>
+
+#include "orm/macros/commonnamespace.hpp"
+#include "orm/macros/threadlocal.hpp"
+
+TINYORM_BEGIN_COMMON_NAMESPACE
+
+namespace Orm::Tiny
+{
+namespace Types
+{
+
+    /*! Identity map scope (RAII), while an instance is alive the models hydrated
+        on the current thread are created only once for the same model type,
+        connection, table, columns, and primary key, the following rows are copies
+        of this instance, so they share the implicitly shared attributes instead of
+        allocating them again (scopes can be nested, the innermost one is used).
+        Queries with joins bypass the identity map because the primary key column
+        is ambiguous, and models modified by the update or delete queries are
+        removed from it, so the following queries hydrate them again. */
+    class IdentityMap
+    {
+        Q_DISABLE_COPY_MOVE(IdentityMap)
+
+    public:
+        /*! Default constructor (activates the identity map on the current thread). */
+        inline IdentityMap() noexcept;
+        /*! Destructor (activates the previous identity map on the current thread). */
+        inline ~IdentityMap();
+
+        /*! Get the innermost identity map on the current thread or nullptr. */
+        inline static IdentityMap *current() noexcept;
+
+        /*! Get the model for the given identity or nullptr if not found. */
+        template<typename Model>
+        const Model *get(const QString &identity) const;
+        /*! Store the model for the given identity. */
+        template<typename Model>
+        const Model &put(const QString &identity, Model &&model);
+        /*! Remove models with the given primary key (all models of the given type
+            if the key is std::nullopt) from this and all outer identity maps. */
+        template<typename Model>
+        void forget(const std::optional<QVariant> &key = std::nullopt);
+
+        /*! Get the number of models in the identity map. */
+        inline std::size_t size() const noexcept;
+        /*! Remove all models from the identity map. */
+        inline void clear() noexcept;
+
+    private:
+        /*! Models by the identity. */
+        using ModelsHash = QHash<QString, std::shared_ptr<const void>>;
+
+        /*! Models by the model type and identity. */
+        std::unordered_map<std::type_index, ModelsHash> m_models;
+        /*! The identity map that was active before this one. */
+        IdentityMap *m_previous;
+
+        /*! The innermost identity map on the current thread. */
+        T_THREAD_LOCAL
+        inline static IdentityMap *m_current = nullptr;
+    };
+
+    /* public */
+
+    IdentityMap::IdentityMap() noexcept
+        : m_previous(m_current)
+    {
+        m_current = this;
+    }
+
+    IdentityMap::~IdentityMap()
+    {
+        m_current = m_previous;
+    }
+
+    IdentityMap *IdentityMap::current() noexcept
+    {
+        return m_current;
+    }
+
+    template<typename Model>
+    const Model *IdentityMap::get(const QString &identity) const
+    {
+        const auto itModels = m_models.find(typeid (Model));
+
+        if (itModels == m_models.cend())
+            return nullptr;
+
+        const auto itModel = itModels->second.constFind(identity);
+
+        if (itModel == itModels->second.cend())
+            return nullptr;
+
+        return static_cast<const Model *>(itModel->get());
+    }
+
+    template<typename Model>
+    const Model &IdentityMap::put(const QString &identity, Model &&model)
+    {
+        auto modelShared = std::make_shared<const Model>(std::move(model));
+        const auto &modelRef = *modelShared;
+
+        m_models[typeid (Model)].insert(identity, std::move(modelShared));
+
+        return modelRef;
+    }
+
+    template<typename Model>
+    void IdentityMap::forget(const std::optional<QVariant> &key)
+    {
+        if (const auto itModels = m_models.find(typeid (Model));
+            itModels != m_models.end()
+        ) {
+            if (key) {
+                // The identity ends with the primary key
+                const QString keySuffix = QLatin1Char('\n') + key->toString();
+                auto &models = itModels->second;
+
+                for (auto itModel = models.begin(); itModel != models.end();)
+                    if (itModel.key().endsWith(keySuffix))
+                        itModel = models.erase(itModel);
+                    else
+                        ++itModel;
+            }
+            else
+                m_models.erase(itModels);
+        }
+
+        if (m_previous != nullptr)
+            m_previous->forget<Model>(key);
+    }
+
+    std::size_t IdentityMap::size() const noexcept
+    {
+        std::size_t size = 0;
+
+        for (const auto &models : m_models)
+            size += static_cast<std::size_t>(models.second.size());
+
+        return size;
+    }
+
+    void IdentityMap::clear() noexcept
+    {
+        m_models.clear();
+    }
+
+} // namespace Types
+
+    using IdentityMap = Tiny::Types::IdentityMap;
+
+} // namespace Orm::Tiny
+
+TINYORM_END_COMMON_NAMESPACE
+
+#endif // ORM_TINY_TYPES_IDENTITYMAP_HPP
@@ -8,6 +8,8 @@ TINY_SYSTEM_HEADER
 #include <QJsonArray>
 #include <QJsonDocument>
 
+#include <numeric>
+#include <thread>
 #include <unordered_map>
 
 #include <range/v3/action/erase.hpp>
@@ -18,7 +20,11 @@ TINY_SYSTEM_HEADER
 #include <range/v3/view/transform.hpp>
 
 #include "orm/exceptions/invalidargumenterror.hpp"
+#include "orm/tiny/types/modelskeyindex.hpp"
 #include "orm/tiny/utils/attribute.hpp"
+#include "orm/types/jsonwriter.hpp"
+#include "orm/utils/cbor.hpp"
+#include "orm/utils/threadpool.hpp"
 #include "orm/utils/type.hpp"
 
 TINYORM_BEGIN_COMMON_NAMESPACE
@@ -84,6 +90,12 @@ namespace Types
         constexpr static auto IsPointersCollection = std::is_pointer_v<Model>;
         /*! The base class type (used as the storage container). */
         using StorageType     = QVector<Model>;
+        /*! The minimum number of models processed by one thread in the parallel
+            methods (smaller collections are processed in the calling thread). */
+        constexpr static auto ParallelChunkSize = 1024;
+        /*! The minimum number of models for the parallel sort in the sortBy() and
+            stableSortBy() methods (smaller collections are sorted serially). */
+        constexpr static auto ParallelSortMinSize = 16384;
 
         using value_type      = typename StorageType::value_type;
         using pointer         = typename StorageType::pointer;
@@ -263,6 +275,13 @@ namespace Types
         template<typename K, typename V>
         std::unordered_map<K, V>
         mapWithKeys(const std::function<std::pair<K, V>(ModelRawType *)> &callback);
+        /*! Key the models by the given column (the index for repeated lookups,
+            the first model wins for duplicate values). */
+        template<typename T>
+        std::unordered_map<T, ModelRawType *> keyBy(const QString &column);
+        /*! Get the primary key index for repeated find() lookups (the snapshot,
+            obtain it again after this collection is modified). */
+        ModelsKeyIndex<ModelRawType> keyIndex();
 
         /*! Return only the models from the collection with specified primary keys. */
         ModelsCollection<ModelRawType *> only(const std::unordered_set<KeyType> &ids);
@@ -329,6 +348,12 @@ namespace Types
         ModelsCollection<ModelRawType *>
         sortByDesc(const QString &column);
 
+        /*! Sort the collection by the given columns (multi-columns sorting,
+            the T types are the column types). */
+        template<typename ...T> requires (sizeof...(T) > 1)
+        ModelsCollection<ModelRawType *>
+        sortBy(const QStringList &columns, bool descending = false);
+
         /*! Sort the collection by the given callback (supports multi-columns sorting). */
         ModelsCollection<ModelRawType *>
         sortBy(const QVector<std::function<
@@ -363,6 +388,12 @@ namespace Types
         ModelsCollection<ModelRawType *>
         stableSortByDesc(const QString &column);
 
+        /*! Stable sort the collection by the given columns (multi-columns sorting,
+            the T types are the column types). */
+        template<typename ...T> requires (sizeof...(T) > 1)
+        ModelsCollection<ModelRawType *>
+        stableSortBy(const QStringList &columns, bool descending = false);
+
         /*! Sort the collection by the given callback (supports multi-columns sorting). */
         ModelsCollection<ModelRawType *>
         stableSortBy(const QVector<std::function<
@@ -457,6 +488,33 @@ namespace Types
         inline QByteArray
         toJson(QJsonDocument::JsonFormat format = QJsonDocument::Compact) const;
 
+        /*! Write a collection as compact JSON to the writer (streaming). */
+        template<typename PivotType = void> // PivotType is primarily internal
+        void writeJson(JsonWriter &writer) const;
+        /*! Write a collection as compact JSON to the device (streaming). */
+        template<typename PivotType = void> // PivotType is primarily internal
+        void writeJson(QIODevice &device) const;
+        /*! Append a collection as compact JSON to the buffer (streaming). */
+        template<typename PivotType = void> // PivotType is primarily internal
+        void writeJson(QByteArray &buffer) const;
+
+        /*! Write a collection to the CBOR writer (raw attributes with native types
+            and all loaded relations). */
+        template<typename PivotType = void> // PivotType is primarily internal
+        void writeCbor(QCborStreamWriter &writer) const;
+        /*! Convert a collection to CBOR (raw attributes and loaded relations). */
+        template<typename PivotType = void> // PivotType is primarily internal
+        QByteArray toCbor() const;
+
+        /*! Hydrate a new collection from the CBOR reader (written by
+            the writeCbor()). */
+        template<typename PivotType = void> // PivotType is primarily internal
+        static ModelsCollection<Model> fromCbor(QCborStreamReader &reader)
+        requires (!std::is_pointer_v<Model>);
+        /*! Hydrate a new collection from the CBOR (created by the toCbor()). */
+        static ModelsCollection<Model> fromCbor(const QByteArray &cbor)
+        requires (!std::is_pointer_v<Model>);
+
         /*! Create a collection of all models that do not pass a given truth test. */
         ModelsCollection<ModelRawType *>
         reject(const std::function<bool(ModelRawType *, size_type)> &callback);
@@ -550,6 +608,62 @@ namespace Types
         ModelsCollection &&
         tap(const std::function<void(ModelsCollection &)> &callback) &&;
 
+        /* Parallel */
+        /* The collection is split into contiguous chunks processed by worker threads,
+           results are always in the same order as models in the collection.
+           Callbacks are invoked concurrently, they must be thread-safe, must not modify
+           the collection or shared state without synchronization, and must not use
+           database connections. The first thrown exception is re-thrown after all
+           threads finish. */
+        /*! Run a map over each of the models in parallel. */
+        ModelsCollection<ModelRawType>
+        mapParallel(const std::function<ModelRawType(ModelRawType &&modelCopy,
+                                                     size_type)> &callback) const;
+        /*! Run a map over each of the models in parallel. */
+        ModelsCollection<ModelRawType>
+        mapParallel(
+                const std::function<ModelRawType(ModelRawType &&modelCopy)> &callback) const;
+
+        /*! Run a map over each of the models in parallel. */
+        template<typename T>
+        QVector<T>
+        mapParallel(const std::function<T(ModelRawType &&modelCopy,
+                                          size_type)> &callback) const;
+        /*! Run a map over each of the models in parallel. */
+        template<typename T>
+        QVector<T>
+        mapParallel(const std::function<T(ModelRawType &&modelCopy)> &callback) const;
+
+        /*! Run a filter over each of the models in the collection in parallel. */
+        ModelsCollection<ModelRawType *>
+        filterParallel(const std::function<bool(ModelRawType *, size_type)> &callback);
+        /*! Run a filter over each of the models in the collection in parallel. */
+        ModelsCollection<ModelRawType *>
+        filterParallel(const std::function<bool(ModelRawType *)> &callback);
+
+        /*! Create a collection of all models that do not pass a given truth test
+            in parallel. */
+        ModelsCollection<ModelRawType *>
+        rejectParallel(const std::function<bool(ModelRawType *, size_type)> &callback);
+        /*! Create a collection of all models that do not pass a given truth test
+            in parallel. */
+        ModelsCollection<ModelRawType *>
+        rejectParallel(const std::function<bool(ModelRawType *)> &callback);
+
+        /*! Execute a callback over each model in parallel. */
+        ModelsCollection &
+        eachParallel(const std::function<void(ModelRawType *)> &callback) &;
+        /*! Execute a callback over each model in parallel. */
+        ModelsCollection &
+        eachParallel(const std::function<void(ModelRawType *, size_type)> &callback) &;
+
+        /*! Execute a callback over each model in parallel. */
+        ModelsCollection &&
+        eachParallel(const std::function<void(ModelRawType *)> &callback) &&;
+        /*! Execute a callback over each model in parallel. */
+        ModelsCollection &&
+        eachParallel(const std::function<void(ModelRawType *, size_type)> &callback) &&;
+
     protected:
         /*! Convert the Model pointer to the pointer (no-op). */
         constexpr static ModelRawType *toPointer(ModelRawType *model);
@@ -591,6 +705,43 @@ namespace Types
         /*! Return a model copy. */
         inline static ModelRawType getModelCopy(const ModelRawType *model);
 
+        /*! Get the number of chunks for the parallel methods (one for every thread). */
+        static size_type parallelChunksCount(size_type size);
+        /*! Invoke the callback for every chunk, chunks are processed by the shared
+            thread pool and the first chunk by the calling thread. */
+        static void runParallel(
+                size_type size, size_type chunksCount,
+                const std::function<void(size_type chunk, size_type first,
+                                         size_type last)> &callback);
+        /*! Concatenate the results of chunks in the chunks order. */
+        template<typename C>
+        static C mergeParallelChunks(std::vector<C> &&chunks);
+        /*! Run a filter over each of the models in parallel (common code). */
+        ModelsCollection<ModelRawType *>
+        filterParallelInternal(
+                const std::function<bool(ModelRawType *, size_type)> &callback,
+                bool expected);
+
+        /*! Sort the collection by the sort keys that are obtained only once for every
+            model (decorate-sort-undecorate), the comparator doesn't touch models. */
+        template<typename K, typename KeyCallback>
+        ModelsCollection<ModelRawType *>
+        sortByKeys(KeyCallback &&keyCallback, bool descending, bool stable);
+        /*! Sort the indexes, large collections are sorted in parallel chunks that are
+            merged pairwise. */
+        template<typename Comparator>
+        static void sortIndexes(std::vector<std::size_t> &indexes,
+                                const Comparator &comparator, bool stable);
+
+        /*! Get the multi-columns sort key for the given model. */
+        template<typename ...T, std::size_t ...I>
+        static std::tuple<T...>
+        getSortKey(const ModelRawType *model, const QStringList &columns,
+                   std::index_sequence<I...> /*unused*/);
+        /*! Throw if the number of columns doesn't match the number of column types. */
+        static void throwIfInvalidSortColumns(const QStringList &columns,
+                                              std::size_t typesCount);
+
         /*! Throw if the given operator is not valid for the where() method. */
         static void throwIfInvalidWhereOperator(const QString &comparison);
     };
@@ -1159,6 +1310,31 @@ namespace Types
         return result;
     }
 
+    template<DerivedCollectionModel Model>
+    template<typename T>
+    std::unordered_map<T, typename ModelsCollection<Model>::ModelRawType *>
+    ModelsCollection<Model>::keyBy(const QString &column)
+    {
+        /* The index is a snapshot, it's not invalidated when this collection or models
+           are modified, it's up to the user to call the keyBy() again. */
+        std::unordered_map<T, ModelRawType *> result;
+        result.reserve(static_cast<std::size_t>(this->size()));
+
+        // The try_emplace() keeps the first model, the same as the find() method
+        for (ModelLoopType model : *this)
+            result.try_emplace(toPointer(model)->template getAttribute<T>(column),
+                               toPointer(model));
+
+        return result;
+    }
+
+    template<DerivedCollectionModel Model>
+    ModelsKeyIndex<typename ModelsCollection<Model>::ModelRawType>
+    ModelsCollection<Model>::keyIndex()
+    {
+        return ModelsKeyIndex<ModelRawType>(toPointers());
+    }
+
     template<DerivedCollectionModel Model>
     ModelsCollection<typename ModelsCollection<Model>::ModelRawType *>
     ModelsCollection<Model>::only(const std::unordered_set<KeyType> &ids)
@@ -1419,20 +1595,10 @@ namespace Types
         if (this->isEmpty())
             return {};
 
-        auto result = toPointersCollection();
-
-        ranges::sort(result, [&column, descending](const ModelRawType *const left,
-                                                   const ModelRawType *const right)
+        return sortByKeys<T>([&column](const ModelRawType *const model)
         {
-            /* The XOR is like magic here, if the descending is false it behaves as if
-               it wasn't there, but if the descending is true it returns negated values,
-               the result is that it behaves as left > right if the descending is true.
-               Nice table at https://en.wikipedia.org/wiki/XOR_gate */
-            return descending ^ (left->template getAttribute<T>(column) <
-                                 right->template getAttribute<T>(column));
-        });
-
-        return result;
+            return model->template getAttribute<T>(column);
+        }, descending, false);
     }
 
     template<DerivedCollectionModel Model>
@@ -1443,6 +1609,19 @@ namespace Types
         return sortBy<T>(column, true);
     }
 
+    template<DerivedCollectionModel Model>
+    template<typename ...T> requires (sizeof...(T) > 1)
+    ModelsCollection<typename ModelsCollection<Model>::ModelRawType *>
+    ModelsCollection<Model>::sortBy(const QStringList &columns, const bool descending)
+    {
+        throwIfInvalidSortColumns(columns, sizeof...(T));
+
+        return sortByKeys<std::tuple<T...>>([&columns](const ModelRawType *const model)
+        {
+            return getSortKey<T...>(model, columns, std::index_sequence_for<T...>());
+        }, descending, false);
+    }
+
     template<DerivedCollectionModel Model>
     ModelsCollection<typename ModelsCollection<Model>::ModelRawType *>
     ModelsCollection<Model>::sortBy(
@@ -1535,20 +1714,10 @@ namespace Types
         if (this->isEmpty())
             return {};
 
-        auto result = toPointersCollection();
-
-        ranges::stable_sort(result, [&column, descending](const ModelRawType *const left,
-                                                          const ModelRawType *const right)
+        return sortByKeys<T>([&column](const ModelRawType *const model)
         {
-            /* The XOR is like magic here, if the descending is false it behaves as if
-               it wasn't there, but if the descending is true it returns negated values,
-               the result is that it behaves as left > right if the descending is true.
-               Nice table at https://en.wikipedia.org/wiki/XOR_gate */
-            return descending ^ (left->template getAttribute<T>(column) <
-                                 right->template getAttribute<T>(column));
-        });
-
-        return result;
+            return model->template getAttribute<T>(column);
+        }, descending, true);
     }
 
     template<DerivedCollectionModel Model>
@@ -1559,6 +1728,20 @@ namespace Types
         return stableSortBy<T>(column, true);
     }
 
+    template<DerivedCollectionModel Model>
+    template<typename ...T> requires (sizeof...(T) > 1)
+    ModelsCollection<typename ModelsCollection<Model>::ModelRawType *>
+    ModelsCollection<Model>::stableSortBy(const QStringList &columns,
+                                          const bool descending)
+    {
+        throwIfInvalidSortColumns(columns, sizeof...(T));
+
+        return sortByKeys<std::tuple<T...>>([&columns](const ModelRawType *const model)
+        {
+            return getSortKey<T...>(model, columns, std::index_sequence_for<T...>());
+        }, descending, true);
+    }
+
     template<DerivedCollectionModel Model>
     ModelsCollection<typename ModelsCollection<Model>::ModelRawType *>
     ModelsCollection<Model>::stableSortBy(
@@ -1628,15 +1811,7 @@ namespace Types
         if (this->isEmpty())
             return {};
 
-        auto result = toPointersCollection();
-
-        if (sort)
-            ranges::sort(result, [&column](const ModelRawType *const left,
-                                           const ModelRawType *const right)
-            {
-                return left->template getAttribute<T>(column) <
-                       right->template getAttribute<T>(column);
-            });
+        auto result = sort ? sortBy<T>(column) : toPointersCollection();
 
         const auto it = ranges::unique(result, [&column](const ModelRawType *const left,
                                                          const ModelRawType *const right)
@@ -1947,6 +2122,93 @@ namespace Types
         return toJsonDocument<PivotType>().toJson(format);
     }
 
+    template<DerivedCollectionModel Model>
+    template<typename PivotType>
+    void ModelsCollection<Model>::writeJson(JsonWriter &writer) const
+    {
+        writer.beginArray();
+
+        // No model copies, every model is written straight to the writer
+        for (ConstModelLoopType model : *this)
+            toPointer(model)->template writeJson<PivotType>(writer);
+
+        writer.endArray();
+    }
+
+    template<DerivedCollectionModel Model>
+    template<typename PivotType>
+    void ModelsCollection<Model>::writeJson(QIODevice &device) const
+    {
+        JsonWriter writer(device);
+
+        writeJson<PivotType>(writer);
+
+        writer.flush();
+    }
+
+    template<DerivedCollectionModel Model>
+    template<typename PivotType>
+    void ModelsCollection<Model>::writeJson(QByteArray &buffer) const
+    {
+        JsonWriter writer(buffer);
+
+        writeJson<PivotType>(writer);
+    }
+
+    template<DerivedCollectionModel Model>
+    template<typename PivotType>
+    void ModelsCollection<Model>::writeCbor(QCborStreamWriter &writer) const
+    {
+        writer.startArray(static_cast<quint64>(this->size()));
+
+        for (ConstModelLoopType model : *this)
+            toPointer(model)->template writeCbor<PivotType>(writer);
+
+        writer.endArray();
+    }
+
+    template<DerivedCollectionModel Model>
+    template<typename PivotType>
+    QByteArray ModelsCollection<Model>::toCbor() const
+    {
+        QByteArray cbor;
+        QCborStreamWriter writer(&cbor);
+
+        writeCbor<PivotType>(writer);
+
+        return cbor;
+    }
+
+    template<DerivedCollectionModel Model>
+    template<typename PivotType>
+    ModelsCollection<Model>
+    ModelsCollection<Model>::fromCbor(QCborStreamReader &reader)
+    requires (!std::is_pointer_v<Model>)
+    {
+        Orm::Utils::Cbor::enterContainer(reader, QCborStreamReader::Array);
+
+        ModelsCollection<Model> models;
+        if (reader.isLengthKnown())
+            models.reserve(static_cast<size_type>(reader.length()));
+
+        while (reader.hasNext())
+            models.push_back(Model::template fromCbor<PivotType>(reader));
+
+        Orm::Utils::Cbor::leaveContainer(reader);
+
+        return models;
+    }
+
+    template<DerivedCollectionModel Model>
+    ModelsCollection<Model>
+    ModelsCollection<Model>::fromCbor(const QByteArray &cbor)
+    requires (!std::is_pointer_v<Model>)
+    {
+        QCborStreamReader reader(cbor);
+
+        return fromCbor(reader);
+    }
+
     template<DerivedCollectionModel Model>
     ModelsCollection<typename ModelsCollection<Model>::ModelRawType *>
     ModelsCollection<Model>::reject(
@@ -2258,6 +2520,180 @@ namespace Types
         return std::move(*this);
     }
 
+    /* Parallel */
+
+    template<DerivedCollectionModel Model>
+    ModelsCollection<typename ModelsCollection<Model>::ModelRawType>
+    ModelsCollection<Model>::mapParallel(
+            const std::function<ModelRawType(ModelRawType &&modelCopy,
+                                             size_type)> &callback) const
+    {
+        const auto size = this->size();
+        const auto chunksCount = parallelChunksCount(size);
+        const auto *const models = this->constData();
+
+        std::vector<ModelsCollection<ModelRawType>> chunks(
+                    static_cast<std::size_t>(chunksCount));
+
+        runParallel(size, chunksCount,
+                    [&chunks, &callback, models]
+                    (const size_type chunk, const size_type first, const size_type last)
+        {
+            auto &result = chunks[static_cast<std::size_t>(chunk)];
+            result.reserve(last - first);
+
+            for (size_type index = first; index < last; ++index)
+                result.push_back(std::invoke(callback, getModelCopy(models[index]),
+                                             index));
+        });
+
+        return mergeParallelChunks(std::move(chunks));
+    }
+
+    template<DerivedCollectionModel Model>
+    ModelsCollection<typename ModelsCollection<Model>::ModelRawType>
+    ModelsCollection<Model>::mapParallel(
+            const std::function<ModelRawType(ModelRawType &&modelCopy)> &callback) const
+    {
+        return mapParallel([&callback](ModelRawType &&modelCopy, const size_type)
+        {
+            return std::invoke(callback, std::move(modelCopy));
+        });
+    }
+
+    template<DerivedCollectionModel Model>
+    template<typename T>
+    QVector<T>
+    ModelsCollection<Model>::mapParallel(
+            const std::function<T(ModelRawType &&modelCopy, size_type)> &callback) const
+    {
+        const auto size = this->size();
+        const auto chunksCount = parallelChunksCount(size);
+        const auto *const models = this->constData();
+
+        std::vector<QVector<T>> chunks(static_cast<std::size_t>(chunksCount));
+
+        runParallel(size, chunksCount,
+                    [&chunks, &callback, models]
+                    (const size_type chunk, const size_type first, const size_type last)
+        {
+            auto &result = chunks[static_cast<std::size_t>(chunk)];
+            result.reserve(last - first);
+
+            for (size_type index = first; index < last; ++index)
+                result.push_back(std::invoke(callback, getModelCopy(models[index]),
+                                             index));
+        });
+
+        return mergeParallelChunks(std::move(chunks));
+    }
+
+    template<DerivedCollectionModel Model>
+    template<typename T>
+    QVector<T>
+    ModelsCollection<Model>::mapParallel(
+            const std::function<T(ModelRawType &&modelCopy)> &callback) const
+    {
+        return mapParallel<T>([&callback](ModelRawType &&modelCopy, const size_type)
+        {
+            return std::invoke(callback, std::move(modelCopy));
+        });
+    }
+
+    template<DerivedCollectionModel Model>
+    ModelsCollection<typename ModelsCollection<Model>::ModelRawType *>
+    ModelsCollection<Model>::filterParallel(
+            const std::function<bool(ModelRawType *, size_type)> &callback)
+    {
+        return filterParallelInternal(callback, true);
+    }
+
+    template<DerivedCollectionModel Model>
+    ModelsCollection<typename ModelsCollection<Model>::ModelRawType *>
+    ModelsCollection<Model>::filterParallel(
+            const std::function<bool(ModelRawType *)> &callback)
+    {
+        return filterParallelInternal(
+                    [&callback](ModelRawType *const model, const size_type)
+        {
+            return std::invoke(callback, model);
+        },
+            true);
+    }
+
+    template<DerivedCollectionModel Model>
+    ModelsCollection<typename ModelsCollection<Model>::ModelRawType *>
+    ModelsCollection<Model>::rejectParallel(
+            const std::function<bool(ModelRawType *, size_type)> &callback)
+    {
+        return filterParallelInternal(callback, false);
+    }
+
+    template<DerivedCollectionModel Model>
+    ModelsCollection<typename ModelsCollection<Model>::ModelRawType *>
+    ModelsCollection<Model>::rejectParallel(
+            const std::function<bool(ModelRawType *)> &callback)
+    {
+        return filterParallelInternal(
+                    [&callback](ModelRawType *const model, const size_type)
+        {
+            return std::invoke(callback, model);
+        },
+            false);
+    }
+
+    template<DerivedCollectionModel Model>
+    ModelsCollection<Model> &
+    ModelsCollection<Model>::eachParallel(
+            const std::function<void(ModelRawType *)> &callback) &
+    {
+        return eachParallel([&callback](ModelRawType *const model, const size_type)
+        {
+            std::invoke(callback, model);
+        });
+    }
+
+    template<DerivedCollectionModel Model>
+    ModelsCollection<Model> &
+    ModelsCollection<Model>::eachParallel(
+            const std::function<void(ModelRawType *, size_type)> &callback) &
+    {
+        const auto size = this->size();
+        // Detach in the calling thread, worker threads only access the models
+        auto *const models = this->data();
+
+        runParallel(size, parallelChunksCount(size),
+                    [&callback, models]
+                    (const size_type /*unused*/, const size_type first,
+                     const size_type last)
+        {
+            for (size_type index = first; index < last; ++index)
+                std::invoke(callback, toPointer(models[index]), index);
+        });
+
+        return *this;
+    }
+
+    template<DerivedCollectionModel Model>
+    ModelsCollection<Model> &&
+    ModelsCollection<Model>::eachParallel(
+            const std::function<void(ModelRawType *)> &callback) &&
+    {
+        eachParallel(callback);
+
+        return std::move(*this);
+    }
+
+    template<DerivedCollectionModel Model>
+    ModelsCollection<Model> &&
+    ModelsCollection<Model>::eachParallel(
+            const std::function<void(ModelRawType *, size_type)> &callback) &&
+    {
+        eachParallel(callback);
+
+        return std::move(*this);
+    }
+
     /* protected */
 
     template<DerivedCollectionModel Model>
@@ -2427,6 +2863,246 @@ namespace Types
 
     }
 
+    template<DerivedCollectionModel Model>
+    typename ModelsCollection<Model>::size_type
+    ModelsCollection<Model>::parallelChunksCount(const size_type size)
+    {
+        const auto threadsCount =
+                std::max(static_cast<size_type>(std::thread::hardware_concurrency()),
+                         static_cast<size_type>(1));
+
+        /* At least the ParallelChunkSize models in every chunk, it's not worth dispatching
+           a chunk to a worker thread for a few models. */
+        return std::clamp(size / static_cast<size_type>(ParallelChunkSize),
+                          static_cast<size_type>(1), threadsCount);
+    }
+
+    template<DerivedCollectionModel Model>
+    void ModelsCollection<Model>::runParallel(
+            const size_type size, const size_type chunksCount,
+            const std::function<void(size_type chunk, size_type first,
+                                     size_type last)> &callback)
+    {
+        // Nothing to parallelize
+        if (chunksCount <= 1)
+            return std::invoke(callback, 0, 0, size);
+
+        /* Split the collection into contiguous chunks of the same size, the first chunks
+           can be one model bigger. */
+        const auto chunkSize = size / chunksCount;
+        const auto remainder = size % chunksCount;
+
+        const auto chunkFirst = [chunkSize, remainder](const size_type chunk)
+        {
+            return chunk * chunkSize + std::min(chunk, remainder);
+        };
+
+        /* Chunks are processed by the shared thread pool so worker threads are reused
+           between calls, the first exception is rethrown after all chunks are done. */
+        Orm::Utils::ThreadPool::instance().parallelFor(
+                    static_cast<std::size_t>(chunksCount),
+                    [&callback, &chunkFirst](const std::size_t index)
+        {
+            const auto chunk = static_cast<size_type>(index);
+
+            std::invoke(callback, chunk, chunkFirst(chunk), chunkFirst(chunk + 1));
+        });
+    }
+
+    template<DerivedCollectionModel Model>
+    template<typename C>
+    C ModelsCollection<Model>::mergeParallelChunks(std::vector<C> &&chunks)
+    {
+        // Nothing to merge
+        if (chunks.size() == 1)
+            return std::move(chunks.front());
+
+        typename C::size_type size = 0;
+        for (const auto &chunk : chunks)
+            size += chunk.size();
+
+        C result;
+        result.reserve(size);
+
+        for (auto &chunk : chunks)
+            for (auto &&value : chunk)
+                result.push_back(std::move(value));
+
+        return result;
+    }
+
+    template<DerivedCollectionModel Model>
+    ModelsCollection<typename ModelsCollection<Model>::ModelRawType *>
+    ModelsCollection<Model>::filterParallelInternal(
+            const std::function<bool(ModelRawType *, size_type)> &callback,
+            const bool expected)
+    {
+        const auto size = this->size();
+        const auto chunksCount = parallelChunksCount(size);
+        // Detach in the calling thread, worker threads only access the models
+        auto *const models = this->data();
+
+        std::vector<ModelsCollection<ModelRawType *>> chunks(
+                    static_cast<std::size_t>(chunksCount));
+
+        runParallel(size, chunksCount,
+                    [&chunks, &callback, models, expected]
+                    (const size_type chunk, const size_type first, const size_type last)
+        {
+            auto &result = chunks[static_cast<std::size_t>(chunk)];
+            result.reserve(last - first);
+
+            for (size_type index = first; index < last; ++index)
+                // Don't handle the nullptr
+                if (ModelRawType *const modelPointer = toPointer(models[index]);
+                    std::invoke(callback, modelPointer, index) == expected
+                )
+                    result.push_back(modelPointer);
+        });
+
+        return mergeParallelChunks(std::move(chunks));
+    }
+
+    template<DerivedCollectionModel Model>
+    template<typename K, typename KeyCallback>
+    ModelsCollection<typename ModelsCollection<Model>::ModelRawType *>
+    ModelsCollection<Model>::sortByKeys(KeyCallback &&keyCallback,
+                                        const bool descending, const bool stable)
+    {
+        // Nothing to do
+        if (this->isEmpty())
+            return {};
+
+        const auto models = toPointersCollection();
+        const auto size = static_cast<std::size_t>(models.size());
+
+        /* Obtain the sort keys only once for every model, the getAttribute() with casts
+           would be called twice for every comparison otherwise. */
+        std::vector<K> keys;
+        keys.reserve(size);
+
+        for (const ModelRawType *const model : models)
+            keys.push_back(std::invoke(keyCallback, model));
+
+        // Sort the indexes instead of models, the comparator only compares typed keys
+        std::vector<std::size_t> indexes(size);
+        std::iota(indexes.begin(), indexes.end(), 0);
+
+        const auto comparator = [&keys](const std::size_t left, const std::size_t right)
+        {
+            return keys[left] < keys[right];
+        };
+
+        sortIndexes(indexes, comparator, stable);
+
+        /* The descending order is the reversed ascending order, equal keys are also
+           reversed, it's the same order as the XOR trick in the sort() produces. */
+        if (descending)
+            std::ranges::reverse(indexes);
+
+        ModelsCollection<ModelRawType *> result;
+        result.reserve(models.size());
+
+        for (const auto index : indexes)
+            result.push_back(models.at(static_cast<size_type>(index)));
+
+        return result;
+    }
+
+    template<DerivedCollectionModel Model>
+    template<typename Comparator>
+    void ModelsCollection<Model>::sortIndexes(
+            std::vector<std::size_t> &indexes, const Comparator &comparator,
+            const bool stable)
+    {
+        const auto size = static_cast<size_type>(indexes.size());
+        const auto chunksCount = size < static_cast<size_type>(ParallelSortMinSize)
+                                 ? static_cast<size_type>(1)
+                                 : parallelChunksCount(size);
+
+        const auto sortRange = [&indexes, &comparator, stable]
+                               (const size_type first, const size_type last)
+        {
+            const auto begin = indexes.begin() + first;
+            const auto end = indexes.begin() + last;
+
+            if (stable)
+                std::stable_sort(begin, end, comparator);
+            else
+                std::sort(begin, end, comparator);
+        };
+
+        // Nothing to parallelize
+        if (chunksCount <= 1)
+            return sortRange(0, size);
+
+        // Chunk boundaries, the chunk i is the [bounds[i], bounds[i + 1]) range
+        std::vector<size_type> bounds(static_cast<std::size_t>(chunksCount) + 1);
+
+        runParallel(size, chunksCount,
+                    [&sortRange, &bounds]
+                    (const size_type chunk, const size_type first, const size_type last)
+        {
+            bounds[static_cast<std::size_t>(chunk) + 1] = last;
+
+            sortRange(first, last);
+        });
+
+        /* Merge sorted neighbouring chunks pairwise until one chunk is left, the
+           std::inplace_merge() is stable so the stableSortBy() stays stable. */
+        while (bounds.size() > 2) {
+            const auto pairsCount = static_cast<size_type>((bounds.size() - 1) / 2);
+
+            runParallel(pairsCount, pairsCount,
+                        [&indexes, &comparator, &bounds]
+                        (const size_type pair, const size_type /*unused*/,
+                         const size_type /*unused*/)
+            {
+                const auto first = static_cast<std::size_t>(pair) * 2;
+
+                std::inplace_merge(indexes.begin() + bounds[first],
+                                   indexes.begin() + bounds[first + 1],
+                                   indexes.begin() + bounds[first + 2], comparator);
+            });
+
+            // Drop the boundaries between merged chunks, the odd last chunk is kept
+            std::vector<size_type> mergedBounds;
+            mergedBounds.reserve(bounds.size() / 2 + 1);
+
+            for (std::size_t i = 0; i < bounds.size(); i += 2)
+                mergedBounds.push_back(bounds[i]);
+
+            if (bounds.size() % 2 == 0)
+                mergedBounds.push_back(bounds.back());
+
+            bounds = std::move(mergedBounds);
+        }
+    }
+
+    template<DerivedCollectionModel Model>
+    template<typename ...T, std::size_t ...I>
+    std::tuple<T...>
+    ModelsCollection<Model>::getSortKey(
+            const ModelRawType *const model, const QStringList &columns,
+            std::index_sequence<I...> /*unused*/)
+    {
+        return std::tuple<T...>(model->template getAttribute<T>(columns.at(I))...);
+    }
+
+    template<DerivedCollectionModel Model>
+    void ModelsCollection<Model>::throwIfInvalidSortColumns(
+            const QStringList &columns, const std::size_t typesCount)
+    {
+        if (static_cast<std::size_t>(columns.size()) == typesCount)
+            return;
+
+        throw Orm::Exceptions::InvalidArgumentError(
+                    QStringLiteral(
+                        "The number of columns '%1' doesn't match the number of "
+                        "column types '%2' in %3().")
+                    .arg(columns.size()).arg(typesCount).arg(__tiny_func__));
+    }
+
 } // namespace Types
 
     /*! Alias for the WhereBetweenCollectionItem. */
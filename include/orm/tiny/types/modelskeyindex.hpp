@@ -0,0 +1,127 @@
+#pragma once
+#ifndef ORM_TINY_TYPES_MODELSKEYINDEX_HPP
+#define ORM_TINY_TYPES_MODELSKEYINDEX_HPP
+
+#include "orm/macros/systemheader.hpp"
+TINY_SYSTEM_HEADER
+
+#include <QVector>
+
+#include <unordered_map>
+
+#include "orm/macros/commonnamespace.hpp"
+
+TINYORM_BEGIN_COMMON_NAMESPACE
+
+namespace Orm::Tiny
+{
+namespace Types
+{
+
+    /*! Primary key index of the ModelsCollection for repeated find() lookups, it's
+        a snapshot of model pointers, obtain it using the ModelsCollection::keyIndex()
+        and obtain it again after the collection is modified. */
+    template<typename Model>
+    class ModelsKeyIndex
+    {
+    public:
+        /*! The type of the model's primary key. */
+        using KeyType = typename Model::KeyType;
+        /*! The type used for the number of models. */
+        using size_type = typename QVector<Model *>::size_type;
+
+        /*! Constructor (the first model wins for duplicate primary keys). */
+        explicit ModelsKeyIndex(QVector<Model *> models);
+
+        /*! Find a model by the primary key. */
+        Model *find(KeyType id, Model *defaultModel = nullptr) const;
+        /*! Determine whether the index contains a model with the given primary key. */
+        inline bool contains(KeyType id) const;
+
+        /*! Get the number of indexed models. */
+        inline size_type size() const noexcept;
+        /*! Determine whether the index is empty. */
+        inline bool isEmpty() const noexcept;
+
+    private:
+        /*! Find a model by the primary key using the linear scan. */
+        Model *findLinear(KeyType id) const;
+
+        /*! Indexed models in the collection order. */
+        QVector<Model *> m_models;
+        /*! The primary key to the first model with this key. */
+        std::unordered_map<KeyType, Model *> m_index {};
+    };
+
+    /* public */
+
+    template<typename Model>
+    ModelsKeyIndex<Model>::ModelsKeyIndex(QVector<Model *> models)
+        : m_models(std::move(models))
+    {
+        m_index.reserve(static_cast<std::size_t>(m_models.size()));
+
+        // The try_emplace() keeps the first model, the same as the find() method
+        for (Model *const model : std::as_const(m_models))
+            m_index.try_emplace(model->getKeyCasted(), model);
+    }
+
+    template<typename Model>
+    Model *ModelsKeyIndex<Model>::find(const KeyType id, Model *const defaultModel) const
+    {
+        /* The primary key can be changed in place through the model pointer, the hit
+           is verified and the miss is confirmed by the linear scan, so the result is
+           the same as the ModelsCollection::find() for the indexed models. */
+        if (const auto it = m_index.find(id);
+            it != m_index.cend() && it->second->getKeyCasted() == id
+        )
+            return it->second;
+
+        if (auto *const model = findLinear(id); model != nullptr)
+            return model;
+
+        return defaultModel;
+    }
+
+    template<typename Model>
+    bool ModelsKeyIndex<Model>::contains(const KeyType id) const
+    {
+        return find(id) != nullptr;
+    }
+
+    template<typename Model>
+    typename ModelsKeyIndex<Model>::size_type
+    ModelsKeyIndex<Model>::size() const noexcept
+    {
+        return m_models.size();
+    }
+
+    template<typename Model>
+    bool ModelsKeyIndex<Model>::isEmpty() const noexcept
+    {
+        return m_models.isEmpty();
+    }
+
+    /* private */
+
+    template<typename Model>
+    Model *ModelsKeyIndex<Model>::findLinear(const KeyType id) const
+    {
+        for (Model *const model : m_models)
+            if (model->getKeyCasted() == id)
+                return model;
+
+        return nullptr;
+    }
+
+} // namespace Types
+
+    /*! Alias for the ModelsKeyIndex. */
+    template<typename Model>
+    using ModelsKeyIndex = Tiny::Types::ModelsKeyIndex<Model>;
+
+} // namespace Orm::Tiny
+
+TINYORM_END_COMMON_NAMESPACE
+
+#endif // ORM_TINY_TYPES_MODELSKEYINDEX_HPP
@@ -0,0 +1,73 @@
+#pragma once
+#ifndef ORM_TYPES_ARROWSTREAMWRITER_HPP
+#define ORM_TYPES_ARROWSTREAMWRITER_HPP
+
+#include "orm/macros/systemheader.hpp"
+TINY_SYSTEM_HEADER
+
+#include <QIODevice>
+#include <QtSql/QSqlRecord>
+
+#include "orm/types/columnarresult.hpp"
+
+TINYORM_BEGIN_COMMON_NAMESPACE
+
+namespace Orm::Types
+{
+
+    /*! Apache Arrow IPC streaming format writer (self-contained, the schema message,
+        record batch messages and the end-of-stream marker), the Int64, Double
+        and Utf8 Arrow types are supported (see the ColumnarType). */
+    class SHAREDLIB_EXPORT ArrowStreamWriter
+    {
+        Q_DISABLE_COPY_MOVE(ArrowStreamWriter)
+
+    public:
+        /*! Constructor. */
+        explicit ArrowStreamWriter(QIODevice &device);
+        /*! Default destructor. */
+        inline ~ArrowStreamWriter() = default;
+
+        /*! Write the whole query result as the Arrow IPC stream, the column types
+            are mapped from the driver's field metadata, returns rows count. */
+        static qint64 write(SqlQuery &query, QIODevice &device, qint64 batchSize);
+
+        /*! Write the schema message for the given record (driver's field metadata). */
+        void writeSchema(const QSqlRecord &record);
+        /*! Write the record batch message (columns must match the schema). */
+        void writeRecordBatch(const ColumnarResult &batch);
+        /*! Write the end-of-stream marker. */
+        void writeEndOfStream();
+
+        /*! Get the column types of the written schema. */
+        inline const QVector<ColumnarType> &types() const noexcept;
+
+    private:
+        /*! Write the encapsulated message (metadata and body) to the device. */
+        void writeMessage(const QByteArray &metadata, const QByteArray &body = {});
+        /*! Write the given data to the device. */
+        void writeToDevice(const QByteArray &data);
+
+        /*! Throw if the schema was not written yet or the batch doesn't match it. */
+        void throwIfInvalidBatch(const ColumnarResult &batch) const;
+
+        /*! The output device. */
+        QIODevice &m_device;
+        /*! Column types of the written schema. */
+        QVector<ColumnarType> m_types;
+        /*! Determine whether the schema was written. */
+        bool m_schemaWritten = false;
+    };
+
+    /* public */
+
+    const QVector<ColumnarType> &ArrowStreamWriter::types() const noexcept
+    {
+        return m_types;
+    }
+
+} // namespace Orm::Types
+
+TINYORM_END_COMMON_NAMESPACE
+
+#endif // ORM_TYPES_ARROWSTREAMWRITER_HPP
@@ -0,0 +1,274 @@
+#pragma once
+#ifndef ORM_TYPES_COLUMNARRESULT_HPP
+#define ORM_TYPES_COLUMNARRESULT_HPP
+
+#include "orm/macros/systemheader.hpp"
+TINY_SYSTEM_HEADER
+
+#include <QByteArray>
+#include <QString>
+#include <QVariant>
+#include <QVector>
+
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+#include "orm/macros/export.hpp"
+
+class QSqlField;
+
+TINYORM_BEGIN_COMMON_NAMESPACE
+
+namespace Orm::Types
+{
+
+    class SqlQuery;
+
+    /*! Type of the columnar result column buffer. */
+    enum struct ColumnarType
+    {
+        /*! Integral and boolean values (std::vector<std::int64_t>). */
+        Int64,
+        /*! Floating-point values (std::vector<double>). */
+        Double,
+        /*! All other values as UTF-8 strings (offsets and data buffers). */
+        String,
+    };
+
+    /*! Row selection mask for the columnar reductions (1 for selected rows). */
+    using FilterMask = std::vector<std::uint8_t>;
+
+    /*! One column of the columnar result, contiguous typed buffer with the validity
+        bitmap (the same layout as Apache Arrow, the LSB bit numbering, null slots
+        are zero-filled). */
+    class SHAREDLIB_EXPORT ColumnarColumn
+    {
+        friend class ColumnarResult;
+
+    public:
+        /*! Constructor. */
+        ColumnarColumn(QString name, ColumnarType type);
+
+        /*! Get the column buffer type for the given QMetaType id. */
+        static ColumnarType typeFor(int typeId) noexcept;
+        /*! Get the column buffer type for the given driver's field metadata. */
+        static ColumnarType typeFor(const QSqlField &field);
+        /*! Determine whether the driver reports the type for the given field. */
+        static bool hasType(const QSqlField &field);
+
+        /*! Get the column name. */
+        inline const QString &name() const noexcept;
+        /*! Get the column buffer type. */
+        inline ColumnarType type() const noexcept;
+        /*! Get the number of rows. */
+        inline std::int64_t size() const noexcept;
+        /*! Get the number of null values. */
+        inline std::int64_t nullCount() const noexcept;
+
+        /*! Determine whether the value at the given row is not null. */
+        inline bool isValid(std::int64_t row) const noexcept;
+        /*! Determine whether the value at the given row is null. */
+        inline bool isNull(std::int64_t row) const noexcept;
+
+        /* Buffers */
+        /*! Get the validity bitmap (bit set for non-null values). */
+        inline const std::vector<std::uint8_t> &validityBitmap() const noexcept;
+        /*! Get the values buffer of the Int64 column. */
+        inline const std::vector<std::int64_t> &int64Values() const noexcept;
+        /*! Get the values buffer of the Double column. */
+        inline const std::vector<double> &doubleValues() const noexcept;
+        /*! Get the offsets buffer of the String column (size() + 1 offsets). */
+        inline const std::vector<std::int32_t> &stringOffsets() const noexcept;
+        /*! Get the UTF-8 data buffer of the String column. */
+        inline const QByteArray &stringData() const noexcept;
+
+        /*! Get the string value at the given row (String column only). */
+        QString stringValue(std::int64_t row) const;
+        /*! Get the value at the given row (boxed, for convenience only). */
+        QVariant value(std::int64_t row) const;
+
+        /* Reductions (numeric columns only, nulls are skipped) */
+        /*! Get the number of non-null values (of the selected rows). */
+        std::int64_t count(const FilterMask &mask = {}) const;
+        /*! Get the sum of the values (of the selected rows). */
+        double sum(const FilterMask &mask = {}) const;
+        /*! Get the minimum value (of the selected rows). */
+        std::optional<double> min(const FilterMask &mask = {}) const;
+        /*! Get the maximum value (of the selected rows). */
+        std::optional<double> max(const FilterMask &mask = {}) const;
+        /*! Get the filter mask of rows with non-null values matching the comparison
+            (=, !=, <>, <, <=, >, >=). */
+        FilterMask filter(const QString &comparison, double value) const;
+
+    private:
+        /*! Append the value from the database (converted to the column type). */
+        void append(const QVariant &value);
+        /*! Append the null value. */
+        void appendNull();
+        /*! Set the validity bit for the next row. */
+        void appendValidity(bool valid);
+
+        /*! Throw if the column is not numeric. */
+        void throwIfNotNumeric(const QString &functionName) const;
+        /*! Throw if the filter mask size doesn't match the column size. */
+        void throwIfInvalidMask(const FilterMask &mask,
+                                const QString &functionName) const;
+
+        /*! Column name. */
+        QString m_name;
+        /*! Column buffer type. */
+        ColumnarType m_type;
+        /*! Number of rows. */
+        std::int64_t m_size = 0;
+        /*! Number of null values. */
+        std::int64_t m_nullCount = 0;
+        /*! Validity bitmap (bit set for non-null values). */
+        std::vector<std::uint8_t> m_validity;
+        /*! Values buffer of the Int64 column. */
+        std::vector<std::int64_t> m_int64Values;
+        /*! Values buffer of the Double column. */
+        std::vector<double> m_doubleValues;
+        /*! Offsets buffer of the String column. */
+        std::vector<std::int32_t> m_stringOffsets;
+        /*! UTF-8 data buffer of the String column. */
+        QByteArray m_stringData;
+    };
+
+    /*! Struct-of-arrays result set, every column is stored in the contiguous typed
+        buffer (for client-side analytics without the per-cell QVariant boxing). */
+    class SHAREDLIB_EXPORT ColumnarResult
+    {
+    public:
+        /*! Default constructor. */
+        inline ColumnarResult() = default;
+
+        /*! Read all rows of the given query into the columnar buffers (the column
+            type is detected from the first non-null value). */
+        static ColumnarResult fromSqlQuery(SqlQuery &query);
+        /*! Read at most the given number of rows of the query into the columnar
+            buffers of the given types (values are converted to the column type). */
+        static ColumnarResult
+        fromSqlQuery(SqlQuery &query, const QVector<ColumnarType> &types,
+                     std::int64_t maxRows);
+
+        /*! Get the number of rows. */
+        inline std::int64_t rowsCount() const noexcept;
+        /*! Get the number of columns. */
+        inline QVector<ColumnarColumn>::size_type columnsCount() const noexcept;
+
+        /*! Get all columns. */
+        inline const QVector<ColumnarColumn> &columns() const noexcept;
+        /*! Get the column at the given position. */
+        inline const ColumnarColumn &column(QVector<ColumnarColumn>::size_type index) const;
+        /*! Get the column by the given name. */
+        const ColumnarColumn &column(const QString &name) const;
+        /*! Determine whether the result contains the given column. */
+        bool contains(const QString &name) const;
+
+        /*! Combine the given filter masks (logical AND). */
+        static FilterMask maskAnd(const FilterMask &left, const FilterMask &right);
+        /*! Combine the given filter masks (logical OR). */
+        static FilterMask maskOr(const FilterMask &left, const FilterMask &right);
+
+    private:
+        /*! Columns. */
+        QVector<ColumnarColumn> m_columns;
+        /*! Number of rows. */
+        std::int64_t m_rowsCount = 0;
+    };
+
+    /* public */
+
+    /* ColumnarColumn */
+
+    const QString &ColumnarColumn::name() const noexcept
+    {
+        return m_name;
+    }
+
+    ColumnarType ColumnarColumn::type() const noexcept
+    {
+        return m_type;
+    }
+
+    std::int64_t ColumnarColumn::size() const noexcept
+    {
+        return m_size;
+    }
+
+    std::int64_t ColumnarColumn::nullCount() const noexcept
+    {
+        return m_nullCount;
+    }
+
+    bool ColumnarColumn::isValid(const std::int64_t row) const noexcept
+    {
+        return ((m_validity[static_cast<std::size_t>(row >> 3)] >> (row & 7)) & 1U) != 0;
+    }
+
+    bool ColumnarColumn::isNull(const std::int64_t row) const noexcept
+    {
+        return !isValid(row);
+    }
+
+    const std::vector<std::uint8_t> &ColumnarColumn::validityBitmap() const noexcept
+    {
+        return m_validity;
+    }
+
+    const std::vector<std::int64_t> &ColumnarColumn::int64Values() const noexcept
+    {
+        return m_int64Values;
+    }
+
+    const std::vector<double> &ColumnarColumn::doubleValues() const noexcept
+    {
+        return m_doubleValues;
+    }
+
+    const std::vector<std::int32_t> &ColumnarColumn::stringOffsets() const noexcept
+    {
+        return m_stringOffsets;
+    }
+
+    const QByteArray &ColumnarColumn::stringData() const noexcept
+    {
+        return m_stringData;
+    }
+
+    /* ColumnarResult */
+
+    std::int64_t ColumnarResult::rowsCount() const noexcept
+    {
+        return m_rowsCount;
+    }
+
+    QVector<ColumnarColumn>::size_type ColumnarResult::columnsCount() const noexcept
+    {
+        return m_columns.size();
+    }
+
+    const QVector<ColumnarColumn> &ColumnarResult::columns() const noexcept
+    {
+        return m_columns;
+    }
+
+    const ColumnarColumn &
+    ColumnarResult::column(const QVector<ColumnarColumn>::size_type index) const
+    {
+        return m_columns.at(index);
+    }
+
+} // namespace Orm::Types
+
+namespace Orm
+{
+    using ColumnarColumn = Types::ColumnarColumn;
+    using ColumnarResult = Types::ColumnarResult;
+    using ColumnarType   = Types::ColumnarType;
+} // namespace Orm
+
+TINYORM_END_COMMON_NAMESPACE
+
+#endif // ORM_TYPES_COLUMNARRESULT_HPP
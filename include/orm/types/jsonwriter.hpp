@@ -0,0 +1,96 @@
+#pragma once
+#ifndef ORM_TYPES_JSONWRITER_HPP
+#define ORM_TYPES_JSONWRITER_HPP
+
+#include "orm/macros/systemheader.hpp"
+TINY_SYSTEM_HEADER
+
+#include <QIODevice>
+#include <QVariant>
+
+#include <vector>
+
+#include "orm/macros/export.hpp"
+
+TINYORM_BEGIN_COMMON_NAMESPACE
+
+namespace Orm
+{
+namespace Types
+{
+
+    /*! Streaming compact JSON writer, values are written straight to the UTF-8 buffer
+        or to the device (in chunks) without building the QJsonDocument first. */
+    class SHAREDLIB_EXPORT JsonWriter
+    {
+        Q_DISABLE_COPY_MOVE(JsonWriter)
+
+    public:
+        /*! Constructor, writes to the given device (buffered, call flush() at the end). */
+        explicit JsonWriter(QIODevice &device);
+        /*! Constructor, appends to the given UTF-8 buffer. */
+        explicit JsonWriter(QByteArray &buffer);
+        /*! Destructor, flushes the remaining buffered data to the device. */
+        ~JsonWriter();
+
+        /*! Begin the JSON object. */
+        void beginObject();
+        /*! End the JSON object. */
+        void endObject();
+        /*! Begin the JSON array. */
+        void beginArray();
+        /*! End the JSON array. */
+        void endArray();
+
+        /*! Write the key of the next object member. */
+        void writeKey(const QString &key);
+        /*! Write the value (the same conversion as the QJsonValue::fromVariant()). */
+        void writeValue(const QVariant &value);
+        /*! Write the null value. */
+        void writeNull();
+
+        /*! Write the buffered data to the device (no-op for the buffer). */
+        void flush();
+
+    private:
+        /*! Write the comma separator if it's needed in the current container. */
+        void writeSeparator();
+        /*! Write the escaped JSON string. */
+        void writeString(const QString &string);
+        /*! Write the raw UTF-8 data. */
+        void writeRaw(const QByteArray &data);
+        /*! Write the raw Latin-1 character. */
+        void writeRaw(char character);
+        /*! Flush the buffered data to the device if the chunk size was reached. */
+        inline void flushIfFull();
+
+        /*! The output device (nullptr if writing to the buffer). */
+        QIODevice *m_device = nullptr;
+        /*! The output buffer (the user's buffer or the chunk for the device). */
+        QByteArray *m_buffer;
+        /*! The chunk buffered before it's written to the device. */
+        QByteArray m_chunk;
+        /*! Whether the current nested object/array already contains a value. */
+        std::vector<bool> m_hasValue;
+        /*! Determine whether the key was written and its value is expected. */
+        bool m_afterKey = false;
+    };
+
+    /* private */
+
+    void JsonWriter::flushIfFull()
+    {
+        // 64KiB chunks, the device is written in chunks to keep the peak memory low
+        if (m_device != nullptr && m_chunk.size() >= 65536)
+            flush();
+    }
+
+} // namespace Types
+
+    using JsonWriter = Types::JsonWriter;
+
+} // namespace Orm
+
+TINYORM_END_COMMON_NAMESPACE
+
+#endif // ORM_TYPES_JSONWRITER_HPP
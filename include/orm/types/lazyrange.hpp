@@ -0,0 +1,173 @@
+#pragma once
+#ifndef ORM_TYPES_LAZYRANGE_HPP
+#define ORM_TYPES_LAZYRANGE_HPP
+
+#include "orm/macros/systemheader.hpp"
+TINY_SYSTEM_HEADER
+
+#include <functional>
+#include <iterator>
+
+#include "orm/macros/commonnamespace.hpp"
+
+TINYORM_BEGIN_COMMON_NAMESPACE
+
+namespace Orm
+{
+namespace Types
+{
+
+    /*! Input range that produces values lazily one by one, values are obtained
+        using the given callback that returns nullptr when there are no more values
+        (single-pass, the begin() can be called only once). */
+    template<typename T>
+    class LazyRange
+    {
+    public:
+        /*! Callback type that produces the next value or nullptr at the end. */
+        using NextCallback = std::function<T *()>;
+
+        /*! Input iterator for the LazyRange. */
+        class Iterator
+        {
+        public:
+            /* Iterator related */
+            using iterator_concept  = std::input_iterator_tag;
+            using iterator_category = std::input_iterator_tag;
+            using value_type        = T;
+            using difference_type   = std::ptrdiff_t;
+            using pointer           = T *;
+            using reference         = T &;
+
+            /*! Default constructor. */
+            inline Iterator() = default;
+            /*! Constructor. */
+            inline explicit Iterator(LazyRange *range);
+
+            /*! Return a reference to the current value. */
+            inline reference operator*() const noexcept;
+            /*! Return a pointer to the current value. */
+            inline pointer operator->() const noexcept;
+
+            /*! Obtain the next value. */
+            inline Iterator &operator++();
+            /*! Obtain the next value. */
+            inline void operator++(int);
+
+            /*! Determine whether the iterator reached the end of the range. */
+            friend bool operator==(const Iterator &iterator,
+                                   std::default_sentinel_t /*unused*/) noexcept
+            {
+                return iterator.m_current == nullptr;
+            }
+
+        private:
+            /*! Pointer to the range that owns the value producer. */
+            LazyRange *m_range = nullptr;
+            /*! Pointer to the current value (nullptr at the end). */
+            T *m_current = nullptr;
+        };
+
+        /*! Constructor. */
+        inline explicit LazyRange(NextCallback &&next);
+        /*! Default destructor. */
+        inline ~LazyRange() = default;
+
+        /*! Deleted copy constructor (single-pass range). */
+        LazyRange(const LazyRange &) = delete;
+        /*! Deleted copy assignment operator (single-pass range). */
+        LazyRange &operator=(const LazyRange &) = delete;
+
+        /*! Move constructor. */
+        inline LazyRange(LazyRange &&) noexcept = default;
+        /*! Move assignment operator. */
+        inline LazyRange &operator=(LazyRange &&) noexcept = default;
+
+        /*! Obtain the next value, returns nullptr if there are no more values. */
+        inline T *next();
+
+        /*! Return an iterator to the first value (obtains the first value). */
+        inline Iterator begin();
+        /*! Return the end sentinel. */
+        inline std::default_sentinel_t end() const noexcept;
+
+    private:
+        /*! Callback that produces the next value. */
+        NextCallback m_next;
+    };
+
+    /* public */
+
+    /* Iterator */
+
+    template<typename T>
+    LazyRange<T>::Iterator::Iterator(LazyRange *const range)
+        : m_range(range)
+        , m_current(range->next())
+    {}
+
+    template<typename T>
+    typename LazyRange<T>::Iterator::reference
+    LazyRange<T>::Iterator::operator*() const noexcept
+    {
+        return *m_current;
+    }
+
+    template<typename T>
+    typename LazyRange<T>::Iterator::pointer
+    LazyRange<T>::Iterator::operator->() const noexcept
+    {
+        return m_current;
+    }
+
+    template<typename T>
+    typename LazyRange<T>::Iterator &
+    LazyRange<T>::Iterator::operator++()
+    {
+        m_current = m_range->next();
+
+        return *this;
+    }
+
+    template<typename T>
+    void LazyRange<T>::Iterator::operator++(int)
+    {
+        ++*this;
+    }
+
+    /* LazyRange */
+
+    template<typename T>
+    LazyRange<T>::LazyRange(NextCallback &&next)
+        : m_next(std::move(next))
+    {}
+
+    template<typename T>
+    T *LazyRange<T>::next()
+    {
+        return std::invoke(m_next);
+    }
+
+    template<typename T>
+    typename LazyRange<T>::Iterator LazyRange<T>::begin()
+    {
+        return Iterator(this);
+    }
+
+    template<typename T>
+    std::default_sentinel_t LazyRange<T>::end() const noexcept
+    {
+        return std::default_sentinel;
+    }
+
+} // namespace Types
+
+    /*! Alias for the LazyRange. */
+    template<typename T>
+    using LazyRange = Types::LazyRange<T>;
+
+} // namespace Orm
+
+TINYORM_END_COMMON_NAMESPACE
+
+#endif // ORM_TYPES_LAZYRANGE_HPP
@@ -0,0 +1,48 @@
+#pragma once
+#ifndef ORM_TYPES_NPLUSONEVIOLATION_HPP
+#define ORM_TYPES_NPLUSONEVIOLATION_HPP
+
+#include "orm/macros/systemheader.hpp"
+TINY_SYSTEM_HEADER
+
+#include <QString>
+
+#include "orm/macros/commonnamespace.hpp"
+
+TINYORM_BEGIN_COMMON_NAMESPACE
+
+namespace Orm
+{
+namespace Types
+{
+
+    /*! What to do when the N+1 query is detected. */
+    enum struct NPlusOneAction
+    {
+        /*! Log a warning using the qWarning(). */
+        Log,
+        /*! Throw the NPlusOneQueryError exception (for tests). */
+        Throw,
+    };
+
+    /*! Detected N+1 query, the same query repeatedly executed by lazy loading. */
+    struct NPlusOneViolation
+    {
+        /*! Lazy loaded relation (Model::relation). */
+        QString relation;
+        /*! Query string (fingerprint) without bindings. */
+        QString queryString;
+        /*! Number of executions. */
+        qint64 count = 0;
+    };
+
+} // namespace Types
+
+    using NPlusOneAction    = Types::NPlusOneAction;
+    using NPlusOneViolation = Types::NPlusOneViolation;
+
+} // namespace Orm
+
+TINYORM_END_COMMON_NAMESPACE
+
+#endif // ORM_TYPES_NPLUSONEVIOLATION_HPP
@@ -0,0 +1,73 @@
+#pragma once
+#ifndef ORM_UTILS_CBOR_HPP
+#define ORM_UTILS_CBOR_HPP
+
+#include "orm/macros/systemheader.hpp"
+TINY_SYSTEM_HEADER
+
+#include <QCborStreamReader>
+#include <QCborStreamWriter>
+
+#include "orm/macros/commonnamespace.hpp"
+#include "orm/macros/export.hpp"
+
+TINYORM_BEGIN_COMMON_NAMESPACE
+
+namespace Orm::Utils
+{
+
+    /*! CBOR library class, encodes QVariant-s with their native types so they can
+        be decoded back to the same QMetaType (used by the Model::toCbor()). */
+    class SHAREDLIB_EXPORT Cbor
+    {
+        Q_DISABLE_COPY_MOVE(Cbor)
+
+    public:
+        /*! Deleted default constructor, this is a pure library class. */
+        Cbor() = delete;
+        /*! Deleted destructor. */
+        ~Cbor() = delete;
+
+        /*! CBOR tag for the full-date string (RFC 8943). */
+        constexpr static auto DateStringTag = static_cast<QCborTag>(1004);
+        /*! CBOR tag for values that need the QMetaType to be decoded, the tagged
+            item is the [typeId, value] array, the value is null for null QVariant-s. */
+        constexpr static auto TypedValueTag = static_cast<QCborTag>(0x54696E79);
+
+        /*! Write the given value (a QVariant without the QMetaType is undefined). */
+        static void writeValue(QCborStreamWriter &writer, const QVariant &value);
+        /*! Read the value written by the writeValue(). */
+        static QVariant readValue(QCborStreamReader &reader);
+
+        /*! Read the text string. */
+        static QString readString(QCborStreamReader &reader);
+
+        /*! Enter the array or map container, throw if it's another type. */
+        static void enterContainer(QCborStreamReader &reader,
+                                   QCborStreamReader::Type type);
+        /*! Leave the current container. */
+        static void leaveContainer(QCborStreamReader &reader);
+
+    private:
+        /*! Write the value that needs the QMetaType to be decoded. */
+        static void writeTypedValue(QCborStreamWriter &writer, const QVariant &value,
+                                    int typeId);
+        /*! Read the value written by the writeTypedValue(). */
+        static QVariant readTypedValue(QCborStreamReader &reader);
+        /*! Read the byte string. */
+        static QByteArray readByteArray(QCborStreamReader &reader);
+
+        /*! Throw if the reader is not at the given type. */
+        static void throwIfUnexpectedType(const QCborStreamReader &reader,
+                                          QCborStreamReader::Type type);
+        /*! Throw the exception about the unsupported data type. */
+        [[noreturn]] static void throwUnsupportedType(const QCborStreamReader &reader);
+        /*! Throw if the reader failed. */
+        static void throwIfError(const QCborStreamReader &reader);
+    };
+
+} // namespace Orm::Utils
+
+TINYORM_END_COMMON_NAMESPACE
+
+#endif // ORM_UTILS_CBOR_HPP
@@ -0,0 +1,78 @@
+#pragma once
+#ifndef ORM_UTILS_THREADPOOL_HPP
+#define ORM_UTILS_THREADPOOL_HPP
+
+#include "orm/macros/systemheader.hpp"
+TINY_SYSTEM_HEADER
+
+#include <QtGlobal>
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+
+#include "orm/macros/commonnamespace.hpp"
+#include "orm/macros/export.hpp"
+
+TINYORM_BEGIN_COMMON_NAMESPACE
+
+namespace Orm::Utils
+{
+
+    /*! Shared pool of worker threads for the parallel methods, worker threads are
+        started lazily on the first parallel call and reused by all next calls. */
+    class SHAREDLIB_EXPORT ThreadPool
+    {
+        Q_DISABLE_COPY_MOVE(ThreadPool)
+
+    public:
+        /*! Get the shared thread pool instance. */
+        static ThreadPool &instance();
+
+        /*! Invoke the callback for every index in [0, count) and wait for all of them,
+            the index 0 is processed by the calling thread, the first exception is
+            rethrown after all indexes are processed. */
+        void parallelFor(std::size_t count,
+                         const std::function<void(std::size_t index)> &callback);
+
+        /*! Get the number of worker threads. */
+        inline std::size_t threadsCount() const noexcept;
+
+    private:
+        /*! Private constructor, use the instance() method. */
+        ThreadPool();
+        /*! Private destructor, the shared instance is never destroyed. */
+        ~ThreadPool() = default;
+
+        /*! Start worker threads if they are not already started. */
+        void startWorkers();
+        /*! Process queued tasks, the worker thread function. */
+        void workerLoop();
+
+        /*! The number of worker threads. */
+        std::size_t m_threadsCount;
+        /*! The number of already started worker threads. */
+        std::size_t m_workersCount = 0;
+        /*! Tasks waiting for a worker thread. */
+        std::deque<std::function<void()>> m_tasks {};
+        /*! Mutex protecting the tasks queue and workers. */
+        std::mutex m_mutex {};
+        /*! Signals that a new task was queued. */
+        std::condition_variable m_taskQueued {};
+        /*! Signals that a task was finished. */
+        std::condition_variable m_taskFinished {};
+    };
+
+    /* public */
+
+    std::size_t ThreadPool::threadsCount() const noexcept
+    {
+        return m_threadsCount;
+    }
+
+} // namespace Orm::Utils
+
+TINYORM_END_COMMON_NAMESPACE
+
+#endif // ORM_UTILS_THREADPOOL_HPP
@@ -58,6 +58,10 @@ QString BaseGrammar::wrap(const QString &value, const bool prefixAlias) const
 //    if (isJsonSelector(value))
 //        return wrapJsonSelector(value);
 
+    // Not qualified, wrap the value directly without splitting it into segments
+    if (!value.contains(DOT))
+        return wrapValue(value);
+
     return wrapSegments(value.split(DOT));
 }
 
@@ -0,0 +1,140 @@
+#include "orm/concerns/detectsnplusonequeries.hpp"
+
+#include <typeindex>
+
+#include "orm/databaseconnection.hpp"
+#include "orm/exceptions/nplusonequeryerror.hpp"
+#include "orm/macros/threadlocal.hpp"
+#include "orm/utils/type.hpp"
+
+TINYORM_BEGIN_COMMON_NAMESPACE
+
+using TypeUtils = Orm::Utils::Type;
+
+namespace Orm::Concerns
+{
+
+/* The g_lazyRelationLoading variable has to live in the dll, it's set from the header
+   only Model and read by the DatabaseConnection. */
+
+namespace
+{
+    /*! The innermost relation being lazy loaded on the current thread. */
+    T_THREAD_LOCAL
+    LazyRelationLoading *g_lazyRelationLoading = nullptr;
+} // namespace
+
+/* DetectsNPlusOneQueries */
+
+/* public */
+
+bool DetectsNPlusOneQueries::detectingNPlusOne() const
+{
+    return m_detectingNPlusOne;
+}
+
+DatabaseConnection &
+DetectsNPlusOneQueries::enableNPlusOneDetector(const qint64 threshold,
+                                               const NPlusOneAction action)
+{
+    m_detectingNPlusOne = true;
+    m_nPlusOneThreshold = std::max<qint64>(threshold, 2);
+    m_nPlusOneAction = action;
+
+    return resetNPlusOneDetector();
+}
+
+DatabaseConnection &DetectsNPlusOneQueries::disableNPlusOneDetector()
+{
+    m_detectingNPlusOne = false;
+
+    return resetNPlusOneDetector();
+}
+
+DatabaseConnection &DetectsNPlusOneQueries::resetNPlusOneDetector()
+{
+    m_lazyQueries.clear();
+    m_nPlusOneViolations.clear();
+
+    return databaseConnection();
+}
+
+const QVector<NPlusOneViolation> &
+DetectsNPlusOneQueries::getNPlusOneViolations() const
+{
+    return m_nPlusOneViolations;
+}
+
+/* protected */
+
+void DetectsNPlusOneQueries::detectNPlusOne(const QString &queryString)
+{
+    // Nothing to do, the query wasn't executed by the lazy relation loading
+    if (g_lazyRelationLoading == nullptr)
+        return;
+
+    auto relation = LazyRelationLoading::current();
+
+    /* The query string contains placeholders so it's the same for all queries that
+       differ only in bindings. */
+    const auto count = ++m_lazyQueries[QStringLiteral("%1\n%2").arg(relation,
+                                                                     queryString)];
+
+    // Report every N+1 query only once in the scope
+    if (count != m_nPlusOneThreshold)
+        return;
+
+    m_nPlusOneViolations.append({std::move(relation), queryString, count});
+
+    const auto &violation = m_nPlusOneViolations.constLast();
+
+    if (m_nPlusOneAction == NPlusOneAction::Throw)
+        throw Exceptions::NPlusOneQueryError(violation);
+
+    qWarning().noquote()
+            << QStringLiteral("N+1 query detected on the '%1' connection, the '%2' "
+                              "relation was lazy loaded %3 times using the query: %4")
+               .arg(databaseConnection().getName(), violation.relation)
+               .arg(violation.count).arg(violation.queryString);
+}
+
+/* private */
+
+DatabaseConnection &DetectsNPlusOneQueries::databaseConnection()
+{
+    return dynamic_cast<DatabaseConnection &>(*this);
+}
+
+/* LazyRelationLoading */
+
+/* public */
+
+LazyRelationLoading::LazyRelationLoading(const std::type_info &model,
+                                         const QString &relation)
+    : m_model(model)
+    , m_relation(relation)
+    , m_previous(g_lazyRelationLoading)
+{
+    g_lazyRelationLoading = this;
+}
+
+LazyRelationLoading::~LazyRelationLoading()
+{
+    g_lazyRelationLoading = m_previous;
+}
+
+QString LazyRelationLoading::current()
+{
+    if (g_lazyRelationLoading == nullptr)
+        return {};
+
+    // The class name is obtained lazily, only when it's really needed
+    return QStringLiteral("%1::%2")
+            .arg(TypeUtils::classPureBasename(
+                     std::type_index(g_lazyRelationLoading->m_model)),
+                 g_lazyRelationLoading->m_relation);
+}
+
+} // namespace Orm::Concerns
+
+TINYORM_END_COMMON_NAMESPACE
@@ -4,10 +4,13 @@
 #  include <QDebug>
 #endif
 
+#include <QDataStream>
+#include <QRegularExpression>
 #include <QtSql/QSqlRecord>
 
 #include "orm/exceptions/lostconnectionerror.hpp"
 #include "orm/exceptions/multiplecolumnsselectederror.hpp"
+#include "orm/query/cache/cachedsqlresult.hpp"
 #include "orm/query/querybuilder.hpp"
 #include "orm/utils/configuration.hpp"
 #include "orm/utils/type.hpp"
@@ -18,9 +21,97 @@ using Orm::Utils::Helpers;
 
 using ConfigUtils = Orm::Utils::Configuration;
 
+using Orm::Query::Cache::CachedSqlResult;
+using Orm::Query::Cache::QueryCache;
+using Orm::Query::Cache::QueryCacheEntry;
+
 namespace Orm
 {
 
+namespace
+{
+    /*! Determine whether the given query only reads data. */
+    bool isSelectQuery(const QString &queryString)
+    {
+        const auto query = QStringView(queryString).trimmed();
+
+        return query.startsWith(QStringLiteral("select"), Qt::CaseInsensitive) ||
+               query.startsWith(QStringLiteral("(select"), Qt::CaseInsensitive);
+    }
+
+    /*! Normalize the given table name for the query cache (lowercase without
+        the alias, schema, and quotes). */
+    QString normalizeCacheTable(const QString &table, const QString &tablePrefix = "")
+    {
+        // Remove the alias (eg. torrents as t)
+        auto name = table.trimmed().section(QLatin1Char(' '), 0, 0);
+
+        // Remove the schema (eg. public.torrents)
+        name = name.section(QLatin1Char('.'), -1);
+
+        name.remove(QLatin1Char('"')).remove(QLatin1Char('`'))
+            .remove(QLatin1Char('[')).remove(QLatin1Char(']'));
+
+        return (tablePrefix + name).toLower();
+    }
+
+    /*! Get the table modified by the given write query, the std::nullopt means that
+        the modified table is unknown (eg. DDL queries or joins). */
+    std::optional<QString> writtenTable(const QString &queryString)
+    {
+        static const QRegularExpression regex(
+                    QStringLiteral(
+                        R"(^\s*(?:insert(?:\s+or\s+\w+)?(?:\s+ignore)?\s+into|)"
+                        R"(update(?:\s+ignore)?|delete\s+from)\s+([^\s(]+))"),
+                    QRegularExpression::CaseInsensitiveOption);
+
+        // Joined tables can be modified by the MySQL update/delete statements
+        if (queryString.contains(QStringLiteral(" join "), Qt::CaseInsensitive))
+            return std::nullopt;
+
+        const auto match = regex.match(queryString);
+
+        if (!match.hasMatch())
+            return std::nullopt;
+
+        // The table name already contains the table prefix
+        return normalizeCacheTable(match.captured(1));
+    }
+
+    /*! Get the query cache scope, connections to the same database share it. */
+    QString queryCacheScope(const QVariantHash &config, const QString &database,
+                            const QString &connection)
+    {
+        // Every in-memory SQLite connection has its own database
+        if (database == QStringLiteral(":memory:"))
+            return QStringLiteral("%1\n%2").arg(database, connection);
+
+        return QStringLiteral("%1\n%2\n%3\n%4")
+                .arg(config.value(driver_).value<QString>(),
+                     config.value(host_).value<QString>(),
+                     config.value(port_).value<QString>(),
+                     database);
+    }
+
+    /*! Create the query cache key from the cache scope, query, and bindings. */
+    QByteArray queryCacheKey(const QString &scope, const QString &queryString,
+                             const QVector<QVariant> &bindings)
+    {
+        QByteArray key;
+        key.reserve(queryString.size() * 2 + 64);
+
+        QDataStream stream(&key, QIODevice::WriteOnly);
+        stream << scope << queryString << bindings;
+
+        return key;
+    }
+} // namespace
+
+/* DatabaseConnection */
+
+std::shared_ptr<QueryCache>
+DatabaseConnection::m_queryCache = nullptr;
+
 /*!
     \class DatabaseConnection
     \brief The DatabaseConnection class handles a connection to the database.
@@ -54,6 +145,7 @@ DatabaseConnection::DatabaseConnection(
     , m_config(std::move(config))
     , m_connectionName(getConfig(NAME).value<QString>())
     , m_hostName(getConfig(host_).value<QString>())
+    , m_queryCacheScope(queryCacheScope(m_config, m_database, m_connectionName))
 {}
 
 DatabaseConnection::DatabaseConnection(
@@ -70,6 +162,7 @@ DatabaseConnection::DatabaseConnection(
     , m_config(std::move(config))
     , m_connectionName(getConfig(NAME).value<QString>())
     , m_hostName(getConfig(host_).value<QString>())
+    , m_queryCacheScope(queryCacheScope(m_config, m_database, m_connectionName))
 {}
 
 std::shared_ptr<QueryBuilder>
@@ -112,39 +205,62 @@ std::shared_ptr<QueryBuilder> DatabaseConnection::query()
 SqlQuery
 DatabaseConnection::select(const QString &queryString, QVector<QVariant> bindings)
 {
-    auto queryResult = run<QSqlQuery>(
-                           queryString, std::move(bindings), Prepared,
-                           [this](const QString &queryString_,
-                                  const QVector<QVariant> &preparedBindings)
-                           -> QSqlQuery
-    {
-        if (m_pretending)
-            return getQtQueryForPretend();
+    return selectInternal(queryString, std::move(bindings), false,
+                          "DatabaseConnection::select");
+}
 
-        // Prepare QSqlQuery
-        auto query = prepareQuery(queryString_);
+SqlQuery
+DatabaseConnection::cursor(const QString &queryString, QVector<QVariant> bindings)
+{
+    return selectInternal(queryString, std::move(bindings), true,
+                          "DatabaseConnection::cursor");
+}
 
-        bindValues(query, preparedBindings);
+SqlQuery
+DatabaseConnection::selectRemembered(
+        const QString &queryString, QVector<QVariant> bindings,
+        const std::chrono::milliseconds ttl, const QStringList &tables)
+{
+    /* Pretended queries must be logged, and rows read inside a transaction can
+       contain uncommitted changes that would stay cached after the rollBack(). */
+    if (m_pretending || !m_queryCache || ttl <= std::chrono::milliseconds::zero() ||
+        inTransaction()
+    )
+        return select(queryString, std::move(bindings));
 
-        if (query.exec()) {
-            // Query statements counter
-            if (m_countingStatements)
-                ++m_statementsCounter.normal;
+    auto key = queryCacheKey(m_queryCacheScope, queryString, bindings);
 
-            return query;
-        }
+    if (auto entry = m_queryCache->get(key); entry)
+        return cachedQuery(std::move(entry));
 
-        /* If an error occurs when attempting to run a query, we'll transform it
-           to the exception QueryError(), which formats the error message to
-           include the bindings with SQL, which will make this exception a lot
-           more helpful to the developer instead of just the database's errors. */
-        throw Exceptions::QueryError(
-                    m_connectionName,
-                    "Select statement in DatabaseConnection::select() failed.",
-                    query, preparedBindings);
-    });
+    auto query = select(queryString, std::move(bindings));
 
-    return {std::move(queryResult), m_qtTimeZone, *m_queryGrammar, m_returnQDateTime};
+    auto entry = std::make_shared<QueryCacheEntry>();
+    entry->scope = m_queryCacheScope;
+    entry->record = query.record();
+    entry->expiresAt = std::chrono::steady_clock::now() + ttl;
+
+    entry->tables.reserve(tables.size());
+    for (const auto &table : tables)
+        entry->tables << normalizeCacheTable(table, m_tablePrefix);
+
+    const auto fieldsCount = entry->record.count();
+
+    while (query.next()) {
+        QVector<QVariant> row;
+        row.reserve(fieldsCount);
+
+        /* Raw values are cached, the SqlQuery returned from the cache converts
+           the QDateTime's time zone the same way as the original SqlQuery. */
+        for (int i = 0; i < fieldsCount; ++i)
+            row << query.QSqlQuery::value(i);
+
+        entry->rows << std::move(row);
+    }
+
+    m_queryCache->put(key, entry);
+
+    return cachedQuery(std::move(entry));
 }
 
 SqlQuery
@@ -197,6 +313,7 @@ DatabaseConnection::statement(const QString &queryString, QVector<QVariant> bind
                 ++m_statementsCounter.normal;
 
             recordsHaveBeenModified();
+            invalidateQueryCache(queryString_);
 
             return query;
         }
@@ -242,6 +359,9 @@ DatabaseConnection::affectingStatement(const QString &queryString,
 
             recordsHaveBeenModified(numRowsAffected > 0);
 
+            if (numRowsAffected != 0)
+                invalidateQueryCache(queryString_);
+
             return {numRowsAffected, query};
         }
 
@@ -277,6 +397,7 @@ SqlQuery DatabaseConnection::unprepared(const QString &queryString)
                 ++m_statementsCounter.normal;
 
             recordsHaveBeenModified();
+            invalidateQueryCache(queryString_);
 
             return query;
         }
@@ -607,19 +728,89 @@ void DatabaseConnection::useDefaultPostProcessor()
 
 /* private */
 
-QSqlQuery DatabaseConnection::prepareQuery(const QString &queryString)
+SqlQuery
+DatabaseConnection::selectInternal(
+        const QString &queryString, QVector<QVariant> &&bindings, const bool forwardOnly,
+        const char *const functionName)
+{
+    auto queryResult = run<QSqlQuery>(
+                           queryString, std::move(bindings), Prepared,
+                           [this, forwardOnly, functionName]
+                           (const QString &queryString_,
+                            const QVector<QVariant> &preparedBindings)
+                           -> QSqlQuery
+    {
+        if (m_pretending)
+            return getQtQueryForPretend();
+
+        // Prepare QSqlQuery
+        auto query = prepareQuery(queryString_, forwardOnly);
+
+        bindValues(query, preparedBindings);
+
+        if (query.exec()) {
+            // Query statements counter
+            if (m_countingStatements)
+                ++m_statementsCounter.normal;
+
+            // Insert/update/delete queries with the returning clause
+            if (!isSelectQuery(queryString_))
+                invalidateQueryCache(queryString_);
+
+            return query;
+        }
+
+        /* If an error occurs when attempting to run a query, we'll transform it
+           to the exception QueryError(), which formats the error message to
+           include the bindings with SQL, which will make this exception a lot
+           more helpful to the developer instead of just the database's errors. */
+        throw Exceptions::QueryError(
+                    m_connectionName,
+                    QStringLiteral("Select statement in %1() failed.")
+                        .arg(QLatin1String(functionName)),
+                    query, preparedBindings);
+    });
+
+    return {std::move(queryResult), m_qtTimeZone, *m_queryGrammar, m_returnQDateTime};
+}
+
+QSqlQuery
+DatabaseConnection::prepareQuery(const QString &queryString, const bool forwardOnly)
 {
     // Prepare query string
     auto query = getQtQuery();
 
-    // TODO solve setForwardOnly() in DatabaseConnection class, again this problem 🤔 silverqx
-//    query.setForwardOnly(m_forwardOnly);
+    /* Forward-only queries don't cache already fetched rows, so they are used
+       by the cursor() to iterate huge results using the constant memory. */
+    query.setForwardOnly(forwardOnly);
 
     query.prepare(queryString);
 
     return query;
 }
 
+void DatabaseConnection::invalidateQueryCache(const QString &queryString) const
+{
+    // Nothing to invalidate
+    if (!m_queryCache || m_queryCache->isEmpty())
+        return;
+
+    if (const auto table = writtenTable(queryString); table)
+        m_queryCache->invalidate(m_queryCacheScope, *table);
+    // Unknown modified table (eg. DDL queries), invalidate the whole database
+    else
+        m_queryCache->flush(m_queryCacheScope);
+}
+
+SqlQuery
+DatabaseConnection::cachedQuery(std::shared_ptr<const QueryCacheEntry> &&entry)
+{
+    // The QSqlQuery takes ownership of the QSqlResult
+    QSqlQuery query(new CachedSqlResult(getQtConnection().driver(), std::move(entry)));
+
+    return {std::move(query), m_qtTimeZone, *m_queryGrammar, m_returnQDateTime};
+}
+
 QDateTime DatabaseConnection::prepareBinding(const QDateTime &binding) const
 {
     /* Nothing to convert, the qt_timezone config. option is not valid or was not defined
@@ -1,5 +1,7 @@
 #include "orm/databasemanager.hpp"
 
+#include <atomic>
+
 #include <range/v3/view/map.hpp>
 
 #include "orm/concerns/hasconnectionresolver.hpp"
@@ -22,6 +24,8 @@ DatabaseManager::~DatabaseManager() = default;
 
 std::shared_ptr<DatabaseManager> DatabaseManager::m_instance;
 
+std::mutex DatabaseManager::m_workerConnectionsMutex;
+
 DatabaseManager::DatabaseManager(const QString &defaultConnection)
 {
     Configuration::defaultConnection = defaultConnection;
@@ -368,6 +372,63 @@ bool DatabaseManager::containsConnection(const QString &name)
     return m_connections->contains(name);
 }
 
+QString DatabaseManager::addWorkerConnection(const QString &connection)
+{
+    // Every worker connection has a unique name to avoid QSqlDatabase name conflicts
+    static std::atomic<quint64> workerConnectionId = 0;
+
+    const auto &name = parseConnectionName(connection);
+
+    auto workerName = QStringLiteral("%1-worker-%2").arg(name)
+                      .arg(++workerConnectionId);
+
+    // Copy of the original configuration, it can be modified by the ConnectionFactory
+    auto config = originalConfig(name);
+
+    std::scoped_lock lock(m_workerConnectionsMutex);
+
+    m_workerConfigurations.emplace(workerName, std::move(config));
+
+    return workerName;
+}
+
+DatabaseConnection &DatabaseManager::workerConnection(const QString &name)
+{
+    /* Connections are thread-local, the worker connection is created in this thread
+       from its own configuration, so the main configuration is never modified. */
+    if (!m_connections->contains(name)) {
+        auto connection = makeWorkerConnection(name);
+
+        if (!connection)
+            throw Exceptions::InvalidArgumentError(
+                    QStringLiteral("Worker connection '%1' is not configured.")
+                    .arg(name));
+
+        m_connections->emplace(name, configure(std::move(connection)));
+    }
+
+    return *(*m_connections)[name];
+}
+
+bool DatabaseManager::removeWorkerConnection(const QString &name)
+{
+    if (const auto connection = m_connections->find(name);
+        connection != m_connections->end()
+    ) {
+        // Disconnect first to be nice 😁 and safe 😂
+        connection->second->disconnect();
+
+        m_connections->erase(connection);
+
+        // ~QSqlDatabase() internally also calls close()
+        QSqlDatabase::removeDatabase(name);
+    }
+
+    std::scoped_lock lock(m_workerConnectionsMutex);
+
+    return m_workerConfigurations.erase(name) > 0;
+}
+
 DatabaseConnection &DatabaseManager::reconnect(const QString &name)
 {
     const auto &name_ = parseConnectionName(name);
@@ -891,6 +952,10 @@ DatabaseManager::parseConnectionName(const QString &name) const
 std::shared_ptr<DatabaseConnection>
 DatabaseManager::makeConnection(const QString &connection)
 {
+    // The reconnect() of the worker connection
+    if (auto workerConnection = makeWorkerConnection(connection); workerConnection)
+        return workerConnection;
+
     auto &config = configuration(connection);
 
     // FUTURE add support for extensions silverqx
@@ -898,6 +963,19 @@ DatabaseManager::makeConnection(const QString &connection)
     return Connectors::ConnectionFactory::make(config, connection);
 }
 
+std::shared_ptr<DatabaseConnection>
+DatabaseManager::makeWorkerConnection(const QString &connection)
+{
+    std::scoped_lock lock(m_workerConnectionsMutex);
+
+    const auto config = m_workerConfigurations.find(connection);
+
+    if (config == m_workerConfigurations.end())
+        return nullptr;
+
+    return Connectors::ConnectionFactory::make(config->second, connection);
+}
+
 /* Can not be const because I'm modifying the Configuration (QVariantHash)
    in ConnectionFactory. */
 QVariantHash &
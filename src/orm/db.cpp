@@ -621,6 +621,35 @@ void DB::resetStatementCounters(const QStringList &connections)
     manager().resetStatementCounters(connections);
 }
 
+/* N+1 queries detector */
+
+bool DB::detectingNPlusOne(const QString &connection)
+{
+    return manager().connection(connection).detectingNPlusOne();
+}
+
+DatabaseConnection &
+DB::enableNPlusOneDetector(const qint64 threshold, const NPlusOneAction action,
+                           const QString &connection)
+{
+    return manager().connection(connection).enableNPlusOneDetector(threshold, action);
+}
+
+DatabaseConnection &DB::disableNPlusOneDetector(const QString &connection)
+{
+    return manager().connection(connection).disableNPlusOneDetector();
+}
+
+DatabaseConnection &DB::resetNPlusOneDetector(const QString &connection)
+{
+    return manager().connection(connection).resetNPlusOneDetector();
+}
+
+const QVector<NPlusOneViolation> &DB::getNPlusOneViolations(const QString &connection)
+{
+    return manager().connection(connection).getNPlusOneViolations();
+}
+
 /* private */
 
 DatabaseManager &DB::manager()
@@ -148,6 +148,39 @@ bool MySqlConnection::useUpsertAlias()
     return *m_useUpsertAlias;
 }
 
+quint64 MySqlConnection::autoIncrementIncrement()
+{
+    // Default value is 1 if pretending (MySQL default value)
+    if (m_pretending && !m_autoIncrementIncrement)
+        return 1;
+
+    // Return the cached value
+    if (m_autoIncrementIncrement)
+        return *m_autoIncrementIncrement;
+
+    // Obtain and cache the auto_increment_increment value
+    return *(m_autoIncrementIncrement =
+             scalar(QStringLiteral("select @@session.auto_increment_increment"))
+             .value<quint64>());
+}
+
+quint64 MySqlConnection::autoIncrementLockMode()
+{
+    /* Default value is 1 if pretending (consecutive lock mode), so the multi-rows
+       insert statement is logged the same way as for a real connection. */
+    if (m_pretending && !m_autoIncrementLockMode)
+        return 1;
+
+    // Return the cached value
+    if (m_autoIncrementLockMode)
+        return *m_autoIncrementLockMode;
+
+    // Obtain and cache the innodb_autoinc_lock_mode value (it's read-only at runtime)
+    return *(m_autoIncrementLockMode =
+             scalar(QStringLiteral("select @@global.innodb_autoinc_lock_mode"))
+             .value<quint64>());
+}
+
 #ifdef TINYORM_TESTS_CODE
 void MySqlConnection::setConfigVersion(const QString &value)
 {
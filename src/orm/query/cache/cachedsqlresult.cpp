@@ -0,0 +1,79 @@
+#include "orm/query/cache/cachedsqlresult.hpp"
+
+TINYORM_BEGIN_COMMON_NAMESPACE
+
+namespace Orm::Query::Cache
+{
+
+/* public */
+
+CachedSqlResult::CachedSqlResult(const QSqlDriver *const driver,
+                                 std::shared_ptr<const QueryCacheEntry> entry)
+    : QSqlResult(driver)
+    , m_entry(std::move(entry))
+{
+    setSelect(true);
+    setActive(true);
+    setAt(QSql::BeforeFirstRow);
+}
+
+/* protected */
+
+QVariant CachedSqlResult::data(const int index)
+{
+    const auto &row = m_entry->rows.at(at());
+
+    if (index < 0 || index >= row.size())
+        return {};
+
+    return row.at(index);
+}
+
+bool CachedSqlResult::isNull(const int index)
+{
+    return data(index).isNull();
+}
+
+bool CachedSqlResult::reset(const QString &/*unused*/)
+{
+    return false;
+}
+
+bool CachedSqlResult::fetch(const int index)
+{
+    if (index < 0 || index >= rowsCount())
+        return false;
+
+    setAt(index);
+
+    return true;
+}
+
+bool CachedSqlResult::fetchFirst()
+{
+    return fetch(0);
+}
+
+bool CachedSqlResult::fetchLast()
+{
+    return fetch(rowsCount() - 1);
+}
+
+int CachedSqlResult::size()
+{
+    return rowsCount();
+}
+
+int CachedSqlResult::numRowsAffected()
+{
+    return -1;
+}
+
+QSqlRecord CachedSqlResult::record() const
+{
+    return m_entry->record;
+}
+
+} // namespace Orm::Query::Cache
+
+TINYORM_END_COMMON_NAMESPACE
@@ -0,0 +1,213 @@
+#include "orm/query/cache/lruquerycache.hpp"
+
+TINYORM_BEGIN_COMMON_NAMESPACE
+
+namespace Orm::Query::Cache
+{
+
+/* public */
+
+LruQueryCache::LruQueryCache(const quint64 maxEntries, const quint64 maxBytes)
+    : m_maxEntries(maxEntries)
+    , m_maxBytes(maxBytes)
+{}
+
+std::shared_ptr<const QueryCacheEntry> LruQueryCache::get(const QByteArray &key)
+{
+    std::scoped_lock lock(m_mutex);
+
+    const auto itNode = m_entries.find(key);
+
+    if (itNode == m_entries.end()) {
+        ++m_stats.misses;
+        return nullptr;
+    }
+
+    if (itNode->entry->expiresAt <= std::chrono::steady_clock::now()) {
+        removeEntry(key);
+
+        ++m_stats.misses;
+        return nullptr;
+    }
+
+    // Mark as the most recently used
+    m_lru.splice(m_lru.begin(), m_lru, itNode->position);
+
+    ++m_stats.hits;
+
+    return itNode->entry;
+}
+
+void LruQueryCache::put(const QByteArray &key,
+                        std::shared_ptr<const QueryCacheEntry> entry)
+{
+    const auto bytes = estimateSize(key, *entry);
+
+    std::scoped_lock lock(m_mutex);
+
+    removeEntry(key);
+
+    // Nothing to do, the entry alone exceeds the memory limit
+    if (bytes > m_maxBytes || m_maxEntries == 0)
+        return;
+
+    const auto tables = entry->tables.isEmpty() ? QStringList {QString()}
+                                                : entry->tables;
+    for (const auto &table : tables)
+        m_tags[tag(entry->scope, table)].insert(key);
+
+    m_lru.push_front(key);
+    m_entries.insert(key, {std::move(entry), m_lru.begin(), bytes});
+
+    m_stats.bytes += bytes;
+    ++m_stats.puts;
+    m_size = static_cast<quint64>(m_entries.size());
+
+    evict();
+}
+
+void LruQueryCache::invalidate(const QString &scope, const QString &table)
+{
+    std::scoped_lock lock(m_mutex);
+
+    QSet<QByteArray> keys;
+
+    // Entries with unknown tables are invalidated by a write to any table
+    for (const auto &tagKey : {tag(scope, table), tag(scope, {})})
+        if (const auto itTag = m_tags.constFind(tagKey); itTag != m_tags.cend())
+            keys.unite(*itTag);
+
+    for (const auto &key : std::as_const(keys))
+        removeEntry(key);
+
+    m_stats.invalidations += static_cast<quint64>(keys.size());
+}
+
+void LruQueryCache::flush(const QString &scope)
+{
+    std::scoped_lock lock(m_mutex);
+
+    QVector<QByteArray> keys;
+
+    for (auto itNode = m_entries.cbegin(); itNode != m_entries.cend(); ++itNode)
+        if (itNode->entry->scope == scope)
+            keys << itNode.key();
+
+    for (const auto &key : std::as_const(keys))
+        removeEntry(key);
+
+    m_stats.invalidations += static_cast<quint64>(keys.size());
+}
+
+void LruQueryCache::flush()
+{
+    std::scoped_lock lock(m_mutex);
+
+    m_stats.invalidations += static_cast<quint64>(m_entries.size());
+    m_stats.bytes = 0;
+
+    m_entries.clear();
+    m_lru.clear();
+    m_tags.clear();
+    m_size = 0;
+}
+
+bool LruQueryCache::isEmpty() const
+{
+    return m_size == 0;
+}
+
+QueryCacheStats LruQueryCache::stats() const
+{
+    std::scoped_lock lock(m_mutex);
+
+    auto stats = m_stats;
+    stats.entries = static_cast<quint64>(m_entries.size());
+
+    return stats;
+}
+
+/* private */
+
+void LruQueryCache::removeEntry(const QByteArray &key)
+{
+    const auto itNode = m_entries.find(key);
+
+    if (itNode == m_entries.end())
+        return;
+
+    const auto &entry = *itNode->entry;
+
+    const auto tables = entry.tables.isEmpty() ? QStringList {QString()}
+                                               : entry.tables;
+    for (const auto &table : tables) {
+        const auto tagKey = tag(entry.scope, table);
+
+        if (auto itTag = m_tags.find(tagKey); itTag != m_tags.end()) {
+            itTag->remove(key);
+
+            if (itTag->isEmpty())
+                m_tags.erase(itTag);
+        }
+    }
+
+    m_lru.erase(itNode->position);
+    m_stats.bytes -= itNode->bytes;
+
+    m_entries.erase(itNode);
+    m_size = static_cast<quint64>(m_entries.size());
+}
+
+void LruQueryCache::evict()
+{
+    while (!m_lru.empty() &&
+           (static_cast<quint64>(m_entries.size()) > m_maxEntries ||
+            m_stats.bytes > m_maxBytes)
+    ) {
+        // Copy is needed as the removeEntry() erases the key from the LRU list
+        const auto key = m_lru.back();
+
+        removeEntry(key);
+
+        ++m_stats.evictions;
+    }
+}
+
+QString LruQueryCache::tag(const QString &scope, const QString &table)
+{
+    return QStringLiteral("%1\n%2").arg(scope, table);
+}
+
+quint64 LruQueryCache::estimateSize(const QByteArray &key, const QueryCacheEntry &entry)
+{
+    // Rough estimate of the QVariant and its heap allocated data
+    static const auto variantSize = [](const QVariant &value) -> quint64
+    {
+        constexpr quint64 overhead = sizeof (QVariant);
+
+        switch (value.userType()) {
+        case QMetaType::QString:
+            return overhead + (static_cast<quint64>(value.toString().size()) *
+                               sizeof (QChar));
+        case QMetaType::QByteArray:
+            return overhead + static_cast<quint64>(value.toByteArray().size());
+        default:
+            return overhead;
+        }
+    };
+
+    auto bytes = static_cast<quint64>(key.size()) + sizeof (QueryCacheEntry);
+
+    for (const auto &row : entry.rows) {
+        bytes += sizeof (QVector<QVariant>);
+
+        for (const auto &value : row)
+            bytes += variantSize(value);
+    }
+
+    return bytes;
+}
+
+} // namespace Orm::Query::Cache
+
+TINYORM_END_COMMON_NAMESPACE
@@ -1,6 +1,11 @@
 #include "orm/query/concerns/buildsqueries.hpp"
 
+#include <condition_variable>
+#include <thread>
+
 #include "orm/databaseconnection.hpp"
+#include "orm/databasemanager.hpp"
+#include "orm/exceptions/invalidargumenterror.hpp"
 #include "orm/exceptions/multiplerecordsfounderror.hpp"
 #include "orm/exceptions/recordsnotfounderror.hpp"
 #include "orm/query/querybuilder.hpp"
@@ -13,6 +18,228 @@ using QueryUtils = Orm::Utils::Query;
 namespace Orm::Query::Concerns
 {
 
+namespace
+{
+    /*! Fetches chunks of the query results by comparing IDs (used by lazyById()). */
+    class KeysetPager
+    {
+    public:
+        /*! Constructor. */
+        KeysetPager(Builder &&query, qint64 count, QString column, QString alias);
+
+        /*! Fetch the next chunk, an empty vector means there are no more records. */
+        QVector<QSqlRecord> nextPage();
+        /*! Determine whether the last chunk was already fetched. */
+        bool isFinished() const noexcept;
+
+    private:
+        /*! Query that is chunked. */
+        Builder m_query;
+        /*! Number of records in one chunk. */
+        qint64 m_count;
+        /*! Column name used to compare IDs. */
+        QString m_column;
+        /*! Alias of the ID column in the query result. */
+        QString m_alias;
+        /*! ID of the last record in the last fetched chunk. */
+        QVariant m_lastId;
+        /*! Determine whether the last chunk was already fetched. */
+        bool m_finished = false;
+    };
+
+    KeysetPager::KeysetPager(Builder &&query, const qint64 count, QString column,
+                             QString alias)
+        : m_query(std::move(query))
+        , m_count(count)
+        , m_column(std::move(column))
+        , m_alias(std::move(alias))
+    {}
+
+    QVector<QSqlRecord> KeysetPager::nextPage()
+    {
+        if (m_finished)
+            return {};
+
+        /* We'll execute the query for the given page and get the results, records
+           are copied out of the SqlQuery, so they can be passed between threads. */
+        auto results = m_query.clone().forPageAfterId(m_count, m_lastId, m_column, true)
+                       .get();
+
+        QVector<QSqlRecord> page;
+        page.reserve(static_cast<QVector<QSqlRecord>::size_type>(m_count));
+
+        while (results.next()) {
+            auto record = results.record();
+
+            // SqlQuery::value() also correctly handles the QDateTime's time zone
+            for (int i = 0; i < record.count(); ++i)
+                record.setValue(i, results.value(i));
+
+            page << std::move(record);
+        }
+
+        if (page.size() < m_count)
+            m_finished = true;
+
+        if (page.isEmpty())
+            return page;
+
+        m_lastId = page.constLast().value(m_alias);
+
+        if (!m_lastId.isValid() || m_lastId.isNull())
+            throw Exceptions::RuntimeError(
+                    QStringLiteral("The lazyById operation was aborted because the "
+                                   "[%1] column is not present in the query result.")
+                    .arg(m_alias));
+
+        return page;
+    }
+
+    bool KeysetPager::isFinished() const noexcept
+    {
+        return m_finished;
+    }
+
+    /*! Fetches chunks of the query results by comparing IDs using the worker
+        connection in the worker thread, the next chunk is fetched while the current
+        chunk is processed by the consumer. */
+    class PrefetchingPager
+    {
+        Q_DISABLE_COPY_MOVE(PrefetchingPager)
+
+    public:
+        /*! Constructor. */
+        PrefetchingPager(const Builder &query, qint64 count, QString column,
+                         QString alias);
+        /*! Destructor, stops the worker thread. */
+        ~PrefetchingPager();
+
+        /*! Fetch the next chunk, an empty vector means there are no more records. */
+        QVector<QSqlRecord> nextPage();
+
+    private:
+        /*! Worker thread function that fetches chunks. */
+        void run(Builder &&query, qint64 count, QString &&column, QString &&alias);
+
+        /*! Guards all data members below that are shared with the worker thread. */
+        std::mutex m_mutex;
+        /*! Signals the prefetched chunk was taken or the new chunk is ready. */
+        std::condition_variable m_condition;
+        /*! The prefetched chunk, only one chunk can be prefetched ahead. */
+        std::optional<QVector<QSqlRecord>> m_page;
+        /*! Exception thrown in the worker thread. */
+        std::exception_ptr m_exception;
+        /*! Determine whether the worker thread fetched the last chunk. */
+        bool m_finished = false;
+        /*! Determine whether the consumer took the last chunk. */
+        bool m_exhausted = false;
+        /*! Determine whether the worker thread should stop. */
+        bool m_stop = false;
+
+        /*! Name of the worker connection. */
+        QString m_workerConnection;
+        /*! Worker thread that fetches chunks. */
+        std::thread m_worker;
+    };
+
+    PrefetchingPager::PrefetchingPager(const Builder &query, const qint64 count,
+                                       QString column, QString alias)
+        : m_workerConnection(DatabaseManager::reference()
+                             .addWorkerConnection(query.getConnection().getName()))
+        , m_worker(&PrefetchingPager::run, this, query.clone(), count,
+                   std::move(column), std::move(alias))
+    {}
+
+    PrefetchingPager::~PrefetchingPager()
+    {
+        {
+            std::scoped_lock lock(m_mutex);
+            m_stop = true;
+        }
+
+        m_condition.notify_all();
+
+        if (m_worker.joinable())
+            m_worker.join();
+    }
+
+    QVector<QSqlRecord> PrefetchingPager::nextPage()
+    {
+        std::unique_lock lock(m_mutex);
+
+        if (m_exhausted)
+            return {};
+
+        m_condition.wait(lock, [this]
+        {
+            return m_page.has_value() || m_exception;
+        });
+
+        if (!m_page)
+            std::rethrow_exception(m_exception);
+
+        auto page = std::move(*m_page);
+        m_page.reset();
+
+        m_exhausted = m_finished;
+
+        lock.unlock();
+        // The worker thread can start fetching the next chunk
+        m_condition.notify_all();
+
+        return page;
+    }
+
+    void PrefetchingPager::run(Builder &&query, const qint64 count, QString &&column,
+                               QString &&alias)
+    {
+        auto &manager = DatabaseManager::reference();
+
+        try {
+            // The worker connection must be created in the thread that uses it
+            KeysetPager pager(
+                        query.cloneOnConnection(
+                            manager.workerConnection(m_workerConnection)
+                            .shared_from_this()),
+                        count, std::move(column), std::move(alias));
+
+            while (true) {
+                auto page = pager.nextPage();
+
+                std::unique_lock lock(m_mutex);
+
+                // Wait until the consumer takes the previously prefetched chunk
+                m_condition.wait(lock, [this]
+                {
+                    return m_stop || !m_page.has_value();
+                });
+
+                if (m_stop)
+                    break;
+
+                m_page = std::move(page);
+                m_finished = pager.isFinished();
+
+                lock.unlock();
+                m_condition.notify_all();
+
+                if (pager.isFinished())
+                    break;
+            }
+        } catch (...) {
+            {
+                std::scoped_lock lock(m_mutex);
+                m_exception = std::current_exception();
+            }
+
+            m_condition.notify_all();
+        }
+
+        manager.removeWorkerConnection(m_workerConnection);
+    }
+
+} // namespace
+
 /* public */
 
 bool BuildsQueries::chunk(const qint64 count,
@@ -171,6 +398,206 @@ bool BuildsQueries::eachById(
     }, column, alias);
 }
 
+LazyRange<QSqlRecord>
+BuildsQueries::lazyById(const qint64 count, const QString &column,
+                        const QString &alias, const bool prefetch)
+{
+    if (count < 1)
+        throw Exceptions::InvalidArgumentError(
+                QStringLiteral("The 'count' argument must be greater than 0 in %1().")
+                .arg(__tiny_func__));
+
+    auto columnName = column.isEmpty() ? builder().defaultKeyName() : column;
+    auto aliasName = alias.isEmpty() ? columnName : alias;
+
+    /*! State of the lazy range, the std::function callback must be copyable. */
+    struct LazyByIdState
+    {
+        /*! Fetches chunks in the current thread. */
+        std::optional<KeysetPager> pager;
+        /*! Fetches chunks in the worker thread. */
+        std::unique_ptr<PrefetchingPager> prefetchingPager;
+        /*! The current chunk. */
+        QVector<QSqlRecord> page;
+        /*! Index of the current record in the current chunk. */
+        QVector<QSqlRecord>::size_type index = 0;
+    };
+
+    auto state = std::make_shared<LazyByIdState>();
+
+    if (prefetch && canUseWorkerConnections())
+        state->prefetchingPager = std::make_unique<PrefetchingPager>(
+                                      builder(), count, std::move(columnName),
+                                      std::move(aliasName));
+    else
+        state->pager.emplace(builder().clone(), count, std::move(columnName),
+                             std::move(aliasName));
+
+    return LazyRange<QSqlRecord>([state = std::move(state)]() -> QSqlRecord *
+    {
+        // Fetch the next chunk if the current chunk was already processed
+        if (state->index >= state->page.size()) {
+            state->page = state->prefetchingPager ? state->prefetchingPager->nextPage()
+                                                  : state->pager->nextPage();
+            state->index = 0;
+
+            // No more records
+            if (state->page.isEmpty())
+                return nullptr;
+        }
+
+        return &state->page[state->index++];
+    });
+}
+
+bool BuildsQueries::chunkByIdParallel(
+        const qint64 count, const int workers,
+        const std::function<bool(SqlQuery &, qint64)> &callback,
+        const QString &column, const QString &alias)
+{
+    const auto columnName = column.isEmpty() ? builder().defaultKeyName() : column;
+
+    return eachIdRangeParallel(workers, [count, &callback, &columnName, &alias]
+                                        (Builder &query, const std::atomic_bool &stopped)
+    {
+        return query.chunkById(count, [&callback, &stopped]
+                                      (SqlQuery &results, const qint64 page)
+        {
+            // Some other worker failed or its callback returned false
+            if (stopped)
+                return false;
+
+            return std::invoke(callback, results, page);
+        },
+            columnName, alias);
+    },
+        columnName);
+}
+
+bool BuildsQueries::eachIdRangeParallel(
+        const int workers,
+        const std::function<bool(Builder &, const std::atomic_bool &)> &callback,
+        const QString &column)
+{
+    if (workers < 1)
+        throw Exceptions::InvalidArgumentError(
+                QStringLiteral("The 'workers' argument must be greater than 0 in %1().")
+                .arg(__tiny_func__));
+
+    const auto columnName = column.isEmpty() ? builder().defaultKeyName() : column;
+
+    std::atomic_bool stopped = false;
+
+    /* The worker connection can't be used, so the whole ID range is processed
+       in the current thread using the current connection. */
+    if (workers == 1 || !canUseWorkerConnections()) {
+        auto query = builder().clone();
+
+        return std::invoke(callback, query, stopped);
+    }
+
+    const auto minIdVariant = builder().min(columnName);
+    const auto maxIdVariant = builder().max(columnName);
+
+    // Nothing to do, no records
+    if (minIdVariant.isNull() || maxIdVariant.isNull())
+        return true;
+
+    auto minIdOk = false;
+    auto maxIdOk = false;
+    const auto minId = minIdVariant.toLongLong(&minIdOk);
+    const auto maxId = maxIdVariant.toLongLong(&maxIdOk);
+
+    if (!minIdOk || !maxIdOk)
+        throw Exceptions::InvalidArgumentError(
+                QStringLiteral("The [%1] column must contain integral IDs in %2().")
+                .arg(columnName, __tiny_func__));
+
+    /* Split the ID range into disjoint ranges of the same size, the first ranges
+       can be one ID bigger. */
+    const auto idsCount = static_cast<quint64>(maxId - minId) + 1;
+    const auto rangesCount = std::min(static_cast<quint64>(workers), idsCount);
+    const auto rangeSize = idsCount / rangesCount;
+    const auto remainder = idsCount % rangesCount;
+
+    auto &manager = DatabaseManager::reference();
+    const auto &connectionName = builder().getConnection().getName();
+
+    std::mutex mutex;
+    std::exception_ptr exception;
+    std::atomic_bool completed = true;
+
+    std::vector<std::thread> threads;
+    threads.reserve(rangesCount);
+
+    /* Joins all worker threads, it must be called also if starting of a worker thread
+       fails, otherwise the std::thread destructor terminates the application. */
+    const auto joinAll = [&threads]
+    {
+        for (auto &thread : threads)
+            if (thread.joinable())
+                thread.join();
+    };
+
+    try {
+        auto rangeFirstId = minId;
+
+        for (quint64 range = 0; range < rangesCount; ++range) {
+            const auto rangeLastId = rangeFirstId +
+                                     static_cast<qint64>(rangeSize) - 1 +
+                                     (range < remainder ? 1 : 0);
+
+            threads.emplace_back(
+                        [&, rangeFirstId, rangeLastId, query = builder().clone(),
+                         workerConnection = manager.addWorkerConnection(connectionName)]
+                        () mutable
+            {
+                try {
+                    // The worker connection must be created in the thread that uses it
+                    auto rangeQuery = query.cloneOnConnection(
+                                          manager.workerConnection(workerConnection)
+                                          .shared_from_this());
+
+                    rangeQuery.where(columnName, GE, rangeFirstId)
+                              .where(columnName, LE, rangeLastId);
+
+                    if (!std::invoke(callback, rangeQuery, stopped)) {
+                        completed = false;
+                        stopped = true;
+                    }
+                } catch (...) {
+                    {
+                        std::scoped_lock lock(mutex);
+
+                        if (!exception)
+                            exception = std::current_exception();
+                    }
+
+                    stopped = true;
+                }
+
+                manager.removeWorkerConnection(workerConnection);
+            });
+
+            rangeFirstId = rangeLastId + 1;
+        }
+
+    } catch (...) {
+        stopped = true;
+        joinAll();
+
+        throw;
+    }
+
+    joinAll();
+
+    // Re-throw the first exception thrown in any worker thread
+    if (exception)
+        std::rethrow_exception(exception);
+
+    return completed;
+}
+
 SqlQuery BuildsQueries::sole(const QVector<Column> &columns)
 {
     auto query = builder().take(2).get(columns);
@@ -199,6 +626,17 @@ Builder &BuildsQueries::tap(const std::function<void(Builder &)> &callback)
     return builder();
 }
 
+bool BuildsQueries::canUseWorkerConnections() const
+{
+    auto &connection = builder().getConnection();
+
+    /* The worker connection can't see uncommitted changes of the current transaction,
+       pretended queries must be logged on the current connection, and every SQLite
+       in-memory connection has its own database. */
+    return !connection.pretending() && !connection.inTransaction() &&
+            connection.getDatabaseName() != QStringLiteral(":memory:");
+}
+
 /* private */
 
 Builder &BuildsQueries::builder() noexcept
@@ -1,8 +1,10 @@
 #include "orm/query/grammars/grammar.hpp"
 
 #include "orm/databaseconnection.hpp"
+#include "orm/exceptions/invalidargumenterror.hpp"
 #include "orm/macros/likely.hpp"
 #include "orm/query/joinclause.hpp"
+#include "orm/utils/type.hpp"
 
 TINYORM_BEGIN_COMMON_NAMESPACE
 
@@ -12,6 +14,44 @@ namespace Orm::Query::Grammars
 /* public */
 
 QString Grammar::compileSelect(QueryBuilder &query) const
+{
+    // Nothing to do, the select cache is disabled
+    if (m_selectCacheMaxSize == 0)
+        return compileSelectWithoutCache(query);
+
+    SelectShape shape;
+
+    // The query contains raw expressions, they are a part of the SQL
+    if (!appendSelectShape(shape, query))
+        return compileSelectWithoutCache(query);
+
+    {
+        std::scoped_lock lock(m_selectCacheMutex);
+
+        // Queries of the same shape differ only in bindings, the SQL is the same
+        if (const auto it = m_selectCache.find(shape); it != m_selectCache.cend()) {
+            ++m_selectCacheHits;
+            return it->second;
+        }
+
+        ++m_selectCacheMisses;
+    }
+
+    auto sql = compileSelectWithoutCache(query);
+
+    std::scoped_lock lock(m_selectCacheMutex);
+
+    /* The limit and offset values are a part of the SQL, flush the whole cache if it's
+       full (eg. many different offsets during pagination) instead of evicting. */
+    if (m_selectCache.size() >= m_selectCacheMaxSize)
+        m_selectCache.clear();
+
+    m_selectCache.emplace(shape, sql);
+
+    return sql;
+}
+
+QString Grammar::compileSelectWithoutCache(QueryBuilder &query) const
 {
     /* If the query does not have any columns set, we'll set the columns to the
        * character to just get all of the columns from the database. Then we
@@ -24,7 +64,7 @@ QString Grammar::compileSelect(QueryBuilder &query) const
     /* To compile the query, we'll spin through each component of the query and
        see if that component exists. If it does we'll just call the compiler
        function for the component which is responsible for making the SQL. */
-    auto sql = concatenate(compileComponents(query));
+    auto sql = compileComponents(query);
 
     // Restore original columns value
     query.setColumns(std::move(original));
@@ -167,6 +207,42 @@ const std::unordered_set<QString> &Grammar::getOperators() const
     return cachedOperators;
 }
 
+/* Compiled select queries cache */
+
+void Grammar::enableSelectCache(const std::size_t maxSize)
+{
+    if (maxSize == 0)
+        throw Exceptions::InvalidArgumentError(
+                QStringLiteral("The select cache maximum size must be greater "
+                               "than 0 in %1().")
+                .arg(__tiny_func__));
+
+    m_selectCacheMaxSize = maxSize;
+}
+
+void Grammar::disableSelectCache()
+{
+    m_selectCacheMaxSize = 0;
+
+    flushSelectCache();
+}
+
+void Grammar::flushSelectCache()
+{
+    std::scoped_lock lock(m_selectCacheMutex);
+
+    m_selectCache.clear();
+    m_selectCacheHits = 0;
+    m_selectCacheMisses = 0;
+}
+
+Grammar::SelectCacheStats Grammar::getSelectCacheStats() const
+{
+    std::scoped_lock lock(m_selectCacheMutex);
+
+    return {m_selectCacheHits, m_selectCacheMisses, m_selectCache.size()};
+}
+
 /* protected */
 
 bool Grammar::shouldCompileAggregate(const std::optional<AggregateItem> &aggregate)
@@ -189,7 +265,7 @@ bool Grammar::shouldCompileFrom(const FromClause &from)
              !std::get<QString>(from).isEmpty());
 }
 
-QStringList Grammar::compileComponents(const QueryBuilder &query) const
+QString Grammar::compileComponents(const QueryBuilder &query) const
 {
     const auto &compileMap = getCompileMap();
 
@@ -199,12 +275,29 @@ QStringList Grammar::compileComponents(const QueryBuilder &query) const
     // The same size for all instances has to be guaranteed as it's static
     Q_ASSERT(compileMapSize == 11);
 
-    QStringList sql;
-    sql.reserve(compileMapSize);
+    // Append all components to one buffer, without the intermediate QStringList
+    QString sql;
+    sql.reserve(256);
 
-    for (const auto &component : compileMap)
-        if (component.isset && component.isset(query))
-            sql << std::invoke(component.compileMethod, *this, query);
+    for (const auto &component : compileMap) {
+        if (!component.isset || !component.isset(query))
+            continue;
+
+        const auto compiled = std::invoke(component.compileMethod, *this, query);
+
+        // Skip empty components (eg. the compileLock() without the lock)
+        if (compiled.isEmpty())
+            continue;
+
+        if (!sql.isEmpty())
+            sql += SPACE;
+
+        sql += compiled;
+    }
+
+    // The trimmed() always copies the string, call it only if it's needed
+    if (!sql.isEmpty() && (sql.front().isSpace() || sql.back().isSpace()))
+        return sql.trimmed();
 
     return sql;
 }
@@ -261,37 +354,36 @@ QString Grammar::compileFrom(const QueryBuilder &query) const
 
 QString Grammar::compileWheres(const QueryBuilder &query) const
 {
-    const auto sql = compileWheresToVector(query);
+    const auto &wheres = query.getWheres();
 
-    if (!sql.isEmpty())
-        return concatenateWhereClauses(query, sql);
+    // Nothing to compile
+    if (wheres.isEmpty())
+        return {};
 
-    return {};
-}
+    QString sql;
+    sql.reserve(wheres.size() * 32 + 8);
 
-QStringList Grammar::compileWheresToVector(const QueryBuilder &query) const
-{
-    const auto &wheres = query.getWheres();
+    // Is it a query instance of the JoinClause?
+    if (dynamic_cast<const JoinClause *>(&query) == nullptr)
+        sql += QStringLiteral("where ");
+    else
+        sql += QStringLiteral("on ");
 
-    QStringList compiledWheres;
-    compiledWheres.reserve(wheres.size());
+    const auto conditionsFrom = sql.size();
 
-    for (const auto &where : wheres)
-        compiledWheres << SPACE_IN.arg(where.condition,
-                                       std::invoke(getWhereMethod(where.type), *this, where));
+    // Append all where clauses to one buffer, without the intermediate QStringList
+    for (const auto &where : wheres) {
+        if (sql.size() > conditionsFrom)
+            sql += SPACE;
 
-    return compiledWheres;
-}
+        sql += where.condition;
+        sql += SPACE;
+        sql += std::invoke(getWhereMethod(where.type), *this, where);
+    }
 
-QString Grammar::concatenateWhereClauses(const QueryBuilder &query,
-                                         const QStringList &sql)
-{
-    // Is it a query instance of the JoinClause?
-    const auto conjunction = dynamic_cast<const JoinClause *>(&query) == nullptr
-                             ? QStringLiteral("where")
-                             : QStringLiteral("on");
+    removeLeadingBoolean(sql, conditionsFrom);
 
-    return SPACE_IN.arg(conjunction, removeLeadingBoolean(sql.join(SPACE)));
+    return sql;
 }
 
 QString Grammar::compileJoins(const QueryBuilder &query) const
@@ -356,28 +448,32 @@ QString Grammar::compileBasicHaving(const HavingConditionItem &having) const
 
 QString Grammar::compileOrders(const QueryBuilder &query) const
 {
-    if (query.getOrders().isEmpty())
+    const auto &orders = query.getOrders();
+
+    if (orders.isEmpty())
         return QLatin1String("");
 
-    return QStringLiteral("order by %1")
-            .arg(columnizeWithoutWrap(compileOrdersToVector(query)));
-}
+    QString sql;
+    sql.reserve(orders.size() * 24 + 9);
 
-QStringList Grammar::compileOrdersToVector(const QueryBuilder &query) const
-{
-    const auto &orders = query.getOrders();
+    sql += QStringLiteral("order by ");
 
-    QStringList compiledOrders;
-    compiledOrders.reserve(orders.size());
+    // Append all orders to one buffer, without the intermediate QStringList
+    for (auto it = orders.cbegin(); it != orders.cend(); ++it) {
+        // Don't prepend a comma before the first order
+        if (it != orders.cbegin())
+            sql += COMMA;
 
-    for (const auto &order : orders)
-        if (order.sql.isEmpty()) T_LIKELY
-            compiledOrders << SPACE_IN.arg(wrap(order.column),
-                                           order.direction.toLower());
+        if (it->sql.isEmpty()) T_LIKELY {
+            sql += wrap(it->column);
+            sql += SPACE;
+            sql += it->direction.toLower();
+        }
         else T_UNLIKELY
-            compiledOrders << order.sql;
+            sql += it->sql;
+    }
 
-    return compiledOrders;
+    return sql;
 }
 
 QString Grammar::compileLimit(const QueryBuilder &query) const // NOLINT(readability-convert-member-functions-to-static)
@@ -615,22 +711,6 @@ QString Grammar::compileDeleteWithJoins(const QueryBuilder &query, const QString
     return QStringLiteral("delete %1 from %2 %3 %4").arg(alias, table, joins, wheres);
 }
 
-QString Grammar::concatenate(QStringList &&segments)
-{
-    QString result;
-    result.reserve(ContainerUtils::countStringSizes(segments, 1) + 8);
-
-    for (auto &&segment : segments) {
-        if (segment.isEmpty())
-            continue;
-
-        result += segment;
-        result += SPACE;
-    }
-
-    return result.trimmed();
-}
-
 QString Grammar::removeLeadingBoolean(QString &&statement)
 {
     // Skip all whitespaces after and/or, to avoid trimmed() for performance reasons
@@ -666,6 +746,36 @@ QString Grammar::removeLeadingBoolean(QString &&statement)
     return std::move(statement);
 }
 
+void Grammar::removeLeadingBoolean(QString &statement, const QString::size_type from)
+{
+    static const auto AndTmpl = QStringLiteral("and ");
+    static const auto OrTmpl =  QStringLiteral("or ");
+
+    /* The same as the removeLeadingBoolean() above but removes the and/or in place,
+       the statement is checked from the given position. */
+    const auto statementView = QStringView(statement).mid(from);
+
+    QString::size_type length = 0;
+
+    if (statementView.startsWith(AndTmpl))
+        length = 4;
+    else if (statementView.startsWith(OrTmpl))
+        length = 3;
+    else
+        return;
+
+    // Skip all whitespaces after and/or
+    auto end = from + length;
+    while (end < statement.size() && statement.at(end) == SPACE)
+        ++end;
+
+    // Keep whitespaces if there is nothing after them, the same as above
+    if (end == statement.size())
+        end = from + length;
+
+    statement.remove(from, end - from);
+}
+
 QVector<std::reference_wrapper<const QVariant>>
 Grammar::flatBindingsForUpdateDelete(const BindingsMap &bindings,
                                      const QVector<BindingType> &exclude)
@@ -702,6 +812,254 @@ Grammar::computeReserveForBindingsMap(const BindingsMap &bindings,
     return size;
 }
 
+/* private */
+
+bool Grammar::appendSelectShape(SelectShape &key, const QueryBuilder &query) const // NOLINT(misc-no-recursion)
+{
+    // The table prefix is a part of wrapped table names
+    appendShape(key, m_tablePrefix);
+
+    if (const auto &aggregate = query.getAggregate(); aggregate) {
+        appendShape(key, aggregate->function);
+
+        if (!appendShape(key, aggregate->columns))
+            return false;
+    }
+    appendShape(key, QStringLiteral("#distinct"));
+
+    if (const auto &distinct = query.getDistinct();
+        std::holds_alternative<bool>(distinct)
+    )
+        appendShape(key, std::get<bool>(distinct) ? QStringLiteral("1")
+                                                  : QStringLiteral("0"));
+    else
+        for (const auto &column : std::get<QStringList>(distinct))
+            appendShape(key, column);
+
+    appendShape(key, QStringLiteral("#columns"));
+
+    if (!appendShape(key, query.getColumns()))
+        return false;
+
+    appendShape(key, QStringLiteral("#from"));
+
+    if (!appendShape(key, query.getFrom()))
+        return false;
+
+    for (const auto &join : query.getJoins()) {
+        appendShape(key, QStringLiteral("#join"));
+        appendShape(key, join->getType());
+
+        if (!appendShape(key, join->getTable()) || !appendWheresShape(key, *join))
+            return false;
+    }
+
+    appendShape(key, QStringLiteral("#wheres"));
+
+    if (!appendWheresShape(key, query))
+        return false;
+
+    appendShape(key, QStringLiteral("#groups"));
+
+    if (!appendShape(key, query.getGroups()) ||
+        !appendHavingsShape(key, query) ||
+        !appendOrdersShape(key, query)
+    )
+        return false;
+
+    // The limit and offset values are not bound, they are a part of the SQL
+    appendShape(key, static_cast<quint64>(query.getLimit()));
+    appendShape(key, static_cast<quint64>(query.getOffset()));
+
+    appendLockShape(key, query);
+
+    return true;
+}
+
+bool Grammar::appendWheresShape(SelectShape &key, const QueryBuilder &query) const // NOLINT(misc-no-recursion)
+{
+    for (const auto &where : query.getWheres())
+        if (!appendWhereShape(key, where))
+            return false;
+
+    appendShape(key, QStringLiteral("#end"));
+
+    return true;
+}
+
+bool Grammar::appendWhereShape(SelectShape &key, const WhereConditionItem &where) const // NOLINT(misc-no-recursion)
+{
+    appendShape(key, static_cast<quint64>(where.type));
+    appendShape(key, where.condition);
+
+    switch (where.type) {
+    case WhereType::BASIC:
+    case WhereType::DATE:
+    case WhereType::TIME:
+    case WhereType::DAY:
+    case WhereType::MONTH:
+    case WhereType::YEAR:
+        appendShape(key, where.comparison);
+        return appendShape(key, where.column) && appendBindingShape(key, where.value);
+
+    case WhereType::NESTED:
+        return appendWheresShape(key, *where.nestedQuery);
+
+    case WhereType::COLUMN:
+        appendShape(key, where.comparison);
+        return appendShape(key, where.column) && appendShape(key, where.columnTwo);
+
+    case WhereType::IN_:
+    case WhereType::NOT_IN:
+    case WhereType::ROW_VALUES:
+        appendShape(key, where.comparison);
+
+        if (!appendShape(key, where.column) || !appendShape(key, where.columns))
+            return false;
+
+        // Every value has its own placeholder
+        for (const auto &value : where.values)
+            if (!appendBindingShape(key, value))
+                return false;
+
+        return true;
+
+    case WhereType::NULL_:
+    case WhereType::NOT_NULL:
+        return appendShape(key, where.column);
+
+    case WhereType::RAW:
+        appendShape(key, where.sql);
+        return true;
+
+    case WhereType::EXISTS:
+    case WhereType::NOT_EXISTS:
+        // The sub-query already compiled in the QueryBuilder using the createSub()
+        if (!where.nestedQuery)
+            return false;
+
+        return appendSelectShape(key, *where.nestedQuery);
+
+    case WhereType::BETWEEN:
+        appendShape(key, where.nope ? QStringLiteral("1") : QStringLiteral("0"));
+
+        return appendShape(key, where.column) &&
+               appendBindingShape(key, where.between.min) &&
+               appendBindingShape(key, where.between.max);
+
+    case WhereType::BETWEEN_COLUMNS:
+        appendShape(key, where.nope ? QStringLiteral("1") : QStringLiteral("0"));
+
+        return appendShape(key, where.column) &&
+               appendShape(key, where.betweenColumns.min) &&
+               appendShape(key, where.betweenColumns.max);
+
+    default:
+        return false;
+    }
+}
+
+bool Grammar::appendHavingsShape(SelectShape &key, const QueryBuilder &query)
+{
+    for (const auto &having : query.getHavings()) {
+        appendShape(key, QStringLiteral("#having"));
+        appendShape(key, having.condition);
+
+        if (having.type == HavingType::RAW) {
+            appendShape(key, having.sql);
+            continue;
+        }
+
+        appendShape(key, having.comparison);
+
+        if (having.type != HavingType::BASIC ||
+            !appendShape(key, having.column) || !appendBindingShape(key, having.value)
+        )
+            return false;
+    }
+
+    return true;
+}
+
+bool Grammar::appendOrdersShape(SelectShape &key, const QueryBuilder &query)
+{
+    for (const auto &order : query.getOrders()) {
+        appendShape(key, QStringLiteral("#order"));
+
+        if (!order.sql.isEmpty()) {
+            appendShape(key, order.sql);
+            continue;
+        }
+
+        appendShape(key, order.direction);
+
+        if (!appendShape(key, order.column))
+            return false;
+    }
+
+    return true;
+}
+
+void Grammar::appendLockShape(SelectShape &key, const QueryBuilder &query)
+{
+    const auto &lock = query.getLock();
+
+    appendShape(key, static_cast<quint64>(lock.index()));
+
+    if (std::holds_alternative<bool>(lock))
+        appendShape(key, std::get<bool>(lock) ? QStringLiteral("1")
+                                              : QStringLiteral("0"));
+
+    else if (std::holds_alternative<QString>(lock))
+        appendShape(key, std::get<QString>(lock));
+}
+
+bool Grammar::appendShape(SelectShape &key, const Column &column)
+{
+    // Raw expressions are inlined into the SQL, don't cache them
+    if (!std::holds_alternative<QString>(column))
+        return false;
+
+    appendShape(key, std::get<QString>(column));
+
+    return true;
+}
+
+bool Grammar::appendShape(SelectShape &key, const QVector<Column> &columns)
+{
+    for (const auto &column : columns)
+        if (!appendShape(key, column))
+            return false;
+
+    appendShape(key, QStringLiteral("#end"));
+
+    return true;
+}
+
+bool Grammar::appendShape(SelectShape &key, const FromClause &table)
+{
+    if (std::holds_alternative<Expression>(table))
+        return false;
+
+    if (std::holds_alternative<QString>(table))
+        appendShape(key, std::get<QString>(table));
+    else
+        appendShape(key, QString());
+
+    return true;
+}
+
+bool Grammar::appendBindingShape(SelectShape &key, const QVariant &value)
+{
+    // Raw expressions are inlined into the SQL, all other values are bound
+    if (isExpression(value))
+        return false;
+
+    appendShape(key, QStringLiteral("?"));
+
+    return true;
+}
+
 } // namespace Orm::Query::Grammars
 
 TINYORM_END_COMMON_NAMESPACE
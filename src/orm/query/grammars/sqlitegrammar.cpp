@@ -18,6 +18,16 @@ QString SQLiteGrammar::compileInsertOrIgnore(const QueryBuilder &query,
             .replace(0, 6, QStringLiteral("insert or ignore"));
 }
 
+QString SQLiteGrammar::compileInsertGetIds(const QueryBuilder &query,
+                                           const QVector<QVariantMap> &values,
+                                           const QString &sequence) const
+{
+    // The RETURNING clause is supported by SQLite >=3.35, checked in the SQLiteProcessor
+    return QStringLiteral("%1 returning %2")
+            .arg(compileInsert(query, values),
+                 wrap(sequence.isEmpty() ? ID : sequence));
+}
+
 QString SQLiteGrammar::compileUpdate(QueryBuilder &query,
                                      const QVector<UpdateItem> &values) const
 {
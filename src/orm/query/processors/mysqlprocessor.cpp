@@ -0,0 +1,47 @@
+#include "orm/query/processors/mysqlprocessor.hpp"
+
+#include "orm/mysqlconnection.hpp"
+#include "orm/query/querybuilder.hpp"
+
+TINYORM_BEGIN_COMMON_NAMESPACE
+
+namespace Orm::Query::Processors
+{
+
+bool MySqlProcessor::supportsInsertGetIds(QueryBuilder &query) const
+{
+    /* The LAST_INSERT_ID() returns the ID of the first record inserted by
+       the multi-rows insert statement, the rest of IDs can be computed only if
+       the auto-increment values are consecutive. InnoDB guarantees consecutive
+       values for the multi-rows insert only in the traditional (0) and
+       consecutive (1) lock modes, the interleaved lock mode (2, the MySQL 8
+       default) can interleave values of concurrent inserts. In all other cases
+       the insertGetIds() inserts records one by one. */
+    auto &connection = dynamic_cast<MySqlConnection &>(query.getConnection());
+
+    return connection.autoIncrementIncrement() == 1 &&
+           connection.autoIncrementLockMode() < 2;
+}
+
+QVector<quint64>
+MySqlProcessor::processInsertGetIds(SqlQuery &query,
+                                    const QVector<QVariant>::size_type count) const
+{
+    const auto firstId = query.lastInsertId().value<quint64>();
+
+    // QSqlQuery returns an invalid QVariant if can't obtain last inserted id (pretend)
+    if (firstId == 0)
+        return {};
+
+    QVector<quint64> ids;
+    ids.reserve(count);
+
+    for (QVector<QVariant>::size_type i = 0; i < count; ++i)
+        ids << firstId + static_cast<quint64>(i);
+
+    return ids;
+}
+
+} // namespace Orm::Query::Processors
+
+TINYORM_END_COMMON_NAMESPACE
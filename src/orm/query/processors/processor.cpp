@@ -22,6 +22,22 @@ QStringList Processor::processColumnListing(SqlQuery &query) const
     return columns;
 }
 
+QVector<quint64>
+Processor::processInsertGetIds(SqlQuery &query,
+                               const QVector<QVariant>::size_type count) const
+{
+    /* The default implementation expects that IDs are returned as the result set
+       of the insert statement, using the RETURNING clause, in the same order as
+       records were inserted. */
+    QVector<quint64> ids;
+    ids.reserve(count);
+
+    while (query.next())
+        ids << query.value(0).value<quint64>();
+
+    return ids;
+}
+
 } // namespace Orm::Query::Processors
 
 TINYORM_END_COMMON_NAMESPACE
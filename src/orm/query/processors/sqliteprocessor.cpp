@@ -1,5 +1,7 @@
 #include "orm/query/processors/sqliteprocessor.hpp"
 
+#include "orm/query/querybuilder.hpp"
+#include "orm/sqliteconnection.hpp"
 #include "orm/types/sqlquery.hpp"
 #include "orm/utils/query.hpp"
 
@@ -22,6 +24,14 @@ QStringList SQLiteProcessor::processColumnListing(SqlQuery &query) const
     return columns;
 }
 
+bool SQLiteProcessor::supportsInsertGetIds(QueryBuilder &query) const
+{
+    /* The last_insert_rowid() returns only the ID of the last inserted record and
+       the rowid-s of the multi-rows insert aren't guaranteed to be consecutive, so
+       the RETURNING clause (SQLite >=3.35) is the only correct way. */
+    return dynamic_cast<SQLiteConnection &>(query.getConnection()).supportsReturning();
+}
+
 } // namespace Orm::Query::Processors
 
 TINYORM_END_COMMON_NAMESPACE
@@ -1,6 +1,7 @@
 #include "orm/query/querybuilder.hpp"
 
 #include <QDebug>
+#include <QRegularExpression>
 
 #include <range/v3/view/remove_if.hpp>
 
@@ -8,10 +9,12 @@
 #include "orm/exceptions/invalidargumenterror.hpp"
 #include "orm/macros/likely.hpp"
 #include "orm/query/joinclause.hpp"
+#include "orm/types/arrowstreamwriter.hpp"
 #include "orm/utils/type.hpp"
 
 TINYORM_BEGIN_COMMON_NAMESPACE
 
+using Orm::Types::ArrowStreamWriter;
 using Orm::Utils::Helpers;
 
 namespace Orm::Query
@@ -36,6 +39,64 @@ SqlQuery Builder::get(const QVector<Column> &columns)
     });
 }
 
+LazyRange<QSqlRecord> Builder::cursor(const QVector<Column> &columns)
+{
+    /*! State of the lazy range, the std::function callback must be copyable. */
+    struct CursorState
+    {
+        /*! The forward-only query. */
+        SqlQuery query;
+        /*! The current record, reused for every row. */
+        QSqlRecord record;
+    };
+
+    auto query = onceWithColumns(columns, [this]
+    {
+        return m_connection->cursor(toSql(), getBindings());
+    });
+
+    auto record = query.record();
+
+    auto state = std::make_shared<CursorState>(
+                     CursorState {std::move(query), std::move(record)});
+
+    return LazyRange<QSqlRecord>([state = std::move(state)]() -> QSqlRecord *
+    {
+        // No more records
+        if (!state->query.next())
+            return nullptr;
+
+        // SqlQuery::value() also correctly handles the QDateTime's time zone
+        for (int i = 0; i < state->record.count(); ++i)
+            state->record.setValue(i, state->query.value(i));
+
+        return &state->record;
+    });
+}
+
+ColumnarResult Builder::getColumnar(const QVector<Column> &columns)
+{
+    // The forward-only query, every row is read only once into the column buffers
+    auto query = onceWithColumns(columns, [this]
+    {
+        return m_connection->cursor(toSql(), getBindings());
+    });
+
+    return ColumnarResult::fromSqlQuery(query);
+}
+
+qint64 Builder::toArrowStream(QIODevice &device, const qint64 batchSize,
+                              const QVector<Column> &columns)
+{
+    // The forward-only query, rows are read straight into the record batches
+    auto query = onceWithColumns(columns, [this]
+    {
+        return m_connection->cursor(toSql(), getBindings());
+    });
+
+    return ArrowStreamWriter::write(query, device, batchSize);
+}
+
 SqlQuery Builder::find(const QVariant &id, const QVector<Column> &columns)
 {
     return where(ID, EQ, id).first(columns);
@@ -215,6 +276,40 @@ quint64 Builder::insertGetId(const QVariantMap &values, const QString &sequence)
     return query.lastInsertId().value<quint64>();
 }
 
+QVector<quint64>
+Builder::insertGetIds(const QVector<QVariantMap> &values, const QString &sequence)
+{
+    if (values.isEmpty())
+        return {};
+
+    const auto &processor = m_connection->getPostProcessor();
+
+    /* Not all databases are able to return IDs of all records inserted by
+       the multi-rows insert statement, in this case insert records one by one. */
+    if (values.size() == 1 || !processor.supportsInsertGetIds(*this)) {
+        QVector<quint64> ids;
+        ids.reserve(values.size());
+
+        for (const auto &value : values)
+            ids << insertGetId(value, sequence);
+
+        return ids;
+    }
+
+    auto query = m_connection->insert(
+                     m_grammar->compileInsertGetIds(*this, values, sequence),
+                     cleanBindings(flatValuesForInsert(values)));
+
+    auto ids = processor.processInsertGetIds(query, values.size());
+
+    /* Returned IDs vector must always have the same size as the values vector, IDs
+       can't be obtained while pretending, they will be 0 the same as in insertGetId(). */
+    if (ids.size() != values.size())
+        ids = QVector<quint64>(values.size(), 0);
+
+    return ids;
+}
+
 std::tuple<int, std::optional<QSqlQuery>>
 Builder::insertOrIgnore(const QVector<QVariantMap> &values)
 {
@@ -1186,6 +1281,22 @@ Builder &Builder::lock(QString &&value)
     return *this;
 }
 
+/* Query cache */
+
+Builder &Builder::remember(const std::chrono::milliseconds ttl)
+{
+    m_cacheTtl = ttl;
+
+    return *this;
+}
+
+Builder &Builder::dontRemember()
+{
+    m_cacheTtl.reset();
+
+    return *this;
+}
+
 /* Debugging */
 
 // NOTE api different, added the replaceBindings and simpleBindings parameters silverqx
@@ -1450,6 +1561,16 @@ Builder Builder::cloneWithoutBindings(
     return copy;
 }
 
+Builder Builder::cloneOnConnection(std::shared_ptr<DatabaseConnection> connection) const
+{
+    auto copy = *this;
+
+    copy.m_grammar = connection->getQueryGrammarShared();
+    copy.m_connection = std::move(connection);
+
+    return copy;
+}
+
 /* protected */
 
 void Builder::throwIfInvalidOperator(const QString &comparison) const
@@ -1692,9 +1813,105 @@ Builder &Builder::setAggregate(const QString &function, const QVector<Column> &c
 
 SqlQuery Builder::runSelect()
 {
+    const auto isLocking = std::holds_alternative<QString>(m_lock) ||
+                           (std::holds_alternative<bool>(m_lock) &&
+                            std::get<bool>(m_lock));
+
+    // Locking reads must always hit the database
+    if (m_cacheTtl && !isLocking)
+        if (auto tables = cacheTables(); tables)
+            return m_connection->selectRemembered(toSql(), getBindings(), *m_cacheTtl,
+                                                  *tables);
+
     return m_connection->select(toSql(), getBindings());
 }
 
+std::optional<QStringList> Builder::cacheTables() const
+{
+    /* Tables read by subqueries are unknown, so writes to them couldn't invalidate
+       the cached results, these queries always hit the database. */
+    if (!std::holds_alternative<QString>(m_from) || hasSubquery())
+        return std::nullopt;
+
+    QStringList tables;
+    tables.reserve(m_joins.size() + 1);
+
+    tables << std::get<QString>(m_from);
+
+    for (const auto &join : m_joins) {
+        const auto &table = join->getTable();
+
+        if (!std::holds_alternative<QString>(table))
+            return std::nullopt;
+
+        tables << std::get<QString>(table);
+    }
+
+    return tables;
+}
+
+bool Builder::hasSubquery() const
+{
+    // Subqueries are compiled to expressions by the createSub()
+    const auto isSubquery = [](const Column &column)
+    {
+        return std::holds_alternative<Expression>(column) &&
+               isSubquerySql(std::get<Expression>(column).getValue()
+                                                       .value<QString>());
+    };
+    const auto isSubqueryValue = [](const QVariant &value)
+    {
+        return value.canConvert<Expression>() &&
+               isSubquerySql(value.value<Expression>().getValue().value<QString>());
+    };
+
+    if (std::ranges::any_of(m_columns, isSubquery) ||
+        std::ranges::any_of(m_groups, isSubquery)
+    )
+        return true;
+
+    for (const auto &where : m_wheres) {
+        // The exists sub-query reads its own tables, they aren't in the cache tables
+        if ((where.type == WhereType::EXISTS || where.type == WhereType::NOT_EXISTS) &&
+            where.nestedQuery
+        )
+            return true;
+
+        if ((where.nestedQuery && where.nestedQuery->hasSubquery()) ||
+            isSubquery(where.column) || isSubquery(where.columnTwo) ||
+            isSubqueryValue(where.value) || isSubquerySql(where.sql) ||
+            std::ranges::any_of(where.columns, isSubquery) ||
+            std::ranges::any_of(where.values, isSubqueryValue)
+        )
+            return true;
+    }
+
+    for (const auto &having : m_havings)
+        if (isSubquery(having.column) || isSubqueryValue(having.value) ||
+            isSubquerySql(having.sql)
+        )
+            return true;
+
+    for (const auto &order : m_orders)
+        if (isSubquery(order.column) || isSubquerySql(order.sql))
+            return true;
+
+    // Join conditions can contain subqueries too
+    return std::ranges::any_of(m_joins, [](const auto &join)
+    {
+        return join->hasSubquery();
+    });
+}
+
+bool Builder::isSubquerySql(const QString &sql)
+{
+    static const QRegularExpression regex(
+                QStringLiteral(R"(\bselect\b)"),
+                QRegularExpression::CaseInsensitiveOption);
+
+    return !sql.isEmpty() && sql.contains(regex);
+}
+
 Builder &Builder::joinInternal(
             std::shared_ptr<JoinClause> &&join, const QString &first,
             const QString &comparison, const QVariant &second, const bool where)
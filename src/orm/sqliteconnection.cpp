@@ -1,5 +1,7 @@
 #include "orm/sqliteconnection.hpp"
 
+#include <QVersionNumber>
+
 #include "orm/query/grammars/sqlitegrammar.hpp"
 #include "orm/query/processors/sqliteprocessor.hpp"
 #include "orm/schema/grammars/sqliteschemagrammar.hpp"
@@ -38,6 +40,47 @@ SQLiteConnection &SQLiteConnection::setReturnQDateTime(const bool value)
     return *this;
 }
 
+/* Getters / Setters */
+
+std::optional<QString> SQLiteConnection::version()
+{
+    // The default value is the std::nullopt if pretending
+    if (m_pretending && !m_version)
+        return std::nullopt;
+
+    // Return the cached value
+    if (m_version)
+        return m_version;
+
+    // Obtain and cache the SQLite library version value
+    return m_version = scalar(QStringLiteral("select sqlite_version()"))
+                       .value<QString>();
+}
+
+bool SQLiteConnection::supportsReturning()
+{
+    // Default value is false if pretending
+    if (m_pretending && !m_supportsReturning && !m_version)
+        return false;
+
+    // Return the cached value
+    if (m_supportsReturning)
+        return *m_supportsReturning;
+
+    // Obtain a version from the database if needed
+    version();
+
+    // This should never happen 🤔 because of the condition at beginning
+    if (!m_version)
+        return false;
+
+    // Cache the value
+    m_supportsReturning = QVersionNumber::fromString(*m_version) >=
+                          QVersionNumber(3, 35, 0);
+
+    return *m_supportsReturning;
+}
+
 /* protected */
 
 std::unique_ptr<QueryGrammar> SQLiteConnection::getDefaultQueryGrammar() const
@@ -0,0 +1,193 @@
+#include "orm/tiny/cache/entitycache.hpp"
+
+TINYORM_BEGIN_COMMON_NAMESPACE
+
+namespace Orm::Tiny::Cache
+{
+
+/* public */
+
+EntityCache::EntityCache(const quint64 maxEntries)
+    : m_maxEntries(maxEntries)
+{}
+
+EntityCache &EntityCache::instance()
+{
+    static EntityCache cache;
+
+    return cache;
+}
+
+std::optional<QVector<AttributeItem>>
+EntityCache::get(const QString &connection, const QString &table, const QVariant &key)
+{
+    const auto cacheKey_ = cacheKey(tag(connection, table), key);
+
+    std::scoped_lock lock(m_mutex);
+
+    const auto itNode = m_entries.constFind(cacheKey_);
+
+    if (itNode == m_entries.cend()) {
+        ++m_stats.misses;
+        return std::nullopt;
+    }
+
+    // Mark as the most recently used
+    m_lru.splice(m_lru.begin(), m_lru, itNode->position);
+
+    ++m_stats.hits;
+
+    return itNode->attributes;
+}
+
+void EntityCache::put(const QString &connection, const QString &table,
+                      const QVariant &key, QVector<AttributeItem> attributes)
+{
+    auto tag_ = tag(connection, table);
+    auto cacheKey_ = cacheKey(tag_, key);
+
+    std::scoped_lock lock(m_mutex);
+
+    removeEntry(cacheKey_);
+
+    // Nothing to do, the cache is disabled
+    if (m_maxEntries == 0)
+        return;
+
+    m_tags[tag_].insert(cacheKey_);
+    m_lru.push_front(cacheKey_);
+    m_entries.insert(std::move(cacheKey_),
+                     {std::move(attributes), std::move(tag_), m_lru.begin()});
+
+    ++m_stats.puts;
+    m_size = static_cast<quint64>(m_entries.size());
+
+    evict();
+}
+
+void EntityCache::forget(const QString &connection, const QString &table,
+                         const QVariant &key)
+{
+    const auto cacheKey_ = cacheKey(tag(connection, table), key);
+
+    std::scoped_lock lock(m_mutex);
+
+    if (!m_entries.contains(cacheKey_))
+        return;
+
+    removeEntry(cacheKey_);
+
+    ++m_stats.invalidations;
+}
+
+void EntityCache::forgetTable(const QString &connection, const QString &table)
+{
+    const auto tag_ = tag(connection, table);
+
+    std::scoped_lock lock(m_mutex);
+
+    const auto itTag = m_tags.constFind(tag_);
+
+    if (itTag == m_tags.cend())
+        return;
+
+    // Copy is needed as the removeEntry() modifies the tag index
+    const auto keys = *itTag;
+
+    for (const auto &cacheKey_ : keys)
+        removeEntry(cacheKey_);
+
+    m_stats.invalidations += static_cast<quint64>(keys.size());
+}
+
+void EntityCache::flush()
+{
+    std::scoped_lock lock(m_mutex);
+
+    m_stats.invalidations += static_cast<quint64>(m_entries.size());
+
+    m_entries.clear();
+    m_lru.clear();
+    m_tags.clear();
+    m_size = 0;
+}
+
+bool EntityCache::isEmpty() const
+{
+    return m_size == 0;
+}
+
+EntityCacheStats EntityCache::stats() const
+{
+    std::scoped_lock lock(m_mutex);
+
+    auto stats = m_stats;
+    stats.entries = static_cast<quint64>(m_entries.size());
+
+    return stats;
+}
+
+quint64 EntityCache::maxEntries() const
+{
+    std::scoped_lock lock(m_mutex);
+
+    return m_maxEntries;
+}
+
+void EntityCache::setMaxEntries(const quint64 maxEntries)
+{
+    std::scoped_lock lock(m_mutex);
+
+    m_maxEntries = maxEntries;
+
+    evict();
+}
+
+/* private */
+
+void EntityCache::removeEntry(const QString &cacheKey)
+{
+    const auto itNode = m_entries.find(cacheKey);
+
+    if (itNode == m_entries.end())
+        return;
+
+    if (auto itTag = m_tags.find(itNode->tag); itTag != m_tags.end()) {
+        itTag->remove(cacheKey);
+
+        if (itTag->isEmpty())
+            m_tags.erase(itTag);
+    }
+
+    m_lru.erase(itNode->position);
+
+    m_entries.erase(itNode);
+    m_size = static_cast<quint64>(m_entries.size());
+}
+
+void EntityCache::evict()
+{
+    while (!m_lru.empty() && static_cast<quint64>(m_entries.size()) > m_maxEntries) {
+        // Copy is needed as the removeEntry() erases the key from the LRU list
+        const auto cacheKey_ = m_lru.back();
+
+        removeEntry(cacheKey_);
+
+        ++m_stats.evictions;
+    }
+}
+
+QString EntityCache::tag(const QString &connection, const QString &table)
+{
+    return QStringLiteral("%1\n%2").arg(connection, table);
+}
+
+QString EntityCache::cacheKey(const QString &tag, const QVariant &key)
+{
+    // The QVariant::toString() unifies integral key types (eg. int vs qint64)
+    return QStringLiteral("%1\n%2").arg(tag, key.toString());
+}
+
+} // namespace Orm::Tiny::Cache
+
+TINYORM_END_COMMON_NAMESPACE
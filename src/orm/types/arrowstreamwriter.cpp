@@ -0,0 +1,573 @@
+#include "orm/types/arrowstreamwriter.hpp"
+
+#include <QtEndian>
+#include <QtSql/QSqlField>
+
+#include <algorithm>
+#include <bit>
+#include <numeric>
+
+#include "orm/exceptions/invalidargumenterror.hpp"
+#include "orm/exceptions/runtimeerror.hpp"
+#include "orm/types/sqlquery.hpp"
+#include "orm/utils/type.hpp"
+
+TINYORM_BEGIN_COMMON_NAMESPACE
+
+namespace Orm::Types
+{
+
+/* The Arrow IPC metadata are FlatBuffers (see Message.fbs and Schema.fbs in the Apache
+   Arrow format specification), they are written by the minimal forward writer below
+   so no libarrow or flatbuffers dependency is needed. */
+
+namespace
+{
+    /*! Arrow metadata version V5. */
+    constexpr qint64 MetadataVersionV5 = 4;
+
+    /*! Arrow MessageHeader union types. */
+    enum struct MessageHeader : quint8
+    {
+        Schema      = 1,
+        RecordBatch = 3,
+    };
+
+    /*! Arrow Type union types. */
+    enum struct ArrowType : quint8
+    {
+        Int           = 2,
+        FloatingPoint = 3,
+        Utf8          = 5,
+    };
+
+    /*! Arrow FloatingPoint precision DOUBLE. */
+    constexpr qint64 PrecisionDouble = 2;
+
+    /*! The continuation token that precedes every message. */
+    constexpr quint32 Continuation = 0xFFFFFFFF;
+
+    /*! Field of the FlatBuffers table. */
+    struct FlatField
+    {
+        /*! Field id (the position in the schema definition). */
+        quint16 id;
+        /*! Inline size in bytes (4 for the offset fields). */
+        quint8 size;
+        /*! Scalar value (unused for the offset fields). */
+        qint64 value = 0;
+        /*! Determine whether the field is the offset to a string, vector or table. */
+        bool isOffset = false;
+    };
+
+    /*! Create the scalar field of the FlatBuffers table. */
+    inline FlatField scalar(const quint16 id, const quint8 size, const qint64 value)
+    {
+        return {id, size, value, false};
+    }
+
+    /*! Create the offset field of the FlatBuffers table (patched later). */
+    inline FlatField offset(const quint16 id)
+    {
+        return {id, 4, 0, true};
+    }
+
+    /*! Minimal forward FlatBuffers writer, children are always written after their
+        parents so all the offsets point forward (as the format requires). */
+    class FlatBufferWriter
+    {
+    public:
+        /*! Constructor, reserves the root table offset. */
+        inline FlatBufferWriter();
+
+        /*! Write the table, returns its position and the offset fields' positions
+            (in the same order as the given fields). */
+        std::pair<qint64, QVector<qint64>> writeTable(const QVector<FlatField> &fields);
+        /*! Write the string, returns its position. */
+        qint64 writeString(const QString &string);
+        /*! Write the vector of offsets, returns its position and the offsets'
+            positions. */
+        std::pair<qint64, QVector<qint64>> writeOffsetsVector(qint64 count);
+        /*! Write the vector of structs of two longs, returns its position. */
+        qint64 writeStructsVector(const QVector<std::pair<qint64, qint64>> &items);
+
+        /*! Point the offset at the given position to the given target. */
+        void patchOffset(qint64 position, qint64 target);
+        /*! Set the root table and get the buffer padded to 8 bytes. */
+        QByteArray finish(qint64 root);
+
+    private:
+        /*! Pad the buffer to the given alignment. */
+        void align(qint64 alignment);
+        /*! Append the little-endian value of the given size. */
+        void appendScalar(qint64 value, quint8 size);
+
+        /*! The FlatBuffers buffer. */
+        QByteArray m_buffer;
+    };
+
+    /* public */
+
+    FlatBufferWriter::FlatBufferWriter()
+        : m_buffer(4, '\0')
+    {}
+
+    std::pair<qint64, QVector<qint64>>
+    FlatBufferWriter::writeTable(const QVector<FlatField> &fields)
+    {
+        // Lay out the fields from the largest one so the padding is minimal
+        QVector<qsizetype> order(fields.size());
+        std::iota(order.begin(), order.end(), 0);
+        std::ranges::stable_sort(order, [&fields](const auto left, const auto right)
+        {
+            return fields.at(left).size > fields.at(right).size;
+        });
+
+        QVector<quint16> inlineOffsets(fields.size(), 0);
+        // The first 4 bytes are the offset to the vtable
+        quint16 tableSize = 4;
+        quint16 maxId = 0;
+
+        for (const auto index : order) {
+            const auto &field = fields.at(index);
+
+            while (tableSize % field.size != 0)
+                ++tableSize;
+
+            inlineOffsets[index] = tableSize;
+            tableSize += field.size;
+            maxId = std::max<quint16>(maxId, field.id + 1);
+        }
+
+        while (tableSize % 4 != 0)
+            ++tableSize;
+
+        // The vtable
+        align(2);
+        const auto vtablePosition = static_cast<qint64>(m_buffer.size());
+
+        QVector<quint16> vtable(maxId, 0);
+        for (qsizetype index = 0; index < fields.size(); ++index)
+            vtable[fields.at(index).id] = inlineOffsets.at(index);
+
+        appendScalar(4 + 2 * maxId, 2);
+        appendScalar(tableSize, 2);
+        for (const auto fieldOffset : vtable)
+            appendScalar(fieldOffset, 2);
+
+        // The table itself, aligned to the largest scalar
+        align(8);
+        const auto tablePosition = static_cast<qint64>(m_buffer.size());
+
+        QByteArray table(tableSize, '\0');
+        qToLittleEndian<qint32>(static_cast<qint32>(tablePosition - vtablePosition),
+                                table.data());
+
+        QVector<qint64> offsetPositions;
+
+        for (qsizetype index = 0; index < fields.size(); ++index) {
+            const auto &field = fields.at(index);
+            auto *const data = table.data() + inlineOffsets.at(index);
+
+            if (field.isOffset) {
+                offsetPositions << tablePosition + inlineOffsets.at(index);
+                continue;
+            }
+
+            switch (field.size) {
+            case 1:
+                *data = static_cast<char>(field.value);
+                break;
+            case 2:
+                qToLittleEndian<quint16>(static_cast<quint16>(field.value), data);
+                break;
+            case 4:
+                qToLittleEndian<quint32>(static_cast<quint32>(field.value), data);
+                break;
+            case 8:
+                qToLittleEndian<quint64>(static_cast<quint64>(field.value), data);
+                break;
+            default:
+                Q_UNREACHABLE();
+            }
+        }
+
+        m_buffer.append(table);
+
+        return {tablePosition, std::move(offsetPositions)};
+    }
+
+    qint64 FlatBufferWriter::writeString(const QString &string)
+    {
+        const auto data = string.toUtf8();
+
+        align(4);
+        const auto position = static_cast<qint64>(m_buffer.size());
+
+        appendScalar(data.size(), 4);
+        m_buffer.append(data);
+        // Null-terminated
+        m_buffer.append('\0');
+
+        return position;
+    }
+
+    std::pair<qint64, QVector<qint64>>
+    FlatBufferWriter::writeOffsetsVector(const qint64 count)
+    {
+        align(4);
+        const auto position = static_cast<qint64>(m_buffer.size());
+
+        appendScalar(count, 4);
+
+        QVector<qint64> offsetPositions;
+        offsetPositions.reserve(static_cast<qsizetype>(count));
+
+        for (qint64 index = 0; index < count; ++index) {
+            offsetPositions << static_cast<qint64>(m_buffer.size());
+            appendScalar(0, 4);
+        }
+
+        return {position, std::move(offsetPositions)};
+    }
+
+    qint64
+    FlatBufferWriter::writeStructsVector(const QVector<std::pair<qint64, qint64>> &items)
+    {
+        // The structs of longs that follow the length have to be aligned to 8 bytes
+        align(4);
+        if (m_buffer.size() % 8 == 0)
+            appendScalar(0, 4);
+
+        const auto vectorPosition = static_cast<qint64>(m_buffer.size());
+
+        appendScalar(items.size(), 4);
+
+        for (const auto &[first, second] : items) {
+            appendScalar(first, 8);
+            appendScalar(second, 8);
+        }
+
+        return vectorPosition;
+    }
+
+    void FlatBufferWriter::patchOffset(const qint64 position, const qint64 target)
+    {
+        qToLittleEndian<quint32>(static_cast<quint32>(target - position),
+                                 m_buffer.data() + position);
+    }
+
+    QByteArray FlatBufferWriter::finish(const qint64 root)
+    {
+        patchOffset(0, root);
+        align(8);
+
+        return std::move(m_buffer);
+    }
+
+    /* private */
+
+    void FlatBufferWriter::align(const qint64 alignment)
+    {
+        while (m_buffer.size() % alignment != 0)
+            m_buffer.append('\0');
+    }
+
+    void FlatBufferWriter::appendScalar(const qint64 value, const quint8 size)
+    {
+        char data[8] {};
+        qToLittleEndian<quint64>(static_cast<quint64>(value), data);
+
+        m_buffer.append(data, size);
+    }
+
+    /*! Write the Message table with the given header, returns the message metadata. */
+    template<typename F>
+    QByteArray writeMessageMetadata(const MessageHeader headerType, const qint64 bodyLength,
+                            F &&writeHeader)
+    {
+        FlatBufferWriter writer;
+
+        const auto [message, offsets] = writer.writeTable({
+            scalar(0, 2, MetadataVersionV5),
+            scalar(1, 1, static_cast<qint64>(headerType)),
+            offset(2),
+            scalar(3, 8, bodyLength),
+        });
+
+        writer.patchOffset(offsets.constFirst(), std::forward<F>(writeHeader)(writer));
+
+        return writer.finish(message);
+    }
+
+    /*! Append the buffer to the message body (8 bytes padded), returns the Arrow
+        Buffer (offset and length). */
+    template<typename T>
+    std::pair<qint64, qint64>
+    appendBuffer(QByteArray &body, const T *data, const std::size_t count)
+    {
+        const auto position = static_cast<qint64>(body.size());
+        const auto length = static_cast<qint64>(count * sizeof(T));
+
+        // Arrow buffers are little-endian
+        if constexpr (std::endian::native == std::endian::little || sizeof(T) == 1)
+            body.append(reinterpret_cast<const char *>(data), // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+                        static_cast<qsizetype>(length));
+        else
+            for (std::size_t index = 0; index < count; ++index) {
+                char value[sizeof(T)] {};
+                if constexpr (std::is_floating_point_v<T>)
+                    qToLittleEndian(std::bit_cast<quint64>(data[index]), value);
+                else
+                    qToLittleEndian(data[index], value);
+
+                body.append(value, sizeof(T));
+            }
+
+        while (body.size() % 8 != 0)
+            body.append('\0');
+
+        return {position, length};
+    }
+} // namespace
+
+/* public */
+
+ArrowStreamWriter::ArrowStreamWriter(QIODevice &device)
+    : m_device(device)
+{
+    if (!m_device.isWritable())
+        throw Exceptions::InvalidArgumentError(
+                QStringLiteral("The device for the Arrow IPC stream is not writable "
+                               "in %1().")
+                .arg(__tiny_func__));
+}
+
+qint64 ArrowStreamWriter::write(SqlQuery &query, QIODevice &device,
+                                const qint64 batchSize)
+{
+    if (batchSize <= 0)
+        throw Exceptions::InvalidArgumentError(
+                QStringLiteral("The batch size must be greater than 0, '%1' given "
+                               "in %2().")
+                .arg(batchSize).arg(__tiny_func__));
+
+    ArrowStreamWriter writer(device);
+
+    writer.writeSchema(query.record());
+
+    qint64 rowsCount = 0;
+
+    while (true) {
+        const auto batch = ColumnarResult::fromSqlQuery(query, writer.types(),
+                                                        batchSize);
+        // No more rows
+        if (batch.rowsCount() == 0)
+            break;
+
+        writer.writeRecordBatch(batch);
+
+        rowsCount += batch.rowsCount();
+
+        // The last batch
+        if (batch.rowsCount() < batchSize)
+            break;
+    }
+
+    writer.writeEndOfStream();
+
+    return rowsCount;
+}
+
+void ArrowStreamWriter::writeSchema(const QSqlRecord &record)
+{
+    if (m_schemaWritten)
+        throw Exceptions::RuntimeError(
+                QStringLiteral("The Arrow IPC stream schema was already written "
+                               "in %1().")
+                .arg(__tiny_func__));
+
+    const auto columnsCount = record.count();
+
+    m_types.clear();
+    m_types.reserve(columnsCount);
+    for (int index = 0; index < columnsCount; ++index)
+        m_types << ColumnarColumn::typeFor(record.field(index));
+
+    auto metadata = writeMessageMetadata(MessageHeader::Schema, 0,
+                                         [this, &record, columnsCount](FlatBufferWriter &writer)
+    {
+        // Schema table, the endianness field defaults to Little
+        const auto [schema, schemaOffsets] = writer.writeTable({offset(1)});
+
+        const auto [fields, fieldsOffsets] = writer.writeOffsetsVector(columnsCount);
+        writer.patchOffset(schemaOffsets.constFirst(), fields);
+
+        for (int index = 0; index < columnsCount; ++index) {
+            const auto columnType = m_types.at(index);
+
+            const auto arrowType = columnType == ColumnarType::Int64
+                                   ? ArrowType::Int
+                                   : columnType == ColumnarType::Double
+                                     ? ArrowType::FloatingPoint
+                                     : ArrowType::Utf8;
+
+            // Field table (name, nullable, type_type, type, children)
+            const auto [field, fieldOffsets] = writer.writeTable({
+                offset(0),
+                scalar(1, 1, 1),
+                scalar(2, 1, static_cast<qint64>(arrowType)),
+                offset(3),
+                offset(5),
+            });
+            writer.patchOffset(fieldsOffsets.at(index), field);
+
+            writer.patchOffset(fieldOffsets.at(0),
+                               writer.writeString(record.fieldName(index)));
+
+            // Type table
+            qint64 type = 0;
+            if (columnType == ColumnarType::Int64)
+                // Int (bitWidth, is_signed)
+                type = writer.writeTable({scalar(0, 4, 64), scalar(1, 1, 1)}).first;
+            else if (columnType == ColumnarType::Double)
+                // FloatingPoint (precision)
+                type = writer.writeTable({scalar(0, 2, PrecisionDouble)}).first;
+            else
+                // Utf8
+                type = writer.writeTable({}).first;
+
+            writer.patchOffset(fieldOffsets.at(1), type);
+
+            // Children are required even if empty
+            writer.patchOffset(fieldOffsets.at(2),
+                               writer.writeOffsetsVector(0).first);
+        }
+
+        return schema;
+    });
+
+    writeMessage(metadata);
+
+    m_schemaWritten = true;
+}
+
+void ArrowStreamWriter::writeRecordBatch(const ColumnarResult &batch)
+{
+    throwIfInvalidBatch(batch);
+
+    QByteArray body;
+    // FieldNode structs (length, null_count)
+    QVector<std::pair<qint64, qint64>> nodes;
+    nodes.reserve(batch.columnsCount());
+    // Buffer structs (offset, length)
+    QVector<std::pair<qint64, qint64>> buffers;
+    buffers.reserve(batch.columnsCount() * 3);
+
+    for (const auto &column : batch.columns()) {
+        nodes.append({column.size(), column.nullCount()});
+
+        // The validity bitmap may be omitted if there are no nulls
+        const auto &validity = column.validityBitmap();
+        buffers << appendBuffer(body, validity.data(),
+                                column.nullCount() == 0 ? 0 : validity.size());
+
+        switch (column.type()) {
+        case ColumnarType::Int64:
+            buffers << appendBuffer(body, column.int64Values().data(),
+                                    column.int64Values().size());
+            break;
+
+        case ColumnarType::Double:
+            buffers << appendBuffer(body, column.doubleValues().data(),
+                                    column.doubleValues().size());
+            break;
+
+        case ColumnarType::String: {
+            const auto &data = column.stringData();
+
+            buffers << appendBuffer(body, column.stringOffsets().data(),
+                                    column.stringOffsets().size())
+                    << appendBuffer(body, data.constData(),
+                                    static_cast<std::size_t>(data.size()));
+            break;
+        }
+        }
+    }
+
+    auto metadata = writeMessageMetadata(MessageHeader::RecordBatch, body.size(),
+                                         [&batch, &nodes, &buffers](FlatBufferWriter &writer)
+    {
+        // RecordBatch table (length, nodes, buffers)
+        const auto [recordBatch, offsets] = writer.writeTable({
+            scalar(0, 8, batch.rowsCount()),
+            offset(1),
+            offset(2),
+        });
+
+        writer.patchOffset(offsets.at(0), writer.writeStructsVector(nodes));
+        writer.patchOffset(offsets.at(1), writer.writeStructsVector(buffers));
+
+        return recordBatch;
+    });
+
+    writeMessage(metadata, body);
+}
+
+void ArrowStreamWriter::writeEndOfStream()
+{
+    QByteArray data(8, '\0');
+    qToLittleEndian<quint32>(Continuation, data.data());
+
+    writeToDevice(data);
+}
+
+/* private */
+
+void ArrowStreamWriter::writeMessage(const QByteArray &metadata, const QByteArray &body)
+{
+    // The continuation token and the metadata size (the metadata are 8 bytes padded)
+    QByteArray prefix(8, '\0');
+    qToLittleEndian<quint32>(Continuation, prefix.data());
+    qToLittleEndian<qint32>(static_cast<qint32>(metadata.size()), prefix.data() + 4);
+
+    writeToDevice(prefix);
+    writeToDevice(metadata);
+
+    if (!body.isEmpty())
+        writeToDevice(body);
+}
+
+void ArrowStreamWriter::writeToDevice(const QByteArray &data)
+{
+    if (m_device.write(data) == data.size())
+        return;
+
+    throw Exceptions::RuntimeError(
+                QStringLiteral("Writing the Arrow IPC stream failed, %1 in %2().")
+                .arg(m_device.errorString(), __tiny_func__));
+}
+
+void ArrowStreamWriter::throwIfInvalidBatch(const ColumnarResult &batch) const
+{
+    if (!m_schemaWritten)
+        throw Exceptions::RuntimeError(
+                QStringLiteral("The Arrow IPC stream schema must be written before "
+                               "the record batch in %1().")
+                .arg(__tiny_func__));
+
+    const auto matches = std::ranges::equal(batch.columns(), m_types, std::equal_to(),
+                                            &ColumnarColumn::type);
+
+    if (matches)
+        return;
+
+    throw Exceptions::InvalidArgumentError(
+                QStringLiteral("The record batch columns don't match the Arrow IPC "
+                               "stream schema in %1().")
+                .arg(__tiny_func__));
+}
+
+} // namespace Orm::Types
+
+TINYORM_END_COMMON_NAMESPACE
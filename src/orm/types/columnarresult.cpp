@@ -0,0 +1,529 @@
+#include "orm/types/columnarresult.hpp"
+
+#include <QDateTime>
+#include <QtSql/QSqlField>
+#include <QtSql/QSqlRecord>
+
+#include <algorithm>
+#include <functional>
+#include <limits>
+
+#include "orm/constants.hpp"
+#include "orm/exceptions/invalidargumenterror.hpp"
+#include "orm/exceptions/runtimeerror.hpp"
+#include "orm/types/sqlquery.hpp"
+#include "orm/utils/helpers.hpp"
+#include "orm/utils/type.hpp"
+
+TINYORM_BEGIN_COMMON_NAMESPACE
+
+using Orm::Constants::EQ;
+using Orm::Constants::GE;
+using Orm::Constants::GT;
+using Orm::Constants::LE;
+using Orm::Constants::LT;
+using Orm::Constants::NE;
+using Orm::Constants::NE_;
+
+using Orm::Utils::Helpers;
+
+namespace Orm::Types
+{
+
+/* The reduction loops below are intentionally plain loops over the contiguous buffers
+   without branches (null slots are zero-filled), so the compiler can auto-vectorize
+   them. */
+
+namespace
+{
+    /*! Determine whether the given row is selected by the filter mask. */
+    inline bool isSelected(const FilterMask &mask, const std::size_t row) noexcept
+    {
+        return mask.empty() || mask[row] != 0;
+    }
+
+    /*! Get the minimum or maximum of the numeric buffer (nulls are skipped). */
+    template<typename T, typename Compare>
+    std::optional<double>
+    reduceMinMax(const std::vector<T> &values, const ColumnarColumn &column,
+                 const FilterMask &mask, const T initial, Compare compare)
+    {
+        auto result = initial;
+        bool found = false;
+
+        const auto size = values.size();
+
+        for (std::size_t i = 0; i < size; ++i) {
+            const auto ok = column.isValid(static_cast<std::int64_t>(i)) &&
+                            isSelected(mask, i);
+
+            const auto value = ok ? values[i] : initial;
+
+            result = compare(value, result) ? value : result;
+            found = found || ok;
+        }
+
+        if (!found)
+            return std::nullopt;
+
+        return static_cast<double>(result);
+    }
+
+    /*! Get the filter mask for the numeric buffer and the given comparator. */
+    template<typename T, typename Compare>
+    FilterMask filterValues(const std::vector<T> &values, const ColumnarColumn &column,
+                            const double value, Compare compare)
+    {
+        const auto size = values.size();
+
+        FilterMask mask(size, 0);
+
+        for (std::size_t i = 0; i < size; ++i)
+            mask[i] = static_cast<std::uint8_t>(
+                          column.isValid(static_cast<std::int64_t>(i)) &&
+                          compare(static_cast<double>(values[i]), value));
+
+        return mask;
+    }
+} // namespace
+
+/* ColumnarColumn */
+
+/* public */
+
+ColumnarColumn::ColumnarColumn(QString name, const ColumnarType type)
+    : m_name(std::move(name))
+    , m_type(type)
+{
+    if (m_type == ColumnarType::String)
+        m_stringOffsets.push_back(0);
+}
+
+ColumnarType ColumnarColumn::typeFor(const int typeId) noexcept
+{
+    switch (typeId) {
+    case QMetaType::Bool:
+    case QMetaType::Char:
+    case QMetaType::SChar:
+    case QMetaType::UChar:
+    case QMetaType::Short:
+    case QMetaType::UShort:
+    case QMetaType::Int:
+    case QMetaType::UInt:
+    case QMetaType::Long:
+    case QMetaType::ULong:
+    case QMetaType::LongLong:
+    case QMetaType::ULongLong:
+        return ColumnarType::Int64;
+
+    case QMetaType::Float:
+    case QMetaType::Double:
+        return ColumnarType::Double;
+
+    default:
+        return ColumnarType::String;
+    }
+}
+
+ColumnarType ColumnarColumn::typeFor(const QSqlField &field)
+{
+#if QT_VERSION < QT_VERSION_CHECK(6, 0, 0)
+    return typeFor(static_cast<int>(field.type()));
+#else
+    return typeFor(field.metaType().id());
+#endif
+}
+
+bool ColumnarColumn::hasType(const QSqlField &field)
+{
+#if QT_VERSION < QT_VERSION_CHECK(6, 0, 0)
+    return field.type() != QVariant::Invalid;
+#else
+    return field.metaType().isValid();
+#endif
+}
+
+QString ColumnarColumn::stringValue(const std::int64_t row) const
+{
+    if (m_type != ColumnarType::String)
+        throw Exceptions::InvalidArgumentError(
+                QStringLiteral("The '%1' column is not the String column in %2().")
+                .arg(m_name, __tiny_func__));
+
+    const auto start = m_stringOffsets.at(static_cast<std::size_t>(row));
+    const auto end = m_stringOffsets.at(static_cast<std::size_t>(row) + 1);
+
+    return QString::fromUtf8(m_stringData.constData() + start, end - start);
+}
+
+QVariant ColumnarColumn::value(const std::int64_t row) const
+{
+    if (isNull(row))
+        return {};
+
+    switch (m_type) {
+    case ColumnarType::Int64:
+        return QVariant::fromValue<qint64>(
+                    m_int64Values[static_cast<std::size_t>(row)]);
+
+    case ColumnarType::Double:
+        return m_doubleValues[static_cast<std::size_t>(row)];
+
+    case ColumnarType::String:
+        return stringValue(row);
+    }
+
+    Q_UNREACHABLE();
+}
+
+std::int64_t ColumnarColumn::count(const FilterMask &mask) const
+{
+    throwIfInvalidMask(mask, __tiny_func__);
+
+    if (mask.empty())
+        return m_size - m_nullCount;
+
+    std::int64_t result = 0;
+
+    for (std::int64_t i = 0; i < m_size; ++i)
+        result += static_cast<std::int64_t>(
+                      isValid(i) && mask[static_cast<std::size_t>(i)] != 0);
+
+    return result;
+}
+
+double ColumnarColumn::sum(const FilterMask &mask) const
+{
+    throwIfNotNumeric(__tiny_func__);
+    throwIfInvalidMask(mask, __tiny_func__);
+
+    // Null slots are zero-filled so the validity bitmap doesn't have to be checked
+    if (m_type == ColumnarType::Int64) {
+        // Sum integers exactly, convert at the end only
+        std::int64_t result = 0;
+        const auto size = m_int64Values.size();
+
+        if (mask.empty())
+            for (std::size_t i = 0; i < size; ++i)
+                result += m_int64Values[i];
+        else
+            for (std::size_t i = 0; i < size; ++i)
+                result += mask[i] != 0 ? m_int64Values[i] : 0;
+
+        return static_cast<double>(result);
+    }
+
+    double result = 0.0;
+    const auto size = m_doubleValues.size();
+
+    if (mask.empty())
+        for (std::size_t i = 0; i < size; ++i)
+            result += m_doubleValues[i];
+    else
+        for (std::size_t i = 0; i < size; ++i)
+            result += mask[i] != 0 ? m_doubleValues[i] : 0.0;
+
+    return result;
+}
+
+std::optional<double> ColumnarColumn::min(const FilterMask &mask) const
+{
+    throwIfNotNumeric(__tiny_func__);
+    throwIfInvalidMask(mask, __tiny_func__);
+
+    const auto less = [](const auto left, const auto right) { return left < right; };
+
+    if (m_type == ColumnarType::Int64)
+        return reduceMinMax(m_int64Values, *this, mask,
+                            std::numeric_limits<std::int64_t>::max(), less);
+
+    return reduceMinMax(m_doubleValues, *this, mask,
+                        std::numeric_limits<double>::infinity(), less);
+}
+
+std::optional<double> ColumnarColumn::max(const FilterMask &mask) const
+{
+    throwIfNotNumeric(__tiny_func__);
+    throwIfInvalidMask(mask, __tiny_func__);
+
+    const auto greater = [](const auto left, const auto right) { return left > right; };
+
+    if (m_type == ColumnarType::Int64)
+        return reduceMinMax(m_int64Values, *this, mask,
+                            std::numeric_limits<std::int64_t>::min(), greater);
+
+    return reduceMinMax(m_doubleValues, *this, mask,
+                        -std::numeric_limits<double>::infinity(), greater);
+}
+
+FilterMask ColumnarColumn::filter(const QString &comparison, const double value) const
+{
+    throwIfNotNumeric(__tiny_func__);
+
+    const auto filterBy = [this, value](auto compare)
+    {
+        if (m_type == ColumnarType::Int64)
+            return filterValues(m_int64Values, *this, value, compare);
+
+        return filterValues(m_doubleValues, *this, value, compare);
+    };
+
+    if (comparison == EQ)
+        return filterBy(std::equal_to<double>());
+    if (comparison == NE || comparison == NE_)
+        return filterBy(std::not_equal_to<double>());
+    if (comparison == LT)
+        return filterBy(std::less<double>());
+    if (comparison == LE)
+        return filterBy(std::less_equal<double>());
+    if (comparison == GT)
+        return filterBy(std::greater<double>());
+    if (comparison == GE)
+        return filterBy(std::greater_equal<double>());
+
+    throw Exceptions::InvalidArgumentError(
+                QStringLiteral("Unsupported comparison operator '%1' in %2().")
+                .arg(comparison, __tiny_func__));
+}
+
+/* private */
+
+void ColumnarColumn::append(const QVariant &value)
+{
+    if (!value.isValid() || value.isNull())
+        return appendNull();
+
+    switch (m_type) {
+    case ColumnarType::Int64:
+        m_int64Values.push_back(value.toLongLong());
+        break;
+
+    case ColumnarType::Double:
+        m_doubleValues.push_back(value.toDouble());
+        break;
+
+    case ColumnarType::String: {
+        const auto data = Helpers::qVariantTypeId(value) == QMetaType::QDateTime
+                          ? value.value<QDateTime>().toString(Qt::ISODateWithMs)
+                                                    .toUtf8()
+                          : value.toString().toUtf8();
+
+        if (static_cast<qint64>(m_stringData.size()) + data.size() >
+            std::numeric_limits<std::int32_t>::max()
+        )
+            throw Exceptions::RuntimeError(
+                    QStringLiteral("The '%1' String column data exceeded the 2GB "
+                                   "limit in %2().")
+                    .arg(m_name, __tiny_func__));
+
+        m_stringData.append(data);
+        m_stringOffsets.push_back(static_cast<std::int32_t>(m_stringData.size()));
+        break;
+    }
+    }
+
+    appendValidity(true);
+}
+
+void ColumnarColumn::appendNull()
+{
+    // Null slots are zero-filled, so the reductions don't have to branch on them
+    switch (m_type) {
+    case ColumnarType::Int64:
+        m_int64Values.push_back(0);
+        break;
+
+    case ColumnarType::Double:
+        m_doubleValues.push_back(0.0);
+        break;
+
+    case ColumnarType::String:
+        m_stringOffsets.push_back(m_stringOffsets.back());
+        break;
+    }
+
+    ++m_nullCount;
+
+    appendValidity(false);
+}
+
+void ColumnarColumn::appendValidity(const bool valid)
+{
+    const auto bit = m_size & 7;
+
+    if (bit == 0)
+        m_validity.push_back(0);
+
+    if (valid)
+        m_validity.back() |= static_cast<std::uint8_t>(1U << bit);
+
+    ++m_size;
+}
+
+void ColumnarColumn::throwIfNotNumeric(const QString &functionName) const
+{
+    if (m_type != ColumnarType::String)
+        return;
+
+    throw Exceptions::InvalidArgumentError(
+                QStringLiteral("The '%1' column is not numeric, the String columns "
+                               "can't be reduced in %2().")
+                .arg(m_name, functionName));
+}
+
+void ColumnarColumn::throwIfInvalidMask(const FilterMask &mask,
+                                        const QString &functionName) const
+{
+    if (mask.empty() || static_cast<std::int64_t>(mask.size()) == m_size)
+        return;
+
+    throw Exceptions::InvalidArgumentError(
+                QStringLiteral("The filter mask size '%1' doesn't match the '%2' column "
+                               "size '%3' in %4().")
+                .arg(mask.size()).arg(m_name).arg(m_size).arg(functionName));
+}
+
+/* ColumnarResult */
+
+/* public */
+
+ColumnarResult ColumnarResult::fromSqlQuery(SqlQuery &query)
+{
+    ColumnarResult result;
+
+    const auto record = query.record();
+    const auto columnsCount = record.count();
+
+    /* Column types are mapped from the driver's field metadata (the declared column
+       types, eg. the DECIMAL or SQLite NUMERIC column is always the Double column),
+       the first non-null value decides only if the driver doesn't report the type. */
+    std::vector<bool> detected(static_cast<std::size_t>(columnsCount), false);
+
+    result.m_columns.reserve(columnsCount);
+    for (int i = 0; i < columnsCount; ++i) {
+        const auto field = record.field(i);
+        const auto hasType = ColumnarColumn::hasType(field);
+
+        detected[static_cast<std::size_t>(i)] = hasType;
+
+        result.m_columns.append(ColumnarColumn(
+                                    field.name(),
+                                    hasType ? ColumnarColumn::typeFor(field)
+                                            : ColumnarType::String));
+    }
+
+    while (query.next()) {
+        for (int i = 0; i < columnsCount; ++i) {
+            // SqlQuery::value() also correctly handles the QDateTime's time zone
+            auto value = query.value(i);
+            auto &column = result.m_columns[i];
+
+            if (!detected[static_cast<std::size_t>(i)] && !value.isNull()) {
+                // Backfill the leading nulls into the buffer of the detected type
+                ColumnarColumn typed(column.m_name,
+                                     ColumnarColumn::typeFor(
+                                         Helpers::qVariantTypeId(value)));
+
+                for (std::int64_t row = 0; row < column.m_size; ++row)
+                    typed.appendNull();
+
+                column = std::move(typed);
+                detected[static_cast<std::size_t>(i)] = true;
+            }
+
+            column.append(value);
+        }
+
+        ++result.m_rowsCount;
+    }
+
+    return result;
+}
+
+ColumnarResult
+ColumnarResult::fromSqlQuery(SqlQuery &query, const QVector<ColumnarType> &types,
+                             const std::int64_t maxRows)
+{
+    ColumnarResult result;
+
+    const auto record = query.record();
+    const auto columnsCount = record.count();
+
+    if (columnsCount != types.size())
+        throw Exceptions::InvalidArgumentError(
+                QStringLiteral("The number of column types '%1' doesn't match "
+                               "the number of columns '%2' in %3().")
+                .arg(types.size()).arg(columnsCount).arg(__tiny_func__));
+
+    result.m_columns.reserve(columnsCount);
+    for (int i = 0; i < columnsCount; ++i)
+        result.m_columns.append(ColumnarColumn(record.fieldName(i), types.at(i)));
+
+    while (result.m_rowsCount < maxRows && query.next()) {
+        // SqlQuery::value() also correctly handles the QDateTime's time zone
+        for (int i = 0; i < columnsCount; ++i)
+            result.m_columns[i].append(query.value(i));
+
+        ++result.m_rowsCount;
+    }
+
+    return result;
+}
+
+const ColumnarColumn &ColumnarResult::column(const QString &name) const
+{
+    for (const auto &column : m_columns)
+        if (column.name() == name)
+            return column;
+
+    throw Exceptions::InvalidArgumentError(
+                QStringLiteral("The '%1' column doesn't exist in the columnar result "
+                               "in %2().")
+                .arg(name, __tiny_func__));
+}
+
+bool ColumnarResult::contains(const QString &name) const
+{
+    return std::ranges::any_of(m_columns, [&name](const auto &column)
+    {
+        return column.name() == name;
+    });
+}
+
+FilterMask ColumnarResult::maskAnd(const FilterMask &left, const FilterMask &right)
+{
+    if (left.size() != right.size())
+        throw Exceptions::InvalidArgumentError(
+                QStringLiteral("The filter masks sizes don't match in %1().")
+                .arg(__tiny_func__));
+
+    const auto size = left.size();
+
+    FilterMask result(size, 0);
+
+    for (std::size_t i = 0; i < size; ++i)
+        result[i] = static_cast<std::uint8_t>(left[i] & right[i]);
+
+    return result;
+}
+
+FilterMask ColumnarResult::maskOr(const FilterMask &left, const FilterMask &right)
+{
+    if (left.size() != right.size())
+        throw Exceptions::InvalidArgumentError(
+                QStringLiteral("The filter masks sizes don't match in %1().")
+                .arg(__tiny_func__));
+
+    const auto size = left.size();
+
+    FilterMask result(size, 0);
+
+    for (std::size_t i = 0; i < size; ++i)
+        result[i] = static_cast<std::uint8_t>(left[i] | right[i]);
+
+    return result;
+}
+
+} // namespace Orm::Types
+
+TINYORM_END_COMMON_NAMESPACE
@@ -0,0 +1,290 @@
+#include "orm/types/jsonwriter.hpp"
+
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+
+#include <cmath>
+
+#include "orm/exceptions/runtimeerror.hpp"
+#include "orm/utils/helpers.hpp"
+#include "orm/utils/type.hpp"
+
+TINYORM_BEGIN_COMMON_NAMESPACE
+
+using Orm::Utils::Helpers;
+
+namespace Orm::Types
+{
+
+/* public */
+
+JsonWriter::JsonWriter(QIODevice &device)
+    : m_device(&device)
+    , m_buffer(&m_chunk)
+{
+    m_chunk.reserve(65536 + 1024);
+}
+
+JsonWriter::JsonWriter(QByteArray &buffer)
+    : m_buffer(&buffer)
+{}
+
+JsonWriter::~JsonWriter()
+{
+    // Don't throw from the destructor, flush() reports errors
+    if (m_device != nullptr && !m_chunk.isEmpty())
+        m_device->write(m_chunk);
+}
+
+void JsonWriter::beginObject()
+{
+    writeSeparator();
+    writeRaw('{');
+
+    m_hasValue.push_back(false);
+}
+
+void JsonWriter::endObject()
+{
+    writeRaw('}');
+
+    m_hasValue.pop_back();
+    flushIfFull();
+}
+
+void JsonWriter::beginArray()
+{
+    writeSeparator();
+    writeRaw('[');
+
+    m_hasValue.push_back(false);
+}
+
+void JsonWriter::endArray()
+{
+    writeRaw(']');
+
+    m_hasValue.pop_back();
+    flushIfFull();
+}
+
+void JsonWriter::writeKey(const QString &key)
+{
+    writeSeparator();
+    writeString(key);
+    writeRaw(':');
+
+    m_afterKey = true;
+}
+
+void JsonWriter::writeValue(const QVariant &value) // NOLINT(misc-no-recursion)
+{
+    // The same as the AttributeUtils::fixQtNullVariantBug(), null QVariant-s are null
+    if (!value.isValid() || value.isNull())
+        return writeNull();
+
+    switch (Helpers::qVariantTypeId(value)) {
+    case QMetaType::Bool:
+        writeSeparator();
+        return writeRaw(value.value<bool>() ? QByteArrayLiteral("true")
+                                            : QByteArrayLiteral("false"));
+
+    case QMetaType::Char:
+    case QMetaType::SChar:
+    case QMetaType::Short:
+    case QMetaType::Int:
+    case QMetaType::Long:
+    case QMetaType::LongLong:
+        writeSeparator();
+        return writeRaw(QByteArray::number(value.value<qint64>()));
+
+    case QMetaType::UChar:
+    case QMetaType::UShort:
+    case QMetaType::UInt:
+    case QMetaType::ULong:
+    case QMetaType::ULongLong:
+        writeSeparator();
+        return writeRaw(QByteArray::number(value.value<quint64>()));
+
+    case QMetaType::Float:
+    case QMetaType::Double: {
+        const auto number = value.value<double>();
+
+        // The same as the QJsonDocument, JSON doesn't support NaN and infinity
+        if (!std::isfinite(number))
+            return writeNull();
+
+        writeSeparator();
+        return writeRaw(QByteArray::number(number, 'g',
+                                           QLocale::FloatingPointShortest));
+    }
+
+    case QMetaType::QString:
+        writeSeparator();
+        return writeString(value.value<QString>());
+
+    case QMetaType::QVariantMap: {
+        const auto map = value.value<QVariantMap>();
+
+        beginObject();
+        for (auto it = map.constBegin(); it != map.constEnd(); ++it) {
+            writeKey(it.key());
+            writeValue(it.value());
+        }
+        return endObject();
+    }
+
+    case QMetaType::QVariantList: {
+        beginArray();
+        for (const auto list = value.value<QVariantList>();
+             const auto &item : list
+        )
+            writeValue(item);
+        return endArray();
+    }
+
+    default:
+        break;
+    }
+
+    // Other types are rare, let the QJsonValue convert them
+    const auto jsonValue = QJsonValue::fromVariant(value);
+
+    switch (jsonValue.type()) {
+    case QJsonValue::Null:
+    case QJsonValue::Undefined:
+        return writeNull();
+
+    case QJsonValue::String:
+        writeSeparator();
+        return writeString(jsonValue.toString());
+
+    case QJsonValue::Array:
+        writeSeparator();
+        return writeRaw(QJsonDocument(jsonValue.toArray())
+                        .toJson(QJsonDocument::Compact));
+
+    case QJsonValue::Object:
+        writeSeparator();
+        return writeRaw(QJsonDocument(jsonValue.toObject())
+                        .toJson(QJsonDocument::Compact));
+
+    default:
+        return writeValue(jsonValue.toVariant());
+    }
+}
+
+void JsonWriter::writeNull()
+{
+    writeSeparator();
+    writeRaw(QByteArrayLiteral("null"));
+}
+
+void JsonWriter::flush()
+{
+    if (m_device == nullptr || m_chunk.isEmpty())
+        return;
+
+    if (m_device->write(m_chunk) != m_chunk.size())
+        throw Exceptions::RuntimeError(
+                QStringLiteral("Writing the JSON failed, %1 in %2().")
+                .arg(m_device->errorString(), __tiny_func__));
+
+    m_chunk.resize(0);
+}
+
+/* private */
+
+void JsonWriter::writeSeparator()
+{
+    // The value of the object member, the key already wrote the separator
+    if (m_afterKey) {
+        m_afterKey = false;
+        return;
+    }
+
+    // Top-level value
+    if (m_hasValue.empty())
+        return;
+
+    if (m_hasValue.back())
+        writeRaw(',');
+    else
+        m_hasValue.back() = true;
+}
+
+void JsonWriter::writeString(const QString &string)
+{
+    static const char *const hexDigits = "0123456789abcdef";
+
+    writeRaw('"');
+
+    // Escape the same characters as the QJsonDocument, other characters are UTF-8
+    qsizetype start = 0;
+    const auto size = string.size();
+
+    for (qsizetype index = 0; index < size; ++index) {
+        const auto character = string.at(index).unicode();
+
+        if (character >= 0x20 && character != u'"' && character != u'\\')
+            continue;
+
+        // Append the run of characters that don't need to be escaped at once
+        if (index > start)
+            writeRaw(QStringView(string).mid(start, index - start).toUtf8());
+
+        start = index + 1;
+
+        writeRaw('\\');
+
+        switch (character) {
+        case u'"':
+            writeRaw('"');
+            break;
+        case u'\\':
+            writeRaw('\\');
+            break;
+        case u'\b':
+            writeRaw('b');
+            break;
+        case u'\f':
+            writeRaw('f');
+            break;
+        case u'\n':
+            writeRaw('n');
+            break;
+        case u'\r':
+            writeRaw('r');
+            break;
+        case u'\t':
+            writeRaw('t');
+            break;
+        default:
+            writeRaw(QByteArrayLiteral("u00"));
+            writeRaw(hexDigits[(character >> 4) & 0xF]);
+            writeRaw(hexDigits[character & 0xF]);
+        }
+    }
+
+    if (start == 0)
+        writeRaw(string.toUtf8());
+    else if (start < size)
+        writeRaw(QStringView(string).mid(start).toUtf8());
+
+    writeRaw('"');
+}
+
+void JsonWriter::writeRaw(const QByteArray &data)
+{
+    m_buffer->append(data);
+}
+
+void JsonWriter::writeRaw(const char character)
+{
+    m_buffer->append(character);
+}
+
+} // namespace Orm::Types
+
+TINYORM_END_COMMON_NAMESPACE
@@ -0,0 +1,321 @@
+#include "orm/utils/cbor.hpp"
+
+#include <QCborValue>
+#include <QDateTime>
+
+#include "orm/exceptions/invalidformaterror.hpp"
+#include "orm/utils/helpers.hpp"
+#include "orm/utils/type.hpp"
+
+TINYORM_BEGIN_COMMON_NAMESPACE
+
+namespace Orm::Utils
+{
+
+/* public */
+
+void Cbor::writeValue(QCborStreamWriter &writer, const QVariant &value)
+{
+    // QVariant without the QMetaType
+    if (!value.isValid())
+        return writer.append(QCborSimpleType::Undefined);
+
+    const auto typeId = Helpers::qVariantTypeId(value);
+
+    // Null QVariant-s need the QMetaType
+    if (value.isNull())
+        return writeTypedValue(writer, value, typeId);
+
+    /* Values of these types are decoded back to the same QMetaType without any type
+       information, all other types are tagged with their QMetaType. */
+    switch (typeId) {
+    case QMetaType::Bool:
+        return writer.append(value.value<bool>());
+
+    case QMetaType::LongLong:
+        return writer.append(value.value<qint64>());
+
+    case QMetaType::Double:
+        return writer.append(value.value<double>());
+
+    case QMetaType::QString:
+        return writer.append(value.value<QString>());
+
+    case QMetaType::QByteArray:
+        return writer.append(value.value<QByteArray>());
+
+    case QMetaType::QDateTime:
+        writer.append(QCborKnownTags::DateTimeString);
+        return writer.append(value.value<QDateTime>().toString(Qt::ISODateWithMs));
+
+    case QMetaType::QDate:
+        writer.append(DateStringTag);
+        return writer.append(value.value<QDate>().toString(Qt::ISODate));
+
+    default:
+        return writeTypedValue(writer, value, typeId);
+    }
+}
+
+QVariant Cbor::readValue(QCborStreamReader &reader) // NOLINT(misc-no-recursion)
+{
+    throwIfError(reader);
+
+    QVariant value;
+
+    switch (reader.type()) {
+    case QCborStreamReader::UnsignedInteger:
+    case QCborStreamReader::NegativeInteger:
+        value = static_cast<qint64>(reader.toInteger());
+        break;
+
+    case QCborStreamReader::Double:
+        value = reader.toDouble();
+        break;
+
+    case QCborStreamReader::Float:
+        value = static_cast<double>(reader.toFloat());
+        break;
+
+    case QCborStreamReader::String:
+        return readString(reader);
+
+    case QCborStreamReader::ByteArray:
+        return readByteArray(reader);
+
+    case QCborStreamReader::SimpleType:
+        // true/false, the null is written only inside the typed value
+        if (reader.isBool())
+            value = reader.toBool();
+        else if (!reader.isUndefined() && !reader.isNull())
+            throwUnsupportedType(reader);
+        break;
+
+    case QCborStreamReader::Tag: {
+        const auto tag = reader.toTag();
+        reader.next();
+
+        if (tag == static_cast<QCborTag>(QCborKnownTags::DateTimeString))
+            return QDateTime::fromString(readString(reader), Qt::ISODateWithMs);
+
+        if (tag == DateStringTag)
+            return QDate::fromString(readString(reader), Qt::ISODate);
+
+        if (tag == TypedValueTag)
+            return readTypedValue(reader);
+
+        throw Exceptions::InvalidFormatError(
+                    QStringLiteral("Unsupported CBOR tag '%1' in %2().")
+                    .arg(static_cast<quint64>(tag)).arg(__tiny_func__));
+    }
+
+    default:
+        throwUnsupportedType(reader);
+    }
+
+    reader.next();
+
+    return value;
+}
+
+QString Cbor::readString(QCborStreamReader &reader)
+{
+    throwIfUnexpectedType(reader, QCborStreamReader::String);
+
+    // The string can be split into more chunks
+    QString string;
+    auto chunk = reader.readString();
+
+    while (chunk.status == QCborStreamReader::Ok) {
+        string += chunk.data;
+        chunk = reader.readString();
+    }
+
+    throwIfError(reader);
+
+    return string;
+}
+
+void Cbor::enterContainer(QCborStreamReader &reader,
+                          const QCborStreamReader::Type type)
+{
+    throwIfUnexpectedType(reader, type);
+
+    reader.enterContainer();
+}
+
+void Cbor::leaveContainer(QCborStreamReader &reader)
+{
+    throwIfError(reader);
+
+    reader.leaveContainer();
+}
+
+/* private */
+
+void Cbor::writeTypedValue(QCborStreamWriter &writer, const QVariant &value,
+                           const int typeId)
+{
+    writer.append(TypedValueTag);
+    writer.startArray(2);
+
+    writer.append(static_cast<qint64>(typeId));
+
+    if (value.isNull())
+        writer.append(nullptr);
+
+    else
+        switch (typeId) {
+        case QMetaType::Char:
+        case QMetaType::SChar:
+        case QMetaType::Short:
+        case QMetaType::Int:
+        case QMetaType::Long:
+            writer.append(value.value<qint64>());
+            break;
+
+        case QMetaType::UChar:
+        case QMetaType::UShort:
+        case QMetaType::UInt:
+        case QMetaType::ULong:
+        case QMetaType::ULongLong:
+            writer.append(value.value<quint64>());
+            break;
+
+        case QMetaType::Float:
+            writer.append(value.value<float>());
+            break;
+
+        case QMetaType::QTime:
+            writer.append(value.value<QTime>().toString(Qt::ISODateWithMs));
+            break;
+
+        // Other types are rare, let the QCborValue encode them
+        default:
+            QCborValue::fromVariant(value).toCbor(writer);
+        }
+
+    writer.endArray();
+}
+
+QVariant Cbor::readTypedValue(QCborStreamReader &reader) // NOLINT(misc-no-recursion)
+{
+    enterContainer(reader, QCborStreamReader::Array);
+
+    throwIfUnexpectedType(reader, QCborStreamReader::UnsignedInteger);
+    const auto typeId = static_cast<int>(reader.toUnsignedInteger());
+    reader.next();
+
+    QVariant value;
+
+    // Null QVariant of the given type
+    if (reader.isNull()) {
+#if QT_VERSION >= QT_VERSION_CHECK(6, 0, 0)
+        value = QVariant(QMetaType(typeId));
+#else
+        value = QVariant(typeId, nullptr);
+#endif
+        reader.next();
+    }
+    else if (typeId == QMetaType::QTime)
+        value = QTime::fromString(readString(reader), Qt::ISODateWithMs);
+
+    // ULongLong values that don't fit into the qint64
+    else if (reader.isUnsignedInteger()) {
+        value = static_cast<quint64>(reader.toUnsignedInteger());
+        reader.next();
+    }
+    else if (reader.isFloat()) {
+        value = reader.toFloat();
+        reader.next();
+    }
+    else if (reader.isArray() || reader.isMap() || reader.isTag())
+        value = QCborValue::fromCbor(reader).toVariant();
+
+    else
+        value = readValue(reader);
+
+    leaveContainer(reader);
+
+    // Convert back to the original type
+    if (Helpers::qVariantTypeId(value) != typeId &&
+#if QT_VERSION >= QT_VERSION_CHECK(6, 0, 0)
+        !value.convert(QMetaType(typeId))
+#else
+        !value.convert(typeId)
+#endif
+    )
+        throw Exceptions::InvalidFormatError(
+                QStringLiteral("Can't convert the CBOR value to the '%1' type in %2().")
+                .arg(QString::fromLatin1(
+#if QT_VERSION >= QT_VERSION_CHECK(6, 0, 0)
+                         QMetaType(typeId).name()),
+#else
+                         QMetaType::typeName(typeId)),
+#endif
+                     __tiny_func__));
+
+    return value;
+}
+
+QByteArray Cbor::readByteArray(QCborStreamReader &reader)
+{
+    throwIfUnexpectedType(reader, QCborStreamReader::ByteArray);
+
+    // The byte string can be split into more chunks
+    QByteArray byteArray;
+    auto chunk = reader.readByteArray();
+
+    while (chunk.status == QCborStreamReader::Ok) {
+        byteArray += chunk.data;
+        chunk = reader.readByteArray();
+    }
+
+    throwIfError(reader);
+
+    return byteArray;
+}
+
+void Cbor::throwIfUnexpectedType(const QCborStreamReader &reader,
+                                 const QCborStreamReader::Type type)
+{
+    throwIfError(reader);
+
+    if (reader.type() == type)
+        return;
+
+    throw Exceptions::InvalidFormatError(
+                QStringLiteral("Unexpected CBOR data type '%1' at the offset %2, "
+                               "expected '%3' in %4().")
+                .arg(static_cast<int>(reader.type()))
+                .arg(reader.currentOffset())
+                .arg(static_cast<int>(type))
+                .arg(__tiny_func__));
+}
+
+void Cbor::throwUnsupportedType(const QCborStreamReader &reader)
+{
+    throwIfError(reader);
+
+    throw Exceptions::InvalidFormatError(
+                QStringLiteral("Unsupported CBOR data type '%1' at the offset %2 "
+                               "in %3().")
+                .arg(static_cast<int>(reader.type()))
+                .arg(reader.currentOffset())
+                .arg(__tiny_func__));
+}
+
+void Cbor::throwIfError(const QCborStreamReader &reader)
+{
+    if (const auto error = reader.lastError(); error == QCborError::NoError)
+        return;
+    else
+        throw Exceptions::InvalidFormatError(
+                QStringLiteral("Invalid CBOR data at the offset %1, %2 in %3().")
+                .arg(reader.currentOffset())
+                .arg(error.toString(), __tiny_func__));
+}
+
+} // namespace Orm::Utils
+
+TINYORM_END_COMMON_NAMESPACE
@@ -0,0 +1,129 @@
+#include "orm/utils/threadpool.hpp"
+
+#include <algorithm>
+#include <exception>
+#include <thread>
+
+TINYORM_BEGIN_COMMON_NAMESPACE
+
+namespace Orm::Utils
+{
+
+/* public */
+
+ThreadPool &ThreadPool::instance()
+{
+    /* Intentionally never destroyed, joining threads during the static destruction
+       can deadlock (eg. under the loader lock on Windows), idle worker threads are
+       terminated at the application exit. */
+    static auto *const pool = new ThreadPool;
+
+    return *pool;
+}
+
+void ThreadPool::parallelFor(const std::size_t count,
+                             const std::function<void(std::size_t index)> &callback)
+{
+    // Nothing to parallelize
+    if (count == 0)
+        return;
+
+    if (count == 1)
+        return std::invoke(callback, 0);
+
+    // Both are guarded by the m_mutex, the pending counter includes the index 0
+    auto pending = count;
+    std::exception_ptr exception;
+
+    const auto runIndex = [this, &callback, &pending, &exception]
+                          (const std::size_t index)
+    {
+        std::exception_ptr indexException;
+
+        try {
+            std::invoke(callback, index);
+        } catch (...) {
+            indexException = std::current_exception();
+        }
+
+        std::scoped_lock lock(m_mutex);
+
+        // Keep only the first exception
+        if (indexException && !exception)
+            exception = std::move(indexException);
+
+        --pending;
+
+        /* Notify under the lock, the parallelFor() can return right after the pending
+           counter reaches zero and the runIndex must not be used after that. */
+        m_taskFinished.notify_all();
+    };
+
+    {
+        std::scoped_lock lock(m_mutex);
+
+        startWorkers();
+
+        for (std::size_t index = 1; index < count; ++index)
+            m_tasks.emplace_back([&runIndex, index] { runIndex(index); });
+    }
+
+    m_taskQueued.notify_all();
+
+    // The calling thread processes the first index
+    runIndex(0);
+
+    /* The calling thread helps with queued tasks while waiting, so the nested
+       parallelFor() called from a worker thread can't deadlock. */
+    std::unique_lock lock(m_mutex);
+
+    while (pending > 0) {
+        if (m_tasks.empty()) {
+            m_taskFinished.wait(lock);
+            continue;
+        }
+
+        auto task = std::move(m_tasks.front());
+        m_tasks.pop_front();
+
+        lock.unlock();
+        std::invoke(task);
+        lock.lock();
+    }
+
+    if (exception)
+        std::rethrow_exception(exception);
+}
+
+/* private */
+
+ThreadPool::ThreadPool()
+    : m_threadsCount(std::max(std::thread::hardware_concurrency(), 2U) - 1)
+{}
+
+void ThreadPool::startWorkers()
+{
+    // Workers are never joined, see the instance() method
+    for (; m_workersCount < m_threadsCount; ++m_workersCount)
+        std::thread(&ThreadPool::workerLoop, this).detach();
+}
+
+void ThreadPool::workerLoop()
+{
+    std::unique_lock lock(m_mutex);
+
+    while (true) {
+        m_taskQueued.wait(lock, [this] { return !m_tasks.empty(); });
+
+        auto task = std::move(m_tasks.front());
+        m_tasks.pop_front();
+
+        lock.unlock();
+        std::invoke(task);
+        lock.lock();
+    }
+}
+
+} // namespace Orm::Utils
+
+TINYORM_END_COMMON_NAMESPACE
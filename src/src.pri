@@ -6,6 +6,7 @@ extern_constants: \
 sourcesList += \
     $$PWD/orm/basegrammar.cpp \
     $$PWD/orm/concerns/countsqueries.cpp \
+    $$PWD/orm/concerns/detectsnplusonequeries.cpp \
     $$PWD/orm/concerns/detectslostconnections.cpp \
     $$PWD/orm/concerns/hasconnectionresolver.cpp \
     $$PWD/orm/concerns/logsqueries.cpp \
@@ -32,12 +33,15 @@ sourcesList += \
     $$PWD/orm/libraryinfo.cpp \
     $$PWD/orm/mysqlconnection.cpp \
     $$PWD/orm/postgresconnection.cpp \
+    $$PWD/orm/query/cache/cachedsqlresult.cpp \
+    $$PWD/orm/query/cache/lruquerycache.cpp \
     $$PWD/orm/query/concerns/buildsqueries.cpp \
     $$PWD/orm/query/grammars/grammar.cpp \
     $$PWD/orm/query/grammars/mysqlgrammar.cpp \
     $$PWD/orm/query/grammars/postgresgrammar.cpp \
     $$PWD/orm/query/grammars/sqlitegrammar.cpp \
     $$PWD/orm/query/joinclause.cpp \
+    $$PWD/orm/query/processors/mysqlprocessor.cpp \
     $$PWD/orm/query/processors/processor.cpp \
     $$PWD/orm/query/processors/sqliteprocessor.cpp \
     $$PWD/orm/query/querybuilder.cpp \
@@ -55,7 +59,11 @@ sourcesList += \
     $$PWD/orm/schema/schemabuilder.cpp \
     $$PWD/orm/schema/sqliteschemabuilder.cpp \
     $$PWD/orm/sqliteconnection.cpp \
+    $$PWD/orm/types/arrowstreamwriter.cpp \
+    $$PWD/orm/types/columnarresult.cpp \
+    $$PWD/orm/types/jsonwriter.cpp \
     $$PWD/orm/types/sqlquery.cpp \
+    $$PWD/orm/utils/cbor.cpp \
     $$PWD/orm/utils/configuration.cpp \
     $$PWD/orm/utils/fs.cpp \
     $$PWD/orm/utils/helpers.cpp \
@@ -63,10 +71,12 @@ sourcesList += \
     $$PWD/orm/utils/query.cpp \
     $$PWD/orm/utils/string.cpp \
     $$PWD/orm/utils/thread.cpp \
+    $$PWD/orm/utils/threadpool.cpp \
     $$PWD/orm/utils/type.cpp \
 
 !disable_orm: \
     sourcesList += \
+        $$PWD/orm/tiny/cache/entitycache.cpp \
         $$PWD/orm/tiny/concerns/guardedmodel.cpp \
         $$PWD/orm/tiny/exceptions/modelnotfounderror.cpp \
         $$PWD/orm/tiny/exceptions/relationmappingnotfounderror.cpp \
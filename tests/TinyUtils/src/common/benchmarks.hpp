@@ -0,0 +1,40 @@
+#pragma once
+#ifndef TINYUTILS_COMMON_BENCHMARKS_HPP
+#define TINYUTILS_COMMON_BENCHMARKS_HPP
+
+#include <QString>
+
+namespace TestUtils::Common
+{
+
+    /*! Common code for the benchmark_xyz test methods, library class. */
+    class Benchmarks final
+    {
+        Q_DISABLE_COPY_MOVE(Benchmarks)
+
+    public:
+        /*! Deleted default constructor, this is a pure library class. */
+        Benchmarks() = delete;
+        /*! Deleted destructor. */
+        ~Benchmarks() = delete;
+
+        /*! Template message for the QSKIP() for benchmarks. */
+        inline static const auto Skipped =
+                QStringLiteral("%1 benchmark skipped, set the TINYORM_BENCHMARKS "
+                               "environment variable to run benchmarks.");
+
+        /*! Determine whether benchmarks should run, they are slow so they are skipped
+            in the regular auto tests run unless the TINYORM_BENCHMARKS is set. */
+        inline static bool enabled();
+    };
+
+    /* public */
+
+    bool Benchmarks::enabled()
+    {
+        return qEnvironmentVariableIsSet("TINYORM_BENCHMARKS");
+    }
+
+} // namespace TestUtils::Common
+
+#endif // TINYUTILS_COMMON_BENCHMARKS_HPP
@@ -1,6 +1,7 @@
 INCLUDEPATH += $$PWD
 
 HEADERS += \
+    $$PWD/common/benchmarks.hpp \
     $$PWD/common/collection.hpp \
     $$PWD/databases.hpp \
     $$PWD/export.hpp \
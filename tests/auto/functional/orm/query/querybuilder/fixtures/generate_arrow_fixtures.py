@@ -0,0 +1,37 @@
+#!/usr/bin/env python3
+
+# Generates the Apache Arrow IPC stream fixtures for the tst_QueryBuilder using pyarrow,
+# the data match the torrent_previewable_files table from the testdata seeder.
+# Usage: python3 generate_arrow_fixtures.py (pip install pyarrow)
+
+import pathlib
+
+import pyarrow as pa
+import pyarrow.ipc as ipc
+
+FIXTURES = pathlib.Path(__file__).resolve().parent
+
+schema = pa.schema([
+    ('id', pa.int64()),
+    ('size', pa.int64()),
+    ('note', pa.string()),
+])
+
+rows = [
+    {'id': 1, 'size': 1024, 'note': 'no file properties'},
+    {'id': 2, 'size': 2048, 'note': None},
+    {'id': 3, 'size': 3072, 'note': None},
+    {'id': 4, 'size': 5568, 'note': None},
+    {'id': 5, 'size': 4096, 'note': None},
+    {'id': 6, 'size': 2048, 'note': None},
+    {'id': 7, 'size': 2560, 'note': 'for tst_BaseModel::remove()/destroy()'},
+    {'id': 8, 'size': 2570, 'note': 'for tst_BaseModel::destroy()'},
+]
+
+BATCH_SIZE = 3
+
+with ipc.new_stream(FIXTURES / 'torrent_previewable_files.arrows', schema) as writer:
+    # Every batch has its own buffers (Table.to_batches() slices share them)
+    for index in range(0, len(rows), BATCH_SIZE):
+        writer.write_batch(pa.RecordBatch.from_pylist(rows[index:index + BATCH_SIZE],
+                                                      schema=schema))
@@ -1,7 +1,12 @@
+#include <QBuffer>
 #include <QCoreApplication>
+#include <QFile>
 #include <QtSql/QSqlDriver>
+#include <QtEndian>
 #include <QtTest>
 
+#include <array>
+
 #include "orm/db.hpp"
 #include "orm/exceptions/invalidargumenterror.hpp"
 #include "orm/exceptions/multiplerecordsfounderror.hpp"
@@ -13,15 +18,20 @@
 using Orm::Constants::ASTERISK;
 using Orm::Constants::COMMA;
 using Orm::Constants::CREATED_AT;
+using Orm::Constants::GE;
 using Orm::Constants::GT;
 using Orm::Constants::ID;
 using Orm::Constants::LE;
 using Orm::Constants::LT;
 using Orm::Constants::NAME;
+using Orm::Constants::NOTE;
 using Orm::Constants::OR;
+using Orm::Constants::Progress;
 using Orm::Constants::QMYSQL;
 using Orm::Constants::SIZE_;
 
+using Orm::ColumnarResult;
+using Orm::ColumnarType;
 using Orm::DB;
 using Orm::Exceptions::InvalidArgumentError;
 using Orm::Exceptions::MultipleRecordsFoundError;
@@ -36,6 +46,51 @@ using TypeUtils = Orm::Utils::Type;
 
 using TestUtils::Databases;
 
+namespace
+{
+    /*! Decoded torrent previewable file row mapped by the column names. */
+    struct FileRowNamed
+    {
+        /*! Column names the fields are mapped to. */
+        constexpr static std::array RowColumns {"note", "filepath", "id"};
+
+        std::optional<QString> note;
+        QString filepath;
+        quint64 id = 0;
+    };
+
+    /*! Arrow Type union ids (see Schema.fbs). */
+    enum ArrowTypeId : quint8
+    {
+        /*! Int type. */
+        ArrowInt           = 2,
+        /*! FloatingPoint type. */
+        ArrowFloatingPoint = 3,
+        /*! Utf8 type. */
+        ArrowUtf8          = 5,
+    };
+
+    /*! Decoded field of the Arrow IPC stream schema message. */
+    struct ArrowField
+    {
+        /*! Field name. */
+        QString name;
+        /*! Field type_type (the Type union id). */
+        quint8 typeType = 0;
+        /*! Whether the field is nullable. */
+        bool nullable = false;
+        /*! Int.bitWidth. */
+        qint32 bitWidth = 0;
+        /*! Int.is_signed. */
+        bool isSigned = false;
+        /*! FloatingPoint.precision. */
+        qint16 precision = 0;
+
+        /*! Equality comparison operator for the ArrowField. */
+        bool operator==(const ArrowField &) const = default;
+    };
+} // namespace
+
 class tst_QueryBuilder : public QObject // clazy:exclude=ctor-missing-parent-argument
 {
     Q_OBJECT
@@ -143,11 +198,47 @@ private Q_SLOTS:
     void eachById_ReturnFalse_WithAlias() const;
     void eachById_EmptyResult_WithAlias() const;
 
+    void lazyById() const;
+    void lazyById_EmptyResult() const;
+    void lazyById_WithAlias() const;
+    void lazyById_Prefetch() const;
+
+    void cursor() const;
+    void cursor_EmptyResult() const;
+
+    void getAs_Aggregate() const;
+    void getAs_Tuple() const;
+    void getAs_ColumnsCountMismatch() const;
+    void getAs_RowColumns() const;
+    void getAs_RowColumns_MissingColumn() const;
+    void getAs_NullIntoNonOptional() const;
+    void getAs_NotConvertible() const;
+    void cursorAs() const;
+
+    void getColumnar() const;
+    void getColumnar_FilterMask() const;
+    void getColumnar_LeadingNulls() const;
+    void getColumnar_DecimalColumn() const;
+    void getColumnar_StringColumnReduction_ThrowException() const;
+
+    void toArrowStream() const;
+    void toArrowStream_InvalidBatchSize() const;
+
+    void chunkByIdParallel() const;
+    void chunkByIdParallel_ReturnFalse() const;
+
 // NOLINTNEXTLINE(readability-redundant-access-specifiers)
 private:
     /*! Create QueryBuilder instance for the given connection. */
     [[nodiscard]] static std::shared_ptr<QueryBuilder>
     createQuery(const QString &connection);
+
+    /*! Get the header types and bodies of the Arrow IPC stream messages. */
+    [[nodiscard]] static QVector<std::pair<quint8, QByteArray>>
+    arrowMessages(const QByteArray &stream);
+    /*! Get the fields of the Arrow IPC stream schema message (the first message). */
+    [[nodiscard]] static QVector<ArrowField>
+    arrowSchema(const QByteArray &stream);
 };
 
 /* private slots */
@@ -2223,6 +2314,474 @@ void tst_QueryBuilder::eachById_EmptyResult_WithAlias() const
     QVERIFY(!callbackInvoked);
     QVERIFY(result);
 }
+
+void tst_QueryBuilder::lazyById() const
+{
+    QFETCH_GLOBAL(QString, connection);
+
+    std::vector<quint64> ids;
+    ids.reserve(8);
+
+    for (const auto &record : createQuery(connection)->from("file_property_properties")
+                                                     .lazyById(3))
+        ids.emplace_back(record.value(ID).value<quint64>());
+
+    std::vector<quint64> expectedIds {1, 2, 3, 4, 5, 6, 7, 8};
+
+    QVERIFY(ids.size() == expectedIds.size());
+    QCOMPARE(ids, expectedIds);
+}
+
+void tst_QueryBuilder::lazyById_EmptyResult() const
+{
+    QFETCH_GLOBAL(QString, connection);
+
+    auto records = createQuery(connection)->from("file_property_properties")
+                   .whereEq(NAME, QStringLiteral("dummy-NON_EXISTENT"))
+                   .lazyById(3);
+
+    QVERIFY(records.next() == nullptr);
+}
+
+void tst_QueryBuilder::lazyById_WithAlias() const
+{
+    QFETCH_GLOBAL(QString, connection);
+
+    std::vector<quint64> ids;
+    ids.reserve(8);
+
+    for (const auto &record : createQuery(connection)->from("file_property_properties")
+                                                     .select({ASTERISK, "id as id_as"})
+                                                     .lazyById(3, ID, "id_as"))
+        ids.emplace_back(record.value("id_as").value<quint64>());
+
+    std::vector<quint64> expectedIds {1, 2, 3, 4, 5, 6, 7, 8};
+
+    QVERIFY(ids.size() == expectedIds.size());
+    QCOMPARE(ids, expectedIds);
+}
+
+void tst_QueryBuilder::lazyById_Prefetch() const
+{
+    QFETCH_GLOBAL(QString, connection);
+
+    std::vector<quint64> ids;
+    ids.reserve(8);
+
+    for (const auto &record : createQuery(connection)->from("file_property_properties")
+                                                     .lazyById(3, "", "", true))
+        ids.emplace_back(record.value(ID).value<quint64>());
+
+    std::vector<quint64> expectedIds {1, 2, 3, 4, 5, 6, 7, 8};
+
+    QVERIFY(ids.size() == expectedIds.size());
+    QCOMPARE(ids, expectedIds);
+}
+
+void tst_QueryBuilder::cursor() const
+{
+    QFETCH_GLOBAL(QString, connection);
+
+    std::vector<quint64> ids;
+    ids.reserve(8);
+
+    for (const auto &record : createQuery(connection)->from("file_property_properties")
+                                                     .orderBy(ID)
+                                                     .cursor({ID, NAME}))
+    {
+        QCOMPARE(record.count(), 2);
+        ids.emplace_back(record.value(ID).value<quint64>());
+    }
+
+    std::vector<quint64> expectedIds {1, 2, 3, 4, 5, 6, 7, 8};
+
+    QVERIFY(ids.size() == expectedIds.size());
+    QCOMPARE(ids, expectedIds);
+}
+
+void tst_QueryBuilder::cursor_EmptyResult() const
+{
+    QFETCH_GLOBAL(QString, connection);
+
+    auto records = createQuery(connection)->from("file_property_properties")
+                   .whereEq(NAME, QStringLiteral("dummy-NON_EXISTENT"))
+                   .cursor();
+
+    QVERIFY(records.next() == nullptr);
+}
+
+void tst_QueryBuilder::getAs_Aggregate() const
+{
+    QFETCH_GLOBAL(QString, connection);
+
+    /*! Decoded torrent previewable file row. */
+    struct FileRow
+    {
+        quint64 id = 0;
+        QString filepath;
+        std::optional<QString> note;
+    };
+
+    auto files = createQuery(connection)->from("torrent_previewable_files")
+                 .whereIn(ID, {1, 2})
+                 .orderBy(ID)
+                 .getAs<FileRow>({ID, "filepath", "note"});
+
+    QCOMPARE(files.size(), 2);
+
+    QCOMPARE(files.at(0).id, static_cast<quint64>(1));
+    QCOMPARE(files.at(0).filepath, QString("test1_file1.mkv"));
+    QCOMPARE(files.at(0).note, std::make_optional<QString>("no file properties"));
+
+    QCOMPARE(files.at(1).id, static_cast<quint64>(2));
+    QCOMPARE(files.at(1).filepath, QString("test2_file1.mkv"));
+    QVERIFY(!files.at(1).note);
+}
+
+void tst_QueryBuilder::getAs_Tuple() const
+{
+    QFETCH_GLOBAL(QString, connection);
+
+    auto properties = createQuery(connection)->from("file_property_properties")
+                      .orderBy(ID)
+                      .getAs<std::tuple<quint64, QString>>({ID, NAME});
+
+    QCOMPARE(properties.size(), 8);
+
+    const auto &[id, name] = properties.constFirst();
+
+    QCOMPARE(id, static_cast<quint64>(1));
+    QCOMPARE(name, QString("test2_file1_property1"));
+}
+
+void tst_QueryBuilder::getAs_ColumnsCountMismatch() const
+{
+    QFETCH_GLOBAL(QString, connection);
+
+    QVERIFY_EXCEPTION_THROWN(
+                createQuery(connection)->from("file_property_properties")
+                .getAs<std::tuple<quint64>>({ID, NAME}),
+                InvalidArgumentError);
+}
+
+void tst_QueryBuilder::getAs_RowColumns() const
+{
+    QFETCH_GLOBAL(QString, connection);
+
+    // The RowColumns are selected instead of the *
+    auto files = createQuery(connection)->from("torrent_previewable_files")
+                 .whereIn(ID, {1, 2})
+                 .orderBy(ID)
+                 .getAs<FileRowNamed>();
+
+    QCOMPARE(files.size(), 2);
+
+    QCOMPARE(files.at(0).id, static_cast<quint64>(1));
+    QCOMPARE(files.at(0).filepath, QString("test1_file1.mkv"));
+    QCOMPARE(files.at(0).note, std::make_optional<QString>("no file properties"));
+
+    QCOMPARE(files.at(1).id, static_cast<quint64>(2));
+    QCOMPARE(files.at(1).filepath, QString("test2_file1.mkv"));
+    QVERIFY(!files.at(1).note);
+
+    // Fields are mapped by the names, not by the selected columns order
+    auto filesReordered = createQuery(connection)->from("torrent_previewable_files")
+                          .whereEq(ID, 1)
+                          .getAs<FileRowNamed>({ID, "torrent_id", "filepath", "note"});
+
+    QCOMPARE(filesReordered.size(), 1);
+
+    QCOMPARE(filesReordered.constFirst().id, static_cast<quint64>(1));
+    QCOMPARE(filesReordered.constFirst().filepath, QString("test1_file1.mkv"));
+    QCOMPARE(filesReordered.constFirst().note,
+             std::make_optional<QString>("no file properties"));
+}
+
+void tst_QueryBuilder::getAs_RowColumns_MissingColumn() const
+{
+    QFETCH_GLOBAL(QString, connection);
+
+    QVERIFY_EXCEPTION_THROWN(
+                createQuery(connection)->from("torrent_previewable_files")
+                .getAs<FileRowNamed>({ID, "filepath"}),
+                InvalidArgumentError);
+}
+
+void tst_QueryBuilder::getAs_NullIntoNonOptional() const
+{
+    QFETCH_GLOBAL(QString, connection);
+
+    // The note column is NULL for the id = 2
+    QVERIFY_EXCEPTION_THROWN(
+                createQuery(connection)->from("torrent_previewable_files")
+                .whereEq(ID, 2)
+                .getAs<std::tuple<quint64, QString>>({ID, "note"}),
+                InvalidArgumentError);
+}
+
+void tst_QueryBuilder::getAs_NotConvertible() const
+{
+    QFETCH_GLOBAL(QString, connection);
+
+    QVERIFY_EXCEPTION_THROWN(
+                createQuery(connection)->from("torrent_previewable_files")
+                .whereEq(ID, 1)
+                .getAs<std::tuple<QDateTime>>({ID}),
+                InvalidArgumentError);
+}
+
+void tst_QueryBuilder::cursorAs() const
+{
+    QFETCH_GLOBAL(QString, connection);
+
+    std::vector<quint64> ids;
+    ids.reserve(8);
+
+    for (const auto &[id, name] :
+         createQuery(connection)->from("file_property_properties")
+                                 .orderBy(ID)
+                                 .cursorAs<std::tuple<quint64, QString>>({ID, NAME})
+    ) {
+        QVERIFY(!name.isEmpty());
+        ids.emplace_back(id);
+    }
+
+    std::vector<quint64> expectedIds {1, 2, 3, 4, 5, 6, 7, 8};
+
+    QVERIFY(ids.size() == expectedIds.size());
+    QCOMPARE(ids, expectedIds);
+}
+
+void tst_QueryBuilder::getColumnar() const
+{
+    QFETCH_GLOBAL(QString, connection);
+
+    const auto result = createQuery(connection)->from("torrent_previewable_files")
+                        .where(ID, LE, 8)
+                        .orderBy(ID)
+                        .getColumnar({ID, SIZE_, NOTE});
+
+    QVERIFY(result.rowsCount() == 8);
+    QVERIFY(result.columnsCount() == 3);
+
+    const auto &size = result.column(SIZE_);
+    QCOMPARE(size.type(), ColumnarType::Int64);
+    QVERIFY(size.size() == 8);
+    QVERIFY(size.nullCount() == 0);
+    QVERIFY(size.count() == 8);
+    QCOMPARE(size.sum(), 22986.0);
+    QVERIFY(size.min() == std::make_optional(1024.0));
+    QVERIFY(size.max() == std::make_optional(5568.0));
+
+    std::vector<std::int64_t> expectedSizes {1024, 2048, 3072, 5568, 4096, 2048, 2560,
+                                             2570};
+    QCOMPARE(size.int64Values(), expectedSizes);
+
+    const auto &note = result.column(NOTE);
+    QCOMPARE(note.type(), ColumnarType::String);
+    QVERIFY(note.nullCount() == 5);
+    QVERIFY(note.count() == 3);
+    QCOMPARE(note.stringValue(0), QString("no file properties"));
+    QVERIFY(note.isNull(1));
+    QVERIFY(!note.value(1).isValid());
+    QCOMPARE(note.stringValue(7), QString("for tst_BaseModel::destroy()"));
+    QVERIFY(note.stringOffsets().size() == 9);
+
+    QVERIFY_EXCEPTION_THROWN(result.column("dummy-NON_EXISTENT"), InvalidArgumentError);
+}
+
+void tst_QueryBuilder::getColumnar_FilterMask() const
+{
+    QFETCH_GLOBAL(QString, connection);
+
+    const auto result = createQuery(connection)->from("torrent_previewable_files")
+                        .where(ID, LE, 8)
+                        .orderBy(ID)
+                        .getColumnar({ID, SIZE_, Progress});
+
+    const auto &size = result.column(SIZE_);
+    const auto &progress = result.column(Progress);
+
+    const auto bigFiles = size.filter(GT, 3000);
+    QVERIFY(size.count(bigFiles) == 3);
+    QCOMPARE(size.sum(bigFiles), 12736.0);
+    QVERIFY(size.min(bigFiles) == std::make_optional(3072.0));
+
+    const auto mask = ColumnarResult::maskAnd(bigFiles, progress.filter(GE, 870));
+    QVERIFY(size.count(mask) == 2);
+    QCOMPARE(size.sum(mask), 8640.0);
+    QVERIFY(size.max(mask) == std::make_optional(5568.0));
+
+    // No row selected
+    const auto none = size.filter(GT, 10000);
+    QVERIFY(size.count(none) == 0);
+    QCOMPARE(size.sum(none), 0.0);
+    QVERIFY(!size.min(none));
+}
+
+void tst_QueryBuilder::getColumnar_LeadingNulls() const
+{
+    QFETCH_GLOBAL(QString, connection);
+
+    const auto result = createQuery(connection)->from("torrent_previewable_files")
+                        .whereIn(ID, {9, 10, 11})
+                        .orderBy(ID)
+                        .getColumnar({ID, "torrent_id"});
+
+    const auto &torrentId = result.column("torrent_id");
+
+    // The type is mapped from the field metadata, not from the first value
+    QCOMPARE(torrentId.type(), ColumnarType::Int64);
+    QVERIFY(torrentId.size() == 3);
+    QVERIFY(torrentId.nullCount() == 1);
+    QVERIFY(torrentId.isNull(0));
+    QVERIFY(torrentId.isValid(1));
+    QCOMPARE(torrentId.sum(), 14.0);
+    QVERIFY(torrentId.min() == std::make_optional(7.0));
+}
+
+void tst_QueryBuilder::getColumnar_DecimalColumn() const
+{
+    QFETCH_GLOBAL(QString, connection);
+
+    // The integral first value must not decide the column type
+    const auto id1 = createQuery(connection)->from("types")
+                     .insertGetId({{"decimal", 1}});
+    const auto id2 = createQuery(connection)->from("types")
+                     .insertGetId({{"decimal", 10.5}});
+
+    const auto result = createQuery(connection)->from("types")
+                        .whereIn(ID, {id1, id2})
+                        .orderBy(ID)
+                        .getColumnar({"decimal"});
+
+    // Restore db
+    createQuery(connection)->from("types").whereIn(ID, {id1, id2}).remove();
+
+    const auto &decimal = result.column("decimal");
+
+    QCOMPARE(decimal.type(), ColumnarType::Double);
+    QVERIFY(decimal.size() == 2);
+
+    std::vector<double> expectedValues {1.0, 10.5};
+    QCOMPARE(decimal.doubleValues(), expectedValues);
+    QCOMPARE(decimal.sum(), 11.5);
+    QVERIFY(decimal.max() == std::make_optional(10.5));
+}
+
+void tst_QueryBuilder::getColumnar_StringColumnReduction_ThrowException() const
+{
+    QFETCH_GLOBAL(QString, connection);
+
+    const auto result = createQuery(connection)->from("torrent_previewable_files")
+                        .orderBy(ID)
+                        .getColumnar({ID, "filepath"});
+
+    const auto &filepath = result.column("filepath");
+
+    QVERIFY_EXCEPTION_THROWN(filepath.sum(), InvalidArgumentError);
+    QVERIFY_EXCEPTION_THROWN(filepath.filter(GT, 1), InvalidArgumentError);
+    // Filter mask size must match the column size
+    QVERIFY_EXCEPTION_THROWN(result.column(ID).sum({1, 0}), InvalidArgumentError);
+}
+
+void tst_QueryBuilder::toArrowStream() const
+{
+    QFETCH_GLOBAL(QString, connection);
+
+    QByteArray stream;
+    QBuffer buffer(&stream);
+    QVERIFY(buffer.open(QIODevice::WriteOnly));
+
+    const auto rowsCount = createQuery(connection)->from("torrent_previewable_files")
+                           .where(ID, LE, 8)
+                           .orderBy(ID)
+                           .toArrowStream(buffer, 3, {ID, SIZE_, NOTE});
+
+    QVERIFY(rowsCount == 8);
+
+    // Generated by the fixtures/generate_arrow_fixtures.py using the pyarrow
+    QFile fixture(QFINDTESTDATA("fixtures/torrent_previewable_files.arrows"));
+    QVERIFY(fixture.open(QIODevice::ReadOnly));
+
+    const auto fixtureStream = fixture.readAll();
+    const auto expected = arrowMessages(fixtureStream);
+
+    // The schema and 3 record batches
+    QVERIFY(expected.size() == 4);
+    // Bodies (buffers of the record batches) must be byte-for-byte identical
+    QCOMPARE(arrowMessages(stream), expected);
+
+    // Schema field names, types, and nullability
+    QVector<ArrowField> expectedSchema {
+        {ID,    ArrowInt,  true, 64, true,  0},
+        {SIZE_, ArrowInt,  true, 64, true,  0},
+        {NOTE,  ArrowUtf8, true, 0,  false, 0},
+    };
+    QCOMPARE(arrowSchema(fixtureStream), expectedSchema);
+    QCOMPARE(arrowSchema(stream), expectedSchema);
+    // End-of-stream marker
+    QVERIFY(stream.endsWith(QByteArray::fromHex("ffffffff00000000")));
+}
+
+void tst_QueryBuilder::toArrowStream_InvalidBatchSize() const
+{
+    QFETCH_GLOBAL(QString, connection);
+
+    QByteArray stream;
+    QBuffer buffer(&stream);
+    QVERIFY(buffer.open(QIODevice::WriteOnly));
+
+    QVERIFY_EXCEPTION_THROWN(
+                createQuery(connection)->from("torrent_previewable_files")
+                .toArrowStream(buffer, 0),
+                InvalidArgumentError);
+}
+
+void tst_QueryBuilder::chunkByIdParallel() const
+{
+    QFETCH_GLOBAL(QString, connection);
+
+    std::mutex mutex;
+    std::vector<quint64> ids;
+    ids.reserve(8);
+
+    auto result = createQuery(connection)->from("file_property_properties")
+                  .chunkByIdParallel(2, 3, [&mutex, &ids]
+                                           (SqlQuery &query, const qint64 /*unused*/)
+    {
+        std::scoped_lock lock(mutex);
+
+        while (query.next())
+            ids.emplace_back(query.value(ID).value<quint64>());
+
+        return true;
+    });
+
+    QVERIFY(result);
+
+    // The order in which workers process chunks is undefined
+    std::ranges::sort(ids);
+
+    std::vector<quint64> expectedIds {1, 2, 3, 4, 5, 6, 7, 8};
+
+    QVERIFY(ids.size() == expectedIds.size());
+    QCOMPARE(ids, expectedIds);
+}
+
+void tst_QueryBuilder::chunkByIdParallel_ReturnFalse() const
+{
+    QFETCH_GLOBAL(QString, connection);
+
+    auto result = createQuery(connection)->from("file_property_properties")
+                  .chunkByIdParallel(2, 3, [](SqlQuery &/*unused*/,
+                                              const qint64 /*unused*/)
+    {
+        return false;
+    });
+
+    QVERIFY(!result);
+}
 // NOLINTEND(readability-convert-member-functions-to-static)
 
 /* private */
@@ -2233,6 +2792,128 @@ tst_QueryBuilder::createQuery(const QString &connection)
     return DB::connection(connection).query();
 }
 
+QVector<std::pair<quint8, QByteArray>>
+tst_QueryBuilder::arrowMessages(const QByteArray &stream)
+{
+    QVector<std::pair<quint8, QByteArray>> messages;
+
+    const auto *const data = stream.constData();
+    qint64 position = 0;
+
+    while (position + 8 <= stream.size()) {
+        // The continuation token and the metadata size
+        const auto metadataSize = qFromLittleEndian<qint32>(data + position + 4);
+        position += 8;
+
+        // End-of-stream marker
+        if (metadataSize == 0)
+            break;
+
+        /* The FlatBuffers Message table, fields: version (id 0), header_type (id 1),
+           header (id 2) and bodyLength (id 3). */
+        const auto *const metadata = data + position;
+        const auto root = qFromLittleEndian<quint32>(metadata);
+        const auto *const vtable = metadata + root -
+                                   qFromLittleEndian<qint32>(metadata + root);
+        const auto vtableSize = qFromLittleEndian<quint16>(vtable);
+
+        const auto fieldOffset = [vtable, vtableSize](const int id) -> quint16
+        {
+            return 4 + (2 * id) < vtableSize
+                    ? qFromLittleEndian<quint16>(vtable + 4 + (2 * id))
+                    : 0;
+        };
+
+        const auto headerType = static_cast<quint8>(metadata[root + fieldOffset(1)]);
+        const auto bodyLength = fieldOffset(3) == 0
+                                ? 0
+                                : qFromLittleEndian<qint64>(metadata + root +
+                                                            fieldOffset(3));
+        position += metadataSize;
+
+        messages.append({headerType, stream.mid(position, bodyLength)});
+
+        position += bodyLength;
+    }
+
+    return messages;
+}
+
+QVector<ArrowField>
+tst_QueryBuilder::arrowSchema(const QByteArray &stream)
+{
+    // Skip the continuation token and the metadata size of the first message
+    const auto *const metadata = stream.constData() + 8;
+
+    // Follow the FlatBuffers uoffset stored at the given position
+    const auto deref = [](const char *const position)
+    {
+        return position + qFromLittleEndian<quint32>(position);
+    };
+    // Get the position of the table field (nullptr for the default value)
+    const auto field = [](const char *const table, const int id) -> const char *
+    {
+        const auto *const vtable = table - qFromLittleEndian<qint32>(table);
+        const auto vtableSize = qFromLittleEndian<quint16>(vtable);
+
+        const auto offset = 4 + (2 * id) < vtableSize
+                            ? qFromLittleEndian<quint16>(vtable + 4 + (2 * id))
+                            : 0;
+
+        return offset == 0 ? nullptr : table + offset;
+    };
+
+    // Message table, fields: header_type (id 1) must be the Schema, header (id 2)
+    const auto *const message = deref(metadata);
+    const auto *const headerType = field(message, 1);
+
+    if (headerType == nullptr || static_cast<quint8>(*headerType) != 1)
+        return {};
+
+    // Schema table, fields (id 1)
+    const auto *const fields = deref(field(deref(field(message, 2)), 1));
+    const auto fieldsCount = qFromLittleEndian<quint32>(fields);
+
+    QVector<ArrowField> result;
+    result.reserve(static_cast<QVector<ArrowField>::size_type>(fieldsCount));
+
+    for (quint32 index = 0; index < fieldsCount; ++index) {
+        /* Field table, fields: name (id 0), nullable (id 1), type_type (id 2),
+           and type (id 3). */
+        const auto *const fieldTable = deref(fields + 4 + (4 * index));
+        const auto *const name = deref(field(fieldTable, 0));
+        const auto *const nullable = field(fieldTable, 1);
+        const auto *const typeType = field(fieldTable, 2);
+
+        ArrowField arrowField {
+            QString::fromUtf8(name + 4, qFromLittleEndian<qint32>(name)),
+            static_cast<quint8>(typeType == nullptr ? 0 : *typeType),
+            nullable != nullptr && *nullable != 0,
+        };
+
+        /* Type table, Int fields: bitWidth (id 0) and is_signed (id 1),
+           FloatingPoint fields: precision (id 0). */
+        const auto *const type = deref(field(fieldTable, 3));
+        const auto *const typeField0 = field(type, 0);
+
+        if (arrowField.typeType == ArrowInt) {
+            const auto *const isSigned = field(type, 1);
+
+            arrowField.bitWidth = typeField0 == nullptr
+                                  ? 0 : qFromLittleEndian<qint32>(typeField0);
+            arrowField.isSigned = isSigned != nullptr && *isSigned != 0;
+        }
+        else if (arrowField.typeType == ArrowFloatingPoint)
+            arrowField.precision = typeField0 == nullptr
+                                   ? static_cast<qint16>(0)
+                                   : qFromLittleEndian<qint16>(typeField0);
+
+        result << std::move(arrowField);
+    }
+
+    return result;
+}
+
 QTEST_MAIN(tst_QueryBuilder)
 
 #include "tst_querybuilder.moc"
@@ -2,6 +2,13 @@
 #include <QtSql/QSqlDriver>
 #include <QtTest>
 
+#include <mutex>
+#include <thread>
+#include <unordered_set>
+
+#include "orm/utils/threadpool.hpp"
+
+#include "common/benchmarks.hpp"
 #include "common/collection.hpp"
 #include "databases.hpp"
 
@@ -32,6 +39,7 @@ using Orm::Tiny::Types::ModelsCollection;
 
 using AttributeUtils = Orm::Tiny::Utils::Attribute;
 
+using TestUtils::Common::Benchmarks;
 using TestUtils::Databases;
 
 using Common = TestUtils::Common::Collection;
@@ -95,6 +103,17 @@ private Q_SLOTS:
     void mapWithKeys_IdAndModelPointer() const;
     void mapWithKeys_IdAndModel() const;
 
+    void keyBy() const;
+    void keyBy_DuplicateValues() const;
+
+    void keyIndex() const;
+    void keyIndex_NotFound_DefaultModel() const;
+    void keyIndex_KeyChangedInPlace() const;
+    void keyIndex_DuplicateKeys() const;
+
+    void benchmark_KeyIndex_data() const;
+    void benchmark_KeyIndex() const;
+
     void only() const;
     void only_Empty() const;
     void except() const;
@@ -139,6 +158,8 @@ private Q_SLOTS:
 
     void sortBy_MoreColumns() const;
     void sortBy_MoreColumns_SecondDescending() const;
+    void sortBy_MoreColumns_Typed() const;
+    void sortBy_MoreColumns_Typed_InvalidColumns() const;
 
     void sortBy_Projection() const;
     void sortByDesc_Projection() const;
@@ -157,10 +178,14 @@ private Q_SLOTS:
 
     void stableSortBy_MoreColumns() const;
     void stableSortBy_MoreColumns_SecondDescending() const;
+    void stableSortByDesc_MoreColumns_Typed() const;
 
     void stableSortBy_Projection() const;
     void stableSortByDesc_Projection() const;
 
+    void sortBy_ParallelLarge() const;
+    void stableSortBy_ParallelLarge() const;
+
     void unique() const;
     void unique_NoSorting() const;
 
@@ -247,11 +272,23 @@ private Q_SLOTS:
     void tap_lvalue() const;
     void tap_rvalue() const;
 
+    void mapParallel() const;
+    void mapParallel_CustomReturnType_WithIndex() const;
+    void filterParallel() const;
+    void rejectParallel_WithIndex() const;
+    void eachParallel_lvalue() const;
+    void eachParallel_Exception() const;
+    void eachParallel_Nested() const;
+    void eachParallel_ReusesWorkerThreads() const;
+
     /* Others */
     void toPointers() const;
 
 // NOLINTNEXTLINE(readability-redundant-access-specifiers)
 private:
+    /*! Create the collection with the given number of albums (IDs from 1). */
+    static ModelsCollection<Album> createAlbums(int count);
+
     /*! Connection name used in this test case. */
     QString m_connection {};
 };
@@ -919,6 +956,171 @@ void tst_Collection_Models::mapWithKeys_IdAndModel() const
     QCOMPARE(result, expected);
 }
 
+void tst_Collection_Models::keyBy() const
+{
+    auto images = AlbumImage::whereEq(Common::album_id, 2)->get();
+    QCOMPARE(images.size(), 5);
+    QCOMPARE(typeid (images), typeid (ModelsCollection<AlbumImage>));
+    QVERIFY(Common::verifyIds(images, {2, 3, 4, 5, 6}));
+
+    // Get result
+    const auto result = images.keyBy<QString>(NAME);
+
+    // Verify
+    QCOMPARE(result.size(), 5);
+
+    std::unordered_map<QString, AlbumImage *> expected {
+        {images[0].getAttribute<QString>(NAME),
+         &images[0]}, // NOLINT(readability-container-data-pointer)
+        {images[1].getAttribute<QString>(NAME), &images[1]},
+        {images[2].getAttribute<QString>(NAME), &images[2]},
+        {images[3].getAttribute<QString>(NAME), &images[3]},
+        {images[4].getAttribute<QString>(NAME), &images[4]},
+    };
+    QCOMPARE(result, expected);
+
+    // Lookups by the primary key
+    const auto resultById = images.keyBy<quint64>(ID);
+
+    QCOMPARE(resultById.size(), 5);
+    QCOMPARE(resultById.at(4), images.find(4));
+    QVERIFY(!resultById.contains(1));
+}
+
+void tst_Collection_Models::keyBy_DuplicateValues() const
+{
+    ModelsCollection<Album> albums = Orm::collect<Album>({
+        {{NAME, "album1"}, {SIZE_, 1}},
+        {{NAME, "album2"}, {SIZE_, 2}},
+        {{NAME, "album3"}, {SIZE_, 1}},
+    });
+
+    // Get result
+    const auto result = albums.keyBy<quint64>(SIZE_);
+
+    // Verify
+    QCOMPARE(result.size(), 2);
+
+    // The first model wins
+    std::unordered_map<quint64, Album *> expected {
+        {1, &albums[0]}, // NOLINT(readability-container-data-pointer)
+        {2, &albums[1]},
+    };
+    QCOMPARE(result, expected);
+}
+
+void tst_Collection_Models::keyIndex() const
+{
+    auto images = AlbumImage::whereEq(Common::album_id, 2)->get();
+    QCOMPARE(images.size(), 5);
+    QCOMPARE(typeid (images), typeid (ModelsCollection<AlbumImage>));
+    QVERIFY(Common::verifyIds(images, {2, 3, 4, 5, 6}));
+
+    // Get result
+    const auto index = images.keyIndex();
+
+    // Verify
+    QCOMPARE(index.size(), 5);
+    QCOMPARE(index.find(4), &images[2]);
+    QCOMPARE(index.find(6), &images[4]);
+    QVERIFY(index.contains(2));
+    QVERIFY(!index.contains(40));
+    QVERIFY(index.find(40) == nullptr);
+}
+
+void tst_Collection_Models::keyIndex_NotFound_DefaultModel() const
+{
+    auto images = AlbumImage::whereEq(Common::album_id, 2)->get();
+    QCOMPARE(images.size(), 5);
+    QVERIFY(Common::verifyIds(images, {2, 3, 4, 5, 6}));
+
+    // Get result
+    AlbumImage *const result = images.keyIndex().find(40, &images[3]);
+
+    // Verify
+    QCOMPARE(result, &images[3]);
+}
+
+void tst_Collection_Models::keyIndex_KeyChangedInPlace() const
+{
+    auto albums = createAlbums(100);
+
+    const auto index = albums.keyIndex();
+
+    // Change the primary key through the model pointer
+    auto *const album = index.find(10);
+    QVERIFY(album);
+    album->setAttribute(ID, 1000);
+
+    // Verify, the stale hit is verified and the miss is confirmed by the linear scan
+    QVERIFY(index.find(10) == nullptr);
+    QCOMPARE(index.find(1000), album);
+    QCOMPARE(index.find(1000), albums.find(1000));
+}
+
+void tst_Collection_Models::keyIndex_DuplicateKeys() const
+{
+    auto albums = createAlbums(100);
+    albums.push_back(Album({{ID, 10}, {NAME, "album10-duplicate"}}));
+
+    // Verify, the first model wins, the same as the find()
+    QCOMPARE(albums.keyIndex().find(10), &albums[9]);
+    QCOMPARE(albums.keyIndex().find(10), albums.find(10));
+}
+
+void tst_Collection_Models::benchmark_KeyIndex_data() const
+{
+    QTest::addColumn<bool>("indexed");
+
+    QTest::newRow("find()") << false;
+    QTest::newRow("keyIndex().find()") << true;
+}
+
+void tst_Collection_Models::benchmark_KeyIndex() const
+{
+    if (!Benchmarks::enabled())
+        QSKIP(Benchmarks::Skipped.arg(TypeUtils::classPureBasename(*this))
+              .toUtf8().constData(), );
+
+    QFETCH(bool, indexed);
+
+    constexpr auto AlbumsSize = 100000;
+    constexpr auto FindsCount = 10000;
+
+    auto albums = createAlbums(AlbumsSize);
+
+    std::vector<quint64> ids;
+    ids.reserve(FindsCount);
+    for (int index = 0; index < FindsCount; ++index)
+        ids.push_back(static_cast<quint64>((index * 7919) % AlbumsSize) + 1);
+
+    quint64 found = 0;
+
+    /* The find() obtains and compares the primary key of every model for every
+       lookup, the keyIndex() hashes the primary keys once (included in the measured
+       time). */
+    if (indexed) {
+        QBENCHMARK {
+            found = 0;
+            const auto index = albums.keyIndex();
+
+            for (const auto id : ids)
+                if (index.find(id) != nullptr)
+                    ++found;
+        }
+    }
+    else {
+        QBENCHMARK {
+            found = 0;
+            for (const auto id : ids)
+                if (albums.find(id) != nullptr)
+                    ++found;
+        }
+    }
+
+    QCOMPARE(found, static_cast<quint64>(FindsCount));
+}
+
 void tst_Collection_Models::only() const
 {
     auto images = AlbumImage::whereEq(Common::album_id, 2)->get();
@@ -1680,6 +1882,51 @@ void tst_Collection_Models::sortBy_MoreColumns_SecondDescending() const
     QCOMPARE(sorted, expectedAlbums);
 }
 
+void tst_Collection_Models::sortBy_MoreColumns_Typed() const
+{
+    ModelsCollection<Album> albums = Orm::collect<Album>({
+        {{NAME, "album3"}, {SIZE_, 1}},
+        {{NAME, "album1"}, {SIZE_, 1}},
+        {{NAME, "album2"}, {SIZE_, 3}},
+        {{NAME, "album2"}, {SIZE_, 4}},
+        {{NAME, "album4"}, {SIZE_, 1}},
+        {{NAME, "album2"}, {SIZE_, 2}},
+        {{NAME, "album4"}, {SIZE_, 2}},
+        {{NAME, "album1"}, {SIZE_, 2}},
+        {{NAME, "album2"}, {SIZE_, 1}},
+    });
+
+    auto sorted = albums.sortBy<QString, quint64>({NAME, SIZE_});
+    QCOMPARE(typeid (sorted), typeid (ModelsCollection<Album *>));
+
+    ModelsCollection<Album> expectedAlbums = Orm::collect<Album>({
+        {{NAME, "album1"}, {SIZE_, 1}},
+        {{NAME, "album1"}, {SIZE_, 2}},
+        {{NAME, "album2"}, {SIZE_, 1}},
+        {{NAME, "album2"}, {SIZE_, 2}},
+        {{NAME, "album2"}, {SIZE_, 3}},
+        {{NAME, "album2"}, {SIZE_, 4}},
+        {{NAME, "album3"}, {SIZE_, 1}},
+        {{NAME, "album4"}, {SIZE_, 1}},
+        {{NAME, "album4"}, {SIZE_, 2}},
+    });
+    QCOMPARE(sorted, expectedAlbums);
+}
+
+void tst_Collection_Models::sortBy_MoreColumns_Typed_InvalidColumns() const
+{
+    ModelsCollection<Album> albums = Orm::collect<Album>({
+        {{NAME, "album2"}, {SIZE_, 1}},
+        {{NAME, "album1"}, {SIZE_, 1}},
+    });
+
+    // The number of columns must match the number of column types
+    QVERIFY_EXCEPTION_THROWN((albums.sortBy<QString, quint64>({NAME})),
+                             InvalidArgumentError);
+    QVERIFY_EXCEPTION_THROWN((albums.stableSortBy<QString, quint64>({NAME, SIZE_, NOTE})),
+                             InvalidArgumentError);
+}
+
 void tst_Collection_Models::sortBy_Projection() const
 {
     ModelsCollection<Album> albums = Orm::collect<Album>({
@@ -2035,6 +2282,36 @@ void tst_Collection_Models::stableSortBy_MoreColumns_SecondDescending() const
     QCOMPARE(sorted, expectedAlbums);
 }
 
+void tst_Collection_Models::stableSortByDesc_MoreColumns_Typed() const
+{
+    ModelsCollection<Album> albums = Orm::collect<Album>({
+        {{NAME, "album3"}, {SIZE_, 1}, {NOTE, ""}},
+        {{NAME, "album5"}, {SIZE_, 1}, {NOTE, "b"}}, // stable sort must guarantee this order
+        {{NAME, "album1"}, {SIZE_, 1}, {NOTE, ""}},
+        {{NAME, "album5"}, {SIZE_, 1}, {NOTE, "a"}},
+        {{NAME, "album2"}, {SIZE_, 3}, {NOTE, ""}},
+        {{NAME, "album2"}, {SIZE_, 4}, {NOTE, ""}},
+        {{NAME, "album4"}, {SIZE_, 1}, {NOTE, ""}},
+        {{NAME, "album2"}, {SIZE_, 2}, {NOTE, ""}},
+    });
+
+    auto sorted = albums.stableSortBy<QString, quint64>({NAME, SIZE_}, true);
+    QCOMPARE(typeid (sorted), typeid (ModelsCollection<Album *>));
+
+    // The descending order is the reversed ascending order (also for equal keys)
+    ModelsCollection<Album> expectedAlbums = Orm::collect<Album>({
+        {{NAME, "album5"}, {SIZE_, 1}, {NOTE, "a"}},
+        {{NAME, "album5"}, {SIZE_, 1}, {NOTE, "b"}},
+        {{NAME, "album4"}, {SIZE_, 1}, {NOTE, ""}},
+        {{NAME, "album3"}, {SIZE_, 1}, {NOTE, ""}},
+        {{NAME, "album2"}, {SIZE_, 4}, {NOTE, ""}},
+        {{NAME, "album2"}, {SIZE_, 3}, {NOTE, ""}},
+        {{NAME, "album2"}, {SIZE_, 2}, {NOTE, ""}},
+        {{NAME, "album1"}, {SIZE_, 1}, {NOTE, ""}},
+    });
+    QCOMPARE(sorted, expectedAlbums);
+}
+
 void tst_Collection_Models::stableSortBy_Projection() const
 {
     ModelsCollection<Album> albums = Orm::collect<Album>({
@@ -2087,6 +2364,63 @@ void tst_Collection_Models::stableSortByDesc_Projection() const
     QCOMPARE(sorted, expectedAlbums);
 }
 
+void tst_Collection_Models::sortBy_ParallelLarge() const
+{
+    // More models than the ParallelSortMinSize so chunks are sorted in parallel
+    auto albums = createAlbums(20000);
+
+    for (auto &album : albums)
+        album.setAttribute(SIZE_, (album.getKeyCasted() * 7919) % 1000);
+
+    auto sorted = albums.sortBy<quint64>(SIZE_);
+    QCOMPARE(typeid (sorted), typeid (ModelsCollection<Album *>));
+    QCOMPARE(sorted.size(), 20000);
+
+    // Sorted and every model is in the result only once
+    std::unordered_set<quint64> ids;
+    ids.reserve(20000);
+
+    for (ModelsCollection<Album *>::size_type index = 0; index < sorted.size();
+         ++index
+    ) {
+        ids.insert(sorted.at(index)->getKeyCasted());
+
+        if (index > 0)
+            QVERIFY(sorted.at(index - 1)->getAttribute<quint64>(SIZE_) <=
+                    sorted.at(index)->getAttribute<quint64>(SIZE_));
+    }
+
+    QCOMPARE(ids.size(), static_cast<std::size_t>(20000));
+}
+
+void tst_Collection_Models::stableSortBy_ParallelLarge() const
+{
+    auto albums = createAlbums(20000);
+
+    for (auto &album : albums)
+        album.setAttribute(SIZE_, (album.getKeyCasted() * 7919) % 1000);
+
+    auto sorted = albums.stableSortBy<quint64>(SIZE_);
+    QCOMPARE(typeid (sorted), typeid (ModelsCollection<Album *>));
+    QCOMPARE(sorted.size(), 20000);
+
+    // Equal sizes must keep the original order (ascending IDs)
+    for (ModelsCollection<Album *>::size_type index = 1; index < sorted.size();
+         ++index
+    ) {
+        const auto *const previous = sorted.at(index - 1);
+        const auto *const current = sorted.at(index);
+
+        const auto previousSize = previous->getAttribute<quint64>(SIZE_);
+        const auto currentSize = current->getAttribute<quint64>(SIZE_);
+
+        QVERIFY(previousSize <= currentSize);
+
+        if (previousSize == currentSize)
+            QVERIFY(previous->getKeyCasted() < current->getKeyCasted());
+    }
+}
+
 void tst_Collection_Models::unique() const
 {
     ModelsCollection<Album> albums = Orm::collect<Album>({
@@ -3854,6 +4188,178 @@ void tst_Collection_Models::tap_rvalue() const
     QCOMPARE(result.first().getAttribute(NAME), QVariant("image2 NEW"));
 }
 
+void tst_Collection_Models::mapParallel() const
+{
+    // More models than the ParallelChunkSize so more threads are used
+    auto albums = createAlbums(5000);
+
+    // Get result
+    const auto result = albums.mapParallel([](Album &&albumCopy)
+    {
+        albumCopy[NAME] = SPACE_IN.arg(albumCopy.getAttribute<QString>(NAME),
+                                       QStringLiteral("NEW"));
+
+        return std::move(albumCopy);
+    });
+
+    // Verify
+    QCOMPARE(typeid (result), typeid (ModelsCollection<Album>));
+    QCOMPARE(result.size(), 5000);
+
+    // The same order as the original collection
+    for (ModelsCollection<Album>::size_type index = 0; index < result.size(); ++index) {
+        const auto &album = result.at(index);
+
+        QCOMPARE(album.getKeyCasted(), static_cast<quint64>(index) + 1);
+        QCOMPARE(album.getAttribute<QString>(NAME),
+                 QStringLiteral("album%1 NEW").arg(index + 1));
+    }
+
+    // Original models are not changed
+    QCOMPARE(albums.first().getAttribute<QString>(NAME), QStringLiteral("album1"));
+}
+
+void tst_Collection_Models::mapParallel_CustomReturnType_WithIndex() const
+{
+    auto albums = createAlbums(5000);
+
+    // Get result
+    const auto result = albums.mapParallel<quint64>(
+                            [](Album &&albumCopy, const auto index) -> quint64
+    {
+        return albumCopy.getKeyCasted() + static_cast<quint64>(index);
+    });
+
+    // Verify
+    QCOMPARE(typeid (result), typeid (QVector<quint64>));
+    QCOMPARE(result.size(), 5000);
+
+    for (QVector<quint64>::size_type index = 0; index < result.size(); ++index)
+        QCOMPARE(result.at(index), static_cast<quint64>(index) * 2 + 1);
+}
+
+void tst_Collection_Models::filterParallel() const
+{
+    auto albums = createAlbums(5000);
+
+    // Get result
+    const auto result = albums.filterParallel([](const Album *const album)
+    {
+        return album->getKeyCasted() % 3 == 0;
+    });
+
+    // Verify
+    QCOMPARE(typeid (result), typeid (ModelsCollection<Album *>));
+    QCOMPARE(result.size(), 1666);
+
+    // The same order as the original collection and pointers to the original models
+    for (ModelsCollection<Album *>::size_type index = 0; index < result.size();
+         ++index
+    ) {
+        QCOMPARE(result.at(index)->getKeyCasted(), static_cast<quint64>(index + 1) * 3);
+        QCOMPARE(result.at(index), &albums[(index + 1) * 3 - 1]);
+    }
+}
+
+void tst_Collection_Models::rejectParallel_WithIndex() const
+{
+    auto albums = createAlbums(5000);
+
+    // Get result
+    const auto result = albums.rejectParallel([](const Album *const /*unused*/,
+                                                 const auto index)
+    {
+        return index >= 10;
+    });
+
+    // Verify
+    QCOMPARE(typeid (result), typeid (ModelsCollection<Album *>));
+    QCOMPARE(result.size(), 10);
+    QVERIFY(Common::verifyIds(result, {1, 2, 3, 4, 5, 6, 7, 8, 9, 10}));
+}
+
+void tst_Collection_Models::eachParallel_lvalue() const
+{
+    auto albums = createAlbums(5000);
+
+    // Get result
+    auto &result = albums.eachParallel([](Album *const album, const auto index)
+    {
+        album->setAttribute(NOTE, QStringLiteral("note%1").arg(index));
+    });
+
+    // Verify
+    QVERIFY((std::is_same_v<decltype (result), decltype (albums) &>));
+    QCOMPARE(&result, &albums);
+
+    for (ModelsCollection<Album>::size_type index = 0; index < albums.size(); ++index)
+        QCOMPARE(albums.at(index).getAttribute<QString>(NOTE),
+                 QStringLiteral("note%1").arg(index));
+}
+
+void tst_Collection_Models::eachParallel_Exception() const
+{
+    auto albums = createAlbums(5000);
+
+    // The exception thrown in the worker thread is re-thrown in the calling thread
+    QVERIFY_EXCEPTION_THROWN(
+                albums.eachParallel([](const Album *const album)
+    {
+        if (album->getKeyCasted() == 4000)
+            throw Orm::Exceptions::InvalidArgumentError("eachParallel");
+    }),
+                InvalidArgumentError);
+}
+
+void tst_Collection_Models::eachParallel_Nested() const
+{
+    auto albums = createAlbums(5000);
+
+    // Nested parallel calls from worker threads must not deadlock the thread pool
+    albums.eachParallel([](Album *const album)
+    {
+        if (album->getKeyCasted() % 1000 != 0)
+            return;
+
+        auto nestedAlbums = createAlbums(5000);
+
+        nestedAlbums.eachParallel([](Album *const nestedAlbum)
+        {
+            nestedAlbum->setAttribute(NOTE, QStringLiteral("nested"));
+        });
+
+        album->setAttribute(NOTE, nestedAlbums.last().getAttribute<QString>(NOTE));
+    });
+
+    // Verify
+    for (const auto &album : std::as_const(albums))
+        if (album.getKeyCasted() % 1000 == 0)
+            QCOMPARE(album.getAttribute<QString>(NOTE), QStringLiteral("nested"));
+        else
+            QVERIFY(!album.getAttribute(NOTE).isValid());
+}
+
+void tst_Collection_Models::eachParallel_ReusesWorkerThreads() const
+{
+    auto albums = createAlbums(5000);
+
+    std::mutex mutex;
+    std::unordered_set<std::thread::id> threadIds;
+
+    const auto collectThreadIds = [&mutex, &threadIds](const Album *const /*unused*/)
+    {
+        std::scoped_lock lock(mutex);
+        threadIds.insert(std::this_thread::get_id());
+    };
+
+    // Invoke it more times, every call would start new threads without the pool
+    for (auto i = 0; i < 3; ++i)
+        albums.eachParallel(collectThreadIds);
+
+    // Verify, the calling thread and the shared thread pool workers only
+    QVERIFY(threadIds.size() <= Orm::Utils::ThreadPool::instance().threadsCount() + 1);
+}
+
 /* Others */
 
 void tst_Collection_Models::toPointers() const
@@ -3870,6 +4376,19 @@ void tst_Collection_Models::toPointers() const
 }
 // NOLINTEND(readability-convert-member-functions-to-static)
 
+/* private */
+
+ModelsCollection<Album> tst_Collection_Models::createAlbums(const int count)
+{
+    ModelsCollection<Album> albums;
+    albums.reserve(count);
+
+    for (int id = 1; id <= count; ++id)
+        albums.push_back(Album({{ID, id}, {NAME, QStringLiteral("album%1").arg(id)}}));
+
+    return albums;
+}
+
 QTEST_MAIN(tst_Collection_Models)
 
 #include "tst_collection_models.moc"
@@ -1,13 +1,19 @@
 #include <QCoreApplication>
 #include <QtTest>
 
+#include <array>
+
 #include "orm/db.hpp"
+#include "orm/exceptions/nplusonequeryerror.hpp"
 
+#include "common/benchmarks.hpp"
 #include "databases.hpp"
 
 #include "models/filepropertyproperty.hpp"
+#include "models/filepropertyproperty_entitycache.hpp"
 #include "models/massassignmentmodels.hpp"
 #include "models/torrent.hpp"
+#include "models/torrent_batchedlazyloading.hpp"
 #include "models/torrenteager.hpp"
 #include "models/torrenteager_without_qdatetime.hpp"
 
@@ -22,22 +28,29 @@ using Orm::Constants::SIZE_;
 using Orm::DB;
 using Orm::Exceptions::InvalidArgumentError;
 using Orm::Exceptions::MultipleRecordsFoundError;
+using Orm::Exceptions::NPlusOneQueryError;
 using Orm::Exceptions::RecordsNotFoundError;
+using Orm::NPlusOneAction;
 using Orm::One;
 
 using TypeUtils = Orm::Utils::Type;
 
 using Orm::Tiny::AttributeItem;
+using Orm::Tiny::Cache::EntityCache;
 using Orm::Tiny::ConnectionOverride;
+using Orm::Tiny::IdentityMap;
 using Orm::Tiny::Exceptions::MassAssignmentError;
 using Orm::Tiny::Types::ModelsCollection;
 
 using AttributeUtils = Orm::Tiny::Utils::Attribute;
 
+using TestUtils::Common::Benchmarks;
 using TestUtils::Databases;
 
 using Models::FilePropertyProperty;
+using Models::FilePropertyProperty_EntityCache;
 using Models::Torrent;
+using Models::Torrent_BatchedLazyLoading;
 using Models::TorrentPreviewableFile;
 using Models::Torrent_AllowedMassAssignment;
 using Models::Torrent_GuardedAttribute;
@@ -47,6 +60,25 @@ using Models::TorrentEager_Without_QDateTime;
 using Models::TorrentPreviewableFileProperty;
 using Models::User;
 
+namespace
+{
+    /*! Decoded file property property row for the getAs<T>() benchmark. */
+    struct FilePropertyPropertyRow
+    {
+        /*! Column names the fields are mapped to. */
+        constexpr static std::array RowColumns {
+            "id", "file_property_id", "name", "value", "created_at", "updated_at"
+        };
+
+        quint64 id = 0;
+        quint64 filePropertyId = 0;
+        QString name;
+        quint64 value = 0;
+        QDateTime createdAt;
+        QDateTime updatedAt;
+    };
+} // namespace
+
 class tst_Model_Connection_Independent : public QObject // clazy:exclude=ctor-missing-parent-argument
 {
     Q_OBJECT
@@ -158,6 +190,34 @@ private Q_SLOTS:
     void eachById_ReturnFalse_WithAlias() const;
     void eachById_EmptyResult_WithAlias() const;
 
+    void lazyById() const;
+
+    void cursor() const;
+    void cursor_EmptyResult() const;
+
+    void chunkByIdParallel() const;
+
+    void entityCache_Find() const;
+    void entityCache_FindMany() const;
+    void entityCache_InTransaction_Bypassed() const;
+    void entityCache_EvictedOnSave() const;
+
+    void identityMap() const;
+    void identityMap_NotActive() const;
+    void identityMap_BelongsTo_SharedParent() const;
+    void identityMap_ForgottenOnSave() const;
+
+    void eagerLoadConcurrently() const;
+    void eagerLoadConcurrently_RelatedDefaultRelations() const;
+
+    void nPlusOneDetector() const;
+    void nPlusOneDetector_Throw() const;
+
+    void batchedLazyLoading() const;
+    void batchedLazyLoading_ForeignKeyChanged() const;
+
+    void attributesHash_SharedByHydratedModels() const;
+
     void tap() const;
 
     void sole() const;
@@ -170,6 +230,12 @@ private Q_SLOTS:
     void soleValue_MultipleRecordsFoundError() const;
     void soleValue_Pretending() const;
 
+    void benchmark_Hydrate() const;
+    void benchmark_AttributesHash_CopyAndModify() const;
+    void benchmark_GetAttribute() const;
+    void benchmark_GetAs_data() const;
+    void benchmark_GetAs() const;
+
 // NOLINTNEXTLINE(readability-redundant-access-specifiers)
 private:
     /*! Connection name used in this test case. */
@@ -2123,6 +2189,563 @@ void tst_Model_Connection_Independent::eachById_EmptyResult_WithAlias() const
     QVERIFY(result);
 }
 
+void tst_Model_Connection_Independent::lazyById() const
+{
+    std::vector<quint64> ids;
+    ids.reserve(8);
+
+    for (const auto &model : FilePropertyProperty::lazyById(3))
+        ids.emplace_back(model.getKeyCasted());
+
+    std::vector<quint64> expectedIds {1, 2, 3, 4, 5, 6, 7, 8};
+
+    QVERIFY(ids.size() == expectedIds.size());
+    QCOMPARE(ids, expectedIds);
+}
+
+void tst_Model_Connection_Independent::cursor() const
+{
+    std::vector<quint64> ids;
+    ids.reserve(8);
+
+    for (const auto &model : FilePropertyProperty::orderBy(ID)->cursor()) {
+        QVERIFY(model.exists);
+        ids.emplace_back(model.getKeyCasted());
+    }
+
+    std::vector<quint64> expectedIds {1, 2, 3, 4, 5, 6, 7, 8};
+
+    QVERIFY(ids.size() == expectedIds.size());
+    QCOMPARE(ids, expectedIds);
+}
+
+void tst_Model_Connection_Independent::cursor_EmptyResult() const
+{
+    auto models = FilePropertyProperty::whereEq(NAME,
+                                                QStringLiteral("dummy-NON_EXISTENT"))
+                  ->cursor();
+
+    QVERIFY(models.next() == nullptr);
+}
+
+void tst_Model_Connection_Independent::chunkByIdParallel() const
+{
+    std::mutex mutex;
+    std::vector<quint64> ids;
+    ids.reserve(8);
+    ModelsCollection<FilePropertyProperty> kept;
+
+    auto result = FilePropertyProperty::chunkByIdParallel(
+                      2, 3, [&mutex, &ids, &kept]
+                            (ModelsCollection<FilePropertyProperty> &&models,
+                             const qint64 /*unused*/)
+    {
+        std::scoped_lock lock(mutex);
+
+        for (auto &&model : models) {
+            ids.emplace_back(model.getKeyCasted());
+
+            kept << std::move(model);
+        }
+
+        return true;
+    });
+
+    QVERIFY(result);
+
+    /* Models kept after the callback must use the original connection, worker
+       connections are removed when workers finish. */
+    QCOMPARE(kept.size(), 8);
+
+    for (const auto &model : kept)
+        QCOMPARE(model.getConnectionName(), m_connection);
+
+    // Models can be used on the current thread after the chunkByIdParallel()
+    QVERIFY(kept.first().fresh());
+
+    // The order in which workers process chunks is undefined
+    std::ranges::sort(ids);
+
+    std::vector<quint64> expectedIds {1, 2, 3, 4, 5, 6, 7, 8};
+
+    QVERIFY(ids.size() == expectedIds.size());
+    QCOMPARE(ids, expectedIds);
+}
+
+void tst_Model_Connection_Independent::entityCache_Find() const
+{
+    auto &cache = EntityCache::instance();
+    cache.flush();
+
+    const auto statsBefore = cache.stats();
+
+    // Obtained from the database and stored in the entity cache
+    auto model1 = FilePropertyProperty_EntityCache::find(1);
+
+    QVERIFY(model1);
+    QVERIFY(model1->exists);
+
+    const auto statsAfterFind = cache.stats();
+    QCOMPARE(statsAfterFind.misses, statsBefore.misses + 1);
+    QCOMPARE(statsAfterFind.puts, statsBefore.puts + 1);
+    QCOMPARE(statsAfterFind.entries, static_cast<quint64>(1));
+
+    // Obtained from the entity cache
+    auto model2 = FilePropertyProperty_EntityCache::find(1);
+
+    QVERIFY(model2);
+    QVERIFY(model2->exists);
+    QCOMPARE(cache.stats().hits, statsAfterFind.hits + 1);
+    QCOMPARE(model2->getAttributes(), model1->getAttributes());
+
+    cache.flush();
+}
+
+void tst_Model_Connection_Independent::entityCache_FindMany() const
+{
+    auto &cache = EntityCache::instance();
+    cache.flush();
+
+    auto models1 = FilePropertyProperty_EntityCache::findMany({1, 2});
+
+    QCOMPARE(models1.size(), 2);
+    QCOMPARE(cache.stats().entries, static_cast<quint64>(2));
+
+    const auto statsBefore = cache.stats();
+
+    // The 1 and 2 are obtained from the entity cache, only the 3 is queried
+    auto models2 = FilePropertyProperty_EntityCache::findMany({3, 1, 2, 1});
+
+    QCOMPARE(models2.size(), 3);
+
+    const auto statsAfter = cache.stats();
+    QCOMPARE(statsAfter.hits, statsBefore.hits + 2);
+    QCOMPARE(statsAfter.misses, statsBefore.misses + 1);
+    QCOMPARE(statsAfter.entries, static_cast<quint64>(3));
+
+    std::vector<quint64> ids;
+    ids.reserve(3);
+
+    for (const auto &model : models2)
+        ids.emplace_back(model.getKeyCasted());
+
+    // Models are in the order of the given IDs, without duplicates
+    std::vector<quint64> expectedIds {3, 1, 2};
+    QCOMPARE(ids, expectedIds);
+
+    cache.flush();
+}
+
+void tst_Model_Connection_Independent::entityCache_InTransaction_Bypassed() const
+{
+    auto &cache = EntityCache::instance();
+    cache.flush();
+
+    auto model1 = FilePropertyProperty_EntityCache::find(1);
+    QVERIFY(model1);
+    QCOMPARE(cache.stats().entries, static_cast<quint64>(1));
+
+    const auto statsBefore = cache.stats();
+
+    DB::beginTransaction(m_connection);
+
+    // Obtained from the database and not stored in the entity cache
+    auto model2 = FilePropertyProperty_EntityCache::find(1);
+    auto models = FilePropertyProperty_EntityCache::findMany({1, 2});
+
+    DB::rollBack(m_connection);
+
+    QVERIFY(model2);
+    QCOMPARE(models.size(), 2);
+
+    const auto statsAfter = cache.stats();
+    QCOMPARE(statsAfter.hits, statsBefore.hits);
+    QCOMPARE(statsAfter.puts, statsBefore.puts);
+    QCOMPARE(statsAfter.entries, static_cast<quint64>(1));
+
+    cache.flush();
+}
+
+void tst_Model_Connection_Independent::entityCache_EvictedOnSave() const
+{
+    auto &cache = EntityCache::instance();
+    cache.flush();
+
+    auto model = FilePropertyProperty_EntityCache::find(1);
+    QVERIFY(model);
+    QCOMPARE(cache.stats().entries, static_cast<quint64>(1));
+
+    const auto originalValue = model->getAttribute("value");
+
+    (*model)["value"] = originalValue.value<quint64>() + 100;
+    QVERIFY(model->save());
+
+    // The saved model must be evicted
+    QCOMPARE(cache.stats().entries, static_cast<quint64>(0));
+
+    auto modelUpdated = FilePropertyProperty_EntityCache::find(1);
+    QVERIFY(modelUpdated);
+    QCOMPARE(modelUpdated->getAttribute("value").value<quint64>(),
+             originalValue.value<quint64>() + 100);
+
+    // Restore
+    (*modelUpdated)["value"] = originalValue;
+    QVERIFY(modelUpdated->save());
+
+    QCOMPARE(cache.stats().entries, static_cast<quint64>(0));
+
+    cache.flush();
+}
+
+void tst_Model_Connection_Independent::identityMap() const
+{
+    IdentityMap identityMap;
+
+    auto models1 = FilePropertyProperty::whereIn(ID, {1, 2})->orderBy(ID).get();
+    QCOMPARE(models1.size(), 2);
+    QCOMPARE(identityMap.size(), static_cast<std::size_t>(2));
+
+    auto models2 = FilePropertyProperty::whereIn(ID, {2, 3})->orderBy(ID).get();
+    QCOMPARE(models2.size(), 2);
+    QCOMPARE(identityMap.size(), static_cast<std::size_t>(3));
+
+    // The model with the ID 2 was hydrated only once, attributes are shared
+    QCOMPARE(models1.at(1).getKeyCasted(), static_cast<quint64>(2));
+    QCOMPARE(models2.at(0).getKeyCasted(), static_cast<quint64>(2));
+    QVERIFY(models1.at(1).getRawAttributes().constData() ==
+            models2.at(0).getRawAttributes().constData());
+
+    // But they are still independent instances
+    models2[0]["value"] = 1000;
+    QVERIFY(models1.at(1).getAttribute("value") != models2.at(0).getAttribute("value"));
+}
+
+void tst_Model_Connection_Independent::identityMap_NotActive() const
+{
+    QVERIFY(IdentityMap::current() == nullptr);
+
+    auto model1 = FilePropertyProperty::find(2);
+    auto model2 = FilePropertyProperty::find(2);
+
+    QVERIFY(model1);
+    QVERIFY(model2);
+    QVERIFY(model1->getRawAttributes().constData() !=
+            model2->getRawAttributes().constData());
+}
+
+void tst_Model_Connection_Independent::identityMap_BelongsTo_SharedParent() const
+{
+    IdentityMap identityMap;
+
+    // All three belong to the file property with the ID 5
+    auto models = FilePropertyProperty::with("fileProperty")->whereIn(ID, {6, 7, 8})
+                  .orderBy(ID).get();
+    QCOMPARE(models.size(), 3);
+
+    const auto *const fileProperty =
+            models.at(0).getRelation<TorrentPreviewableFileProperty, One>(
+                "fileProperty");
+    QVERIFY(fileProperty);
+    QCOMPARE(fileProperty->getKeyCasted(), static_cast<quint64>(5));
+
+    // Every child shares attributes of one parent instance
+    for (const auto &model : models) {
+        const auto *const parent =
+                model.getRelation<TorrentPreviewableFileProperty, One>(
+                    "fileProperty");
+
+        QVERIFY(parent);
+        QVERIFY(parent->getRawAttributes().constData() ==
+                fileProperty->getRawAttributes().constData());
+    }
+}
+
+void tst_Model_Connection_Independent::identityMap_ForgottenOnSave() const
+{
+    IdentityMap identityMap;
+
+    auto model = FilePropertyProperty::find(1);
+    QVERIFY(model);
+    QCOMPARE(identityMap.size(), static_cast<std::size_t>(1));
+
+    const auto originalValue = model->getAttribute("value");
+
+    (*model)["value"] = originalValue.value<quint64>() + 100;
+    QVERIFY(model->save());
+
+    // The saved model was removed from the identity map and is hydrated again
+    auto modelUpdated = FilePropertyProperty::find(1);
+    QVERIFY(modelUpdated);
+    QCOMPARE(modelUpdated->getAttribute("value").value<quint64>(),
+             originalValue.value<quint64>() + 100);
+
+    // Restore
+    (*modelUpdated)["value"] = originalValue;
+    QVERIFY(modelUpdated->save());
+
+    auto modelRestored = FilePropertyProperty::find(1);
+    QVERIFY(modelRestored);
+    QCOMPARE(modelRestored->getAttribute("value"), originalValue);
+}
+
+void tst_Model_Connection_Independent::eagerLoadConcurrently() const
+{
+    const QVector<QString> relations {
+        "torrentFiles", "torrentPeer", "tags", "torrentFiles.fileProperty",
+    };
+
+    auto torrentsExpected = Torrent::with(relations)->orderBy(ID).get();
+    auto torrents = Torrent::with(relations)->eagerLoadConcurrently()
+                    .orderBy(ID).get();
+
+    QCOMPARE(torrents.size(), torrentsExpected.size());
+
+    // Get the primary keys of the given related models
+    const auto relatedKeys = [](const auto &relatedModels)
+    {
+        QVector<quint64> keys;
+        keys.reserve(relatedModels.size());
+
+        for (auto *const relatedModel : relatedModels)
+            keys << relatedModel->getKeyCasted();
+
+        std::ranges::sort(keys);
+
+        return keys;
+    };
+
+    for (auto i = 0; i < torrents.size(); ++i) {
+        auto &torrent = torrents[i];
+        auto &torrentExpected = torrentsExpected[i];
+
+        QCOMPARE(torrent.getKey(), torrentExpected.getKey());
+
+        // Relations loaded concurrently must use the original connection
+        QCOMPARE(torrent.getConnectionName(), torrentExpected.getConnectionName());
+
+        const auto files = torrent.getRelation<TorrentPreviewableFile>("torrentFiles");
+        const auto filesExpected =
+                torrentExpected.getRelation<TorrentPreviewableFile>("torrentFiles");
+
+        QCOMPARE(relatedKeys(files), relatedKeys(filesExpected));
+
+        for (auto *const file : files) {
+            QCOMPARE(file->getConnectionName(), torrent.getConnectionName());
+            // Nested relation loaded after its parent
+            QVERIFY(file->relationLoaded("fileProperty"));
+        }
+
+        QCOMPARE(relatedKeys(torrent.getRelation<Models::Tag>("tags")),
+                 relatedKeys(torrentExpected.getRelation<Models::Tag>("tags")));
+
+        auto *const peer = torrent.getRelation<Models::TorrentPeer, One>("torrentPeer");
+        auto *const peerExpected =
+                torrentExpected.getRelation<Models::TorrentPeer, One>("torrentPeer");
+
+        QCOMPARE(peer == nullptr, peerExpected == nullptr);
+
+        if (peer != nullptr)
+            QCOMPARE(peer->getKey(), peerExpected->getKey());
+    }
+}
+
+void tst_Model_Connection_Independent::
+     eagerLoadConcurrently_RelatedDefaultRelations() const
+{
+    DB::flushQueryLog(m_connection);
+    DB::enableQueryLog(m_connection);
+
+    /* The TorrentPreviewableFileEager loads the fileProperty relation by default
+       (the u_with), it's also requested as the nested relation. */
+    auto torrent = TorrentEager::withOnly("torrentFiles.fileProperty")
+                   ->eagerLoadConcurrently().find(2);
+
+    DB::disableQueryLog(m_connection);
+
+    QVERIFY(torrent);
+
+    const auto files =
+            torrent->getRelation<Models::TorrentPreviewableFileEager>("torrentFiles");
+    QVERIFY(!files.isEmpty());
+
+    for (auto *const file : files) {
+        QCOMPARE(file->getConnectionName(), m_connection);
+
+        auto *const fileProperty =
+                file->getRelation<Models::TorrentPreviewableFilePropertyEager, One>(
+                    "fileProperty");
+
+        // Loaded using the original connection instead of the worker connection
+        QVERIFY(fileProperty);
+        QCOMPARE(fileProperty->getConnectionName(), m_connection);
+    }
+
+    // The fileProperty relation is loaded only once
+    const auto queryLog = DB::getQueryLog(m_connection);
+
+    const auto filePropertyQueries = static_cast<int>(std::ranges::count_if(
+                                         *queryLog, [](const auto &log)
+    {
+        return log.query.contains("from `torrent_previewable_file_properties`");
+    }));
+
+    QCOMPARE(filePropertyQueries, 1);
+}
+
+void tst_Model_Connection_Independent::nPlusOneDetector() const
+{
+    DB::enableNPlusOneDetector(3, NPlusOneAction::Log, m_connection);
+
+    auto torrents = Torrent::whereKey(QVector<QVariant> {1, 2, 3, 4})
+                    ->orderBy(ID).get();
+
+    QCOMPARE(torrents.size(), 4);
+
+    // Lazy loading in the loop, the N+1 query
+    for (auto &torrent : torrents)
+        torrent.getRelationValue<TorrentPreviewableFile>("torrentFiles");
+
+    // Not lazy loading, not reported
+    for (auto i = 0; i < 4; ++i)
+        Torrent::find(1);
+
+    const auto violations = DB::getNPlusOneViolations(m_connection);
+
+    DB::disableNPlusOneDetector(m_connection);
+
+    QCOMPARE(violations.size(), 1);
+    QCOMPARE(violations.constFirst().relation, QString("Torrent::torrentFiles"));
+    QCOMPARE(violations.constFirst().count, static_cast<qint64>(3));
+    QVERIFY(violations.constFirst().queryString.contains("torrent_previewable_files"));
+}
+
+void tst_Model_Connection_Independent::nPlusOneDetector_Throw() const
+{
+    DB::enableNPlusOneDetector(2, NPlusOneAction::Throw, m_connection);
+
+    auto torrents = Torrent::whereKey(QVector<QVariant> {1, 2})->orderBy(ID).get();
+
+    QCOMPARE(torrents.size(), 2);
+
+    // The first lazy loading is ok
+    torrents[0].getRelationValue<TorrentPreviewableFile>("torrentFiles");
+
+    QVERIFY_EXCEPTION_THROWN(
+                torrents[1].getRelationValue<TorrentPreviewableFile>("torrentFiles"),
+                NPlusOneQueryError);
+
+    DB::disableNPlusOneDetector(m_connection);
+
+    // The detector is disabled
+    torrents[1].getRelationValue<TorrentPreviewableFile>("torrentFiles");
+}
+
+void tst_Model_Connection_Independent::batchedLazyLoading() const
+{
+    // Every lazy loading query is reported as the N+1 query
+    DB::enableNPlusOneDetector(2, NPlusOneAction::Throw, m_connection);
+
+    auto torrents = Torrent_BatchedLazyLoading::whereKey(QVector<QVariant> {1, 2, 3, 4})
+                    ->orderBy(ID).get();
+
+    QCOMPARE(torrents.size(), 4);
+
+    // The first lazy loading eager loads the relation for all the torrents
+    QVector<QVector<quint64>> filesKeys;
+    filesKeys.reserve(torrents.size());
+
+    for (auto &torrent : torrents) {
+        const auto files =
+                torrent.getRelationValue<TorrentPreviewableFile>("torrentFiles");
+
+        QVector<quint64> keys;
+        keys.reserve(files.size());
+
+        for (auto *const file : files) {
+            QCOMPARE(file->getAttribute("torrent_id").value<quint64>(),
+                     torrent.getKey().value<quint64>());
+
+            keys << file->getKey().value<quint64>();
+        }
+
+        std::ranges::sort(keys);
+        filesKeys << std::move(keys);
+    }
+
+    QVERIFY(DB::getNPlusOneViolations(m_connection).isEmpty());
+
+    DB::disableNPlusOneDetector(m_connection);
+
+    QVector<QVector<quint64>> expectedFilesKeys {{1}, {2, 3}, {4}, {5}};
+    QCOMPARE(filesKeys, expectedFilesKeys);
+
+    // The one type relation
+    QVERIFY(torrents[0].getRelationValue<Models::TorrentPeer, One>("torrentPeer")
+            != nullptr);
+    QVERIFY(torrents[1].relationLoaded("torrentPeer"));
+}
+
+void tst_Model_Connection_Independent::batchedLazyLoading_ForeignKeyChanged() const
+{
+    // All the torrents belong to the user with the ID 1
+    auto torrents = Torrent_BatchedLazyLoading::whereKey(QVector<QVariant> {1, 2, 3})
+                    ->orderBy(ID).get();
+
+    QCOMPARE(torrents.size(), 3);
+
+    // Changed before the relation is loaded for the siblings
+    torrents[1]["user_id"] = 2;
+
+    auto *const user1 = torrents[0].getRelationValue<User, One>("user");
+    QVERIFY(user1 != nullptr);
+    QCOMPARE(user1->getKeyCasted(), static_cast<quint64>(1));
+
+    // The current foreign key is used instead of the hydrated one
+    auto *const user2 = torrents[1].getRelationValue<User, One>("user");
+    QVERIFY(user2 != nullptr);
+    QCOMPARE(user2->getKeyCasted(), static_cast<quint64>(2));
+
+    // Not modified, obtained from the siblings
+    auto *const user3 = torrents[2].getRelationValue<User, One>("user");
+    QVERIFY(user3 != nullptr);
+    QCOMPARE(user3->getKeyCasted(), static_cast<quint64>(1));
+}
+
+void tst_Model_Connection_Independent::attributesHash_SharedByHydratedModels() const
+{
+    auto torrents = Torrent::whereKey(QVector<QVariant> {1, 2})->orderBy(ID).get();
+
+    QCOMPARE(torrents.size(), 2);
+
+    auto &torrent1 = torrents[0];
+    const auto &torrent2 = torrents[1];
+
+    // The attribute positions are shared by the models and by the original state
+    QVERIFY(std::addressof(torrent1.getAttributesHash()) ==
+            std::addressof(torrent2.getAttributesHash()));
+    QVERIFY(std::addressof(torrent1.getAttributesHash()) ==
+            std::addressof(torrent1.getOriginalsHash()));
+
+    // Updating an existing attribute doesn't change the positions
+    torrent1.setAttribute(NAME, "test1 batched");
+
+    QVERIFY(std::addressof(torrent1.getAttributesHash()) ==
+            std::addressof(torrent2.getAttributesHash()));
+
+    // A new attribute detaches the positions
+    torrent1.setAttribute("foo", "bar");
+
+    QVERIFY(std::addressof(torrent1.getAttributesHash()) !=
+            std::addressof(torrent2.getAttributesHash()));
+    QVERIFY(torrent1.getAttributesHash().contains("foo"));
+    QVERIFY(!torrent2.getAttributesHash().contains("foo"));
+    QVERIFY(!torrent1.getOriginalsHash().contains("foo"));
+
+    QCOMPARE(torrent1.getAttribute(NAME), QVariant("test1 batched"));
+    QCOMPARE(torrent2.getAttribute(NAME), QVariant("test2"));
+    QCOMPARE(torrent1.getOriginal(NAME), QVariant("test1"));
+}
+
 void tst_Model_Connection_Independent::tap() const
 {
     auto builder = FilePropertyProperty::query();
@@ -2220,6 +2843,123 @@ void tst_Model_Connection_Independent::soleValue_Pretending() const
     QCOMPARE(firstLog.boundValues,
              QVector<QVariant>({QVariant(QString("dummy-NON_EXISTENT"))}));
 }
+
+void tst_Model_Connection_Independent::benchmark_Hydrate() const
+{
+    if (!Benchmarks::enabled())
+        QSKIP(Benchmarks::Skipped.arg(TypeUtils::classPureBasename(*this))
+              .toUtf8().constData(), );
+
+    // 8 * 8 * 8 = 512 rows, the record layout is read once per the result set
+    auto query = FilePropertyProperty::crossJoin(
+                     QString("file_property_properties as p2"));
+    query->crossJoin(QString("file_property_properties as p3"))
+          .select("file_property_properties.*");
+
+    ModelsCollection<FilePropertyProperty> models;
+
+    QBENCHMARK {
+        models = query->get();
+    }
+
+    QCOMPARE(models.size(), 512);
+    QVERIFY(std::addressof(models.first().getAttributesHash()) ==
+            std::addressof(models.last().getAttributesHash()));
+}
+
+void tst_Model_Connection_Independent::benchmark_AttributesHash_CopyAndModify() const
+{
+    if (!Benchmarks::enabled())
+        QSKIP(Benchmarks::Skipped.arg(TypeUtils::classPureBasename(*this))
+              .toUtf8().constData(), );
+
+    // 8 * 8 = 64 models sharing one attribute positions hash
+    auto models = FilePropertyProperty::crossJoin(
+                      QString("file_property_properties as p2"))
+                  ->select("file_property_properties.*").get();
+
+    QCOMPARE(models.size(), 64);
+
+    ModelsCollection<FilePropertyProperty> copies;
+
+    /* Copies share the attributes, and the modification of an existing attribute
+       detaches only the attributes vector, not the positions hash. */
+    QBENCHMARK {
+        copies = models;
+
+        for (auto &model : copies)
+            model["value"] = 100;
+    }
+
+    QCOMPARE(copies.first().getAttribute("value").value<int>(), 100);
+    QVERIFY(models.first().getAttribute("value").value<int>() != 100);
+    QVERIFY(std::addressof(copies.first().getAttributesHash()) ==
+            std::addressof(models.last().getAttributesHash()));
+}
+
+void tst_Model_Connection_Independent::benchmark_GetAttribute() const
+{
+    if (!Benchmarks::enabled())
+        QSKIP(Benchmarks::Skipped.arg(TypeUtils::classPureBasename(*this))
+              .toUtf8().constData(), );
+
+    auto torrent = Torrent::find(1);
+    QVERIFY(torrent);
+
+    /* The attribute without a cast, the primary key (implicit cast), and the date
+       attribute, casts and dates are resolved without copying. */
+    QVariant name;
+    QVariant id;
+    QVariant createdAt;
+
+    QBENCHMARK {
+        name = torrent->getAttribute(NAME);
+        id = torrent->getAttribute(ID);
+        createdAt = torrent->getAttribute(CREATED_AT);
+    }
+
+    QCOMPARE(name, QVariant(QString("test1")));
+    QCOMPARE(id.value<quint64>(), static_cast<quint64>(1));
+    QVERIFY(createdAt.canConvert<QDateTime>());
+}
+
+void tst_Model_Connection_Independent::benchmark_GetAs_data() const
+{
+    QTest::addColumn<bool>("typed");
+
+    QTest::newRow("TinyBuilder::get()") << false;
+    QTest::newRow("QueryBuilder::getAs<T>()") << true;
+}
+
+void tst_Model_Connection_Independent::benchmark_GetAs() const
+{
+    if (!Benchmarks::enabled())
+        QSKIP(Benchmarks::Skipped.arg(TypeUtils::classPureBasename(*this))
+              .toUtf8().constData(), );
+
+    QFETCH(bool, typed);
+
+    // 8 * 8 * 8 = 512 rows, the same query for the models and for the typed rows
+    auto query = FilePropertyProperty::crossJoin(
+                     QString("file_property_properties as p2"));
+    query->crossJoin(QString("file_property_properties as p3"))
+          .select("file_property_properties.*");
+
+    qint64 rowsCount = 0;
+
+    if (typed) {
+        QBENCHMARK {
+            rowsCount = query->getQuery().getAs<FilePropertyPropertyRow>().size();
+        }
+    }
+    else {
+        QBENCHMARK {
+            rowsCount = query->get().size();
+        }
+    }
+
+    QCOMPARE(rowsCount, static_cast<qint64>(512));
+}
 // NOLINTEND(readability-convert-member-functions-to-static)
 
 QTEST_MAIN(tst_Model_Connection_Independent)
@@ -1,6 +1,7 @@
 #include <QCoreApplication>
 #include <QtTest>
 
+#include "common/benchmarks.hpp"
 #include "databases.hpp"
 
 #include "models/album.hpp"
@@ -30,6 +31,7 @@ using Orm::Tiny::CastType;
 using Orm::Tiny::ConnectionOverride;
 using Orm::Tiny::Types::ModelsCollection;
 
+using TestUtils::Common::Benchmarks;
 using TestUtils::Databases;
 
 using Models::Album;
@@ -140,6 +142,24 @@ private Q_SLOTS:
     void toJson_RelationOnly_HasMany() const;
     void toJson_RelationOnly_BelongsToMany() const;
 
+    void writeJson_WithRelations_HasOne_HasMany_BelongsTo() const;
+    void writeJson_WithRelation_BelongsToMany_UserRoles() const;
+    void writeJson_RelationOnly_BelongsToMany_Device() const;
+    void writeJson_WithVisibleAndHidden_WithRelations_HasOne_HasMany_BelongsTo() const;
+    void writeJson_WithAppends_WithVisibleAndHidden() const;
+    void writeJson_SnakeCasedRelationKeys() const;
+    void writeJson_StringEscaping() const;
+
+    void toCbor_fromCbor_WithRelations_HasOne_HasMany_BelongsTo() const;
+    void toCbor_fromCbor_WithRelation_BelongsToMany_UserRoles() const;
+    void toCbor_fromCbor_Collection() const;
+    void toCbor_fromCbor_NullQVariant() const;
+
+    void benchmark_WriteJson_data() const;
+    void benchmark_WriteJson() const;
+    void benchmark_ToCbor_data() const;
+    void benchmark_ToCbor() const;
+
 // NOLINTNEXTLINE(readability-redundant-access-specifiers)
 private:
     /*! Connection name used in this test case. */
@@ -2914,6 +2934,362 @@ R"([
 
     QCOMPARE(json, expectedJson);
 }
+
+/* The writeJson() writes keys in the attributes vector order (like the toVector()),
+   the QJsonDocument sorts keys, so the parsed documents are compared. */
+
+void tst_Model_Serialization::
+     writeJson_WithRelations_HasOne_HasMany_BelongsTo() const
+{
+    auto torrent = Torrent::with({"torrentPeer", "user", "torrentFiles"})->find(7);
+    QVERIFY(torrent);
+    QVERIFY(torrent->exists);
+
+    QByteArray json;
+    torrent->writeJson(json);
+
+    QJsonParseError error {};
+    const auto document = QJsonDocument::fromJson(json, &error);
+    QCOMPARE(error.error, QJsonParseError::NoError);
+
+    QCOMPARE(document, torrent->toJsonDocument());
+}
+
+void tst_Model_Serialization::writeJson_WithRelation_BelongsToMany_UserRoles() const
+{
+    auto user = User::with("roles")->find(1);
+    QVERIFY(user);
+    QVERIFY(user->exists);
+
+    QByteArray json;
+    user->writeJson(json);
+
+    QJsonParseError error {};
+    const auto document = QJsonDocument::fromJson(json, &error);
+    QCOMPARE(error.error, QJsonParseError::NoError);
+
+    QCOMPARE(document, user->toJsonDocument());
+}
+
+void tst_Model_Serialization::writeJson_RelationOnly_BelongsToMany_Device() const
+{
+    auto user = User::with("roles")->find(1);
+    QVERIFY(user);
+    QVERIFY(user->exists);
+
+    ModelsCollection<Role *> roles = user->getRelationValue<Role>("roles");
+    QCOMPARE(roles.size(), 3);
+
+    QBuffer buffer;
+    QVERIFY(buffer.open(QIODevice::WriteOnly));
+
+    roles.template writeJson<RoleUser>(buffer);
+
+    QJsonParseError error {};
+    const auto document = QJsonDocument::fromJson(buffer.data(), &error);
+    QCOMPARE(error.error, QJsonParseError::NoError);
+
+    QCOMPARE(document, roles.template toJsonDocument<RoleUser>());
+}
+
+void tst_Model_Serialization::
+     writeJson_WithVisibleAndHidden_WithRelations_HasOne_HasMany_BelongsTo() const
+{
+    auto torrent = Torrent::with({"torrentPeer", "user", "torrentFiles"})->find(7);
+    QVERIFY(torrent);
+    QVERIFY(torrent->exists);
+
+    // Prepare
+    torrent->setVisible({ID, NAME, NOTE, SIZE_, "user_id", "torrentFiles",
+                         "torrentPeer"});
+    torrent->setHidden({NOTE, "user", "torrentPeer"});
+
+    QByteArray json;
+    torrent->writeJson(json);
+
+    QJsonParseError error {};
+    const auto document = QJsonDocument::fromJson(json, &error);
+    QCOMPARE(error.error, QJsonParseError::NoError);
+
+    const auto expectedDocument = torrent->toJsonDocument();
+
+    // Restore
+    torrent->clearVisible();
+    torrent->clearHidden();
+
+    QCOMPARE(document, expectedDocument);
+
+    const auto object = document.object();
+    QCOMPARE(object.keys(), QStringList({ID, NAME, SIZE_, "torrent_files",
+                                         "user_id"}));
+}
+
+void tst_Model_Serialization::writeJson_WithAppends_WithVisibleAndHidden() const
+{
+    auto torrent = Torrent::find(7);
+    QVERIFY(torrent);
+    QVERIFY(torrent->exists);
+
+    // Prepare
+    torrent->setVisible({ID, NAME, NOTE, "name_progress", "name_size"});
+    torrent->setHidden({NOTE, "name_progress"});
+    torrent->append({"name_progress", "name_size"});
+
+    QByteArray json;
+    torrent->writeJson(json);
+
+    const auto expectedDocument = torrent->toJsonDocument();
+
+    // Restore
+    torrent->clearVisible();
+    torrent->clearHidden();
+    torrent->clearAppends();
+
+    QCOMPARE(json, QByteArray(R"({"id":7,"name":"test7","name_size":"test7 (17)"})"));
+    QCOMPARE(QJsonDocument::fromJson(json), expectedDocument);
+}
+
+void tst_Model_Serialization::writeJson_SnakeCasedRelationKeys() const
+{
+    auto torrent = Torrent::with({"torrentPeer", "torrentFiles.fileProperty"})
+                   ->find(2);
+    QVERIFY(torrent);
+    QVERIFY(torrent->exists);
+
+    QByteArray json;
+    torrent->writeJson(json);
+
+    QJsonParseError error {};
+    const auto document = QJsonDocument::fromJson(json, &error);
+    QCOMPARE(error.error, QJsonParseError::NoError);
+
+    QCOMPARE(document, torrent->toJsonDocument());
+
+    // Relation keys are snake_cased, also for the nested relations
+    const auto object = document.object();
+    QVERIFY(object.contains("torrent_peer"));
+    QVERIFY(object.contains("torrent_files"));
+    QVERIFY(!object.contains("torrentPeer"));
+    QVERIFY(!object.contains("torrentFiles"));
+
+    const auto torrentFile = object.value("torrent_files").toArray().first().toObject();
+    QVERIFY(torrentFile.contains("file_property"));
+    QVERIFY(!torrentFile.contains("fileProperty"));
+}
+
+void tst_Model_Serialization::writeJson_StringEscaping() const
+{
+    auto torrent = Torrent::find(7);
+    QVERIFY(torrent);
+    QVERIFY(torrent->exists);
+
+    // Quotes, backslash, control characters, and non-ASCII (also the surrogate pair)
+    const auto note = QStringLiteral("quote \" backslash \\ slash / "
+                                     "\b\f\n\r\t \x01\x1f "
+                                     "čšž ü 日本語 \U0001F600");
+    torrent->setAttribute(NOTE, note);
+
+    QByteArray json;
+    torrent->writeJson(json);
+
+    QJsonParseError error {};
+    const auto document = QJsonDocument::fromJson(json, &error);
+    QCOMPARE(error.error, QJsonParseError::NoError);
+
+    QCOMPARE(document, torrent->toJsonDocument());
+    QCOMPARE(document.object().value(NOTE).toString(), note);
+
+    // Escaped the same way as the QJsonDocument, the non-ASCII characters are UTF-8
+    QVERIFY(json.contains(R"("quote \" backslash \\ slash / \b\f\n\r\t \u0001\u001f )"));
+    QVERIFY(json.contains(QStringLiteral("čšž ü 日本語 \U0001F600").toUtf8()));
+}
+
+/* The toCbor() serializes the raw attributes, so the hydrated model must have the same
+   raw attributes (including QMetaType-s) and serialize to the same JSON. */
+
+void tst_Model_Serialization::
+     toCbor_fromCbor_WithRelations_HasOne_HasMany_BelongsTo() const
+{
+    auto torrent = Torrent::with({"torrentPeer", "user", "torrentFiles"})->find(7);
+    QVERIFY(torrent);
+    QVERIFY(torrent->exists);
+
+    const auto hydrated = Torrent::fromCbor(torrent->toCbor());
+
+    QVERIFY(hydrated.exists);
+    QVERIFY(hydrated.getRawAttributes() == torrent->getRawAttributes());
+    QCOMPARE(hydrated.getRelations().size(), torrent->getRelations().size());
+    QCOMPARE(hydrated.toJson(), torrent->toJson());
+
+    const auto torrentFiles =
+            hydrated.getRelationValue<TorrentPreviewableFile>("torrentFiles");
+    const auto torrentFilesExpected =
+            torrent->getRelationValue<TorrentPreviewableFile>("torrentFiles");
+    QCOMPARE(torrentFiles.size(), torrentFilesExpected.size());
+
+    for (ModelsCollection<TorrentPreviewableFile>::size_type index = 0;
+         index < torrentFiles.size(); ++index
+    )
+        QVERIFY(torrentFiles.at(index)->getRawAttributes() ==
+                torrentFilesExpected.at(index)->getRawAttributes());
+}
+
+void tst_Model_Serialization::toCbor_fromCbor_WithRelation_BelongsToMany_UserRoles() const
+{
+    auto user = User::with("roles")->find(1);
+    QVERIFY(user);
+    QVERIFY(user->exists);
+
+    const auto hydrated = User::fromCbor(user->toCbor());
+
+    QVERIFY(hydrated.exists);
+    QVERIFY(hydrated.getRawAttributes() == user->getRawAttributes());
+    // Also serializes the pivot models
+    QCOMPARE(hydrated.toJson(), user->toJson());
+}
+
+void tst_Model_Serialization::toCbor_fromCbor_Collection() const
+{
+    auto torrents = Torrent::with("torrentFiles")->orderBy(ID).get();
+    QVERIFY(!torrents.isEmpty());
+
+    const auto hydrated = ModelsCollection<Torrent>::fromCbor(torrents.toCbor());
+
+    QCOMPARE(hydrated.size(), torrents.size());
+    QCOMPARE(hydrated.toJson(), torrents.toJson());
+
+    for (ModelsCollection<Torrent>::size_type index = 0; index < hydrated.size();
+         ++index
+    )
+        QVERIFY(hydrated.at(index).getRawAttributes() ==
+                torrents.at(index).getRawAttributes());
+}
+
+void tst_Model_Serialization::toCbor_fromCbor_NullQVariant() const
+{
+    // Null QVariant-s must be hydrated with the same QMetaType
+    Torrent torrent;
+    torrent.setRawAttributes({
+        {ID,    NullVariant::ULongLong()},
+        {NAME,  NullVariant::QString()},
+        {SIZE_, NullVariant::LongLong()},
+        {NOTE,  QVariant()},
+    });
+
+    const auto hydrated = Torrent::fromCbor(torrent.toCbor());
+
+    QVERIFY(!hydrated.exists);
+
+    const auto &attributes = hydrated.getRawAttributes();
+    QCOMPARE(attributes.size(), 4);
+    QVERIFY(attributes == torrent.getRawAttributes());
+
+    for (const auto &[key, value] : attributes)
+        QVERIFY(value.isNull());
+
+    QCOMPARE(Helpers::qVariantTypeId(attributes.at(0).value), QMetaType::ULongLong);
+    QCOMPARE(Helpers::qVariantTypeId(attributes.at(1).value), QMetaType::QString);
+    QCOMPARE(Helpers::qVariantTypeId(attributes.at(2).value), QMetaType::LongLong);
+    QVERIFY(!attributes.at(3).value.isValid());
+
+    // All the types from the database with the NULL values
+    auto type = Type::find(3);
+    QVERIFY(type);
+    QVERIFY(type->exists);
+
+    QVERIFY(Type::fromCbor(type->toCbor()).getRawAttributes() ==
+            type->getRawAttributes());
+}
+
+void tst_Model_Serialization::benchmark_WriteJson_data() const
+{
+    QTest::addColumn<bool>("streaming");
+
+    QTest::newRow("toJson()") << false;
+    QTest::newRow("writeJson()") << true;
+}
+
+void tst_Model_Serialization::benchmark_WriteJson() const
+{
+    if (!Benchmarks::enabled())
+        QSKIP(Benchmarks::Skipped.arg(TypeUtils::classPureBasename(*this))
+              .toUtf8().constData(), );
+
+    QFETCH(bool, streaming);
+
+    auto torrents = Torrent::with({"torrentPeer", "user", "torrentFiles"})->get();
+    QVERIFY(!torrents.isEmpty());
+
+    QByteArray json;
+
+    /* The toJson() builds the QJsonDocument (QVariant -> QJsonValue conversions,
+       sorted QJsonObject-s), the writeJson() writes to the buffer directly. */
+    if (streaming) {
+        QBENCHMARK {
+            json.clear();
+            torrents.writeJson(json);
+        }
+    }
+    else {
+        QBENCHMARK {
+            json = torrents.toJson();
+        }
+    }
+
+    QCOMPARE(QJsonDocument::fromJson(json), torrents.toJsonDocument());
+}
+
+void tst_Model_Serialization::benchmark_ToCbor_data() const
+{
+    QTest::addColumn<QString>("format");
+
+    QTest::newRow("toJson()") << QStringLiteral("json");
+    QTest::newRow("toCbor()") << QStringLiteral("cbor");
+    QTest::newRow("fromCbor()") << QStringLiteral("fromCbor");
+}
+
+void tst_Model_Serialization::benchmark_ToCbor() const
+{
+    if (!Benchmarks::enabled())
+        QSKIP(Benchmarks::Skipped.arg(TypeUtils::classPureBasename(*this))
+              .toUtf8().constData(), );
+
+    QFETCH(QString, format);
+
+    auto torrents = Torrent::with({"torrentPeer", "user", "torrentFiles"})->get();
+    QVERIFY(!torrents.isEmpty());
+
+    const auto cbor = torrents.toCbor();
+
+    // The CBOR keeps the raw attributes, so the fromCbor() hydrates without the query
+    if (format == QLatin1String("json")) {
+        QByteArray json;
+
+        QBENCHMARK {
+            json = torrents.toJson();
+        }
+
+        QVERIFY(!json.isEmpty());
+    }
+    else if (format == QLatin1String("cbor")) {
+        QByteArray serialized;
+
+        QBENCHMARK {
+            serialized = torrents.toCbor();
+        }
+
+        QCOMPARE(serialized, cbor);
+    }
+    else {
+        ModelsCollection<Torrent> hydrated;
+
+        QBENCHMARK {
+            hydrated = ModelsCollection<Torrent>::fromCbor(cbor);
+        }
+
+        QCOMPARE(hydrated.toJsonDocument(), torrents.toJsonDocument());
+    }
+}
 // NOLINTEND(readability-convert-member-functions-to-static)
 
 QTEST_MAIN(tst_Model_Serialization)
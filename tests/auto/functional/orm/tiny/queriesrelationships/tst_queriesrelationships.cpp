@@ -1,13 +1,18 @@
 #include <QCoreApplication>
 #include <QtTest>
 
+#include "orm/utils/helpers.hpp"
+
 #include "databases.hpp"
 
 #include "models/torrent.hpp"
 
 using Orm::Constants::AND;
+using Orm::Constants::ID;
 using Orm::Constants::LIKE;
+using Orm::Constants::NAME;
 using Orm::Constants::Progress;
+using Orm::Constants::SIZE_;
 
 using Orm::QueryBuilder;
 
@@ -15,6 +20,8 @@ using Orm::Tiny::ConnectionOverride;
 using Orm::Tiny::Relations::Relation;
 using Orm::Tiny::TinyBuilder;
 
+using Orm::Utils::Helpers;
+
 using TypeUtils = Orm::Utils::Type;
 
 using TestUtils::Databases;
@@ -49,6 +56,12 @@ private Q_SLOTS:
     void hasNested_Basic_OnHasMany() const;
     void hasNested_Count_OnHasMany() const;
     void hasNested_Count_TinyBuilder_OnHasMany() const;
+
+    /* Relationship aggregates */
+    void withCount_OnHasMany() const;
+    void withCount_WithCallbackAndAlias_OnHasMany() const;
+    void withSum_OnHasMany() const;
+    void withExists_OnHasMany() const;
 };
 
 /* private slots */
@@ -343,6 +356,104 @@ void tst_QueriesRelationships::hasNested_Count_TinyBuilder_OnHasMany() const
     for (const auto &torrent : torrents)
         QVERIFY(expectedIds.contains(torrent.getKey()));
 }
+
+/* Relationship aggregates */
+
+void tst_QueriesRelationships::withCount_OnHasMany() const
+{
+    QFETCH_GLOBAL(QString, connection);
+
+    ConnectionOverride::connection = connection;
+
+    auto torrents = Torrent::withCount("torrentFiles")->orderBy(ID).get();
+
+    const QHash<quint64, quint64> expectedCounts {
+        {1, 1}, {2, 2}, {3, 1}, {4, 1}, {5, 3}, {6, 0}, {7, 3},
+    };
+
+    QVERIFY(!torrents.isEmpty());
+
+    for (const auto &torrent : torrents) {
+        const auto id = torrent.getKeyCasted();
+
+        if (!expectedCounts.contains(id))
+            continue;
+
+        // All the torrent's columns are still selected
+        QVERIFY(torrent.getAttribute(NAME).isValid());
+        QCOMPARE(torrent.getAttribute("torrent_files_count").value<quint64>(),
+                 expectedCounts.value(id));
+    }
+}
+
+void tst_QueriesRelationships::withCount_WithCallbackAndAlias_OnHasMany() const
+{
+    QFETCH_GLOBAL(QString, connection);
+
+    ConnectionOverride::connection = connection;
+
+    auto torrents = Torrent::query()
+                    ->withCount("torrentFiles as big_files_count", [](auto &query)
+    {
+        QVERIFY((std::is_same_v<decltype (query), QueryBuilder &>));
+
+        query.where(SIZE_, ">", 2560);
+    })
+            .orderBy(ID).get();
+
+    const QHash<quint64, quint64> expectedCounts {
+        {1, 0}, {2, 1}, {3, 1}, {4, 1}, {5, 1}, {6, 0}, {7, 2},
+    };
+
+    for (const auto &torrent : torrents) {
+        const auto id = torrent.getKeyCasted();
+
+        if (!expectedCounts.contains(id))
+            continue;
+
+        QCOMPARE(torrent.getAttribute("big_files_count").value<quint64>(),
+                 expectedCounts.value(id));
+    }
+}
+
+void tst_QueriesRelationships::withSum_OnHasMany() const
+{
+    QFETCH_GLOBAL(QString, connection);
+
+    ConnectionOverride::connection = connection;
+
+    auto torrents = Torrent::whereKey(QVector<QVariant> {2, 5, 6})
+                    ->withSum("torrentFiles", SIZE_)
+                    .orderBy(ID).get();
+
+    QCOMPARE(torrents.size(), 3);
+
+    QCOMPARE(torrents.at(0).getAttribute("torrent_files_sum_size").value<quint64>(),
+             static_cast<quint64>(5120));
+    QCOMPARE(torrents.at(1).getAttribute("torrent_files_sum_size").value<quint64>(),
+             static_cast<quint64>(7178));
+    // The sum of no rows is null
+    QVERIFY(torrents.at(2).getAttribute("torrent_files_sum_size").isNull());
+}
+
+void tst_QueriesRelationships::withExists_OnHasMany() const
+{
+    QFETCH_GLOBAL(QString, connection);
+
+    ConnectionOverride::connection = connection;
+
+    auto torrents = Torrent::withExists("torrentFiles")->whereKey(
+                        QVector<QVariant> {5, 6})
+                    .orderBy(ID).get();
+
+    QCOMPARE(torrents.size(), 2);
+
+    // Casted to the bool
+    const auto exists5 = torrents.at(0).getAttribute("torrent_files_exists");
+    QCOMPARE(Helpers::qVariantTypeId(exists5), QMetaType::Bool);
+    QCOMPARE(exists5.value<bool>(), true);
+    QCOMPARE(torrents.at(1).getAttribute("torrent_files_exists").value<bool>(), false);
+}
 // NOLINTEND(readability-convert-member-functions-to-static)
 
 QTEST_MAIN(tst_QueriesRelationships)
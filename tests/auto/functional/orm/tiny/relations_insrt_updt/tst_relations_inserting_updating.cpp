@@ -2,6 +2,9 @@
 #include <QtTest>
 
 #include <typeinfo>
+#include <unordered_set>
+
+#include "orm/db.hpp"
 
 #include "databases.hpp"
 
@@ -18,6 +21,8 @@ using Orm::Constants::Progress;
 using Orm::Constants::SIZE_;
 using Orm::Constants::Updated_;
 
+using Orm::DB;
+
 using Orm::Exceptions::QueryError;
 using Orm::One;
 
@@ -47,6 +52,7 @@ private Q_SLOTS:
 
     void saveMany_OnHasOneOrMany() const;
     void saveMany_OnHasOneOrMany_WithRValue() const;
+    void saveMany_OnHasOneOrMany_AssignedIds() const;
     void saveMany_OnHasOneOrMany_Failed() const;
 
     void create_OnHasOneOrMany() const;
@@ -111,6 +117,15 @@ private Q_SLOTS:
     void syncWithoutDetaching_BasicPivot_IdsWithAttributes() const;
     void syncWithoutDetaching_CustomPivot_WithIds() const;
     void syncWithoutDetaching_CustomPivot_IdsWithAttributes() const;
+
+    void attach_detach_CustomPivot_OneStatement() const;
+    void syncWithoutDetaching_BasicPivot_SameValues_OneStatement() const;
+    void syncWithoutDetaching_CustomPivot_SameValues_OneStatement() const;
+
+private:
+    /*! Count the logged statements of the given type on the tag_torrent table. */
+    static QVector<Orm::Log>::size_type
+    countPivotStatements(const QString &connection, const QString &type);
 };
 
 /* private slots */
@@ -375,6 +390,63 @@ void tst_Relations_Inserting_Updating::saveMany_OnHasOneOrMany_WithRValue() cons
     QVERIFY(!savedFile2.exists);
 }
 
+void tst_Relations_Inserting_Updating::saveMany_OnHasOneOrMany_AssignedIds() const
+{
+    QFETCH_GLOBAL(QString, connection);
+
+    ConnectionOverride::connection = connection;
+
+    auto torrent = Torrent::find(5);
+    QVERIFY(torrent);
+    QVERIFY(torrent->exists);
+
+    // More models than two to verify that every ID belongs to its own record
+    auto savedFiles = torrent->torrentFiles()->saveMany({{
+        {"file_index", 3},
+        {"filepath",   "test5_file4-saveManyIds.mkv"},
+        {SIZE_,        322322},
+        {Progress,     777},
+    }, {
+        {"file_index", 4},
+        {"filepath",   "test5_file5-saveManyIds.mkv"},
+        {SIZE_,        333322},
+        {Progress,     888},
+    }, {
+        {"file_index", 5},
+        {"filepath",   "test5_file6-saveManyIds.mkv"},
+        {SIZE_,        344322},
+        {Progress,     999},
+    }});
+    QCOMPARE(savedFiles.size(), 3);
+
+    std::unordered_set<quint64> ids;
+    ids.reserve(3);
+
+    for (auto &savedFile : savedFiles) {
+        QVERIFY(savedFile.exists);
+        QVERIFY(savedFile[ID]->isValid());
+
+        const auto id = savedFile[ID]->value<quint64>();
+        QVERIFY(id > 8);
+        // IDs must be unique
+        QVERIFY(ids.insert(id).second);
+
+        // The assigned ID must point to the record with the same values
+        auto fileVerify = TorrentPreviewableFile::find(id);
+        QVERIFY(fileVerify);
+        QCOMPARE((*fileVerify)["torrent_id"], QVariant(5));
+        QCOMPARE((*fileVerify)["file_index"], savedFile.getAttribute("file_index"));
+        QCOMPARE((*fileVerify)["filepath"],   savedFile.getAttribute("filepath"));
+        QCOMPARE((*fileVerify)[SIZE_],        savedFile.getAttribute(SIZE_));
+    }
+
+    // Remove files, restore db
+    for (auto &savedFile : savedFiles) {
+        QVERIFY(savedFile.remove());
+        QVERIFY(!savedFile.exists);
+    }
+}
+
 void tst_Relations_Inserting_Updating::saveMany_OnHasOneOrMany_Failed() const
 {
     QFETCH_GLOBAL(QString, connection);
@@ -3299,8 +3371,211 @@ void tst_Relations_Inserting_Updating::
     tag102.remove();
     tag103.remove();
 }
+
+void tst_Relations_Inserting_Updating::attach_detach_CustomPivot_OneStatement() const
+{
+    QFETCH_GLOBAL(QString, connection);
+
+    ConnectionOverride::connection = connection;
+
+    Tag tag100({{NAME, "tag100"}});
+    tag100.save();
+    Tag tag101({{NAME, "tag101"}});
+    tag101.save();
+    Tag tag102({{NAME, "tag102"}});
+    tag102.save();
+
+    auto torrent5 = Torrent::find(5);
+    QVERIFY(torrent5);
+    QVERIFY(torrent5->exists);
+
+    const auto torrent5Id = (*torrent5)[ID];
+
+    // All custom pivots are inserted using the one multi-rows insert statement
+    DB::flushQueryLog(connection);
+    DB::enableQueryLog(connection);
+    torrent5->tags()->attach({tag100[ID], tag101[ID], tag102[ID]},
+                             {{"active", true}}, false);
+    DB::disableQueryLog(connection);
+
+    QCOMPARE(countPivotStatements(connection, "insert"), 1);
+
+    auto taggedsSize = Tagged::whereEq("torrent_id", torrent5Id)
+                       ->whereIn("tag_id", {tag100[ID], tag101[ID], tag102[ID]})
+                       .count();
+
+    QCOMPARE(taggedsSize, 3);
+
+    // All custom pivots are deleted using the one delete statement
+    DB::flushQueryLog(connection);
+    DB::enableQueryLog(connection);
+    auto affected = torrent5->tags()->detach({tag100[ID], tag101[ID], tag102[ID]},
+                                             false);
+    DB::disableQueryLog(connection);
+
+    QCOMPARE(affected, 3);
+    QCOMPARE(countPivotStatements(connection, "delete"), 1);
+
+    taggedsSize = Tagged::whereEq("torrent_id", torrent5Id)
+                  ->whereIn("tag_id", {tag100[ID], tag101[ID], tag102[ID]})
+                  .count();
+
+    QCOMPARE(taggedsSize, 0);
+
+    // Restore db
+    tag100.remove();
+    tag101.remove();
+    tag102.remove();
+}
+
+void tst_Relations_Inserting_Updating::
+     syncWithoutDetaching_BasicPivot_SameValues_OneStatement() const
+{
+    QFETCH_GLOBAL(QString, connection);
+
+    ConnectionOverride::connection = connection;
+
+    Torrent torrent100 {
+        {NAME, "test100"}, {SIZE_, 100}, {Progress, 555},
+        {HASH_, "xyzhash100"}, {NOTE, "sync with pivot"},
+    };
+    torrent100.save();
+    Torrent torrent101 {
+        {NAME, "test101"}, {SIZE_, 101}, {Progress, 556},
+        {HASH_, "xyzhash101"}, {NOTE, "sync with pivot"},
+    };
+    torrent101.save();
+    Torrent torrent102 {
+        {NAME, "test102"}, {SIZE_, 102}, {Progress, 557},
+        {HASH_, "xyzhash102"}, {NOTE, "sync with pivot"},
+    };
+    torrent102.save();
+
+    auto tag5 = Tag::find(5);
+    QVERIFY(tag5);
+    QVERIFY(tag5->exists);
+
+    const auto tagId = (*tag5)[ID];
+
+    tag5->torrents()->attach({{torrent100}, {torrent101}, {torrent102}},
+                             {{"active", true}}, false);
+
+    // Records updated with the same values are updated using the one statement
+    DB::flushQueryLog(connection);
+    DB::enableQueryLog(connection);
+    const auto changed = tag5->torrents()->syncWithoutDetaching(
+                             {{torrent100[ID]->value<quint64>(), {{"active", false}}},
+                              {torrent101[ID]->value<quint64>(), {{"active", false}}},
+                              {torrent102[ID]->value<quint64>(), {{"active", false}}}});
+    DB::disableQueryLog(connection);
+
+    QCOMPARE(countPivotStatements(connection, "update"), 1);
+
+    // Verify result, all records are reported in the same order as they were given
+    QVERIFY(changed.at(Attached).isEmpty());
+    QVERIFY(changed.at(Detached).isEmpty());
+    QCOMPARE(changed.at(Updated_),
+             QVector<QVariant>({torrent100[ID], torrent101[ID], torrent102[ID]}));
+
+    // Verify tagged values in the database
+    auto taggeds = Tagged::whereEq("tag_id", tagId)
+                   ->whereIn("torrent_id", {torrent100[ID], torrent101[ID],
+                                            torrent102[ID]})
+                   .get();
+
+    QCOMPARE(taggeds.size(), 3);
+
+    for (auto &tagged : taggeds)
+        QCOMPARE(tagged["active"]->value<bool>(), false);
+
+    // Restore db
+    torrent100.remove();
+    torrent101.remove();
+    torrent102.remove();
+}
+
+void tst_Relations_Inserting_Updating::
+     syncWithoutDetaching_CustomPivot_SameValues_OneStatement() const
+{
+    QFETCH_GLOBAL(QString, connection);
+
+    ConnectionOverride::connection = connection;
+
+    Tag tag100({{NAME, "tag100"}});
+    tag100.save();
+    Tag tag101({{NAME, "tag101"}});
+    tag101.save();
+    Tag tag102({{NAME, "tag102"}});
+    tag102.save();
+
+    auto torrent5 = Torrent::find(5);
+    QVERIFY(torrent5);
+    QVERIFY(torrent5->exists);
+
+    const auto torrent5Id = (*torrent5)[ID];
+
+    torrent5->tags()->attach({tag100[ID], tag101[ID], tag102[ID]},
+                             {{"active", true}}, false);
+
+    /* Only really changed custom pivot records are updated and reported, all of them
+       are updated with the same values, so using the one statement. */
+    DB::flushQueryLog(connection);
+    DB::enableQueryLog(connection);
+    const auto changed = torrent5->tags()->syncWithoutDetaching(
+                             {{tag100[ID]->value<quint64>(), {{"active", false}}},
+                              {tag101[ID]->value<quint64>(), {{"active", true}}},
+                              {tag102[ID]->value<quint64>(), {{"active", false}}}});
+    DB::disableQueryLog(connection);
+
+    QCOMPARE(countPivotStatements(connection, "update"), 1);
+
+    // Verify result
+    QVERIFY(changed.at(Attached).isEmpty());
+    QVERIFY(changed.at(Detached).isEmpty());
+    QCOMPARE(changed.at(Updated_), QVector<QVariant>({tag100[ID], tag102[ID]}));
+
+    // Verify tagged values in the database
+    auto taggeds = Tagged::whereEq("torrent_id", torrent5Id)
+                   ->whereIn("tag_id", {tag100[ID], tag101[ID], tag102[ID]})
+                   .get();
+
+    QCOMPARE(taggeds.size(), 3);
+
+    // Expected active attribute values by the tag ID
+    std::unordered_map<quint64, bool> taggedActive {
+        {tag100[ID]->value<quint64>(), false},
+        {tag101[ID]->value<quint64>(), true},
+        {tag102[ID]->value<quint64>(), false},
+    };
+
+    for (auto &tagged : taggeds) {
+        const auto tagId = tagged["tag_id"]->value<quint64>();
+
+        QVERIFY(taggedActive.contains(tagId));
+        QCOMPARE(tagged["active"]->value<bool>(), taggedActive.at(tagId));
+    }
+
+    // Restore db
+    tag100.remove();
+    tag101.remove();
+    tag102.remove();
+}
 // NOLINTEND(readability-convert-member-functions-to-static)
 
+/* private */
+
+QVector<Orm::Log>::size_type
+tst_Relations_Inserting_Updating::countPivotStatements(const QString &connection,
+                                                        const QString &type)
+{
+    const auto queryLog = DB::getQueryLog(connection);
+
+    return std::ranges::count_if(*queryLog, [&type](const Orm::Log &log)
+    {
+        return log.query.startsWith(type) && log.query.contains("tag_torrent");
+    });
+}
+
 QTEST_MAIN(tst_Relations_Inserting_Updating)
 
 #include "tst_relations_inserting_updating.moc"
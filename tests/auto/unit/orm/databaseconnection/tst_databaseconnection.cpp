@@ -5,6 +5,7 @@
 #include "orm/db.hpp"
 #include "orm/exceptions/multiplecolumnsselectederror.hpp"
 #include "orm/mysqlconnection.hpp"
+#include "orm/query/cache/lruquerycache.hpp"
 #include "orm/utils/type.hpp"
 
 #include "databases.hpp"
@@ -21,11 +22,14 @@ using Orm::Constants::qt_timezone;
 using Orm::Constants::timezone_;
 
 using Orm::DB;
+using Orm::DatabaseConnection;
 using Orm::Exceptions::MultipleColumnsSelectedError;
 using Orm::MySqlConnection;
 using Orm::QtTimeZoneConfig;
 using Orm::QtTimeZoneType;
 
+using Orm::Query::Cache::LruQueryCache;
+
 using QueryBuilder = Orm::Query::Builder;
 using TypeUtils = Orm::Utils::Type;
 
@@ -60,11 +64,21 @@ private Q_SLOTS:
     void scalar_EmptyResult() const;
     void scalar_MultipleColumnsSelectedError() const;
 
+    void remember_DisabledByDefault() const;
+    void remember_CacheHit() const;
+    void remember_InvalidatedByWrite() const;
+    void remember_InvalidatedByWorkerConnection() const;
+    void remember_InTransaction_Bypassed() const;
+    void remember_Subquery_NotCached() const;
+    void remember_Pretending() const;
+
 // NOLINTNEXTLINE(readability-redundant-access-specifiers)
 private:
     /*! Create QueryBuilder instance for the given connection. */
     [[nodiscard]] static std::shared_ptr<QueryBuilder>
     createQuery(const QString &connection);
+    /*! Enable the query cache for remember() queries, returns the new cache. */
+    static std::shared_ptr<LruQueryCache> enableQueryCache();
 };
 
 /* private slots */
@@ -873,6 +887,193 @@ void tst_DatabaseConnection::scalar_MultipleColumnsSelectedError() const
                                  "select id, name from torrents order by id"),
                              MultipleColumnsSelectedError);
 }
+
+void tst_DatabaseConnection::remember_DisabledByDefault() const
+{
+    QFETCH_GLOBAL(QString, connection);
+
+    QVERIFY(!DatabaseConnection::getQueryCache());
+
+    DB::flushQueryLog(connection);
+    DB::enableQueryLog(connection);
+
+    createQuery(connection)->from("torrents").whereEq(ID, 2)
+            .remember(std::chrono::minutes(1)).get();
+    createQuery(connection)->from("torrents").whereEq(ID, 2)
+            .remember(std::chrono::minutes(1)).get();
+
+    DB::disableQueryLog(connection);
+
+    // Both queries hit the database
+    QCOMPARE(DB::getQueryLog(connection)->size(), 2);
+}
+
+void tst_DatabaseConnection::remember_CacheHit() const
+{
+    QFETCH_GLOBAL(QString, connection);
+
+    const auto cache = enableQueryCache();
+
+    auto query1 = createQuery(connection)->from("torrents").whereEq(ID, 2)
+                  .remember(std::chrono::minutes(1)).get();
+    auto query2 = createQuery(connection)->from("torrents").whereEq(ID, 2)
+                  .remember(std::chrono::minutes(1)).get();
+
+    const auto stats = cache->stats();
+
+    QCOMPARE(stats.misses, static_cast<quint64>(1));
+    QCOMPARE(stats.hits, static_cast<quint64>(1));
+    QCOMPARE(stats.entries, static_cast<quint64>(1));
+
+    QVERIFY(query1.next());
+    QVERIFY(query2.next());
+    QCOMPARE(query2.value(ID), QVariant(2));
+    QCOMPARE(query2.value(NAME), query1.value(NAME));
+    QCOMPARE(query2.record().count(), query1.record().count());
+    QVERIFY(!query2.next());
+
+    DatabaseConnection::setQueryCache(nullptr);
+}
+
+void tst_DatabaseConnection::remember_InvalidatedByWrite() const
+{
+    QFETCH_GLOBAL(QString, connection);
+
+    const auto cache = enableQueryCache();
+
+    // Cache a result from the users and torrents tables
+    createQuery(connection)->from("users").remember(std::chrono::minutes(1)).get();
+    createQuery(connection)->from("torrents").remember(std::chrono::minutes(1)).get();
+
+    QCOMPARE(cache->stats().entries, static_cast<quint64>(2));
+
+    DB::beginTransaction(connection);
+
+    createQuery(connection)->from("users").insert({{NAME, QStringLiteral("alibaba")},
+                                                   {NOTE, QStringLiteral("remember")}});
+
+    DB::rollBack(connection);
+
+    // Only the entry tagged with the users table is invalidated
+    QCOMPARE(cache->stats().entries, static_cast<quint64>(1));
+
+    DatabaseConnection::setQueryCache(nullptr);
+}
+
+void tst_DatabaseConnection::remember_InvalidatedByWorkerConnection() const
+{
+    QFETCH_GLOBAL(QString, connection);
+
+    // In-memory SQLite databases are not shared between connections
+    if (DB::connection(connection).getDatabaseName() == QStringLiteral(":memory:"))
+        QSKIP("In-memory SQLite database is not shared with the worker connection.", );
+
+    const auto cache = enableQueryCache();
+
+    createQuery(connection)->from("users").remember(std::chrono::minutes(1)).get();
+    createQuery(connection)->from("torrents").remember(std::chrono::minutes(1)).get();
+
+    QCOMPARE(cache->stats().entries, static_cast<quint64>(2));
+
+    const auto manager = Orm::DatabaseManager::instance();
+    const auto workerName = manager->addWorkerConnection(connection);
+
+    {
+        auto &worker = manager->workerConnection(workerName);
+
+        worker.beginTransaction();
+
+        worker.query()->from("users").insert({{NAME, QStringLiteral("alibaba")},
+                                              {NOTE, QStringLiteral("remember")}});
+
+        worker.rollBack();
+    }
+
+    manager->removeWorkerConnection(workerName);
+
+    /* The worker connection connects to the same database, so the write invalidates
+       the entry cached by the original connection. */
+    QCOMPARE(cache->stats().entries, static_cast<quint64>(1));
+
+    DatabaseConnection::setQueryCache(nullptr);
+}
+
+void tst_DatabaseConnection::remember_InTransaction_Bypassed() const
+{
+    QFETCH_GLOBAL(QString, connection);
+
+    const auto cache = enableQueryCache();
+
+    DB::beginTransaction(connection);
+
+    const auto id = createQuery(connection)->from("users").insertGetId(
+                        {{NAME, QStringLiteral("alibaba")},
+                         {NOTE, QStringLiteral("remember")}});
+
+    auto query = createQuery(connection)->from("users").whereEq(ID, id)
+                 .remember(std::chrono::minutes(1)).get();
+
+    DB::rollBack(connection);
+
+    // The uncommitted row is read from the database and is not cached
+    QVERIFY(query.next());
+    QCOMPARE(query.value(NAME), QVariant(QStringLiteral("alibaba")));
+    QVERIFY(cache->isEmpty());
+
+    auto queryAfter = createQuery(connection)->from("users").whereEq(ID, id)
+                      .remember(std::chrono::minutes(1)).get();
+
+    QVERIFY(!queryAfter.next());
+
+    DatabaseConnection::setQueryCache(nullptr);
+}
+
+void tst_DatabaseConnection::remember_Subquery_NotCached() const
+{
+    QFETCH_GLOBAL(QString, connection);
+
+    const auto cache = enableQueryCache();
+
+    // The users table is read only by the subquery
+    createQuery(connection)->from("torrents")
+            .whereExists([](QueryBuilder &query)
+    {
+        query.from("users").whereColumnEq("users.id", "torrents.user_id");
+    })
+            .remember(std::chrono::minutes(1)).get();
+
+    QVERIFY(cache->isEmpty());
+
+    // Nested wheres without subqueries are cached
+    createQuery(connection)->from("torrents")
+            .where([](QueryBuilder &query)
+    {
+        query.whereEq(ID, 1).orWhereEq(ID, 2);
+    })
+            .remember(std::chrono::minutes(1)).get();
+
+    QCOMPARE(cache->stats().entries, static_cast<quint64>(1));
+
+    DatabaseConnection::setQueryCache(nullptr);
+}
+
+void tst_DatabaseConnection::remember_Pretending() const
+{
+    QFETCH_GLOBAL(QString, connection);
+
+    const auto cache = enableQueryCache();
+
+    auto log = DB::connection(connection).pretend([](DatabaseConnection &connection_)
+    {
+        connection_.query()->from("torrents").remember(std::chrono::minutes(1)).get();
+    });
+
+    // Pretended queries are logged and never cached
+    QCOMPARE(log.size(), 1);
+    QVERIFY(cache->isEmpty());
+
+    DatabaseConnection::setQueryCache(nullptr);
+}
 // NOLINTEND(readability-convert-member-functions-to-static)
 
 /* private */
@@ -883,6 +1084,15 @@ tst_DatabaseConnection::createQuery(const QString &connection)
     return DB::connection(connection).query();
 }
 
+std::shared_ptr<LruQueryCache> tst_DatabaseConnection::enableQueryCache()
+{
+    auto cache = std::make_shared<LruQueryCache>();
+
+    DatabaseConnection::setQueryCache(cache);
+
+    return cache;
+}
+
 QTEST_MAIN(tst_DatabaseConnection)
 
 #include "tst_databaseconnection.moc"
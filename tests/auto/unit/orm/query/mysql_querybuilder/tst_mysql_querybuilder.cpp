@@ -6,6 +6,7 @@
 #include "orm/mysqlconnection.hpp"
 #include "orm/utils/type.hpp"
 
+#include "common/benchmarks.hpp"
 #include "databases.hpp"
 
 using Orm::Constants::AND;
@@ -35,6 +36,7 @@ using QueryBuilder = Orm::Query::Builder;
 using Raw = Orm::Query::Expression;
 using TypeUtils = Orm::Utils::Type;
 
+using TestUtils::Common::Benchmarks;
 using TestUtils::Databases;
 
 /*
@@ -220,6 +222,7 @@ private Q_SLOTS:
 
     void insert() const;
     void insert_WithExpression() const;
+    void insertGetIds() const;
 
     void update() const;
     void update_WithExpression() const;
@@ -241,6 +244,14 @@ private Q_SLOTS:
     void sole() const;
     void soleValue() const;
 
+    void selectCache() const;
+
+    void benchmark_SelectCache_data() const;
+    void benchmark_SelectCache() const;
+
+    void benchmark_ToSql_data() const;
+    void benchmark_ToSql() const;
+
 // NOLINTNEXTLINE(readability-redundant-access-specifiers)
 private:
     /*! Create QueryBuilder instance for the given connection. */
@@ -3279,6 +3290,29 @@ void tst_MySql_QueryBuilder::insert_WithExpression() const
              QVector<QVariant>({QVariant(6)}));
 }
 
+void tst_MySql_QueryBuilder::insertGetIds() const
+{
+    auto log = DB::connection(m_connection).pretend([](auto &connection)
+    {
+        const auto ids = connection.query()->from("torrents")
+                         .insertGetIds({{{NAME, "xyz"}, {SIZE_, 6}},
+                                        {{NAME, "abc"}, {SIZE_, 7}}});
+
+        // IDs are not obtained while pretending
+        QCOMPARE(ids, QVector<quint64>({0, 0}));
+    });
+
+    QVERIFY(!log.isEmpty());
+    const auto &firstLog = log.first();
+
+    QCOMPARE(log.size(), 1);
+    QCOMPARE(firstLog.query,
+             "insert into `torrents` (`name`, `size`) values (?, ?), (?, ?)");
+    QCOMPARE(firstLog.boundValues,
+             QVector<QVariant>({QVariant("xyz"), QVariant(6),
+                                QVariant("abc"), QVariant(7)}));
+}
+
 void tst_MySql_QueryBuilder::update() const
 {
     auto log = DB::connection(m_connection).pretend([](auto &connection)
@@ -3678,6 +3712,173 @@ void tst_MySql_QueryBuilder::soleValue() const
     QCOMPARE(firstLog.boundValues,
              QVector<QVariant>({QVariant(QString("dummy-NON_EXISTENT"))}));
 }
+
+void tst_MySql_QueryBuilder::selectCache() const
+{
+    auto &grammar = DB::connection(m_connection).getQueryGrammar();
+
+    grammar.enableSelectCache();
+    QVERIFY(grammar.isSelectCacheEnabled());
+
+    // Queries of the same shape, only binding values differ
+    for (const auto id : {1, 2, 3})
+        QCOMPARE(createQuery()->from("torrents").whereEq(ID, id).limit(1).toSql(),
+                 "select * from `torrents` where `id` = ? limit 1");
+
+    auto stats = grammar.getSelectCacheStats();
+    QCOMPARE(stats.hits, static_cast<quint64>(2));
+    QCOMPARE(stats.misses, static_cast<quint64>(1));
+    QCOMPARE(stats.size, static_cast<std::size_t>(1));
+    QCOMPARE(stats.hitRatio(), 2.0 / 3.0);
+
+    // Every value has its own placeholder, so it's another shape
+    QCOMPARE(createQuery()->from("torrents").whereIn(ID, {1, 2}).toSql(),
+             "select * from `torrents` where `id` in (?, ?)");
+    QCOMPARE(createQuery()->from("torrents").whereIn(ID, {1, 2, 3}).toSql(),
+             "select * from `torrents` where `id` in (?, ?, ?)");
+
+    // The limit value is a part of the SQL
+    QCOMPARE(createQuery()->from("torrents").whereEq(ID, 1).limit(2).toSql(),
+             "select * from `torrents` where `id` = ? limit 2");
+
+    // Raw expressions are a part of the SQL, they are not cached
+    QCOMPARE(createQuery()->from("torrents").whereIn(NAME, {Raw("'xyz'")}).toSql(),
+             "select * from `torrents` where `name` in ('xyz')");
+    QCOMPARE(createQuery()->from("torrents").whereIn(NAME, {Raw("'abc'")}).toSql(),
+             "select * from `torrents` where `name` in ('abc')");
+
+    stats = grammar.getSelectCacheStats();
+    QCOMPARE(stats.hits, static_cast<quint64>(2));
+    QCOMPARE(stats.misses, static_cast<quint64>(4));
+    QCOMPARE(stats.size, static_cast<std::size_t>(4));
+
+    grammar.disableSelectCache();
+    QVERIFY(!grammar.isSelectCacheEnabled());
+    QCOMPARE(grammar.getSelectCacheStats().size, static_cast<std::size_t>(0));
+}
+
+void tst_MySql_QueryBuilder::benchmark_SelectCache_data() const
+{
+    QTest::addColumn<bool>("cached");
+
+    QTest::newRow("compileSelect()") << false;
+    QTest::newRow("select cache") << true;
+}
+
+void tst_MySql_QueryBuilder::benchmark_SelectCache() const
+{
+    if (!Benchmarks::enabled())
+        QSKIP(Benchmarks::Skipped.arg(TypeUtils::classPureBasename(*this))
+              .toUtf8().constData(), );
+
+    QFETCH(bool, cached);
+
+    auto &grammar = DB::connection(m_connection).getQueryGrammar();
+
+    if (cached)
+        grammar.enableSelectCache();
+
+    auto builder = createQuery();
+
+    builder->select({"torrents.id", "torrents.name", "torrent_peers.seeds"})
+            .from("torrents")
+            .join("torrent_peers", "torrents.id", EQ, "torrent_peers.torrent_id")
+            .whereEq("torrents.user_id", 1)
+            .where([](QueryBuilder &query)
+    {
+        query.where("torrents.size", GT, 10).orWhere("torrents.progress", LT, 100);
+    })
+            .whereIn("torrents.id", {1, 2, 3, 4, 5})
+            .whereNotNull("torrents.note")
+            .orderBy("torrents.name")
+            .limit(10);
+
+    QString sql;
+
+    /* The cache hit computes the structural hash of the query shape (no strings are
+       built) and copies the cached implicitly shared QString. */
+    QBENCHMARK {
+        sql = builder->toSql();
+    }
+
+    QCOMPARE(sql,
+             "select `torrents`.`id`, `torrents`.`name`, `torrent_peers`.`seeds` "
+             "from `torrents` "
+             "inner join `torrent_peers` "
+               "on `torrents`.`id` = `torrent_peers`.`torrent_id` "
+             "where `torrents`.`user_id` = ? "
+               "and (`torrents`.`size` > ? or `torrents`.`progress` < ?) "
+               "and `torrents`.`id` in (?, ?, ?, ?, ?) "
+               "and `torrents`.`note` is not null "
+             "order by `torrents`.`name` asc limit 10");
+
+    if (cached) {
+        QVERIFY(grammar.getSelectCacheStats().hits > 0);
+        grammar.disableSelectCache();
+    }
+}
+
+void tst_MySql_QueryBuilder::benchmark_ToSql_data() const
+{
+    QTest::addColumn<QString>("shape");
+
+    QTest::newRow("simple") << QStringLiteral("simple");
+    QTest::newRow("wheres") << QStringLiteral("wheres");
+    QTest::newRow("joins and sub-query") << QStringLiteral("joins");
+}
+
+void tst_MySql_QueryBuilder::benchmark_ToSql() const
+{
+    if (!Benchmarks::enabled())
+        QSKIP(Benchmarks::Skipped.arg(TypeUtils::classPureBasename(*this))
+              .toUtf8().constData(), );
+
+    QFETCH(QString, shape);
+
+    auto builder = createQuery();
+
+    if (shape == QStringLiteral("simple"))
+        builder->from("torrents").whereEq(ID, 1);
+
+    else if (shape == QStringLiteral("wheres"))
+        builder->select({ID, NAME, SIZE_})
+                .from("torrents")
+                .whereEq("user_id", 1)
+                .where(SIZE_, GT, 10)
+                .orWhere(Progress, LT, 100)
+                .whereIn(ID, {1, 2, 3, 4, 5, 6, 7, 8})
+                .whereNotNull(NOTE)
+                .whereBetween(CREATED_AT, {"2020-01-01", "2021-01-01"})
+                .orderBy(NAME)
+                .orderByDesc(ID)
+                .limit(10)
+                .offset(20);
+
+    else
+        builder->select({"torrents.id", "torrents.name", "torrent_peers.seeds"})
+                .from("torrents")
+                .join("torrent_peers", "torrents.id", EQ, "torrent_peers.torrent_id")
+                .leftJoin("users", "torrents.user_id", EQ, "users.id")
+                .whereEq("torrents.user_id", 1)
+                .whereExists([](QueryBuilder &query)
+        {
+            query.from("torrent_previewable_files")
+                    .whereColumnEq("torrent_previewable_files.torrent_id",
+                                   "torrents.id");
+        })
+                .groupBy("torrents.id")
+                .orderBy("torrents.name");
+
+    QString sql;
+
+    // The select cache is disabled, every toSql() compiles the whole query
+    QBENCHMARK {
+        sql = builder->toSql();
+    }
+
+    QVERIFY(sql.startsWith(QStringLiteral("select ")));
+    QVERIFY(!sql.contains(QStringLiteral("  ")));
+}
 // NOLINTEND(readability-convert-member-functions-to-static)
 
 /* private */
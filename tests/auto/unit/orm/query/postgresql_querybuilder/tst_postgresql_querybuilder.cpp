@@ -133,6 +133,7 @@ private Q_SLOTS:
 
     void insert() const;
     void insert_WithExpression() const;
+    void insertGetIds() const;
 
     void update() const;
     void update_WithExpression() const;
@@ -1902,6 +1903,30 @@ void tst_PostgreSQL_QueryBuilder::insert_WithExpression() const
              QVector<QVariant>({QVariant(6)}));
 }
 
+void tst_PostgreSQL_QueryBuilder::insertGetIds() const
+{
+    auto log = DB::connection(m_connection).pretend([](auto &connection)
+    {
+        const auto ids = connection.query()->from("torrents")
+                         .insertGetIds({{{NAME, "xyz"}, {SIZE_, 6}},
+                                        {{NAME, "abc"}, {SIZE_, 7}}});
+
+        // IDs are not obtained while pretending
+        QCOMPARE(ids, QVector<quint64>({0, 0}));
+    });
+
+    QVERIFY(!log.isEmpty());
+    const auto &firstLog = log.first();
+
+    QCOMPARE(log.size(), 1);
+    QCOMPARE(firstLog.query,
+             "insert into \"torrents\" (\"name\", \"size\") values (?, ?), (?, ?)"
+             " returning \"id\"");
+    QCOMPARE(firstLog.boundValues,
+             QVector<QVariant>({QVariant("xyz"), QVariant(6),
+                                QVariant("abc"), QVariant(7)}));
+}
+
 void tst_PostgreSQL_QueryBuilder::update() const
 {
     auto log = DB::connection(m_connection).pretend([](auto &connection)
@@ -6,6 +6,7 @@ HEADERS += \
     $$PWD/models/datetime.hpp \
     $$PWD/models/datetime_serializeoverride.hpp \
     $$PWD/models/filepropertyproperty.hpp \
+    $$PWD/models/filepropertyproperty_entitycache.hpp \
     $$PWD/models/massassignmentmodels.hpp \
     $$PWD/models/phone.hpp \
     $$PWD/models/role.hpp \
@@ -17,6 +18,7 @@ HEADERS += \
     $$PWD/models/tagged.hpp \
     $$PWD/models/tagproperty.hpp \
     $$PWD/models/torrent.hpp \
+    $$PWD/models/torrent_batchedlazyloading.hpp \
     $$PWD/models/torrent_returnrelation.hpp \
     $$PWD/models/torrenteager.hpp \
     $$PWD/models/torrenteager_failed.hpp \
@@ -0,0 +1,29 @@
+#pragma once
+#ifndef MODELS_FILEPROPERTYPROPERTY_ENTITYCACHE_HPP
+#define MODELS_FILEPROPERTYPROPERTY_ENTITYCACHE_HPP
+
+#include "orm/tiny/model.hpp"
+
+namespace Models
+{
+
+using Orm::Tiny::Model;
+
+// NOLINTNEXTLINE(bugprone-exception-escape)
+class FilePropertyProperty_EntityCache final :
+        public Model<FilePropertyProperty_EntityCache>
+{
+    friend Model;
+    using Model::Model;
+
+    /*! The table associated with the model. */
+    QString u_table {"file_property_properties"};
+
+    /*! Indicates whether the model attributes are stored in the entity cache. */
+    T_THREAD_LOCAL
+    inline static const bool u_entityCache = true;
+};
+
+} // namespace Models
+
+#endif // MODELS_FILEPROPERTYPROPERTY_ENTITYCACHE_HPP
@@ -0,0 +1,70 @@
+#pragma once
+#ifndef MODELS_TORRENT_BATCHEDLAZYLOADING_HPP
+#define MODELS_TORRENT_BATCHEDLAZYLOADING_HPP
+
+#include "models/torrentpeer.hpp"
+#include "models/torrentpreviewablefile.hpp"
+#include "models/user.hpp"
+
+namespace Models
+{
+
+using Orm::Tiny::Model;
+using Orm::Tiny::Relations::BelongsTo;
+using Orm::Tiny::Relations::HasMany;
+using Orm::Tiny::Relations::HasOne;
+
+class TorrentPeer;
+class TorrentPreviewableFile;
+class User;
+
+// NOLINTNEXTLINE(bugprone-exception-escape)
+class Torrent_BatchedLazyLoading final :
+        public Model<Torrent_BatchedLazyLoading, TorrentPreviewableFile, TorrentPeer,
+                     User>
+{
+    friend Model;
+    using Model::Model;
+
+public:
+    /*! Get previewable files associated with the torrent. */
+    std::unique_ptr<HasMany<Torrent_BatchedLazyLoading, TorrentPreviewableFile>>
+    torrentFiles()
+    {
+        return hasMany<TorrentPreviewableFile>("torrent_id");
+    }
+
+    /*! Get a torrent peer associated with the torrent. */
+    std::unique_ptr<HasOne<Torrent_BatchedLazyLoading, TorrentPeer>>
+    torrentPeer()
+    {
+        return hasOne<TorrentPeer>("torrent_id");
+    }
+
+    /*! Get a user that owns the torrent. */
+    std::unique_ptr<BelongsTo<Torrent_BatchedLazyLoading, User>>
+    user()
+    {
+        return belongsTo<User>("user_id");
+    }
+
+private:
+    /*! The table associated with the model. */
+    QString u_table {"torrents"};
+
+    /*! Map of relation names to methods. */
+    QHash<QString, RelationVisitor> u_relations {
+        {"torrentFiles", [](auto &v) { v(&Torrent_BatchedLazyLoading::torrentFiles); }},
+        {"torrentPeer",  [](auto &v) { v(&Torrent_BatchedLazyLoading::torrentPeer); }},
+        {"user",         [](auto &v) { v(&Torrent_BatchedLazyLoading::user); }},
+    };
+
+    /*! Indicates whether the lazy loading of a relation on one of the models
+        hydrated together eager loads this relation for all of them. */
+    T_THREAD_LOCAL
+    inline static const bool u_batchLazyLoading = true;
+};
+
+} // namespace Models
+
+#endif // MODELS_TORRENT_BATCHEDLAZYLOADING_HPP